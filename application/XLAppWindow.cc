@@ -312,6 +312,18 @@ uint64_t AppWindow::getPresentationFrameInterval() const {
 	return _presentationEngine ? _presentationEngine->getTargetFrameInterval() : 0;
 }
 
+void AppWindow::setPresentationPipelineDepth(uint32_t value) {
+	_context->performOnThread([this, value] {
+		if (_presentationEngine) {
+			_presentationEngine->setPipelineDepth(value);
+		}
+	}, this, true);
+}
+
+uint32_t AppWindow::getPresentationPipelineDepth() const {
+	return _presentationEngine ? _presentationEngine->getPipelineDepth() : 1;
+}
+
 WindowState AppWindow::getUpdatableStateFlags() const {
 	auto caps = getCapabilities();
 	WindowState flags = WindowState::None;
@@ -105,6 +105,13 @@ public:
 	// 0 if no frame interval is set
 	uint64_t getPresentationFrameInterval() const;
 
+	// Set frame pipeline depth (see PresentationOptions::pipelineDepth)
+	// Can be called from any thread
+	void setPresentationPipelineDepth(uint32_t);
+
+	// Effective pipeline depth, limited by swapchain
+	uint32_t getPresentationPipelineDepth() const;
+
 	// State flags you can enable or disable
 	WindowState getUpdatableStateFlags() const;
 
@@ -31,6 +31,10 @@ static constexpr size_t NodePreallocateChilds = 4;
 
 static constexpr size_t MaxMaterialImages = 4;
 
+// Extra area around the node for the damage tracking to cover node's shadow,
+// in pixels per depth index unit
+static constexpr float NodeDamageDepthPadding = 4.0f;
+
 static constexpr uint32_t MaxAmbientLights = 16;
 static constexpr uint32_t MaxDirectLights = 16;
 
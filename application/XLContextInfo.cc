@@ -159,6 +159,49 @@ CommandLineParser<ContextConfig> ContextConfig::getCommandLineParser() {
 			return true;
 		}
 		return false;
+	}},
+		CommandLineOption<ContextConfig>{.patterns = {"--headless"},
+			.description = StringView("Run without window system, render windows with null device"),
+			.callback = [](ContextConfig &target, StringView pattern,
+								SpanView<StringView> args) -> bool {
+		if (!target.context) {
+			target.context = Rc<ContextInfo>::alloc();
+		}
+		if (!target.instance) {
+			target.instance = Rc<core::InstanceInfo>::alloc();
+		}
+		target.context->flags |= ContextFlags::Headless;
+		if (target.instance->api == core::InstanceApi::None) {
+			target.instance->api = core::InstanceApi::Null;
+		}
+		return true;
+	}},
+		CommandLineOption<ContextConfig>{.patterns = {"--gapi <vulkan|null>"},
+			.description = StringView("Select graphics API backend"),
+			.callback = [](ContextConfig &target, StringView pattern,
+								SpanView<StringView> args) -> bool {
+		if (!target.instance) {
+			target.instance = Rc<core::InstanceInfo>::alloc();
+		}
+		auto name = StringView(args.at(0));
+		if (name == "vulkan" || name == "vk") {
+			target.instance->api = core::InstanceApi::Vulkan;
+		} else if (name == "null") {
+			target.instance->api = core::InstanceApi::Null;
+		} else {
+			return false;
+		}
+		return true;
+	}},
+		CommandLineOption<ContextConfig>{.patterns = {"--url <launch-url>"},
+			.description = StringView("Initial launch URL (deep link)"),
+			.callback = [](ContextConfig &target, StringView pattern,
+								SpanView<StringView> args) -> bool {
+		if (!target.context) {
+			target.context = Rc<ContextInfo>::alloc();
+		}
+		target.context->launchUrl = args.at(0).str<Interface>();
+		return true;
 	}},
 		CommandLineOption<ContextConfig>{.patterns = {"--device <#>"},
 			.description = StringView("Force-disable Vulkan validation layers"),
@@ -224,6 +267,9 @@ Value ContextInfo::encode() const {
 	ret.setInteger(mainThreadsCount, "mainThreadsCount");
 
 	Value f;
+	if (hasFlag(flags, ContextFlags::Headless)) {
+		f.addString("Headless");
+	}
 	if (hasFlag(flags, ContextFlags::DestroyWhenAllWindowsClosed)) {
 		f.addString("DestroyWhenAllWindowsClosed");
 	}
@@ -93,6 +93,8 @@ struct SP_PUBLIC UpdateTime final {
 enum class ContextFlags : uint32_t {
 	None = 0,
 
+	// Run without window system connection; windows are rendered with the null device
+	// and are never shown (see `--headless` and `--gapi` command line options)
 	Headless = 1 << 0,
 
 	// Application shold be terminated when all it's windows were closed
@@ -24,6 +24,7 @@
 
 #include "platform/XLContextController.cc"
 #include "platform/XLContextNativeWindow.cc"
+#include "platform/XLContextHeadlessWindow.cc"
 #include "platform/XLDisplayConfigManager.cc"
 
 #if LINUX
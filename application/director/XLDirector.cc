@@ -47,6 +47,7 @@ bool Director::init(NotNull<AppThread> app, const core::FrameConstraints &constr
 	_engine = window->getPresentationEngine();
 	_allocator = Rc<AllocRef>::alloc();
 	_pool = Rc<PoolRef>::alloc(_allocator);
+	_framePools = Rc<core::FramePoolRing>::create(Rc<AllocRef>(_allocator));
 	_pool->perform([&, this] {
 		_scheduler = Rc<Scheduler>::create();
 		_actionManager = Rc<ActionManager>::create();
@@ -84,6 +85,7 @@ bool Director::acquireFrame(FrameRequest *req) {
 			_scene->setFrameConstraints(_constraints);
 			updateGeneralTransform();
 			_scene->handlePresented(this);
+			_damage.setFull();
 		}
 	}
 
@@ -114,7 +116,7 @@ bool Director::acquireFrame(FrameRequest *req) {
 			return;
 		}
 
-		auto pool = Rc<PoolRef>::alloc(_allocator);
+		auto pool = _framePools->acquireRef();
 
 		pool->perform([&, this] {
 			_scene->renderRequest(req, pool);
@@ -159,6 +161,7 @@ void Director::update(uint64_t t) {
 		_scene->setFrameConstraints(_constraints);
 		_scene->handlePresented(this);
 		_nextScene = nullptr;
+		_damage.setFull();
 	}
 
 	_inputDispatcher->update(_time);
@@ -242,6 +245,7 @@ void Director::setFrameConstraints(const core::FrameConstraints &c) {
 		}
 
 		updateGeneralTransform();
+		_damage.setFull();
 	}
 }
 
@@ -294,9 +298,34 @@ float Director::getTimestampFrameTime() const {
 	return _engine ? _engine->getLastTimestampFrameTime() / 1000.0f : 1.0f;
 }
 
+core::FramePoolStats Director::getFramePoolStats() const {
+	return _framePools ? _framePools->getStats() : core::FramePoolStats();
+}
+
 void Director::autorelease(Ref *ref) { _autorelease.emplace_back(ref); }
 
-void Director::invalidate() { }
+void Director::setDamageTrackingEnabled(bool value) {
+	if (_damageTracking != value) {
+		_damageTracking = value;
+		_damage.setFull();
+	}
+}
+
+void Director::addDamage(const Rect &rect) { _damage.add(rect); }
+
+void Director::addFullDamage() { _damage.setFull(); }
+
+FrameDamage Director::acquireDamage() {
+	if (!_damageTracking) {
+		return FrameDamage();
+	}
+
+	auto ret = _damage;
+	_damage.reset();
+	return ret;
+}
+
+void Director::invalidate() { _damage.setFull(); }
 
 void Director::updateGeneralTransform() {
 	auto transform = core::getPureTransform(_constraints.transform);
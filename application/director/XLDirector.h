@@ -26,6 +26,7 @@
 #include "XLResourceCache.h"
 #include "XLAppThread.h"
 #include "XLInput.h" // IWYU pragma: keep
+#include "XLCoreFramePool.h"
 #include "SPMovingAverage.h"
 
 namespace STAPPLER_VERSIONIZED stappler::xenolith {
@@ -89,8 +90,24 @@ public:
 
 	float getDirectorFrameTime() const { return _avgFrameTimeValue / 1000.0f; }
 
+	core::FramePoolStats getFramePoolStats() const;
+
 	void autorelease(Ref *);
 
+	// With damage tracking enabled, only screen areas changed since previous frame are redrawn,
+	// previous contents of the swapchain image is preserved elsewhere.
+	// Disabled by default: every frame redraws whole screen
+	void setDamageTrackingEnabled(bool);
+	bool isDamageTrackingEnabled() const { return _damageTracking; }
+
+	// Report damage, that can not be detected in scene graph traversal
+	// (like removed or hidden nodes)
+	void addDamage(const Rect &);
+	void addFullDamage();
+
+	// Returns damage, accumulated since previous call
+	FrameDamage acquireDamage();
+
 protected:
 	// Vk Swaphain was invalidated, drop all dependent resources;
 	void invalidate();
@@ -116,6 +133,7 @@ protected:
 
 	Rc<AllocRef> _allocator;
 	Rc<PoolRef> _pool;
+	Rc<core::FramePoolRing> _framePools;
 	Rc<Scheduler> _scheduler;
 	Rc<ActionManager> _actionManager;
 	Rc<InputDispatcher> _inputDispatcher;
@@ -123,6 +141,9 @@ protected:
 
 	Vector<Rc<Ref>> _autorelease;
 
+	bool _damageTracking = false;
+	FrameDamage _damage;
+
 	math::MovingAverage<20, uint64_t> _avgFrameTime;
 	uint64_t _avgFrameTimeValue = 0;
 };
@@ -91,6 +91,7 @@ core::MaterialId FrameContext::acquireMaterial(const core::PipelineFamilyInfo *f
 	}
 
 	if (auto m = Rc<core::Material>::create(newId, pipeline, sp::move(images), data)) {
+		m->setFlags(info.flags);
 		auto id = m->getId();
 		addPendingMaterial(move(m));
 		addMaterial(info, id, revokable);
@@ -141,6 +142,7 @@ MaterialInfo FrameContext::getMaterialInfo(const Rc<core::Material> &material) c
 	}
 
 	ret.pipeline = material->getPipeline()->material;
+	ret.flags = material->getFlags();
 	return ret;
 }
 
@@ -241,8 +243,14 @@ void FrameContext::submitMaterials(const FrameInfo &info) {
 			req->attachment = _materialAttachment;
 			req->materialsToAddOrUpdate = sp::move(_pendingMaterialsToAdd);
 			req->materialsToRemove = sp::move(_pendingMaterialsToRemove);
-			req->callback = [app = Rc<AppThread>(info.director->getApplication())] {
-				app->wakeup();
+			req->callback = [ctx = Rc<FrameContext>(this),
+									app = Rc<AppThread>(info.director->getApplication()),
+									dep = _materialDependency] {
+				app->performOnAppThread([ctx, dep] {
+					if (ctx->_submittedMaterialDependency == dep) {
+						ctx->_submittedMaterialDependency = nullptr;
+					}
+				}, ctx.get());
 			};
 
 			for (auto &it : req->materialsToRemove) { emplace_ordered(_revokedIds, it); }
@@ -252,7 +260,7 @@ void FrameContext::submitMaterials(const FrameInfo &info) {
 
 		_pendingMaterialsToAdd.clear();
 		_pendingMaterialsToRemove.clear();
-		_materialDependency = nullptr;
+		_submittedMaterialDependency = move(_materialDependency);
 	}
 }
 
@@ -105,6 +105,11 @@ protected:
 
 	Rc<core::DependencyEvent> _materialDependency;
 
+	// Last submitted material compilation, that is not yet completed. With pipelined frames,
+	// next frame can be processed before previous one, so it should wait for this compilation
+	// explicitly (see PresentationOptions::pipelineDepth)
+	Rc<core::DependencyEvent> _submittedMaterialDependency;
+
 	// отозванные ид могут быть выданы новым отзываемым материалам, чтобы не засорять биндинги
 	Vector<core::MaterialId> _revokedIds;
 };
@@ -116,6 +121,9 @@ struct SP_PUBLIC FrameContextHandle : public core::AttachmentInputData {
 	Rc<Director> director; // allow to access director from rendering pipeline (to send stats)
 	FrameContext *context = nullptr;
 
+	// Screen area, changed since previous frame, render pipeline can limit drawing with it
+	FrameDamage damage;
+
 	memory::vector<Pair<StateId, FrameStateOwnerInterface *>> stateStack;
 	memory::vector<DrawStateValues> states;
 
@@ -189,6 +197,9 @@ struct SP_PUBLIC FrameInfo {
 
 	FrameContextHandle *currentContext = nullptr;
 
+	// Screen area, changed since previous frame. Nodes add their changes to it within visit
+	FrameDamage damage;
+
 	memory::vector<Rc<System>> *pushSystem(const Rc<System> &comp) {
 		auto it = systemStack.find(comp->getFrameTag());
 		if (it == systemStack.end()) {
@@ -216,6 +227,10 @@ struct SP_PUBLIC FrameInfo {
 	}
 
 	void popContext() {
+		// only root context draws into the screen, nested contexts are always redrawn
+		if (contextStack.size() == 1) {
+			currentContext->damage = damage;
+		}
 		currentContext->context->submitHandle(*this, currentContext);
 		contextStack.pop_back();
 		if (contextStack.empty()) {
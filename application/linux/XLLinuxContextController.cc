@@ -32,6 +32,7 @@
 #include "linux/xcb/XLLinuxXcbWindow.h"
 #include "platform/XLContextController.h"
 #include "platform/XLContextNativeWindow.h"
+#include "platform/XLContextHeadlessWindow.h"
 
 #if MODULE_XENOLITH_BACKEND_VK
 #include "XLVkInstance.h"
@@ -130,6 +131,14 @@ int LinuxContextController::run(NotNull<ContextContainer> container) {
 	_context->handleConfigurationChanged(move(_contextInfo));
 
 	_contextInfo = nullptr;
+
+	if (hasFlag(_context->getInfo()->flags, ContextFlags::Headless)) {
+		// no window system and no session bus are required for the headless context
+		_looper->performOnThread([this] { runHeadless(); }, this);
+		_looper->run();
+		return ContextController::run(container);
+	}
+
 	_dbusController = Rc<dbus::Controller>::create(_dbus, _looper, this);
 
 	_looper->performOnThread([this] {
@@ -375,6 +384,20 @@ void LinuxContextController::tryStart() {
 
 Rc<core::Instance> LinuxContextController::loadInstance() {
 	Rc<core::Instance> instance;
+	if (_instanceInfo->api == core::InstanceApi::Null) {
+		// null device requires no platform-specific setup
+		auto instanceInfo = move(_instanceInfo);
+		_instanceInfo = nullptr;
+
+		instance = core::Instance::create(move(instanceInfo));
+		if (!instance) {
+			log::source().error("LinuxContextController",
+					"Null gAPI is not available: xenolith_backend_null module is not linked");
+			_resultCode = -1;
+		}
+		return instance;
+	}
+
 #if MODULE_XENOLITH_BACKEND_VK
 	auto instanceInfo = move(_instanceInfo);
 	_instanceInfo = nullptr;
@@ -440,6 +463,53 @@ bool LinuxContextController::loadWindow() {
 	return false;
 }
 
+void LinuxContextController::runHeadless() {
+	auto instance = loadInstance();
+	if (!instance) {
+		log::source().error("LinuxContextController", "Fail to load gAPI instance");
+		_resultCode = -1;
+		destroy();
+		return;
+	}
+
+	auto api = instance->getApi();
+	if (auto loop = makeLoop(instance)) {
+		_context->handleGraphicsLoaded(loop);
+	}
+
+	if (!resume()) {
+		log::source().error("LinuxContextController", "Fail to resume Context");
+		destroy();
+		return;
+	}
+
+	if (_windowInfo) {
+		if (api != core::InstanceApi::Null) {
+			// only the null device can present without a window system
+			log::source().warn("LinuxContextController", "Headless window is not supported for ",
+					core::getInstanceApiName(api), " gAPI, run with `--gapi null`");
+			_windowInfo = nullptr;
+		} else if (!loadHeadlessWindow()) {
+			log::source().error("LinuxContextController", "Fail to load headless window");
+			destroy();
+		}
+	}
+}
+
+bool LinuxContextController::loadHeadlessWindow() {
+	auto wInfo = move(_windowInfo);
+
+	if (configureWindow(wInfo)) {
+		auto window = Rc<HeadlessWindow>::create(this, move(wInfo));
+		if (window) {
+			notifyWindowCreated(window);
+			return true;
+		}
+	}
+
+	return false;
+}
+
 void LinuxContextController::handleContextWillDestroy() {
 	if (_xcbPollHandle) {
 		_xcbPollHandle->cancel();
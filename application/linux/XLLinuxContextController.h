@@ -68,6 +68,10 @@ protected:
 	Rc<core::Instance> loadInstance();
 	bool loadWindow();
 
+	// Run context without X11 or Wayland connection (see ContextFlags::Headless)
+	void runHeadless();
+	bool loadHeadlessWindow();
+
 	virtual void handleContextWillDestroy() override;
 	virtual void handleContextDidDestroy() override;
 
@@ -97,7 +97,7 @@ String MaterialInfo::description() const {
 		   << "},"
 		   << "{" << colorModes[0].toInt() << "," << colorModes[1].toInt() << ","
 		   << colorModes[2].toInt() << "," << colorModes[3].toInt() << "},"
-		   << "," << pipeline.description();
+		   << "," << pipeline.description() << "," << toInt(flags);
 
 	return stream.str();
 }
@@ -173,6 +173,7 @@ void Node::setLocalZOrder(ZOrder z) {
 	}
 
 	_zOrder = z;
+	_damaged = true;
 	if (_parent) {
 		_parent->reorderChild(this, z);
 	}
@@ -322,6 +323,8 @@ void Node::setVisible(bool visible) {
 	_visible = visible;
 	if (_visible) {
 		_contentSizeDirty = _transformInverseDirty = _transformCacheDirty = _transformDirty = true;
+	} else {
+		releaseDamage(true);
 	}
 }
 
@@ -780,6 +783,8 @@ void Node::handleExit() {
 		_frameContext = nullptr;
 	}
 
+	releaseDamage(false);
+
 	// prevent node destruction until update is ended
 	_director->autorelease(this);
 
@@ -1046,6 +1051,7 @@ void Node::setOpacity(OpacityValue value) { setOpacity(value.get() / 255.0f); }
 
 void Node::updateDisplayedOpacity(float parentOpacity) {
 	_displayedColor.a = _realColor.a * parentOpacity;
+	_damaged = true;
 
 	updateColor();
 
@@ -1072,6 +1078,7 @@ void Node::updateDisplayedColor(const Color4F &parentColor) {
 	_displayedColor.r = _realColor.r * parentColor.r;
 	_displayedColor.g = _realColor.g * parentColor.g;
 	_displayedColor.b = _realColor.b * parentColor.b;
+	_damaged = true;
 	updateColor();
 
 	if (_cascadeColorEnabled) {
@@ -1250,6 +1257,7 @@ NodeVisitFlags Node::processParentFlags(FrameInfo &info, NodeVisitFlags parentFl
 	if ((flags & NodeVisitFlags::GlobalTransformDirtyMask) != NodeVisitFlags::None
 			|| _transformDirty || _contentSizeDirty) {
 		_modelViewTransform = this->transform(info.modelTransformStack.back());
+		_damaged = true;
 
 		handleGlobalTransformDirty(info.modelTransformStack.back());
 	}
@@ -1327,6 +1335,8 @@ bool Node::wrapVisit(FrameInfo &info, NodeVisitFlags parentFlags, const VisitInf
 		info.depthStack.push_back(std::max(info.depthStack.back(), _depthIndex));
 	}
 
+	auto depth = info.depthStack.back();
+
 	memory::vector< memory::vector<Rc<System>> * > systems;
 
 	for (auto &it : _systems) {
@@ -1401,6 +1411,11 @@ bool Node::wrapVisit(FrameInfo &info, NodeVisitFlags parentFlags, const VisitInf
 
 	for (auto &it : systems) { info.popSystem(it); }
 
+	// node's content can be updated within visit, so, process damage after it
+	if (_damaged) {
+		updateDamage(info, depth);
+	}
+
 	if (_depthIndex > 0.0f) {
 		info.depthStack.pop_back();
 	}
@@ -1417,6 +1432,41 @@ bool Node::wrapVisit(FrameInfo &info, NodeVisitFlags parentFlags, const VisitInf
 	return true;
 }
 
+Rect Node::getDrawBounds() const { return Rect(0, 0, _contentSize.width, _contentSize.height); }
+
+Rect Node::getDamageBounds(const FrameInfo &info, float depth) const {
+	auto ret = TransformRect(getDrawBounds(), _modelViewTransform);
+	if (depth > 0.0f && ret.size.width > 0.0f && ret.size.height > 0.0f) {
+		auto padding = depth * config::NodeDamageDepthPadding
+				* info.director->getFrameConstraints().density;
+		ret.origin.x -= padding;
+		ret.origin.y -= padding;
+		ret.size.width += padding * 2.0f;
+		ret.size.height += padding * 2.0f;
+	}
+	return ret;
+}
+
+void Node::updateDamage(FrameInfo &info, float depth) {
+	// both previous and current area should be redrawn
+	info.damage.add(_damageBounds);
+	_damageBounds = getDamageBounds(info, depth);
+	info.damage.add(_damageBounds);
+	_damaged = false;
+}
+
+void Node::releaseDamage(bool recursive) {
+	if (_director) {
+		_director->addDamage(_damageBounds);
+	}
+	_damageBounds = Rect();
+	_damaged = true;
+
+	if (recursive) {
+		for (auto &it : _children) { it->releaseDamage(recursive); }
+	}
+}
+
 CallbackSystem *Node::makeDefaultCallbackSystem() {
 	auto system = getSystemByType<CallbackSystem>(DefaultCallbackSystemTag);
 	if (!system) {
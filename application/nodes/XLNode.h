@@ -315,7 +315,10 @@ public:
 	virtual void setColor(const Color4F &color, bool withOpacity = false);
 	virtual void updateDisplayedColor(const Color4F &parentColor);
 
-	virtual void setDepthIndex(float value) { _depthIndex = value; }
+	virtual void setDepthIndex(float value) {
+		_depthIndex = value;
+		_damaged = true;
+	}
 	virtual float getDepthIndex() const { return _depthIndex; }
 
 	virtual void draw(FrameInfo &, NodeVisitFlags flags);
@@ -357,6 +360,12 @@ public:
 
 	virtual float getMaxDepthIndex() const;
 
+	// Marks node's screen area to be redrawn within next frame, if damage tracking is enabled
+	// (see Director::setDamageTrackingEnabled). Transform, visibility and color changes are
+	// tracked automatically, node should call it when it's drawing content was changed
+	void setDamaged() { _damaged = true; }
+	bool isDamaged() const { return _damaged; }
+
 	// Recurse into parent tree to find node with specific component.
 	// Node that have specific component will be returned to callback.
 	// `depth` will be set to recursion depth where 0 - direct parent.
@@ -403,6 +412,18 @@ protected:
 
 	virtual bool wrapVisit(FrameInfo &, NodeVisitFlags flags, const VisitInfo &, bool useContext);
 
+	// Area, affected by node's drawing, in node's local coordinates, content rect by default.
+	// Nodes, that draws outside of the content rect, should extend it
+	virtual Rect getDrawBounds() const;
+
+	// Screen area, affected by node's drawing, in world coordinates
+	virtual Rect getDamageBounds(const FrameInfo &, float depth) const;
+
+	void updateDamage(FrameInfo &, float depth);
+
+	// Report last drawn area of the node and it's childs as damaged, when they are no longer drawn
+	void releaseDamage(bool recursive);
+
 	virtual CallbackSystem *makeDefaultCallbackSystem();
 
 	template <typename T>
@@ -424,6 +445,7 @@ protected:
 	bool _transformDirty = true;
 	mutable bool _transformCacheDirty = true; // dynamic value
 	mutable bool _transformInverseDirty = true; // dynamic value
+	bool _damaged = true;
 
 	NodeEventFlags _eventFlags = NodeEventFlags::None;
 
@@ -449,6 +471,9 @@ protected:
 	mutable Mat4 _inverse = Mat4::IDENTITY;
 	Mat4 _modelViewTransform = Mat4::IDENTITY;
 
+	// Last screen area, reported to damage tracking
+	Rect _damageBounds;
+
 	Vector<Rc<Node>> _children;
 	Node *_parent = nullptr;
 
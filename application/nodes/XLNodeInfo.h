@@ -80,6 +80,7 @@ struct SP_PUBLIC MaterialInfo {
 	std::array<uint16_t, config::MaxMaterialImages> samplers = {0};
 	std::array<core::ColorMode, config::MaxMaterialImages> colorModes = {core::ColorMode()};
 	core::PipelineMaterialInfo pipeline;
+	core::MaterialFlags flags;
 
 	uint64_t hash() const {
 		return hash::hash64(reinterpret_cast<const char *>(this), sizeof(MaterialInfo));
@@ -140,6 +141,50 @@ struct SP_PUBLIC DrawStateValues {
 	}
 };
 
+// Screen area, changed since previous frame (in world coordinates, same as scissor)
+// Full damage means that the whole target should be redrawn
+struct SP_PUBLIC FrameDamage {
+	Rect rect;
+	bool full = true;
+
+	bool isFull() const { return full; }
+	bool isEmpty() const { return !full && (rect.size.width <= 0.0f || rect.size.height <= 0.0f); }
+
+	void add(const Rect &r) {
+		if (full || r.size.width <= 0.0f || r.size.height <= 0.0f) {
+			return;
+		}
+
+		if (rect.size.width <= 0.0f || rect.size.height <= 0.0f) {
+			rect = r;
+		} else {
+			auto minX = std::min(rect.getMinX(), r.getMinX());
+			auto minY = std::min(rect.getMinY(), r.getMinY());
+			auto maxX = std::max(rect.getMaxX(), r.getMaxX());
+			auto maxY = std::max(rect.getMaxY(), r.getMaxY());
+			rect = Rect(minX, minY, maxX - minX, maxY - minY);
+		}
+	}
+
+	void add(const FrameDamage &d) {
+		if (d.full) {
+			setFull();
+		} else {
+			add(d.rect);
+		}
+	}
+
+	void setFull() {
+		full = true;
+		rect = Rect();
+	}
+
+	void reset() {
+		full = false;
+		rect = Rect();
+	}
+};
+
 struct SP_PUBLIC DrawStat {
 	uint32_t vertexes;
 	uint32_t triangles;
@@ -151,6 +196,10 @@ struct SP_PUBLIC DrawStat {
 	uint32_t cachedImageViews;
 	uint32_t materials;
 
+	// device memory for aliased transient attachments and memory saved by aliasing, in KiB
+	uint32_t aliasedMemory;
+	uint32_t aliasingSavedMemory;
+
 	uint32_t solidCmds;
 	uint32_t surfaceCmds;
 	uint32_t transparentCmds;
@@ -26,6 +26,7 @@
 #include "XLInputDispatcher.h"
 #include "XLDirector.h"
 #include "XLSceneContent.h"
+#include "XLCoreTrace.h"
 
 namespace STAPPLER_VERSIONIZED stappler::xenolith {
 
@@ -91,12 +92,22 @@ void Scene::render(FrameInfo &info) {
 	info.depthStack.reserve(4);
 	info.depthStack.push_back(0.0f);
 
+	info.damage = _director->acquireDamage();
+
 	auto eventDispatcher = _director->getInputDispatcher();
 
 	info.input = eventDispatcher->acquireNewStorage();
 
-	visitGeometry(info, NodeVisitFlags::None);
-	visitDraw(info, NodeVisitFlags::None);
+	do {
+		core::TraceScope trace(core::TraceCategory::Scene, "Scene::visitGeometry");
+		visitGeometry(info, NodeVisitFlags::None);
+	} while (0);
+
+	do {
+		// commands for the frame are emitted within draw visit
+		core::TraceScope trace(core::TraceCategory::Commands, "Scene::visitDraw");
+		visitDraw(info, NodeVisitFlags::None);
+	} while (0);
 
 	eventDispatcher->commitStorage(_director->getWindow(), move(info.input));
 }
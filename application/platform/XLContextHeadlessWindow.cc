@@ -0,0 +1,80 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "XLContextHeadlessWindow.h"
+#include "XLContextController.h"
+
+#if MODULE_XENOLITH_BACKEND_NULL
+#include "XLNullSwapchain.h"
+#endif
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::platform {
+
+bool HeadlessWindow::init(NotNull<ContextController> c, Rc<WindowInfo> &&info) {
+	if (info->rect.width > 0 && info->rect.height > 0) {
+		_extent = Extent2(info->rect.width, info->rect.height);
+	}
+
+	if (!NativeWindow::init(c, move(info), WindowCapabilities::None)) {
+		return false;
+	}
+
+	_info->state |= WindowState::Focused;
+	return true;
+}
+
+void HeadlessWindow::mapWindow() { }
+
+void HeadlessWindow::unmapWindow() { }
+
+bool HeadlessWindow::close() {
+	if (!_closed) {
+		// there is no user to confirm close request, so, exit guard is ignored
+		_closed = _controller->notifyWindowClosed(this,
+				WindowCloseOptions::CloseInPlace | WindowCloseOptions::IgnoreExitGuard);
+	}
+	return _closed;
+}
+
+Rc<core::Surface> HeadlessWindow::makeSurface(NotNull<core::Instance> instance) {
+#if MODULE_XENOLITH_BACKEND_NULL
+	if (instance->getApi() == core::InstanceApi::Null) {
+		return Rc<null::Surface>::create(static_cast<null::Instance *>(instance.get()), _extent,
+				this);
+	}
+#endif
+	log::source().error("HeadlessWindow", "Headless presentation is not supported for ",
+			core::getInstanceApiName(instance->getApi()), " instance");
+	return nullptr;
+}
+
+core::PresentationOptions HeadlessWindow::getPreferredOptions() const {
+	core::PresentationOptions opts;
+	// no compositor to follow, frames are paced only by the presentation engine;
+	// render continuously, so frame timings reflect the engine throughput
+	opts.renderOnDemand = false;
+	opts.followDisplayLink = false;
+	opts.followDisplayLinkBarrier = false;
+	return opts;
+}
+
+} // namespace stappler::xenolith::platform
@@ -0,0 +1,68 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef XENOLITH_APPLICATION_PLATFORM_XLCONTEXTHEADLESSWINDOW_H_
+#define XENOLITH_APPLICATION_PLATFORM_XLCONTEXTHEADLESSWINDOW_H_
+
+#include "XLContextNativeWindow.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::platform {
+
+// Window without a window system: it is never shown and receives no input.
+// Frames are rendered and presented on gAPI surface without a display (null::Surface).
+// Used with ContextFlags::Headless to run scenes for benchmarking and testing.
+class HeadlessWindow final : public NativeWindow {
+public:
+	static constexpr Extent2 DefaultExtent = Extent2(1'024, 768);
+
+	virtual ~HeadlessWindow() = default;
+
+	virtual bool init(NotNull<ContextController>, Rc<WindowInfo> &&);
+
+	virtual void mapWindow() override;
+	virtual void unmapWindow() override;
+
+	virtual bool close() override;
+
+	virtual Extent2 getExtent() const override { return _extent; }
+
+	virtual Rc<core::Surface> makeSurface(NotNull<core::Instance>) override;
+
+	virtual core::PresentationOptions getPreferredOptions() const override;
+
+protected:
+	using NativeWindow::init;
+
+	virtual bool updateTextInput(const TextInputRequest &,
+			TextInputFlags flags = TextInputFlags::RunIfDisabled) override {
+		return false;
+	}
+
+	virtual void cancelTextInput() override { }
+
+	Extent2 _extent = DefaultExtent;
+	bool _closed = false;
+};
+
+} // namespace stappler::xenolith::platform
+
+#endif /* XENOLITH_APPLICATION_PLATFORM_XLCONTEXTHEADLESSWINDOW_H_ */
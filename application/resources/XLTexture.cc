@@ -117,6 +117,13 @@ Extent3 Texture::getExtent() const {
 	return Extent3();
 }
 
+uint32_t Texture::getDynamicGeneration() const {
+	if (_dynamic) {
+		return _dynamic->getCompiledGeneration();
+	}
+	return 0;
+}
+
 bool Texture::isLoaded() const {
 	return _dynamic || (_temporary && _temporary->isLoaded() && _data->image) || _data->image;
 }
@@ -48,6 +48,10 @@ public:
 
 	virtual bool isLoaded() const;
 
+	// Compiled generation of the dynamic image, changes when new image instance becomes
+	// available for drawing, always 0 for static images
+	uint32_t getDynamicGeneration() const;
+
 	core::MaterialImage getMaterialImage() const;
 
 	// returns nullptr for dynamic images
@@ -0,0 +1,61 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef XENOLITH_BACKEND_NULL_XLNULL_H_
+#define XENOLITH_BACKEND_NULL_XLNULL_H_
+
+#include "XLCommon.h" // IWYU pragma: keep
+#include "XLCoreInstance.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::null {
+
+using core::BufferInfo;
+using core::ImageInfo;
+using core::ImageInfoData;
+using core::ImageViewInfo;
+
+class Instance;
+class Device;
+class Loop;
+
+// Simulated device timings for the null backend, all values in microseconds
+struct SP_PUBLIC LoopBackendInfo : public core::LoopBackendInfo {
+	virtual ~LoopBackendInfo() = default;
+
+	// time between queue submission and fence signal
+	uint64_t submitLatency = 0;
+
+	// number of simulated queues in each family
+	uint32_t queueCount = 2;
+
+	virtual Value encode() const override;
+};
+
+struct SP_PUBLIC InstanceBackendInfo : public core::InstanceBackendInfo {
+	virtual ~InstanceBackendInfo() = default;
+
+	virtual Value encode() const override;
+};
+
+} // namespace stappler::xenolith::null
+
+#endif /* XENOLITH_BACKEND_NULL_XLNULL_H_ */
@@ -0,0 +1,46 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "XLCommon.h"
+#include "XLNull.h"
+
+#include "XLNullObject.cc"
+#include "XLNullDevice.cc"
+#include "XLNullQueuePass.cc"
+#include "XLNullSwapchain.cc"
+#include "XLNullPresentationEngine.cc"
+#include "XLNullLoop.cc"
+#include "XLNullInstance.cc"
+
+#include "SPSharedModule.h"
+#include "XLNullInstance.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::null {
+
+static SharedSymbol s_nullSharedSymbols[] = {
+	SharedSymbol("createInstance", createInstance),
+};
+
+SP_USED static SharedModule s_nullSharedModule(buildconfig::MODULE_XENOLITH_BACKEND_NULL_NAME,
+		s_nullSharedSymbols, sizeof(s_nullSharedSymbols) / sizeof(SharedSymbol));
+
+} // namespace stappler::xenolith::null
@@ -0,0 +1,114 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "XLNullDevice.h"
+#include "XLNullLoop.h"
+#include "XLCoreImageStorage.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::null {
+
+bool Device::init(const Instance *instance, const LoopBackendInfo &info) {
+	if (!core::Device::init(instance)) {
+		return false;
+	}
+
+	_submitLatency = info.submitLatency;
+
+	_depthFormats = Vector<core::ImageFormat>{core::ImageFormat::D16_UNORM,
+		core::ImageFormat::D32_SFLOAT, core::ImageFormat::D24_UNORM_S8_UINT,
+		core::ImageFormat::D32_SFLOAT_S8_UINT};
+	_colorFormats = Vector<core::ImageFormat>{core::ImageFormat::R8G8B8A8_UNORM,
+		core::ImageFormat::B8G8R8A8_UNORM, core::ImageFormat::R8G8B8A8_SRGB,
+		core::ImageFormat::B8G8R8A8_SRGB};
+
+	// single family, that supports all operations, including presentation on null::Surface
+	auto &family =
+			_families.emplace_back(core::DeviceQueueFamily{0, std::max(info.queueCount, 1U)});
+	family.flags = core::QueueFlags::Graphics | core::QueueFlags::Compute
+			| core::QueueFlags::Transfer | core::QueueFlags::Present;
+	family.preferred = family.flags;
+
+	for (uint32_t i = 0; i < family.count; ++i) {
+		family.queues.emplace_back(Rc<DeviceQueue>::create(*this, family.index, family.flags));
+	}
+
+	_started = true;
+	return true;
+}
+
+Rc<core::Framebuffer> Device::makeFramebuffer(const core::QueuePassData *pass,
+		SpanView<Rc<core::ImageView>> views) {
+	return Rc<Framebuffer>::create(*this, (RenderPass *)pass->impl.get(), views);
+}
+
+auto Device::makeImage(StringView key, const ImageInfoData &imageInfo) -> Rc<ImageStorage> {
+	return Rc<ImageStorage>::create(Rc<Image>::create(*this, key, imageInfo));
+}
+
+Rc<core::Semaphore> Device::makeSemaphore() {
+	return Rc<Semaphore>::create(*this, core::SemaphoreType::Default);
+}
+
+Rc<core::ImageView> Device::makeImageView(const Rc<core::ImageObject> &img,
+		const ImageViewInfo &info) {
+	return Rc<ImageView>::create(*this, img.get(), info);
+}
+
+Rc<Fence> Device::makeFence(core::FenceType type) { return Rc<Fence>::create(*this, type); }
+
+Rc<Buffer> Device::makeBuffer(const BufferInfo &info, BytesView data) {
+	return Rc<Buffer>::create(*this, info, data);
+}
+
+void Device::compileResource(const Rc<core::Resource> &res) {
+	for (auto &it : res->getImages()) {
+		auto image = Rc<Image>::create(*this, it->key, *it, Rc<core::DataAtlas>(it->atlas));
+		it->image = image;
+		for (auto &view : it->views) { view->view = makeImageView(it->image, *view); }
+	}
+
+	for (auto &it : res->getBuffers()) {
+		auto buffer = Rc<Buffer>::create(*this, *it);
+		it->writeData(buffer->getData(), buffer->getSize());
+		it->buffer = buffer;
+	}
+
+	res->setCompiled(true);
+}
+
+void Device::compileImage(const Loop &loop, const Rc<core::DynamicImage> &img,
+		Function<void(bool)> &&cb) {
+	loop.performInQueue([this, img, loop = Rc<Loop>((Loop *)&loop), cb = sp::move(cb)]() mutable {
+		auto info = img->getInfo();
+		auto image = Rc<Image>::create(*this, info.key, info);
+		img->acquireData([&](BytesView view) { image->setData(view); });
+
+		loop->performOnThread([img, image = move(image), cb = sp::move(cb)]() mutable {
+			img->setImage(image.get());
+			if (cb) {
+				cb(true);
+			}
+		}, loop);
+	}, img);
+}
+
+} // namespace stappler::xenolith::null
@@ -0,0 +1,64 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef XENOLITH_BACKEND_NULL_XLNULLDEVICE_H_
+#define XENOLITH_BACKEND_NULL_XLNULLDEVICE_H_
+
+#include "XLNullObject.h"
+#include "XLCoreDevice.h"
+#include "XLCoreDynamicImage.h"
+#include "XLCoreResource.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::null {
+
+// Device without GPU: objects are host-only, queue submissions are signaled
+// after configured latency
+class SP_PUBLIC Device : public core::Device {
+public:
+	virtual ~Device() = default;
+
+	bool init(const Instance *, const LoopBackendInfo &);
+
+	virtual Rc<core::Framebuffer> makeFramebuffer(const core::QueuePassData *,
+			SpanView<Rc<core::ImageView>>) override;
+	virtual Rc<ImageStorage> makeImage(StringView, const ImageInfoData &) override;
+	virtual Rc<core::Semaphore> makeSemaphore() override;
+	virtual Rc<core::ImageView> makeImageView(const Rc<core::ImageObject> &,
+			const ImageViewInfo &) override;
+
+	Rc<Fence> makeFence(core::FenceType);
+	Rc<Buffer> makeBuffer(const BufferInfo &, BytesView = BytesView());
+
+	void compileResource(const Rc<core::Resource> &);
+	void compileImage(const Loop &, const Rc<core::DynamicImage> &, Function<void(bool)> &&);
+
+	uint64_t getSubmitLatency() const { return _submitLatency; }
+
+protected:
+	using core::Device::init;
+
+	uint64_t _submitLatency = 0;
+};
+
+} // namespace stappler::xenolith::null
+
+#endif /* XENOLITH_BACKEND_NULL_XLNULLDEVICE_H_ */
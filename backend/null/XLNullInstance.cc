@@ -0,0 +1,62 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "XLNullInstance.h"
+#include "XLNullDevice.h"
+#include "XLNullLoop.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::null {
+
+Value LoopBackendInfo::encode() const {
+	Value ret;
+	ret.setInteger(submitLatency, "submitLatency");
+	ret.setInteger(queueCount, "queueCount");
+	return ret;
+}
+
+Value InstanceBackendInfo::encode() const { return Value(); }
+
+Instance::Instance(core::InstanceFlags flags)
+: core::Instance(core::InstanceApi::Null, flags, Dso()) {
+	_availableDevices.emplace_back(core::DeviceProperties{"Null Device", 0, 0, false});
+}
+
+Rc<core::Loop> Instance::makeLoop(NotNull<event::Looper> looper,
+		Rc<core::LoopInfo> &&info) const {
+	return Rc<null::Loop>::create(looper, const_cast<Instance *>(this), move(info));
+}
+
+Rc<Device> Instance::makeDevice(const core::LoopInfo &info) const {
+	auto data = info.backend.get_cast<LoopBackendInfo>();
+	if (!data) {
+		log::source().error("null::Instance",
+				"Fail to create device: loop platform data is not defined");
+		return nullptr;
+	}
+	return Rc<Device>::create(this, *data);
+}
+
+Rc<core::Instance> createInstance(Rc<core::InstanceInfo> &&info) {
+	return Rc<null::Instance>::alloc(info->flags);
+}
+
+} // namespace stappler::xenolith::null
@@ -0,0 +1,604 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "XLNullLoop.h"
+#include "XLNullQueuePass.h"
+#include "XLCoreQueue.h"
+#include "XLCoreFrameHandle.h"
+#include "XLCoreFrameCache.h"
+#include "XLCoreMaterial.h"
+#include "XLNullPresentationEngine.h"
+
+#include "SPEventLooper.h"
+#include "SPEventTimerHandle.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::null {
+
+struct DependencyRequest : public Ref {
+	Vector<Rc<core::DependencyEvent>> events;
+	Function<void(bool)> callback;
+	uint32_t signaled = 0;
+	bool success = true;
+};
+
+struct Loop::Internal final {
+	Internal(Loop *l) : loop(l) { }
+
+	void endDevice() {
+		if (!device) {
+			return;
+		}
+
+		defaultFences.clear();
+		swapchainFences.clear();
+		device->end();
+		device = nullptr;
+	}
+
+	void update(bool lockfree = true) {
+		auto it = scheduledFences.begin();
+		while (it != scheduledFences.end()) {
+			if ((*it)->check(*loop, lockfree)) {
+				it = scheduledFences.erase(it);
+			} else {
+				++it;
+			}
+		}
+
+		if (updateTimerHandle && scheduledFences.empty()) {
+			updateTimerHandle->pause();
+		}
+	}
+
+	void waitIdle() {
+		// wait for all pending tasks on fences
+		for (auto &it : scheduledFences) { it->check(*loop, false); }
+		scheduledFences.clear();
+
+		if (device) {
+			device->waitIdle();
+		}
+	}
+
+	void compileQueue(const Rc<core::Queue> &req, Function<void(bool)> &&cb) {
+		if (!_running.load()) {
+			return;
+		}
+
+		if (!device) {
+			log::source().error("null::Loop", "No device to compileQueue");
+			return;
+		}
+
+		if (auto res = req->getInternalResource()) {
+			if (!res->isCompiled()) {
+				device->compileResource(res);
+			}
+		}
+
+		req->prepare(*device);
+
+		// same FrameCache registration, as the real queue compiler does
+		auto cache = loop->getFrameCache();
+
+		Vector<uint64_t> passIds;
+		for (auto &it : req->getPasses()) {
+			auto pass = Rc<RenderPass>::create(*device, *it);
+			if (!pass) {
+				log::source().error("null::Loop", "Fail to compile render pass ", it->key);
+				if (cb) {
+					cb(false);
+				}
+				return;
+			}
+
+			it->impl = pass.get();
+			it->pass->setFrameHandleCallback(
+					[](core::QueuePass &pass, const core::FrameQueue &q)
+							-> Rc<core::QueuePassHandle> {
+				return Rc<QueuePassHandle>::create(pass, q);
+			});
+
+			if (it->pass->getType() != core::PassType::Generic) {
+				passIds.emplace_back(pass->getIndex());
+				cache->addRenderPass(pass->getIndex());
+			}
+		}
+
+		Vector<uint64_t> attachmentIds;
+		for (auto &it : req->getAttachments()) {
+			if (it->type == core::AttachmentType::Image) {
+				attachmentIds.emplace_back(it->id);
+				cache->addAttachment(it->id);
+			}
+		}
+
+		for (auto &it : req->getAttachmentAliasing()) {
+			Vector<uint64_t> ids;
+			for (auto &a : it->attachments) { ids.emplace_back(a->id); }
+			cache->addAliasingGroup(req->getName(), ids);
+		}
+
+		req->setCompiled(*device,
+				[loop = Rc<core::Loop>(loop), passIds = sp::move(passIds),
+						attachmentIds = sp::move(attachmentIds)]() mutable {
+			loop->performOnThread([loop, passIds = sp::move(passIds),
+										  attachmentIds = sp::move(attachmentIds)]() mutable {
+				auto cache = loop->getFrameCache();
+				for (auto &id : passIds) { cache->removeRenderPass(id); }
+				for (auto &id : attachmentIds) { cache->removeAttachment(id); }
+				cache->removeUnreachableFramebuffers();
+			});
+		});
+
+		for (auto &it : req->getAttachments()) {
+			if (auto v = it->attachment.cast<core::MaterialAttachment>()) {
+				auto initial = v->getPredefinedMaterials();
+				if (!initial.empty()) {
+					auto data = v->allocateSet(*device, v->getTargetLayout()->imageCount);
+					updateMaterials(data, initial, SpanView<core::MaterialId>(),
+							SpanView<core::MaterialId>());
+					v->setMaterials(data);
+				}
+			}
+		}
+
+		if (cb) {
+			cb(true);
+		}
+	}
+
+	void compileMaterials(Rc<core::MaterialInputData> &&req, Vector<Rc<DependencyEvent>> &&deps) {
+		if (!_running.load()) {
+			return;
+		}
+
+		auto attachment = req->attachment;
+		Rc<core::MaterialSet> data;
+		if (auto &set = attachment->getMaterials()) {
+			data = attachment->cloneSet(set);
+		} else {
+			data = attachment->allocateSet(*device, attachment->getTargetLayout()->imageCount);
+		}
+
+		updateMaterials(data, req->materialsToAddOrUpdate, req->dynamicMaterialsToUpdate,
+				req->materialsToRemove);
+		attachment->setMaterials(data);
+
+		signalDependencies(deps, attachment->getCompiler(), true);
+
+		if (req->callback) {
+			req->callback();
+		}
+	}
+
+	void updateMaterials(const Rc<core::MaterialSet> &data, SpanView<Rc<core::Material>> materials,
+			SpanView<core::MaterialId> dynamicMaterials,
+			SpanView<core::MaterialId> materialsToRemove) {
+		data->updateMaterials(materials, dynamicMaterials, materialsToRemove,
+				[&, this](const core::MaterialImage &image) -> Rc<core::ImageView> {
+			for (auto &it : image.image->views) {
+				if (*it == image.info || it->view->getInfo() == image.info) {
+					return it->view;
+				}
+			}
+
+			return device->makeImageView(image.image->image, image.info);
+		});
+	}
+
+	void signalDependencies(const Vector<Rc<DependencyEvent>> &events, Queue *queue, bool success) {
+		for (auto &it : events) {
+			if (it->signal(queue, success)) {
+				auto iit = dependencyRequests.equal_range(it.get());
+				auto tmp = iit;
+				while (iit.first != iit.second) {
+					auto &v = iit.first->second;
+					if (!success) {
+						v->success = false;
+					}
+					++v->signaled;
+					if (v->signaled == v->events.size()) {
+						v->callback(iit.first->second->success);
+					}
+					++iit.first;
+				}
+				dependencyRequests.erase(tmp.first, tmp.second);
+			}
+		}
+	}
+
+	void waitForDependencies(Vector<Rc<DependencyEvent>> &&events, Function<void(bool)> &&cb) {
+		auto req = Rc<DependencyRequest>::alloc();
+		req->events = sp::move(events);
+		req->callback = sp::move(cb);
+
+		for (auto &it : req->events) {
+			if (it->isSignaled()) {
+				if (!it->isSuccessful()) {
+					req->success = false;
+				}
+				++req->signaled;
+			} else {
+				dependencyRequests.emplace(it.get(), req);
+			}
+		}
+
+		if (req->signaled == req->events.size()) {
+			req->callback(req->success);
+		}
+	}
+
+	void scheduleFence(Rc<Fence> &&fence) {
+		if (!_running) {
+			fence->check(*loop, false);
+			return;
+		}
+
+		if (scheduledFences.empty() && updateTimerHandle) {
+			auto status = updateTimerHandle->resume();
+			if (status != Status::Ok) {
+				log::source().error("null::Loop", "Fail to resume fence scheduler: ", status);
+			}
+		}
+		scheduledFences.emplace(move(fence));
+	}
+
+	Loop *loop = nullptr;
+
+	Rc<event::TimerHandle> updateTimerHandle;
+
+	std::multimap<DependencyEvent *, Rc<DependencyRequest>, std::less<void>> dependencyRequests;
+
+	Mutex resourceMutex;
+
+	Rc<Device> device;
+	Vector<Rc<Fence>> defaultFences;
+	Vector<Rc<Fence>> swapchainFences;
+	Set<Rc<Fence>> scheduledFences;
+
+	std::atomic<bool> _running = true;
+};
+
+Loop::~Loop() {
+	_looper->performOnThread([internal = _internal, frameCache = _frameCache] {
+		internal->_running = false;
+
+		if (frameCache) {
+			frameCache->invalidate();
+		}
+
+		internal->waitIdle();
+		internal->endDevice();
+
+		delete internal;
+	}, nullptr);
+}
+
+bool Loop::init(NotNull<event::Looper> looper, NotNull<core::Instance> instance,
+		Rc<LoopInfo> &&info) {
+	if (!core::Loop::init(looper, instance, move(info))) {
+		return false;
+	}
+
+	if (!_info->backend.get_cast<LoopBackendInfo>()) {
+		_info->backend = Rc<LoopBackendInfo>::alloc();
+	}
+
+	looper->performOnThread([&] {
+		_internal = new Internal(this);
+
+		if (auto dev = _instance.get_cast<Instance>()->makeDevice(*_info)) {
+			_internal->device = move(dev);
+			_frameCache = Rc<FrameCache>::create(*this, *_internal->device);
+		} else {
+			log::source().error("null::Loop", "Unable to create device");
+		}
+	}, this, true);
+
+	return true;
+}
+
+void Loop::run() {
+	_looper->performOnThread([&] {
+		_internal->updateTimerHandle = _looper->scheduleTimer(event::TimerInfo{
+			.completion = event::TimerInfo::Completion::create<Loop>(this,
+					[](Loop *loop, event::TimerHandle *, uint32_t value, Status status) {
+			if (loop->_internal) {
+				loop->_internal->update();
+			}
+			if (loop->_frameCache) {
+				loop->_frameCache->clear();
+			}
+		}),
+			.interval = TimeInterval::microseconds(config::PresentationSchedulerInterval),
+			.count = event::TimerInfo::Infinite});
+		_internal->updateTimerHandle->setUserdata(this);
+	}, this, true);
+}
+
+void Loop::stop() {
+	_looper->performOnThread([&] {
+		_internal->_running = false;
+		_internal->waitIdle();
+
+		_internal->update(false);
+
+		if (_internal->updateTimerHandle) {
+			_internal->updateTimerHandle->cancel();
+			_internal->updateTimerHandle = nullptr;
+		}
+
+		_internal->defaultFences.clear();
+		_internal->swapchainFences.clear();
+	}, this);
+}
+
+bool Loop::isRunning() const { return _internal && _internal->_running; }
+
+void Loop::compileResource(Rc<core::Resource> &&req, Function<void(bool)> &&cb,
+		bool preload) const {
+	if (preload) {
+		_internal->device->compileResource(req);
+		performOnThread([cb = sp::move(cb)] {
+			if (cb) {
+				cb(true);
+			}
+		}, const_cast<Loop *>(this), true);
+		return;
+	}
+
+	performInQueue([this, req = sp::move(req), cb = sp::move(cb)]() mutable {
+		_internal->device->compileResource(req);
+		performOnThread([cb = sp::move(cb)] {
+			if (cb) {
+				cb(true);
+			}
+		}, const_cast<Loop *>(this), true);
+	}, const_cast<Loop *>(this));
+}
+
+void Loop::compileQueue(const Rc<Queue> &req, Function<void(bool)> &&callback) const {
+	performOnThread([this, req, callback = sp::move(callback)]() mutable {
+		if (!_internal) {
+			return;
+		}
+		_internal->compileQueue(req, sp::move(callback));
+	}, const_cast<Loop *>(this), true);
+}
+
+void Loop::compileMaterials(Rc<core::MaterialInputData> &&req,
+		const Vector<Rc<DependencyEvent>> &deps) const {
+	performOnThread([this, req = move(req), deps = deps]() mutable {
+		if (!_internal) {
+			return;
+		}
+		_internal->compileMaterials(sp::move(req), sp::move(deps));
+	}, const_cast<Loop *>(this), true);
+}
+
+void Loop::compileImage(const Rc<core::DynamicImage> &img, Function<void(bool)> &&callback) const {
+	performOnThread([this, img, callback = sp::move(callback)]() mutable {
+		if (!_internal) {
+			return;
+		}
+		_internal->device->compileImage(*this, img, sp::move(callback));
+	}, const_cast<Loop *>(this), true);
+}
+
+void Loop::runRenderQueue(Rc<FrameRequest> &&req, uint64_t gen, Function<void(bool)> &&callback) {
+	performOnThread([this, req = sp::move(req), gen, callback = sp::move(callback)]() mutable {
+		if (!_internal || !_internal->_running.load()) {
+			return;
+		}
+
+		auto frame = makeFrame(move(req), gen);
+		if (frame && callback) {
+			frame->setCompleteCallback([this, callback = sp::move(callback)](FrameHandle &handle) {
+				if (!_internal || !_internal->_running.load()) {
+					return;
+				}
+				callback(handle.isValid());
+			});
+		}
+		if (frame) {
+			frame->update(true);
+		}
+	}, this, true);
+}
+
+void Loop::performInQueue(Rc<thread::Task> &&task) const {
+	if (!_internal || !_internal->_running.load()) {
+		task->cancel();
+		return;
+	}
+
+	_looper->performAsync(move(task));
+}
+
+void Loop::performInQueue(Function<void()> &&func, Ref *target) const {
+	if (!_internal || !_internal->_running.load()) {
+		return;
+	}
+
+	_looper->performAsync(sp::move(func), target);
+}
+
+void Loop::performOnThread(Function<void()> &&func, Ref *target, bool immediate,
+		StringView tag) const {
+	if (!_internal || !_internal->_running.load()) {
+		return;
+	}
+
+	if (immediate) {
+		if (_looper->isOnThisThread()) {
+			func();
+			return;
+		}
+	}
+
+	_looper->performOnThread(sp::move(func), target, immediate, tag);
+}
+
+auto Loop::makeFrame(Rc<FrameRequest> &&req, uint64_t gen) -> Rc<FrameHandle> {
+	return Rc<FrameHandle>::create(*this, *_internal->device, move(req), gen);
+}
+
+Rc<core::Framebuffer> Loop::acquireFramebuffer(const PassData *data,
+		SpanView<Rc<core::ImageView>> views) {
+	return _frameCache->acquireFramebuffer(data, views);
+}
+
+void Loop::releaseFramebuffer(Rc<core::Framebuffer> &&fb) {
+	_frameCache->releaseFramebuffer(move(fb));
+}
+
+auto Loop::acquireImage(const ImageAttachment *a, const AttachmentHandle *h,
+		const core::ImageInfoData &i, uint64_t frame) -> Rc<ImageStorage> {
+	core::ImageInfoData info(i);
+	if (a->isTransient()) {
+		if ((info.usage
+					& (core::ImageUsage::ColorAttachment | core::ImageUsage::DepthStencilAttachment
+							| core::ImageUsage::InputAttachment))
+				!= core::ImageUsage::None) {
+			info.usage |= core::ImageUsage::TransientAttachment;
+		}
+	}
+
+	auto views = a->getImageViews(info);
+	return _frameCache->acquireImage(a->getId(), info, views, frame);
+}
+
+void Loop::releaseImage(Rc<ImageStorage> &&image) {
+	performOnThread([this, image = move(image)]() mutable {
+		_frameCache->releaseImage(move(image));
+	}, this, true);
+}
+
+Rc<core::Semaphore> Loop::makeSemaphore() { return _internal->device->makeSemaphore(); }
+
+core::ImageFormat Loop::getCommonFormat() const { return _info->defaultFormat; }
+
+SpanView<core::ImageFormat> Loop::getSupportedDepthStencilFormat() const {
+	return _internal->device->getSupportedDepthStencilFormat();
+}
+
+Rc<core::Fence> Loop::acquireFence(core::FenceType type) {
+	auto initFence = [&](const Rc<Fence> &fence) {
+		fence->setFrame([guard = Rc<Loop>(this), fence]() mutable {
+			if (guard->_looper->isOnThisThread()) {
+				guard->_internal->scheduleFence(Rc<Fence>(fence));
+				return true;
+			} else {
+				guard->performOnThread([guard, fence = move(fence)]() mutable {
+					if (!fence->check(*guard, true)) {
+						return;
+					}
+
+					guard->_internal->scheduleFence(move(fence));
+				}, guard, true);
+				return true;
+			}
+		}, [guard = Rc<Loop>(this), fence]() mutable {
+			if (!guard->_internal) {
+				return;
+			}
+			fence->clear();
+			std::unique_lock<Mutex> lock(guard->_internal->resourceMutex);
+			switch (fence->getType()) {
+			case core::FenceType::Default:
+				guard->_internal->defaultFences.emplace_back(move(fence));
+				break;
+			case core::FenceType::Swapchain:
+				guard->_internal->swapchainFences.emplace_back(move(fence));
+				break;
+			}
+		}, 0);
+	};
+
+	std::unique_lock<Mutex> lock(_internal->resourceMutex);
+	auto &fences = (type == core::FenceType::Swapchain) ? _internal->swapchainFences
+														: _internal->defaultFences;
+	if (!fences.empty()) {
+		auto ref = move(fences.back());
+		fences.pop_back();
+		initFence(ref);
+		return ref;
+	}
+	lock.unlock();
+
+	auto ref = _internal->device->makeFence(type);
+	initFence(ref);
+	return ref;
+}
+
+void Loop::signalDependencies(const Vector<Rc<DependencyEvent>> &events, Queue *q, bool success) {
+	if (!events.empty()) {
+		if (_looper->isOnThisThread() && _internal) {
+			_internal->signalDependencies(events, q, success);
+			return;
+		}
+
+		performOnThread([this, events, success, q = Rc<Queue>(q)]() {
+			_internal->signalDependencies(events, q, success);
+		}, this, false);
+	}
+}
+
+void Loop::waitForDependencies(const Vector<Rc<DependencyEvent>> &events,
+		Function<void(bool)> &&cb) {
+	if (events.empty()) {
+		cb(true);
+	} else {
+		performOnThread([this, events = events, cb = sp::move(cb)]() mutable {
+			_internal->waitForDependencies(sp::move(events), sp::move(cb));
+		}, this, true);
+	}
+}
+
+void Loop::waitIdle() {
+	if (_internal) {
+		_internal->waitIdle();
+	}
+}
+
+void Loop::captureImage(Function<void(const ImageInfoData &info, BytesView view)> &&cb,
+		const Rc<core::ImageObject> &image, core::AttachmentLayout l) {
+	performOnThread([cb = sp::move(cb), image]() mutable {
+		cb(image->getInfo(), image.cast<Image>()->getData());
+	}, this, true);
+}
+
+void Loop::captureBuffer(Function<void(const BufferInfo &info, BytesView view)> &&cb,
+		const Rc<core::BufferObject> &buf) {
+	performOnThread([cb = sp::move(cb), buf]() mutable {
+		auto b = buf.cast<Buffer>();
+		cb(buf->getInfo(), static_cast<const Buffer *>(b.get())->getData());
+	}, this, true);
+}
+
+Rc<core::PresentationEngine> Loop::makePresentationEngine(NotNull<core::PresentationWindow> w,
+		core::PresentationOptions opts) {
+	return Rc<PresentationEngine>::create(this, _internal->device.get(), w, opts);
+}
+
+} // namespace stappler::xenolith::null
@@ -0,0 +1,204 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "XLNullObject.h"
+#include "XLNullDevice.h"
+#include "XLCoreFrameQueue.h"
+
+#include <thread>
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::null {
+
+bool Image::init(Device &dev, StringView key, const ImageInfoData &info,
+		Rc<core::DataAtlas> &&atlas) {
+	_name = key.str<Interface>();
+	_info = info;
+	_atlas = move(atlas);
+
+	return core::ImageObject::init(dev, nullptr, core::ObjectType::Image, ObjectHandle::zero(),
+			nullptr);
+}
+
+bool Image::init(Device &dev, StringView key, uint64_t idx, const ImageInfoData &info) {
+	_name = key.str<Interface>();
+	_info = info;
+
+	return core::ImageObject::init(dev, nullptr, core::ObjectType::Image, ObjectHandle::zero(),
+			nullptr, idx);
+}
+
+void Image::setData(BytesView data) { _data = data.bytes<Interface>(); }
+
+bool ImageView::init(Device &dev, core::ImageObject *image, const ImageViewInfo &info) {
+	_info = image->getViewInfo(info);
+	if (_info.layerCount.get() == maxOf<uint32_t>()) {
+		_info.layerCount = core::ArrayLayers(
+				image->getInfo().arrayLayers.get() - _info.baseArrayLayer.get());
+	}
+	if (_info.type == core::ImageViewType::ImageView2D && _info.layerCount.get() > 1) {
+		_info.layerCount = core::ArrayLayers(1);
+	}
+
+	_image = image;
+	return core::ImageView::init(dev, nullptr, core::ObjectType::ImageView, ObjectHandle::zero());
+}
+
+bool Buffer::init(Device &dev, const BufferInfo &info, BytesView data) {
+	_info = info;
+	if (!_info.key.empty()) {
+		_name = _info.key.str<Interface>();
+	}
+
+	_data.resize(_info.size);
+	if (!data.empty()) {
+		memcpy(_data.data(), data.data(), std::min(data.size(), _data.size()));
+	}
+
+	return core::BufferObject::init(dev, nullptr, core::ObjectType::Buffer, ObjectHandle::zero());
+}
+
+bool RenderPass::init(Device &dev, const core::QueuePassData &data) {
+	_type = data.type;
+	_name = data.key.str<Interface>();
+	return core::RenderPass::init(dev, nullptr, core::ObjectType::RenderPass,
+			ObjectHandle::zero(), nullptr);
+}
+
+bool Framebuffer::init(Device &dev, RenderPass *renderPass,
+		SpanView<Rc<core::ImageView>> imageViews) {
+	_viewIds.reserve(imageViews.size());
+	_imageViews.reserve(imageViews.size());
+	_renderPass = renderPass;
+
+	auto extent = imageViews.front()->getFramebufferExtent();
+
+	for (auto &it : imageViews) {
+		_viewIds.emplace_back(it->getIndex());
+		_imageViews.emplace_back(it);
+
+		if (extent != it->getFramebufferExtent()) {
+			log::source().error("null::Framebuffer",
+					"Invalid extent for framebuffer image: ", it->getFramebufferExtent());
+			return false;
+		}
+	}
+
+	_extent = Extent2(extent.width, extent.height);
+	_layerCount = extent.depth;
+
+	return core::Framebuffer::init(dev, nullptr, core::ObjectType::Framebuffer,
+			ObjectHandle::zero());
+}
+
+bool Semaphore::init(Device &dev, core::SemaphoreType type) {
+	_type = type;
+	return core::Semaphore::init(dev, nullptr, core::ObjectType::Semaphore, ObjectHandle::zero());
+}
+
+bool Fence::init(Device &dev, core::FenceType type) {
+	_type = type;
+	_state = Disabled;
+	return core::Fence::init(dev, nullptr, core::ObjectType::Fence, ObjectHandle::zero());
+}
+
+void Fence::setLatency(uint64_t latency) { _latency = latency; }
+
+Status Fence::doCheckFence(bool lockfree) {
+	auto now = sp::platform::clock(ClockType::Monotonic);
+	auto signalTime = getSignalTime();
+	if (now >= signalTime) {
+		return Status::Ok;
+	}
+
+	if (lockfree) {
+		return Status::Suspended;
+	}
+
+	// blocking wait, like vkWaitForFences
+	std::this_thread::sleep_for(std::chrono::microseconds(signalTime - now));
+	return Status::Ok;
+}
+
+void Fence::doResetFence() { }
+
+Status DeviceQueue::submit(const core::FrameSync &sync, core::Fence &fence) {
+	return doSubmit(&sync, nullptr, fence, SpanView<const core::CommandBuffer *>(),
+			core::DeviceIdleFlags::None);
+}
+
+Status DeviceQueue::waitIdle() { return Status::Ok; }
+
+Status DeviceQueue::doSubmit(const core::FrameSync *sync, core::CommandPool *commandPool,
+		core::Fence &fence, SpanView<const core::CommandBuffer *> buffers,
+		core::DeviceIdleFlags idle) {
+	auto dev = static_cast<Device *>(_device);
+
+	// perform the same semaphore bookkeeping, as real queue does
+	if (sync) {
+		for (auto &it : sync->waitAttachments) {
+			if (it.semaphore) {
+				it.semaphore->setWaited(true);
+				if (it.image && !it.image->isSemaphorePersistent()) {
+					fence.addRelease(
+							[img = it.image, sem = it.semaphore.get(),
+									t = it.semaphore->getTimeline()](bool success) {
+						sem->setInUse(false, t);
+						img->releaseSemaphore(sem);
+					},
+							it.image, "null::DeviceQueue::submit::!isSemaphorePersistent");
+				} else {
+					fence.addRelease(
+							[sem = it.semaphore.get(), t = it.semaphore->getTimeline()](
+									bool success) { sem->setInUse(false, t); },
+							it.semaphore, "null::DeviceQueue::submit::isSemaphorePersistent");
+				}
+				fence.autorelease(it.semaphore.get());
+				if (commandPool) {
+					commandPool->autorelease(it.semaphore.get());
+				}
+			}
+		}
+
+		for (auto &it : sync->signalAttachments) {
+			if (it.semaphore) {
+				it.semaphore->setSignaled(true);
+				it.semaphore->setInUse(true, it.semaphore->getTimeline());
+				fence.autorelease(it.semaphore.get());
+				if (commandPool) {
+					commandPool->autorelease(it.semaphore.get());
+				}
+			}
+		}
+	}
+
+	static_cast<Fence &>(fence).setLatency(dev->getSubmitLatency());
+	fence.setArmed(*this);
+
+	if (sync) {
+		for (auto &it : sync->images) { it.image->setLayout(it.newLayout); }
+	}
+
+	_lastStatus = Status::Ok;
+	return Status::Ok;
+}
+
+} // namespace stappler::xenolith::null
@@ -0,0 +1,145 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef XENOLITH_BACKEND_NULL_XLNULLOBJECT_H_
+#define XENOLITH_BACKEND_NULL_XLNULLOBJECT_H_
+
+#include "XLNull.h"
+#include "XLCoreObject.h"
+#include "XLCoreDeviceQueue.h"
+#include "XLCoreImageStorage.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::null {
+
+// Image without backing memory; null device never reads or writes image content
+class SP_PUBLIC Image : public core::ImageObject {
+public:
+	virtual ~Image() = default;
+
+	bool init(Device &, StringView, const ImageInfoData &, Rc<core::DataAtlas> && = nullptr);
+
+	// image with the fixed index, used for the swapchain images
+	bool init(Device &, StringView, uint64_t idx, const ImageInfoData &);
+
+	// host copy of initial data, if any
+	BytesView getData() const { return _data; }
+	void setData(BytesView);
+
+protected:
+	using core::ImageObject::init;
+
+	Bytes _data;
+};
+
+class SP_PUBLIC ImageView : public core::ImageView {
+public:
+	virtual ~ImageView() = default;
+
+	bool init(Device &, core::ImageObject *, const ImageViewInfo &);
+
+protected:
+	using core::ImageView::init;
+};
+
+// Buffer in host memory
+class SP_PUBLIC Buffer : public core::BufferObject {
+public:
+	virtual ~Buffer() = default;
+
+	bool init(Device &, const BufferInfo &, BytesView = BytesView());
+
+	uint8_t *getData() { return _data.data(); }
+	BytesView getData() const { return _data; }
+
+protected:
+	using core::BufferObject::init;
+
+	Bytes _data;
+};
+
+class SP_PUBLIC RenderPass : public core::RenderPass {
+public:
+	virtual ~RenderPass() = default;
+
+	bool init(Device &, const core::QueuePassData &);
+
+protected:
+	using core::RenderPass::init;
+};
+
+class SP_PUBLIC Framebuffer : public core::Framebuffer {
+public:
+	virtual ~Framebuffer() = default;
+
+	bool init(Device &, RenderPass *, SpanView<Rc<core::ImageView>>);
+
+protected:
+	using core::Framebuffer::init;
+};
+
+class SP_PUBLIC Semaphore : public core::Semaphore {
+public:
+	virtual ~Semaphore() = default;
+
+	bool init(Device &, core::SemaphoreType);
+
+protected:
+	using core::Semaphore::init;
+};
+
+// Fence, that becomes signaled when simulated device latency is expired
+class SP_PUBLIC Fence : public core::Fence {
+public:
+	virtual ~Fence() = default;
+
+	bool init(Device &, core::FenceType);
+
+	void setLatency(uint64_t);
+
+	// time, when armed fence will be signaled
+	uint64_t getSignalTime() const { return _armedTime + _latency; }
+
+protected:
+	using core::Fence::init;
+
+	virtual Status doCheckFence(bool lockfree) override;
+	virtual void doResetFence() override;
+
+	uint64_t _latency = 0;
+};
+
+class SP_PUBLIC DeviceQueue : public core::DeviceQueue {
+public:
+	virtual ~DeviceQueue() = default;
+
+	Status submit(const core::FrameSync &, core::Fence &);
+
+	virtual Status waitIdle() override;
+
+protected:
+	virtual Status doSubmit(const core::FrameSync *, core::CommandPool *, core::Fence &,
+			SpanView<const core::CommandBuffer *>, core::DeviceIdleFlags) override;
+};
+
+} // namespace stappler::xenolith::null
+
+#endif /* XENOLITH_BACKEND_NULL_XLNULLOBJECT_H_ */
@@ -0,0 +1,162 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "XLNullPresentationEngine.h"
+#include "XLCoreFrameCache.h"
+#include "XlCoreMonitorInfo.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::null {
+
+bool PresentationEngine::run() {
+	if (!_surface) {
+		log::source().error("null::PresentationEngine", "No surface to present images");
+		return false;
+	}
+
+	auto info = _window->getSurfaceOptions(*_device, _surface);
+	auto cfg = _window->selectConfig(info, false);
+
+	if (!createSwapchain(info, move(cfg), cfg.presentMode, true)) {
+		return false;
+	}
+
+	return core::PresentationEngine::run();
+}
+
+Rc<core::ScreenInfo> PresentationEngine::getScreenInfo() const {
+	// headless device has no displays
+	Rc<core::ScreenInfo> ret = Rc<core::ScreenInfo>::create();
+	ret->primaryMonitor = maxOf<uint32_t>();
+	return ret;
+}
+
+Status PresentationEngine::setFullscreenSurface(const core::MonitorId &, const core::ModeInfo &) {
+	return Status::ErrorNotSupported;
+}
+
+bool PresentationEngine::recreateSwapchain() {
+	if (hasFlag(_deprecationFlags, core::UpdateConstraintsFlags::Finalized)) {
+		return false;
+	}
+
+	_device->waitIdle();
+	_waitForDisplayLink = false;
+
+	resetFrames();
+
+	if (hasFlag(_deprecationFlags, core::UpdateConstraintsFlags::EndOfLife)) {
+		_deprecationFlags |= core::UpdateConstraintsFlags::Finalized;
+
+		auto callbacks = sp::move(_deprecationCallbacks);
+		_deprecationCallbacks.clear();
+
+		for (auto &it : callbacks) { it(false); }
+
+		end();
+
+		return false;
+	}
+
+	if (hasFlag(_deprecationFlags, core::UpdateConstraintsFlags::EnableLiveResize)) {
+		_liveResizeEnabled = true;
+	}
+
+	if (hasFlag(_deprecationFlags, core::UpdateConstraintsFlags::DisableLiveResize)) {
+		_liveResizeEnabled = false;
+	}
+
+	auto fastModeSelected = _liveResizeEnabled
+			|| hasFlag(_deprecationFlags, core::UpdateConstraintsFlags::SwitchToFastMode);
+	auto info = _window->getSurfaceOptions(*_device, _surface);
+	auto cfg = _window->selectConfig(info, fastModeSelected);
+
+	if (!info.isSupported(cfg)) {
+		log::source().error("null::PresentationEngine", "Presentation with config ",
+				cfg.description(), " is not supported for ", info.description());
+		return false;
+	}
+
+	auto mode = cfg.presentMode;
+	if (fastModeSelected && cfg.presentModeFast != core::PresentMode::Unsupported) {
+		mode = cfg.presentModeFast;
+	}
+
+	auto ret = createSwapchain(info, move(cfg), mode, true);
+
+	_deprecationFlags = core::UpdateConstraintsFlags::None;
+
+	auto callbacks = sp::move(_deprecationCallbacks);
+	_deprecationCallbacks.clear();
+
+	for (auto &it : callbacks) { it(true); }
+
+	if (ret) {
+		_nextPresentWindow = 0;
+		_readyForNextFrame = true;
+		scheduleNextImage();
+	}
+	return ret;
+}
+
+bool PresentationEngine::createSwapchain(const core::SurfaceInfo &info,
+		core::SwapchainConfig &&cfg, core::PresentMode presentMode, bool oldSwapchainValid) {
+	auto dev = static_cast<Device *>(_device);
+	auto swapchainImageInfo = _window->getSwapchainImageInfo(cfg);
+
+	auto oldSwapchain = move(_swapchain);
+
+	_swapchain = Rc<SwapchainHandle>::create(*dev, info, cfg, move(swapchainImageInfo),
+			presentMode, _surface.get_cast<Surface>(),
+			(oldSwapchain && oldSwapchainValid) ? oldSwapchain.get_cast<SwapchainHandle>()
+												: nullptr);
+
+	if (!_swapchain) {
+		log::source().error("null::PresentationEngine", "Fail to create swapchain");
+		return false;
+	}
+
+	auto newConstraints = _window->exportConstraints();
+	newConstraints.extent = cfg.extent;
+	newConstraints.transform = cfg.transform;
+
+	_constraints = sp::move(newConstraints);
+
+	// swapchain image views should be known to FrameCache, as with the real swapchain
+	Vector<uint64_t> ids;
+	auto cache = _loop->getFrameCache();
+	for (auto &it : _swapchain.get_cast<SwapchainHandle>()->getImages()) {
+		for (auto &iit : it.views) {
+			auto id = iit.second->getIndex();
+			ids.emplace_back(id);
+			iit.second->setReleaseCallback(
+					[loop = _loop, cache, id] { cache->removeImageView(id); });
+		}
+	}
+
+	for (auto &id : ids) { cache->addImageView(id); }
+
+	_waitForDisplayLink = false;
+	_readyForNextFrame = true;
+	return true;
+}
+
+} // namespace stappler::xenolith::null
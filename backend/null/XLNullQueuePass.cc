@@ -0,0 +1,113 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "XLNullQueuePass.h"
+#include "XLCoreFrameHandle.h"
+#include "XLCoreLoop.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::null {
+
+bool QueuePassHandle::prepare(FrameQueue &q, Function<void(bool)> &&cb) {
+	_device = static_cast<Device *>(q.getFrame()->getDevice());
+	return core::QueuePassHandle::prepare(q, sp::move(cb));
+}
+
+void QueuePassHandle::submit(FrameQueue &q, Rc<FrameSync> &&sync,
+		Function<void(bool)> &&onSubmited, Function<void(bool)> &&onComplete) {
+	Rc<FrameHandle> f = q.getFrame(); // capture frame ref
+
+	_fence->addRelease([this, func = sp::move(onComplete), q = &q](bool success) mutable {
+		// simulated device time is exactly the configured latency
+		_queueData->deviceTime = _device->getSubmitLatency();
+		doComplete(*q, sp::move(func), success);
+	}, this, "null::QueuePassHandle::submit onComplete");
+
+	_sync = move(sync);
+
+	auto success = _device->acquireQueue(getQueueOps(), *f.get(),
+			[this, onSubmited = sp::move(onSubmited)](FrameHandle &frame,
+					const Rc<core::DeviceQueue> &queue) mutable {
+		_queue = static_cast<DeviceQueue *>(queue.get());
+
+		// acquire callback can be called under device lock, so, submit in queue
+		frame.performInQueue([this, onSubmited = sp::move(onSubmited)](FrameHandle &frame) mutable {
+			doSubmit(frame, sp::move(onSubmited));
+		}, this, "null::QueuePassHandle::submit");
+	}, [this](FrameHandle &frame) {
+		_sync = nullptr;
+		if (_queue) {
+			_device->releaseQueue(move(_queue));
+			_queue = nullptr;
+		}
+	}, this);
+
+	if (!success) {
+		log::source().error("null::QueuePassHandle", "No queue for pass: ", getName());
+	}
+}
+
+core::QueueFlags QueuePassHandle::getQueueOps() const {
+	switch (_queuePass->getType()) {
+	case core::PassType::Compute: return core::QueueFlags::Compute; break;
+	case core::PassType::Transfer: return core::QueueFlags::Transfer; break;
+	case core::PassType::Graphics:
+	case core::PassType::Generic: break;
+	}
+	return core::QueueFlags::Graphics;
+}
+
+bool QueuePassHandle::doSubmit(FrameHandle &frame, Function<void(bool)> &&onSubmited) {
+	auto success = _queue->submit(*_sync, *_fence);
+	frame.performOnGlThread(
+			[this, success, onSubmited = sp::move(onSubmited), queue = move(_queue),
+					armedTime = _fence->getArmedTime()](FrameHandle &frame) mutable {
+		_queueData->submitTime = armedTime;
+
+		if (queue) {
+			_device->releaseQueue(move(queue));
+			queue = nullptr;
+		}
+
+		doSubmitted(frame, sp::move(onSubmited), success == Status::Ok, move(_fence));
+		_fence = nullptr;
+		_sync = nullptr;
+	}, nullptr, false, "null::QueuePassHandle::doSubmit");
+	return success == Status::Ok;
+}
+
+void QueuePassHandle::doSubmitted(FrameHandle &handle, Function<void(bool)> &&func, bool success,
+		Rc<core::Fence> &&fence) {
+	auto queue = handle.getFrameQueue(_data->queue->queue);
+	for (auto &it : _data->submittedCallbacks) { it(*queue, *_data, success); }
+
+	func(success);
+
+	fence->schedule(*_loop);
+}
+
+void QueuePassHandle::doComplete(FrameQueue &queue, Function<void(bool)> &&func, bool success) {
+	for (auto &it : _data->completeCallbacks) { it(queue, *_data, success); }
+
+	func(success);
+}
+
+} // namespace stappler::xenolith::null
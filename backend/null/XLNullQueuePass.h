@@ -0,0 +1,60 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef XENOLITH_BACKEND_NULL_XLNULLQUEUEPASS_H_
+#define XENOLITH_BACKEND_NULL_XLNULLQUEUEPASS_H_
+
+#include "XLNullDevice.h"
+#include "XLCoreQueuePass.h"
+#include "XLCoreFrameQueue.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::null {
+
+// Pass handle, that runs pass lifecycle (prepare, queue acquisition, submission, fence wait)
+// without recording any commands; installed for every pass of queue, compiled with null::Loop
+class SP_PUBLIC QueuePassHandle : public core::QueuePassHandle {
+public:
+	virtual ~QueuePassHandle() = default;
+
+	virtual bool prepare(FrameQueue &, Function<void(bool)> &&) override;
+
+	virtual void submit(FrameQueue &, Rc<FrameSync> &&, Function<void(bool)> &&onSubmited,
+			Function<void(bool)> &&onComplete) override;
+
+	core::QueueFlags getQueueOps() const;
+
+protected:
+	virtual bool doSubmit(FrameHandle &frame, Function<void(bool)> &&onSubmited);
+
+	virtual void doSubmitted(FrameHandle &, Function<void(bool)> &&, bool success,
+			Rc<core::Fence> &&);
+
+	virtual void doComplete(FrameQueue &, Function<void(bool)> &&, bool success);
+
+	Device *_device = nullptr;
+	Rc<DeviceQueue> _queue;
+	Rc<FrameSync> _sync;
+};
+
+} // namespace stappler::xenolith::null
+
+#endif /* XENOLITH_BACKEND_NULL_XLNULLQUEUEPASS_H_ */
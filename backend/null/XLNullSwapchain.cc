@@ -0,0 +1,267 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "XLNullSwapchain.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::null {
+
+static constexpr uint32_t MaxExtent = 16'384;
+
+bool Surface::init(Instance *instance, Extent2 extent, Ref *win) {
+	if (extent.width == 0 || extent.height == 0) {
+		return false;
+	}
+
+	if (!core::Surface::init(instance, win)) {
+		return false;
+	}
+
+	_extent = extent;
+	return true;
+}
+
+void Surface::invalidate() { _window = nullptr; }
+
+core::SurfaceInfo Surface::getSurfaceOptions(const core::Device &dev,
+		core::FullScreenExclusiveMode mode, void *handle) const {
+	core::SurfaceInfo ret;
+	ret.minImageCount = 2;
+	ret.maxImageCount = 8;
+	ret.currentExtent = _extent;
+	ret.minImageExtent = Extent2(1, 1);
+	ret.maxImageExtent =
+			Extent2(std::max(_extent.width, MaxExtent), std::max(_extent.height, MaxExtent));
+	ret.maxImageArrayLayers = 1;
+	ret.supportedCompositeAlpha =
+			core::CompositeAlphaFlags::Opaque | core::CompositeAlphaFlags::Premultiplied;
+	ret.supportedTransforms = core::SurfaceTransformFlags::Identity;
+	ret.currentTransform = core::SurfaceTransformFlags::Identity;
+	ret.supportedUsageFlags = core::ImageUsage::ColorAttachment | core::ImageUsage::TransferSrc
+			| core::ImageUsage::TransferDst;
+	ret.formats = Vector<Pair<core::ImageFormat, core::ColorSpace>>{
+		pair(core::ImageFormat::B8G8R8A8_UNORM, core::ColorSpace::SRGB_NONLINEAR_KHR),
+		pair(core::ImageFormat::R8G8B8A8_UNORM, core::ColorSpace::SRGB_NONLINEAR_KHR),
+	};
+	ret.presentModes = Vector<core::PresentMode>{core::PresentMode::Mailbox,
+		core::PresentMode::Immediate, core::PresentMode::Fifo};
+	return ret;
+}
+
+static void SwapchainHandle_destroy(core::Device *dev, core::ObjectType, core::ObjectHandle,
+		void *ptr) {
+	auto data = reinterpret_cast<SwapchainHandle::SwapchainData *>(ptr);
+	data->invalidate(*dev);
+	delete data;
+}
+
+bool SwapchainHandle::init(Device &dev, const core::SurfaceInfo &info,
+		const core::SwapchainConfig &cfg, ImageInfo &&swapchainImageInfo,
+		core::PresentMode presentMode, Surface *surface, SwapchainHandle *old) {
+	auto data = new SwapchainData;
+
+	auto imageCount = std::max(cfg.imageCount, info.minImageCount);
+	data->images.reserve(imageCount);
+	data->presentSemaphores.resize(imageCount);
+
+	if (old) {
+		// new data is not shared yet, only old swapchain should be locked
+		std::unique_lock<Mutex> lock(old->_resourceMutex);
+		data->semaphores = sp::move(old->_data->semaphores);
+
+		for (auto &it : old->_data->presentSemaphores) {
+			if (it) {
+				if (it->reset()) {
+					data->semaphores.emplace_back(move(it));
+				} else {
+					_invalidatedSemaphores.emplace_back(move(it));
+				}
+				it = nullptr;
+			}
+		}
+	}
+
+	auto swapchainImageViewInfo = getSwapchainImageViewInfo(swapchainImageInfo);
+
+	for (uint32_t i = 0; i < imageCount; ++i) {
+		auto image = Rc<Image>::create(dev, toString("SwapchainImage[", i, "]"), i,
+				swapchainImageInfo);
+
+		Map<ImageViewInfo, Rc<core::ImageView>> views;
+		views.emplace(swapchainImageViewInfo,
+				Rc<ImageView>::create(dev, image.get(), swapchainImageViewInfo));
+
+		data->images.emplace_back(SwapchainImageData{sp::move(image), sp::move(views)});
+	}
+
+	_presentMode = presentMode;
+	_imageInfo = move(swapchainImageInfo);
+	_config = cfg;
+	_config.imageCount = imageCount;
+	_surface = surface;
+	_surfaceInfo = info;
+	_data = data;
+
+	return core::Swapchain::init(dev, SwapchainHandle_destroy, core::ObjectType::Swapchain,
+			ObjectHandle::zero(), _data);
+}
+
+SpanView<SwapchainHandle::SwapchainImageData> SwapchainHandle::getImages() const {
+	return _data->images;
+}
+
+auto SwapchainHandle::acquire(bool lockfree, const Rc<core::Fence> &fence, Status &status)
+		-> Rc<SwapchainAcquiredImage> {
+	if (_deprecated) {
+		status = Status::ErrorCancelled;
+		return nullptr;
+	}
+
+	std::unique_lock<Mutex> lock(_resourceMutex);
+	auto imageCount = uint32_t(_data->images.size());
+	if (_acquiredIndexes.size() >= imageCount) {
+		// all images are in use, engine should wait for presentation
+		status = Status::Timeout;
+		return nullptr;
+	}
+
+	auto imageIndex = _nextImage;
+	while (_acquiredIndexes.find(imageIndex) != _acquiredIndexes.end()) {
+		imageIndex = (imageIndex + 1) % imageCount;
+	}
+	_nextImage = (imageIndex + 1) % imageCount;
+
+	_acquiredIndexes.emplace(imageIndex);
+	++_acquiredImages;
+	lock.unlock();
+
+	Rc<core::Semaphore> sem = acquireSemaphore();
+	if (sem) {
+		sem->setSignaled(true);
+	}
+	if (fence) {
+		// no device work for acquisition, fence should be signaled on first check
+		static_cast<Fence *>(fence.get())->setLatency(0);
+		fence->setTag("null::SwapchainHandle::acquire");
+		fence->setArmed();
+	}
+
+	status = Status::Ok;
+	return Rc<SwapchainAcquiredImage>::alloc(imageIndex, &_data->images.at(imageIndex), move(sem),
+			this);
+}
+
+Status SwapchainHandle::present(core::DeviceQueue &queue, core::ImageStorage *image,
+		uint64_t presentWindow) {
+	if (_invalid) {
+		return Status::ErrorCancelled;
+	}
+
+	auto waitSem = image->getSignalSem();
+	auto imageIndex = uint32_t(image->getImageIndex());
+	auto swapchainImage = static_cast<core::SwapchainImage *>(image);
+
+	do {
+		std::unique_lock<Mutex> lock(_resourceMutex);
+		swapchainImage->setPresented();
+		auto it = _acquiredIndexes.find(imageIndex);
+		if (it != _acquiredIndexes.end()) {
+			_acquiredIndexes.erase(it);
+			--_acquiredImages;
+		} else {
+			log::source().error("null::SwapchainHandle", "Image index ", imageIndex,
+					" was not acquired");
+		}
+	} while (0);
+
+	if (_data->presentSemaphores[imageIndex]) {
+		_data->presentSemaphores[imageIndex]->setWaited(true);
+		releaseSemaphore(move(_data->presentSemaphores[imageIndex]));
+		_data->presentSemaphores[imageIndex] = nullptr;
+	}
+
+	_data->presentSemaphores[imageIndex] = waitSem;
+
+	++_presentedFrames;
+	_presentTime = sp::platform::clock(ClockType::Monotonic);
+	return Status::Ok;
+}
+
+void SwapchainHandle::invalidateImage(const core::ImageStorage *image, bool release) {
+	if (!static_cast<const core::SwapchainImage *>(image)->isPresented()) {
+		auto imageIndex = uint32_t(image->getImageIndex());
+		invalidateImage(imageIndex, release);
+	}
+}
+
+void SwapchainHandle::invalidateImage(uint32_t idx, bool release) {
+	invalidateImageDamage(idx);
+
+	std::unique_lock<Mutex> lock(_resourceMutex);
+	auto it = _acquiredIndexes.find(idx);
+	if (it != _acquiredIndexes.end()) {
+		_acquiredIndexes.erase(it);
+		--_acquiredImages;
+	} else {
+		log::source().error("null::SwapchainHandle", "Image index ", idx, " was not acquired");
+	}
+}
+
+Rc<core::Semaphore> SwapchainHandle::acquireSemaphore() {
+	std::unique_lock<Mutex> lock(_resourceMutex);
+	if (!_data->semaphores.empty()) {
+		auto sem = _data->semaphores.back();
+		_data->semaphores.pop_back();
+		return sem;
+	}
+	lock.unlock();
+
+	return Rc<Semaphore>::create(*static_cast<Device *>(_object.device),
+			core::SemaphoreType::Default);
+}
+
+bool SwapchainHandle::releaseSemaphore(Rc<core::Semaphore> &&sem) {
+	if (sem && sem->reset()) {
+		std::unique_lock<Mutex> lock(_resourceMutex);
+		_data->semaphores.emplace_back(move(sem));
+		return true;
+	}
+	return false;
+}
+
+Rc<core::ImageView> SwapchainHandle::makeView(const Rc<core::ImageObject> &image,
+		const ImageViewInfo &viewInfo) {
+	auto idx = image->getIndex();
+
+	auto dev = static_cast<Device *>(_object.device);
+
+	auto it = _data->images[idx].views.find(viewInfo);
+	if (it != _data->images[idx].views.end()) {
+		return it->second;
+	}
+
+	it = _data->images[idx]
+				 .views.emplace(viewInfo, Rc<ImageView>::create(*dev, image.get(), viewInfo))
+				 .first;
+	return it->second;
+}
+
+} // namespace stappler::xenolith::null
@@ -0,0 +1,88 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef XENOLITH_BACKEND_NULL_XLNULLSWAPCHAIN_H_
+#define XENOLITH_BACKEND_NULL_XLNULLSWAPCHAIN_H_
+
+#include "XLNullDevice.h"
+#include "XLCoreSwapchain.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::null {
+
+// Surface without a display: reports fixed extent and common formats and present modes
+class SP_PUBLIC Surface : public core::Surface {
+public:
+	virtual ~Surface() = default;
+
+	bool init(Instance *instance, Extent2 extent, Ref * = nullptr);
+
+	virtual void invalidate() override;
+
+	virtual core::SurfaceInfo getSurfaceOptions(const core::Device &, core::FullScreenExclusiveMode,
+			void *) const override;
+
+	Extent2 getExtent() const { return _extent; }
+
+protected:
+	using core::Surface::init;
+
+	Extent2 _extent;
+};
+
+// Swapchain with host-only images; acquisition is signaled immediately, presentation
+// only releases image back to the swapchain
+class SP_PUBLIC SwapchainHandle : public core::Swapchain {
+public:
+	virtual ~SwapchainHandle() = default;
+
+	bool init(Device &dev, const core::SurfaceInfo &, const core::SwapchainConfig &, ImageInfo &&,
+			core::PresentMode, Surface *, SwapchainHandle *);
+
+	SpanView<SwapchainImageData> getImages() const;
+
+	virtual Rc<SwapchainAcquiredImage> acquire(bool lockfree, const Rc<core::Fence> &fence,
+			Status &) override;
+
+	virtual Status present(core::DeviceQueue &queue, core::ImageStorage *,
+			uint64_t presentWindow) override;
+	virtual void invalidateImage(const core::ImageStorage *image, bool release) override;
+	virtual void invalidateImage(uint32_t, bool release) override;
+
+	virtual Rc<core::ImageView> makeView(const Rc<core::ImageObject> &,
+			const ImageViewInfo &) override;
+
+	virtual Rc<core::Semaphore> acquireSemaphore() override;
+	virtual bool releaseSemaphore(Rc<core::Semaphore> &&) override;
+
+protected:
+	using core::Object::init;
+
+	SwapchainData *_data = nullptr;
+	Set<uint32_t> _acquiredIndexes;
+
+	// images are acquired in round-robin order, like FIFO presentation engine does
+	uint32_t _nextImage = 0;
+};
+
+} // namespace stappler::xenolith::null
+
+#endif /* XENOLITH_BACKEND_NULL_XLNULLSWAPCHAIN_H_ */
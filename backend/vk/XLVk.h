@@ -147,10 +147,12 @@ enum class OptionalDeviceExtension {
 	MemoryBudget,
 	GetMemoryRequirements2,
 	DedicatedAllocation,
+	DescriptorUpdateTemplate,
 	ExternalFenceFd,
 	SwapchainMaintenance1,
 	FullscreenExclusive,
 	DisplayTiming,
+	IncrementalPresent,
 	Portability,
 	Max
 };
@@ -173,10 +175,12 @@ static const char * const s_optionalDeviceExtensions[] = {
 	VK_EXT_MEMORY_BUDGET_EXTENSION_NAME,
 	VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME,
 	VK_KHR_DEDICATED_ALLOCATION_EXTENSION_NAME,
+	VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME,
 	VK_KHR_EXTERNAL_FENCE_FD_EXTENSION_NAME,
 	VK_EXT_SWAPCHAIN_MAINTENANCE_1_EXTENSION_NAME,
 	VK_EXT_FULL_SCREEN_EXCLUSIVE_EXTENSION_NAME,
 	VK_GOOGLE_DISPLAY_TIMING_EXTENSION_NAME,
+	VK_KHR_INCREMENTAL_PRESENT_EXTENSION_NAME,
 	VK_KHR_PORTABILITY_SUBSET_EXTENSION_NAME,
 	nullptr
 };
@@ -906,6 +906,62 @@ Rc<DeviceMemory> Allocator::emplaceObjects(AllocationUsage usage, SpanView<Image
 	return memory;
 }
 
+Rc<DeviceMemory> Allocator::allocateAliased(AllocationUsage usage, SpanView<Image *> images,
+		VkDeviceSize *unaliasedSize) {
+	auto mask = getInitialTypeMask();
+	VkDeviceSize size = 0;
+	VkDeviceSize alignment = 1;
+	VkDeviceSize unaliased = 0;
+
+	for (auto &it : images) {
+		auto req = getImageMemoryRequirements(it->getImage());
+		if (req.requiresDedicated) {
+			log::source().error("vk::Allocator",
+					"allocateAliased: image requires dedicated allocation: ", it->getName());
+			return nullptr;
+		}
+
+		mask &= req.requirements.memoryTypeBits;
+		if (mask == 0) {
+			log::source().error("vk::Allocator", "allocateAliased: fail to find common memory type");
+			return nullptr;
+		}
+
+		size = std::max(size, req.requirements.size);
+		alignment = std::max(alignment, req.requirements.alignment);
+		unaliased += math::align<VkDeviceSize>(req.requirements.size, req.requirements.alignment);
+	}
+
+	auto type = findMemoryType(mask, usage);
+	if (!type) {
+		log::source().error("vk::Allocator", "allocateAliased: fail to find memory type");
+		return nullptr;
+	}
+
+	VkMemoryAllocateInfo allocInfo;
+	allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+	allocInfo.pNext = nullptr;
+	allocInfo.allocationSize = size;
+	allocInfo.memoryTypeIndex = type->idx;
+
+	VkDeviceMemory memory;
+	VkResult result = VK_ERROR_UNKNOWN;
+	_device->makeApiCall([&](const DeviceTable &table, VkDevice device) {
+		result = table.vkAllocateMemory(device, &allocInfo, nullptr, &memory);
+	});
+	if (result != VK_SUCCESS) {
+		log::source().error("vk::Allocator", "allocateAliased: fail to allocate memory");
+		return nullptr;
+	}
+
+	if (unaliasedSize) {
+		*unaliasedSize = unaliased;
+	}
+
+	return Rc<DeviceMemory>::create(this, DeviceMemoryInfo{size, alignment, type->idx, false},
+			memory, usage);
+}
+
 bool Allocator::allocateDedicated(AllocationUsage usage, Buffer *target) {
 	auto req = getBufferMemoryRequirements(target->getBuffer());
 	auto type = findMemoryType(req.requirements.memoryTypeBits, usage);
@@ -174,6 +174,11 @@ public:
 
 	Rc<DeviceMemory> emplaceObjects(AllocationUsage usage, SpanView<Image *>, SpanView<Buffer *>);
 
+	// allocate memory, that can be bound to any one of the images at offset 0
+	// unaliasedSize receives total size of images, if they were allocated separately
+	Rc<DeviceMemory> allocateAliased(AllocationUsage usage, SpanView<Image *>,
+			VkDeviceSize *unaliasedSize = nullptr);
+
 protected:
 	friend class DeviceMemoryPool;
 
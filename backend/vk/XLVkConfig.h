@@ -36,6 +36,10 @@ static constexpr bool UseExternalFenceSync = true;
 /* Number of frames, that can be performed in suboptimal swapchain modes */
 static constexpr uint32_t MaxSuboptimalFrames = 24;
 
+/* Number of separate descriptor writes for TextureSet update, above which the whole image array
+ * is written with single descriptor update template call */
+static constexpr uint32_t TextureSetMaxDescriptorWrites = 8;
+
 } // namespace stappler::xenolith::config
 
 #endif /* XENOLITH_BACKEND_VK_XLVKCONFIG_H_ */
@@ -501,6 +501,61 @@ auto Device::makeImage(StringView key, const ImageInfoData &imageInfo) -> Rc<Ima
 	return Rc<ImageStorage>::create(move(img));
 }
 
+core::AliasingMemory Device::makeAliasingMemory(SpanView<ImageInfoData> infos) {
+	bool isTransient = true;
+	Vector<Rc<Image>> images;
+	images.reserve(infos.size());
+	for (auto &it : infos) {
+		if ((it.usage & core::ImageUsage::TransientAttachment) == core::ImageUsage::None) {
+			isTransient = false;
+		}
+		// image objects used only to query memory requirements
+		auto img = _allocator->preallocate("AliasingMemoryImage", it, false);
+		if (!img) {
+			return core::AliasingMemory();
+		}
+		images.emplace_back(move(img));
+	}
+
+	Vector<Image *> targets;
+	targets.reserve(images.size());
+	for (auto &it : images) { targets.emplace_back(it.get()); }
+
+	VkDeviceSize unaliasedSize = 0;
+	auto mem = _allocator->allocateAliased(isTransient ? AllocationUsage::DeviceLocalLazilyAllocated
+													   : AllocationUsage::DeviceLocal,
+			targets, &unaliasedSize);
+	if (!mem) {
+		return core::AliasingMemory();
+	}
+
+	auto size = mem->getInfo().size;
+	return core::AliasingMemory{move(mem), size, unaliasedSize};
+}
+
+auto Device::makeAliasedImage(StringView key, const ImageInfoData &imageInfo, core::Object *obj)
+		-> Rc<ImageStorage> {
+	auto mem = static_cast<DeviceMemory *>(obj);
+	auto img = _allocator->preallocate(key, imageInfo, false);
+	if (!img) {
+		return nullptr;
+	}
+
+	auto req = _allocator->getImageMemoryRequirements(img->getImage());
+	if (req.requirements.size > mem->getInfo().size
+			|| (req.requirements.memoryTypeBits & (1 << mem->getInfo().memoryType)) == 0) {
+		log::source().error("vk::Device", "makeAliasedImage: memory is not compatible with image ",
+				key);
+		return nullptr;
+	}
+
+	if (!img->bindMemory(Rc<DeviceMemory>(mem))) {
+		return nullptr;
+	}
+
+	return Rc<ImageStorage>::create(move(img));
+}
+
 Rc<core::Semaphore> Device::makeSemaphore() {
 	auto ret = Rc<Semaphore>::create(*this, core::SemaphoreType::Default);
 	return ret;
@@ -84,6 +84,9 @@ public:
 	virtual Rc<core::Framebuffer> makeFramebuffer(const core::QueuePassData *,
 			SpanView<Rc<core::ImageView>>) override;
 	virtual Rc<ImageStorage> makeImage(StringView, const ImageInfoData &) override;
+	virtual core::AliasingMemory makeAliasingMemory(SpanView<ImageInfoData>) override;
+	virtual Rc<ImageStorage> makeAliasedImage(StringView, const ImageInfoData &,
+			core::Object *) override;
 	virtual Rc<core::Semaphore> makeSemaphore() override;
 	virtual Rc<core::ImageView> makeImageView(const Rc<core::ImageObject> &,
 			const ImageViewInfo &) override;
@@ -575,16 +575,22 @@ void CommandBuffer::cmdClearColorImage(Image *image, XImageLayout layout, const
 
 void CommandBuffer::cmdBeginRenderPass(RenderPass *pass, Framebuffer *fb, VkSubpassContents subpass,
 		bool alt) {
-	auto &clearValues = pass->getClearValues();
 	auto currentExtent = fb->getExtent();
 
+	cmdBeginRenderPass(pass, pass->getRenderPass(alt), fb, subpass,
+			VkRect2D{{0, 0}, {currentExtent.width, currentExtent.height}});
+}
+
+void CommandBuffer::cmdBeginRenderPass(RenderPass *pass, VkRenderPass variant, Framebuffer *fb,
+		VkSubpassContents subpass, const VkRect2D &renderArea) {
+	auto &clearValues = pass->getClearValues();
+
 	VkRenderPassBeginInfo renderPassInfo{VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO, nullptr};
 	renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
 	renderPassInfo.pNext = nullptr;
-	renderPassInfo.renderPass = pass->getRenderPass(alt);
+	renderPassInfo.renderPass = variant;
 	renderPassInfo.framebuffer = fb->getFramebuffer();
-	renderPassInfo.renderArea.offset = {0, 0};
-	renderPassInfo.renderArea.extent = VkExtent2D{currentExtent.width, currentExtent.height};
+	renderPassInfo.renderArea = renderArea;
 	renderPassInfo.clearValueCount = uint32_t(clearValues.size());
 	renderPassInfo.pClearValues = clearValues.data();
 
@@ -207,6 +207,8 @@ public:
 
 	void cmdBeginRenderPass(RenderPass *pass, Framebuffer *fb, VkSubpassContents subpass,
 			bool alt = false);
+	void cmdBeginRenderPass(RenderPass *pass, VkRenderPass variant, Framebuffer *fb,
+			VkSubpassContents subpass, const VkRect2D &renderArea);
 	void cmdEndRenderPass();
 
 	void cmdSetViewport(uint32_t firstViewport, SpanView<VkViewport> viewports);
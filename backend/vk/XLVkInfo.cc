@@ -76,6 +76,7 @@ DeviceInfo::Features DeviceInfo::Features::getOptional() {
 	ret.optionals.set(toInt(OptionalDeviceExtension::ShaderFloat16Int8));
 	ret.optionals.set(toInt(OptionalDeviceExtension::MemoryBudget));
 	ret.optionals.set(toInt(OptionalDeviceExtension::DedicatedAllocation));
+	ret.optionals.set(toInt(OptionalDeviceExtension::DescriptorUpdateTemplate));
 	ret.optionals.set(toInt(OptionalDeviceExtension::GetMemoryRequirements2));
 	ret.optionals.set(toInt(OptionalDeviceExtension::ExternalFenceFd));
 
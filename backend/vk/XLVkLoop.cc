@@ -555,7 +555,7 @@ void Loop::releaseFramebuffer(Rc<core::Framebuffer> &&fb) {
 }
 
 auto Loop::acquireImage(const ImageAttachment *a, const AttachmentHandle *h,
-		const core::ImageInfoData &i) -> Rc<ImageStorage> {
+		const core::ImageInfoData &i, uint64_t frame) -> Rc<ImageStorage> {
 	core::ImageInfoData info(i);
 	if (a->isTransient()) {
 		if ((info.usage
@@ -567,7 +567,7 @@ auto Loop::acquireImage(const ImageAttachment *a, const AttachmentHandle *h,
 	}
 
 	auto views = a->getImageViews(info);
-	return _frameCache->acquireImage(a->getId(), info, views);
+	return _frameCache->acquireImage(a->getId(), info, views, frame);
 }
 
 void Loop::releaseImage(Rc<ImageStorage> &&image) {
@@ -74,7 +74,7 @@ public:
 	virtual void releaseFramebuffer(Rc<core::Framebuffer> &&) override;
 
 	virtual Rc<ImageStorage> acquireImage(const ImageAttachment *, const AttachmentHandle *,
-			const core::ImageInfoData &) override;
+			const core::ImageInfoData &, uint64_t frame) override;
 	virtual void releaseImage(Rc<ImageStorage> &&) override;
 
 	virtual Rc<core::Semaphore> makeSemaphore() override;
@@ -36,6 +36,14 @@
 #include "XLVkPipeline.h"
 #include "XLCoreFrameQueue.h"
 
+#define XL_VKMATERIAL_DEBUG 0
+
+#if XL_VKMATERIAL_DEBUG
+#define XL_VKMATERIAL_LOG(...) log::source().debug("vk::QueuePassHandle", __VA_ARGS__)
+#else
+#define XL_VKMATERIAL_LOG(...)
+#endif
+
 namespace STAPPLER_VERSIONIZED stappler::xenolith::vk {
 
 QueuePass::~QueuePass() { }
@@ -345,7 +353,7 @@ void QueuePassHandle::doFinalizeTransfer(core::MaterialSet *materials,
 		}
 	}, true);
 
-	for (auto &it : materials->getLayouts()) {
+	materials->foreachLayout([&](uint32_t, const core::MaterialLayout &it) {
 		if (it.set) {
 			it.set.get_cast<TextureSet>()->foreachPendingImageBarriers(
 					[&](const ImageMemoryBarrier &b) { outputImageBarriers.emplace_back(b); },
@@ -354,7 +362,7 @@ void QueuePassHandle::doFinalizeTransfer(core::MaterialSet *materials,
 		} else {
 			log::source().error("QueuePassHandle", "No set for material layout");
 		}
-	}
+	});
 }
 
 auto QueuePassHandle::updateMaterials(FrameHandle &frame, NotNull<core::MaterialSet> data,
@@ -375,23 +383,32 @@ auto QueuePassHandle::updateMaterials(FrameHandle &frame, NotNull<core::Material
 				image.info);
 	});
 
+#if XL_VKMATERIAL_DEBUG
+	auto &stats = data->getStats();
+	XL_VKMATERIAL_LOG("updateMaterials: generation: ", data->getGeneration(),
+			"; materials: ", stats.materials, "; updated: ", stats.updated,
+			"; clone: ", stats.cloneTime, "us; update: ", stats.updateTime,
+			"us; copied chunks: ", stats.copiedChunks, "; layouts: ", stats.layouts,
+			"; copied layouts: ", stats.copiedLayouts, "; dirty layouts: ", stats.dirtyLayouts);
+#endif
+
 	if (updated.empty()) {
 		return ret;
 	}
 
 	auto layout = data->getTargetLayout();
 
-	// update texture layout descriptors
+	// update texture layout descriptors; unchanged layouts share sets with previous generation
 	// here we can place UpdateWhilePending optimization in future, to update set in use instead of copy
-	for (auto &it : data->getLayouts()) {
+	data->foreachDirtyLayout([&](uint32_t, core::MaterialLayout &it) {
 		frame.performRequiredTask([layout, target = &it](FrameHandle &handle) {
 			auto dev = static_cast<Device *>(handle.getDevice());
 
-			target->set = ref_cast<TextureSet>(layout->layout->acquireSet(*dev));
+			target->set = ref_cast<TextureSet>(layout->layout->acquireSet(*dev, target));
 			target->set->write(*target);
 			return true;
 		}, data, "QueuePassHandle::updateMaterials");
-	}
+	});
 
 	auto pool = static_cast<DeviceFrameHandle &>(frame).getMemPool(&frame);
 
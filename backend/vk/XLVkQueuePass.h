@@ -101,6 +101,11 @@ public:
 
 	void setQueueIdleFlags(core::DeviceIdleFlags);
 
+	// Partial redraw: if render area is set, render pass is performed only within it, and
+	// swapchain attachments preserve previous contents outside of it
+	bool hasRenderArea() const { return _hasRenderArea; }
+	const VkRect2D &getRenderArea() const { return _renderArea; }
+
 protected:
 	virtual Vector<const core::CommandBuffer *> doPrepareCommands(FrameHandle &);
 	virtual bool doSubmit(FrameHandle &frame, Function<void(bool)> &&onSubmited);
@@ -140,6 +145,9 @@ protected:
 	Vector<const core::CommandBuffer *> _buffers;
 	Rc<FrameSync> _sync;
 	core::FrameConstraints _constraints;
+
+	bool _hasRenderArea = false;
+	VkRect2D _renderArea;
 };
 
 } // namespace stappler::xenolith::vk
@@ -334,6 +334,11 @@ bool RenderPass::Data::cleanup(Device &dev) {
 		renderPassAlternative = VK_NULL_HANDLE;
 	}
 
+	if (renderPassPreserve) {
+		dev.getTable()->vkDestroyRenderPass(dev.getDevice(), renderPassPreserve, nullptr);
+		renderPassPreserve = VK_NULL_HANDLE;
+	}
+
 	layouts.clear();
 
 	return false;
@@ -725,6 +730,10 @@ void RenderPass::perform(const QueuePassHandle &handle, CommandBuffer &buf,
 		}
 	}
 
+	// previous contents is valid only for presented swapchain images
+	bool usePreserve = handle.hasRenderArea() && !useAlternative
+			&& _data->renderPassPreserve != VK_NULL_HANDLE;
+
 	Vector<QueuePassHandle::ImageInputOutputBarrier> imageBarriersData;
 	Vector<QueuePassHandle::BufferInputOutputBarrier> bufferBarriersData;
 
@@ -815,8 +824,14 @@ void RenderPass::perform(const QueuePassHandle &handle, CommandBuffer &buf,
 	}
 
 	if (_data->renderPass) {
-		buf.cmdBeginRenderPass(this, (Framebuffer *)handle.getFramebuffer(),
-				VK_SUBPASS_CONTENTS_INLINE, useAlternative);
+		if (usePreserve) {
+			buf.cmdBeginRenderPass(this, _data->renderPassPreserve,
+					(Framebuffer *)handle.getFramebuffer(), VK_SUBPASS_CONTENTS_INLINE,
+					handle.getRenderArea());
+		} else {
+			buf.cmdBeginRenderPass(this, (Framebuffer *)handle.getFramebuffer(),
+					VK_SUBPASS_CONTENTS_INLINE, useAlternative);
+		}
 
 		cb();
 
@@ -866,6 +881,7 @@ bool RenderPass::initGraphicsPass(Device &dev, QueuePassData &data) {
 
 		VkAttachmentDescription attachment;
 		VkAttachmentDescription attachmentAlternative;
+		VkAttachmentDescription attachmentPreserve;
 
 		bool mayAlias = false;
 		for (auto &u : desc->subpasses) {
@@ -893,17 +909,25 @@ bool RenderPass::initGraphicsPass(Device &dev, QueuePassData &data) {
 		attachmentAlternative.finalLayout = attachment.finalLayout =
 				VkImageLayout(desc->finalLayout);
 
+		attachmentPreserve = attachment;
+
 		if (desc->finalLayout == core::AttachmentLayout::PresentSrc) {
 			hasAlternative = true;
 			attachmentAlternative.finalLayout =
 					VkImageLayout(core::AttachmentLayout::TransferSrcOptimal);
 			_variableAttachments.emplace(desc);
+
+			// image was presented before; clear affects only render area, so, contents outside
+			// of it is preserved with defined initial layout
+			attachmentPreserve.initialLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+			attachmentPreserve.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
 		}
 
 		desc->index = uint32_t(_attachmentDescriptions.size());
 
 		_attachmentDescriptions.emplace_back(attachment);
 		_attachmentDescriptionsAlternative.emplace_back(attachmentAlternative);
+		_attachmentDescriptionsPreserve.emplace_back(attachmentPreserve);
 
 		auto fmt = core::getImagePixelFormat(imageAttachment->getImageInfo().format);
 		switch (fmt) {
@@ -1111,6 +1135,14 @@ bool RenderPass::initGraphicsPass(Device &dev, QueuePassData &data) {
 				!= VK_SUCCESS) {
 			return pass.cleanup(dev);
 		}
+
+		renderPassInfo.pAttachments = _attachmentDescriptionsPreserve.data();
+
+		if (dev.getTable()->vkCreateRenderPass(dev.getDevice(), &renderPassInfo, nullptr,
+					&pass.renderPassPreserve)
+				!= VK_SUCCESS) {
+			return pass.cleanup(dev);
+		}
 	}
 
 	if (initDescriptors(dev, data, pass)) {
@@ -116,6 +116,9 @@ public:
 	struct Data {
 		VkRenderPass renderPass = VK_NULL_HANDLE;
 		VkRenderPass renderPassAlternative = VK_NULL_HANDLE;
+
+		// variant for partial redraw: presentable attachments keeps previous contents
+		VkRenderPass renderPassPreserve = VK_NULL_HANDLE;
 		Vector<Rc<PipelineLayout>> layouts;
 
 		bool cleanup(Device &dev);
@@ -126,6 +129,7 @@ public:
 	virtual bool init(Device &dev, QueuePassData &);
 
 	VkRenderPass getRenderPass(bool alt = false) const;
+	VkRenderPass getPreserveRenderPass() const { return _data->renderPassPreserve; }
 	PipelineLayout *getPipelineLayout(uint32_t idx) const { return _data->layouts[idx]; }
 
 	//const Vector<Rc<DescriptorSetBindings>> &getDescriptorSets(uint32_t idx) const { return _data->layouts[idx].descriptors[0].sets; }
@@ -154,6 +158,7 @@ protected:
 
 	Vector<VkAttachmentDescription> _attachmentDescriptions;
 	Vector<VkAttachmentDescription> _attachmentDescriptionsAlternative;
+	Vector<VkAttachmentDescription> _attachmentDescriptionsPreserve;
 	Vector<VkAttachmentReference> _attachmentReferences;
 	Vector<uint32_t> _preservedAttachments;
 	Vector<VkSubpassDependency> _subpassDependencies;
@@ -545,6 +545,12 @@ void RenderQueuePassHandle::finalize(FrameQueue &frame, bool successful) {
 		}
 	}
 
+	for (auto &it : _attachment->getRenderQueue()->getAttachmentAliasing()) {
+		Vector<uint64_t> ids;
+		for (auto &a : it->attachments) { ids.emplace_back(a->id); }
+		cache->addAliasingGroup(_attachment->getRenderQueue()->getName(), ids);
+	}
+
 	_attachment->getRenderQueue()->setCompiled(*_device,
 			[loop = Rc<core::Loop>(frame.getLoop()), passIds = sp::move(passIds),
 					attachmentIds = sp::move(attachmentIds)]() mutable {
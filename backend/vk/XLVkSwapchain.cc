@@ -374,6 +374,29 @@ Status SwapchainHandle::present(core::DeviceQueue &queue, core::ImageStorage *im
 		presentInfo.pNext = &presentTimeInfo;
 	}
 
+	// with partial redraw, only changed area of the image can be updated by presentation engine
+	auto swapchainImage = static_cast<core::SwapchainImage *>(image);
+
+	VkRectLayerKHR presentRect;
+	VkPresentRegionKHR presentRegion{1, &presentRect};
+	VkPresentRegionsKHR presentRegionsInfo{
+		VK_STRUCTURE_TYPE_PRESENT_REGIONS_KHR,
+		nullptr,
+		1,
+		&presentRegion,
+	};
+
+	if (swapchainImage->hasPresentRegion()
+			&& dev->hasExtension(OptionalDeviceExtension::IncrementalPresent)) {
+		auto &region = swapchainImage->getPresentRegion();
+		presentRect.offset = VkOffset2D{int32_t(region.x), int32_t(region.y)};
+		presentRect.extent = VkExtent2D{region.width, region.height};
+		presentRect.layer = 0;
+
+		presentRegionsInfo.pNext = presentInfo.pNext;
+		presentInfo.pNext = &presentRegionsInfo;
+	}
+
 	VkResult result = VK_ERROR_UNKNOWN;
 	dev->makeApiCall([&](const DeviceTable &table, VkDevice device) {
 #if XL_VKAPI_DEBUG
@@ -393,7 +416,7 @@ Status SwapchainHandle::present(core::DeviceQueue &queue, core::ImageStorage *im
 
 	do {
 		std::unique_lock<Mutex> lock(_resourceMutex);
-		static_cast<core::SwapchainImage *>(image)->setPresented();
+		swapchainImage->setPresented();
 		auto it = _acquiredIndexes.find(imageIndex);
 		if (it != _acquiredIndexes.end()) {
 			_acquiredIndexes.erase(it);
@@ -439,6 +462,8 @@ void SwapchainHandle::invalidateImage(const core::ImageStorage *image, bool rele
 }
 
 void SwapchainHandle::invalidateImage(uint32_t idx, bool release) {
+	invalidateImageDamage(idx);
+
 	std::unique_lock<Mutex> lock(_resourceMutex);
 	auto it = _acquiredIndexes.find(idx);
 	if (it != _acquiredIndexes.end()) {
@@ -27,6 +27,18 @@
 
 namespace STAPPLER_VERSIONIZED stappler::xenolith::vk {
 
+static void destroyUpdateTemplate(Device *dev, VkDescriptorUpdateTemplate updateTemplate,
+		bool khr) {
+#if defined(VK_KHR_descriptor_update_template)
+	if (khr) {
+		dev->getTable()->vkDestroyDescriptorUpdateTemplateKHR(dev->getDevice(), updateTemplate,
+				nullptr);
+		return;
+	}
+#endif
+	dev->getTable()->vkDestroyDescriptorUpdateTemplate(dev->getDevice(), updateTemplate, nullptr);
+}
+
 uint32_t TextureSetLayout::getLayoutImageCount(const Device &dev,
 		const core::TextureSetLayoutData &data) {
 	auto &devInfo = dev.getInfo();
@@ -110,19 +122,66 @@ bool TextureSetLayout::init(Device &dev, const core::TextureSetLayoutData &data)
 	_emptyImage = data.queue->emptyImage;
 	_solidImage = data.queue->solidImage;
 
+	// core entry points on 1.1+, KHR ones when extension is enabled on 1.0 device
+	PFN_vkCreateDescriptorUpdateTemplate createTemplate = nullptr;
+	if (dev.getInfo().properties.device10.properties.apiVersion >= VK_API_VERSION_1_1) {
+		createTemplate = dev.getTable()->vkCreateDescriptorUpdateTemplate;
+	}
+#if defined(VK_KHR_descriptor_update_template)
+	else if (dev.hasExtension(OptionalDeviceExtension::DescriptorUpdateTemplate)) {
+		createTemplate = dev.getTable()->vkCreateDescriptorUpdateTemplateKHR;
+		_updateTemplateKhr = true;
+	}
+#endif
+
+	if (createTemplate) {
+		VkDescriptorUpdateTemplateEntry entry{};
+		entry.dstBinding = 1;
+		entry.dstArrayElement = 0;
+		entry.descriptorCount = _imageCount;
+		entry.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+		entry.offset = 0;
+		entry.stride = sizeof(VkDescriptorImageInfo);
+
+		VkDescriptorUpdateTemplateCreateInfo templateInfo{};
+		templateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+		templateInfo.pNext = nullptr;
+		templateInfo.flags = 0;
+		templateInfo.descriptorUpdateEntryCount = 1;
+		templateInfo.pDescriptorUpdateEntries = &entry;
+		templateInfo.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+		templateInfo.descriptorSetLayout = _layout;
+
+		if (createTemplate(dev.getDevice(), &templateInfo, nullptr, &_updateTemplate)
+				!= VK_SUCCESS) {
+			// fallback to regular descriptor writes
+			_updateTemplate = VK_NULL_HANDLE;
+		}
+	}
+
 	return core::Object::init(dev,
 			[](core::Device *dev, core::ObjectType, core::ObjectHandle ptr, void *data) {
 		auto d = ((Device *)dev);
+		auto layout = (TextureSetLayout *)data;
+		auto updateTemplate = layout->_updateTemplate;
+		auto khr = layout->_updateTemplateKhr;
 		if (d->isPortabilityMode()) {
 			auto pool = memory::pool::acquire();
-			memory::pool::pre_cleanup_register(pool, [d, ptr = (VkDescriptorSetLayout)ptr.get()]() {
+			memory::pool::pre_cleanup_register(pool,
+					[d, ptr = (VkDescriptorSetLayout)ptr.get(), updateTemplate, khr]() {
+				if (updateTemplate) {
+					destroyUpdateTemplate(d, updateTemplate, khr);
+				}
 				d->getTable()->vkDestroyDescriptorSetLayout(d->getDevice(), ptr, nullptr);
 			});
 		} else {
+			if (updateTemplate) {
+				destroyUpdateTemplate(d, updateTemplate, khr);
+			}
 			d->getTable()->vkDestroyDescriptorSetLayout(d->getDevice(),
 					(VkDescriptorSetLayout)ptr.get(), nullptr);
 		}
-	}, core::ObjectType::DescriptorSetLayout, ObjectHandle(_layout));
+	}, core::ObjectType::DescriptorSetLayout, ObjectHandle(_layout), this);
 
 	return true;
 }
@@ -184,12 +243,26 @@ void TextureSet::write(const core::MaterialLayout &set) {
 	auto table = ((Device *)_object.device)->getTable();
 	auto dev = ((Device *)_object.device)->getDevice();
 
-	std::forward_list<Vector<VkDescriptorImageInfo>> imagesList;
+	Vector<VkDescriptorImageInfo> images;
 	Vector<VkWriteDescriptorSet> writes;
 
-	writeImages(writes, set, imagesList);
+	// set is written once per acquisition, barriers from the previous use of recycled set
+	// are already consumed, and their images can be released
+	_pendingImageBarriers.clear();
+
+	writeImages(writes, set, images);
+
+	if (writes.empty()) {
+		return;
+	}
 
-	table->vkUpdateDescriptorSets(dev, uint32_t(writes.size()), writes.data(), 0, nullptr);
+	auto updateTemplate = _layout->getUpdateTemplate();
+	if (updateTemplate && writes.size() > config::TextureSetMaxDescriptorWrites) {
+		// too many separate ranges, write whole array at once
+		writeTemplate(updateTemplate);
+	} else {
+		table->vkUpdateDescriptorSets(dev, uint32_t(writes.size()), writes.data(), 0, nullptr);
+	}
 }
 
 Vector<const ImageMemoryBarrier *> TextureSet::getPendingImageBarriers() const {
@@ -222,8 +295,15 @@ void TextureSet::dropPendingBarriers() {
 Device *TextureSet::getDevice() const { return (Device *)_object.device; }
 
 void TextureSet::writeImages(Vector<VkWriteDescriptorSet> &writes, const core::MaterialLayout &set,
-		std::forward_list<Vector<VkDescriptorImageInfo>> &imagesList) {
-	Vector<VkDescriptorImageInfo> *localImages = nullptr;
+		Vector<VkDescriptorImageInfo> &images) {
+	// with partially bound descriptors only used slots should be valid
+	auto slotsCount = _partiallyBound ? set.usedImageSlots : _imageCount;
+
+	_layoutIndexes.resize(slotsCount, 0);
+	_imageViews.resize(slotsCount, VK_NULL_HANDLE);
+
+	// reserve to keep pImageInfo pointers valid
+	images.reserve(slotsCount);
 
 	VkWriteDescriptorSet imageWriteData({VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr,
 		_set, // set
@@ -231,86 +311,87 @@ void TextureSet::writeImages(Vector<VkWriteDescriptorSet> &writes, const core::M
 		0, // index
 		0, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, nullptr, VK_NULL_HANDLE, VK_NULL_HANDLE});
 
-	if (_partiallyBound) {
-		_layoutIndexes.resize(set.usedImageSlots, 0);
-	} else {
-		_layoutIndexes.resize(set.imageSlots.size(), 0);
-	}
-
-	auto pushWritten = [&, this] {
-		imageWriteData.descriptorCount = uint32_t(localImages->size());
-		imageWriteData.pImageInfo = localImages->data();
-		writes.emplace_back(move(imageWriteData));
-		imageWriteData = VkWriteDescriptorSet({VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr,
-			_set, // set
-			1, // descriptor
-			0, // start from next index
-			0, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, nullptr, VK_NULL_HANDLE, VK_NULL_HANDLE});
-		localImages = nullptr;
+	auto pushWritten = [&] {
+		imageWriteData.pImageInfo =
+				images.data() + (images.size() - imageWriteData.descriptorCount);
+		writes.emplace_back(imageWriteData);
+		imageWriteData.descriptorCount = 0;
 	};
 
 	auto emptyImageView = _layout->getEmptyImage()->views.front();
+	auto emptyIndex = emptyImageView->view->getIndex();
+	auto emptyView = emptyImageView->view.get_cast<ImageView>()->getImageView();
+
+	for (uint32_t i = 0; i < slotsCount; ++i) {
+		auto slot = (i < set.usedImageSlots) ? set.imageSlots[i].image.get() : nullptr;
+		auto index = slot ? slot->getIndex() : emptyIndex;
+
+		if (!slot && _partiallyBound) {
+			// empty slots in partially bound set are not accessed, so, they are not written,
+			// but previous view should not be used in full rewrite
+			_layoutIndexes[i] = 0;
+			_imageViews[i] = VK_NULL_HANDLE;
+		}
 
-	for (uint32_t i = 0; i < set.usedImageSlots; ++i) {
-		if (set.imageSlots[i].image && _layoutIndexes[i] != set.imageSlots[i].image->getIndex()) {
-			if (!localImages) {
-				localImages = &imagesList.emplace_front(Vector<VkDescriptorImageInfo>());
-			}
-			localImages->emplace_back(VkDescriptorImageInfo(
-					{VK_NULL_HANDLE, set.imageSlots[i].image.get_cast<ImageView>()->getImageView(),
-						VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL}));
-			auto image = (Image *)set.imageSlots[i].image->getImage().get();
-			if (image->getPendingBarrier()) {
-				_pendingImageBarriers.emplace_back(image);
-			}
-			_layoutIndexes[i] = set.imageSlots[i].image->getIndex();
-			++imageWriteData.descriptorCount;
-		} else if (!_partiallyBound && !set.imageSlots[i].image
-				&& _layoutIndexes[i] != emptyImageView->view->getIndex()) {
-			if (!localImages) {
-				localImages = &imagesList.emplace_front(Vector<VkDescriptorImageInfo>());
-			}
-			localImages->emplace_back(VkDescriptorImageInfo(
-					{VK_NULL_HANDLE, emptyImageView->view.get_cast<ImageView>()->getImageView(),
-						VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL}));
-			_layoutIndexes[i] = emptyImageView->view->getIndex();
-			++imageWriteData.descriptorCount;
-		} else {
+		if (_layoutIndexes[i] == index || (!slot && _partiallyBound)) {
 			// no need to write, push written
 			if (imageWriteData.descriptorCount > 0) {
 				pushWritten();
 			}
-			imageWriteData.dstArrayElement = i + 1; // start from next index
+			continue;
 		}
-	}
 
-	if (!_partiallyBound) {
-		// write empty
-		for (uint32_t i = set.usedImageSlots; i < _imageCount; ++i) {
-			if (_layoutIndexes[i] != emptyImageView->view->getIndex()) {
-				if (!localImages) {
-					localImages = &imagesList.emplace_front(Vector<VkDescriptorImageInfo>());
-				}
-				localImages->emplace_back(VkDescriptorImageInfo(
-						{VK_NULL_HANDLE, emptyImageView->view.get_cast<ImageView>()->getImageView(),
-							VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL}));
-				_layoutIndexes[i] = emptyImageView->view->getIndex();
-				++imageWriteData.descriptorCount;
-			} else {
-				// no need to write, push written
-				if (imageWriteData.descriptorCount > 0) {
-					pushWritten();
-				}
-				imageWriteData.dstArrayElement = i + 1; // start from next index
+		if (imageWriteData.descriptorCount == 0) {
+			imageWriteData.dstArrayElement = i;
+		}
+
+		auto view = slot ? static_cast<ImageView *>(slot)->getImageView() : emptyView;
+		images.emplace_back(VkDescriptorImageInfo(
+				{VK_NULL_HANDLE, view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL}));
+
+		if (slot) {
+			auto image = (Image *)slot->getImage().get();
+			if (image->getPendingBarrier()) {
+				_pendingImageBarriers.emplace_back(image);
 			}
 		}
+
+		_layoutIndexes[i] = index;
+		_imageViews[i] = view;
+		++imageWriteData.descriptorCount;
 	}
 
 	if (imageWriteData.descriptorCount > 0) {
-		imageWriteData.descriptorCount = uint32_t(localImages->size());
-		imageWriteData.pImageInfo = localImages->data();
-		writes.emplace_back(move(imageWriteData));
+		pushWritten();
+	}
+}
+
+void TextureSet::writeTemplate(VkDescriptorUpdateTemplate updateTemplate) {
+	auto table = ((Device *)_object.device)->getTable();
+	auto dev = ((Device *)_object.device)->getDevice();
+
+	auto emptyImageView = _layout->getEmptyImage()->views.front();
+	auto emptyView = emptyImageView->view.get_cast<ImageView>()->getImageView();
+
+	// template writes all slots, unused slots in partially bound set are filled with empty image
+	Vector<VkDescriptorImageInfo> images;
+	images.reserve(_imageCount);
+	for (uint32_t i = 0; i < _imageCount; ++i) {
+		auto view = (i < _imageViews.size()) ? _imageViews[i] : VkImageView(VK_NULL_HANDLE);
+		if (!view) {
+			view = emptyView;
+		}
+		images.emplace_back(VkDescriptorImageInfo(
+				{VK_NULL_HANDLE, view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL}));
+	}
+
+#if defined(VK_KHR_descriptor_update_template)
+	if (_layout->isUpdateTemplateKhr()) {
+		table->vkUpdateDescriptorSetWithTemplateKHR(dev, _set, updateTemplate, images.data());
+		return;
 	}
+#endif
+	table->vkUpdateDescriptorSetWithTemplate(dev, _set, updateTemplate, images.data());
 }
 
 } // namespace stappler::xenolith::vk
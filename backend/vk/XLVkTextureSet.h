@@ -47,8 +47,16 @@ public:
 
 	VkDescriptorSetLayout getLayout() const { return _layout; }
 
+	// Template to write whole image array in single call, VK_NULL_HANDLE if not supported
+	VkDescriptorUpdateTemplate getUpdateTemplate() const { return _updateTemplate; }
+
+	// Template was created with VK_KHR_descriptor_update_template entry points (1.0 device)
+	bool isUpdateTemplateKhr() const { return _updateTemplateKhr; }
+
 protected:
 	VkDescriptorSetLayout _layout = VK_NULL_HANDLE;
+	VkDescriptorUpdateTemplate _updateTemplate = VK_NULL_HANDLE;
+	bool _updateTemplateKhr = false;
 };
 
 class SP_PUBLIC TextureSet : public core::TextureSet {
@@ -73,8 +81,12 @@ public:
 protected:
 	using core::TextureSet::init;
 
+	// writes only slots, that was changed since previous write
 	void writeImages(Vector<VkWriteDescriptorSet> &writes, const core::MaterialLayout &set,
-			std::forward_list<Vector<VkDescriptorImageInfo>> &imagesList);
+			Vector<VkDescriptorImageInfo> &images);
+
+	// writes whole image array with update template
+	void writeTemplate(VkDescriptorUpdateTemplate);
 
 	bool _partiallyBound = false;
 	const TextureSetLayout *_layout = nullptr;
@@ -82,6 +94,7 @@ protected:
 	VkDescriptorSet _set = VK_NULL_HANDLE;
 	VkDescriptorPool _pool = VK_NULL_HANDLE;
 	Vector<Image *> _pendingImageBarriers;
+	Vector<VkImageView> _imageViews; // views, written into slots, parallel to _layoutIndexes
 };
 
 } // namespace stappler::xenolith::vk
@@ -29,6 +29,7 @@
 #include "XLVkObject.h"
 #include "XLCoreFrameQueue.h"
 #include "XLCoreFrameRequest.h"
+#include "XLCoreTrace.h"
 
 namespace STAPPLER_VERSIONIZED stappler::xenolith::vk {
 
@@ -950,6 +951,8 @@ void TransferAttachmentHandle::submitInput(FrameQueue &q, Rc<core::AttachmentInp
 		}
 
 		handle.performInQueue([this](FrameHandle &frame) -> bool {
+			core::TraceScope trace(core::TraceCategory::Transfer, "TransferResource::initialize",
+					frame.getOrder());
 			if (_resource->initialize()) {
 				return true;
 			}
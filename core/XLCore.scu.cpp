@@ -42,6 +42,8 @@
 #include "XLCorePresentationFrame.cc"
 #include "XLCorePresentationEngine.cc"
 #include "XLCoreTextInput.cc"
+#include "XLCoreTrace.cc"
+#include "XLCoreFramePool.cc"
 
 #include "SPMetastring.h"
 
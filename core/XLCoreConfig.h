@@ -59,6 +59,21 @@ static constexpr uint32_t MaxTextureSetImagesIndexed = 1024 << 4;
 
 static constexpr uint32_t MaxBufferArrayObjectsIndexed = 1024;
 
+/* Bind transient image attachments with non-overlapping lifetimes within a frame to the shared device memory */
+static constexpr bool EnableAttachmentAliasing = true;
+
+/* Compile timeline trace points (see core::Trace), recording itself should be started in runtime */
+static constexpr bool EnableTrace = true;
+
+/* Number of preallocated per-frame memory pools (swapchain images + one frame in preparation) */
+static constexpr uint32_t FramePoolsInFlight = 4;
+
+/* Number of released texture sets, that TextureSetLayout keeps for reuse */
+static constexpr uint32_t RecycledTextureSets = 8;
+
+/* Number of frames, which damage is stored by swapchain for partial redraw */
+static constexpr uint32_t SwapchainDamageHistory = 16;
+
 }
 
 #endif /* XENOLITH_CORE_XLCORECONFIG_H_ */
@@ -77,6 +77,12 @@ Rc<Framebuffer> Device::makeFramebuffer(const QueuePassData *, SpanView<Rc<Image
 
 auto Device::makeImage(StringView, const ImageInfoData &) -> Rc<ImageStorage> { return nullptr; }
 
+AliasingMemory Device::makeAliasingMemory(SpanView<ImageInfoData>) { return AliasingMemory(); }
+
+auto Device::makeAliasedImage(StringView, const ImageInfoData &, Object *) -> Rc<ImageStorage> {
+	return nullptr;
+}
+
 Rc<Semaphore> Device::makeSemaphore() { return nullptr; }
 
 Rc<ImageView> Device::makeImageView(const Rc<ImageObject> &, const ImageViewInfo &) {
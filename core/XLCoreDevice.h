@@ -56,6 +56,15 @@ protected:
 	core::QueueFlags _queueFlags = core::QueueFlags::None;
 };
 
+// Device memory, that can hold any one of the specified images at a time
+struct SP_PUBLIC AliasingMemory {
+	Rc<Object> memory;
+	uint64_t size = 0; // allocated size
+	uint64_t unaliasedSize = 0; // size, required to allocate all images separately
+
+	explicit operator bool() const { return memory != nullptr; }
+};
+
 class SP_PUBLIC Device : public Ref {
 public:
 	using DescriptorType = core::DescriptorType;
@@ -83,6 +92,11 @@ public:
 
 	virtual Rc<Framebuffer> makeFramebuffer(const QueuePassData *, SpanView<Rc<ImageView>>);
 	virtual Rc<ImageStorage> makeImage(StringView, const ImageInfoData &);
+
+	// Memory aliasing support, used by FrameCache for transient attachments;
+	// returns empty memory if aliasing is not supported by device
+	virtual AliasingMemory makeAliasingMemory(SpanView<ImageInfoData>);
+	virtual Rc<ImageStorage> makeAliasedImage(StringView, const ImageInfoData &, Object *memory);
 	virtual Rc<Semaphore> makeSemaphore();
 	virtual Rc<ImageView> makeImageView(const Rc<ImageObject> &, const ImageViewInfo &);
 	virtual Rc<CommandPool> makeCommandPool(uint32_t family, QueueFlags flags);
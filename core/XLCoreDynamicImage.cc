@@ -73,7 +73,9 @@ void DynamicImage::updateInstance(Loop &loop, const Rc<ImageObject> &obj, Rc<Dat
 	_instance = newInstance;
 	_data.image = nullptr;
 
-	for (auto &it : _materialTrackers) { it->updateDynamicImage(loop, this, deps); }
+	for (auto &it : _materialTrackers) {
+		it->updateDynamicImage(loop, this, newInstance->gen, deps);
+	}
 }
 
 void DynamicImage::addTracker(const MaterialAttachment *a) {
@@ -86,6 +88,12 @@ void DynamicImage::removeTracker(const MaterialAttachment *a) {
 	_materialTrackers.erase(a);
 }
 
+void DynamicImage::setCompiledGeneration(uint32_t gen) {
+	// trackers can be compiled out of order, keep the latest generation
+	auto current = _compiledGen.load();
+	while (current < gen && !_compiledGen.compare_exchange_weak(current, gen)) { }
+}
+
 ImageInfo DynamicImage::getInfo() const {
 	std::unique_lock<Mutex> lock(_mutex);
 	return ImageInfo(static_cast<const ImageInfo &>(_data));
@@ -64,6 +64,13 @@ public:
 	ImageInfo getInfo() const;
 	Extent3 getExtent() const;
 
+	// Generation of the latest instance, that was compiled into materials,
+	// nodes can use it to detect, when their drawing was changed
+	uint32_t getCompiledGeneration() const { return _compiledGen.load(); }
+
+	// called by material attachment, when materials with the instance was compiled
+	void setCompiledGeneration(uint32_t);
+
 	// called when image compiled successfully
 	void setImage(const Rc<ImageObject> &);
 	void acquireData(const Callback<void(BytesView)> &);
@@ -77,6 +84,7 @@ protected:
 	ImageData _data;
 	Rc<DynamicImageInstance> _instance;
 	Set<const MaterialAttachment *> _materialTrackers;
+	std::atomic<uint32_t> _compiledGen = 0;
 };
 
 class SP_PUBLIC DynamicImage::Builder {
@@ -26,6 +26,63 @@
 
 namespace STAPPLER_VERSIONIZED stappler::xenolith::core {
 
+FrameCacheFramebufferKey::FrameCacheFramebufferKey(uint64_t pass, Extent3 e,
+		SpanView<uint64_t> views) {
+	auto target = prepare(pass, e, views.size());
+	memcpy(target, views.data(), views.size() * sizeof(uint64_t));
+	hash = hash::hash64((const char *)getIds().data(), count * sizeof(uint64_t));
+}
+
+FrameCacheFramebufferKey::FrameCacheFramebufferKey(uint64_t pass, Extent3 e,
+		SpanView<Rc<ImageView>> views) {
+	auto target = prepare(pass, e, views.size());
+	for (auto &it : views) { *target++ = it->getIndex(); }
+	hash = hash::hash64((const char *)getIds().data(), count * sizeof(uint64_t));
+}
+
+SpanView<uint64_t> FrameCacheFramebufferKey::getIds() const {
+	if (!extra.empty()) {
+		return extra;
+	}
+	return SpanView<uint64_t>(ids.data(), count);
+}
+
+bool FrameCacheFramebufferKey::operator==(const FrameCacheFramebufferKey &other) const {
+	if (hash != other.hash || count != other.count) {
+		return false;
+	}
+	return memcmp(getIds().data(), other.getIds().data(), count * sizeof(uint64_t)) == 0;
+}
+
+uint64_t *FrameCacheFramebufferKey::prepare(uint64_t pass, Extent3 e, size_t nviews) {
+	count = uint32_t(nviews + 2);
+
+	uint64_t *target = ids.data();
+	if (nviews > InlineIds) {
+		extra.resize(count);
+		target = extra.data();
+	}
+
+	target[0] = pass;
+	target[1] = uint64_t(e.depth) << uint64_t(48) | uint64_t(e.height) << uint64_t(24)
+			| uint64_t(e.width);
+	return target + 2;
+}
+
+FrameCacheImageKey::FrameCacheImageKey(const ImageInfoData &i) : info(i) {
+	// hash only significant fields, ImageInfoData can contain uninitialized padding
+	std::array<uint64_t, 6> data{
+		uint64_t(toInt(info.format)) << 32 | uint64_t(toInt(info.flags)),
+		uint64_t(toInt(info.imageType)) << 32 | uint64_t(toInt(info.samples)),
+		uint64_t(info.extent.width) << 32 | uint64_t(info.extent.height),
+		uint64_t(info.extent.depth) << 32 | uint64_t(info.mipLevels.get()),
+		uint64_t(info.arrayLayers.get()) << 32 | uint64_t(toInt(info.tiling)),
+		uint64_t(toInt(info.usage)) << 32 | uint64_t(toInt(info.type)) << 16
+				| uint64_t(toInt(info.hints)),
+	};
+	hash = hash::hash64((const char *)data.data(), data.size() * sizeof(uint64_t));
+}
+
 FrameCache::~FrameCache() { }
 
 bool FrameCache::init(Loop &loop, Device &dev) {
@@ -39,23 +96,20 @@ void FrameCache::invalidate() {
 	_imageViews.clear();
 	_renderPasses.clear();
 	_images.clear();
+	_aliasingImages.clear();
+	_aliasingAttachments.clear();
+	_aliasingGroups.clear();
 }
 
 Rc<Framebuffer> FrameCache::acquireFramebuffer(const QueuePassData *data,
 		SpanView<Rc<ImageView>> views) {
-	auto e = views.front()->getFramebufferExtent();
-	Vector<uint64_t> ids;
-	ids.reserve(views.size() + 2);
-	ids.emplace_back(data->impl->getIndex());
-	ids.emplace_back(uint64_t(e.depth) << uint64_t(48) | uint64_t(e.height) << uint64_t(24)
-			| uint64_t(e.width));
-	for (auto &it : views) { ids.emplace_back(it->getIndex()); }
-
-	auto it = _framebuffers.find(ids);
-	if (it != _framebuffers.end()) {
-		if (!it->second.framebuffers.empty()) {
-			auto fb = it->second.framebuffers.back();
-			it->second.framebuffers.pop_back();
+	FrameCacheFramebufferKey key(data->impl->getIndex(), views.front()->getFramebufferExtent(),
+			views);
+
+	if (auto it = _framebuffers.find(key)) {
+		if (!it->framebuffers.empty()) {
+			auto fb = it->framebuffers.back();
+			it->framebuffers.pop_back();
 			return fb;
 		}
 	}
@@ -65,26 +119,17 @@ Rc<Framebuffer> FrameCache::acquireFramebuffer(const QueuePassData *data,
 
 void FrameCache::releaseFramebuffer(Rc<Framebuffer> &&fb) {
 	auto e = fb->getFramebufferExtent();
-	Vector<uint64_t> ids;
-	ids.reserve(fb->getViewIds().size() + 2);
-	ids.emplace_back(fb->getRenderPass()->getIndex());
-	ids.emplace_back(uint64_t(e.depth) << uint64_t(48) | uint64_t(e.height) << uint64_t(24)
-			| uint64_t(e.width));
-	for (auto &it : fb->getViewIds()) { ids.emplace_back(it); }
-
-	if (isReachable(SpanView<uint64_t>(ids))) {
-		auto it = _framebuffers.find(ids);
-		if (it == _framebuffers.end()) {
-			_framebuffers.emplace(sp::move(ids),
-					FrameCacheFramebuffer{Vector<Rc<Framebuffer>>{sp::move(fb)}, e});
-		} else {
-			it->second.framebuffers.emplace_back(sp::move(fb));
-		}
+	FrameCacheFramebufferKey key(fb->getRenderPass()->getIndex(), e, fb->getViewIds());
+
+	if (isReachable(key.getIds())) {
+		auto &it = _framebuffers.emplace(key);
+		it.extent = e;
+		it.framebuffers.emplace_back(sp::move(fb));
 	}
 }
 
 Rc<ImageStorage> FrameCache::acquireImage(uint64_t attachment, const ImageInfoData &info,
-		SpanView<ImageViewInfo> v) {
+		SpanView<ImageViewInfo> v, uint64_t frame) {
 	auto makeImage = [&, this] {
 		auto ret = _device->makeImage("TransientCacheImage", info);
 		ret->rearmSemaphores(*_loop);
@@ -98,18 +143,30 @@ Rc<ImageStorage> FrameCache::acquireImage(uint64_t attachment, const ImageInfoDa
 		return makeImage();
 	}
 
-	if (aIt->second == nullptr) {
-		aIt->second = addImage(info);
-	} else if (*aIt->second != info) {
-		removeImage(*aIt->second);
-		aIt->second = addImage(info);
+	auto gIt = _aliasingAttachments.find(attachment);
+
+	FrameCacheImageKey key(info);
+	if (!aIt->second || *aIt->second != key) {
+		if (aIt->second) {
+			removeImage(*aIt->second);
+		}
+		addImage(key);
+		aIt->second = key;
+		if (gIt != _aliasingAttachments.end()) {
+			gIt->second->dirty = true;
+		}
 	}
 
-	auto imageIt = _images.find(info);
-	if (imageIt != _images.end()) {
-		if (!imageIt->second.images.empty()) {
-			auto ret = move(imageIt->second.images.back());
-			imageIt->second.images.pop_back();
+	if (gIt != _aliasingAttachments.end() && !gIt->second->disabled) {
+		if (auto ret = acquireAliasedImage(*gIt->second, info, v, frame)) {
+			return ret;
+		}
+	}
+
+	if (auto imageIt = _images.find(key)) {
+		if (!imageIt->images.empty()) {
+			auto ret = move(imageIt->images.back());
+			imageIt->images.pop_back();
 			ret->rearmSemaphores(*_loop);
 			makeViews(ret, v);
 			return ret;
@@ -125,14 +182,42 @@ void FrameCache::releaseImage(Rc<ImageStorage> &&img) {
 		return;
 	}
 
-	auto info = img->getInfo();
-	auto imageIt = _images.find(info);
-	if (imageIt == _images.end()) {
+	auto aliasedIt = _aliasingImages.find(img->getImageIndex());
+	if (aliasedIt != _aliasingImages.end()) {
+		// memory can now be used by other attachment from the same group within the same
+		// frame; other frames should wait until this one is finalized (see releaseFrame)
+		auto mem = aliasedIt->second;
+		if (mem->acquired && mem->frame == img->getFrameIndex()) {
+			mem->acquired = false;
+			mem->pending = true;
+		}
+		return;
+	}
+
+	auto imageIt = _images.find(FrameCacheImageKey(img->getInfo()));
+	if (!imageIt) {
 		log::source().warn("FrameCache", "releaseImage: cache miss: ", img->getInfo());
 		return;
 	}
 
-	imageIt->second.images.emplace_back(move(img));
+	imageIt->images.emplace_back(move(img));
+}
+
+void FrameCache::releaseFrame(StringView queue, uint64_t frame) {
+	for (auto &it : _aliasingGroups) {
+		if (it.second.queue != queue) {
+			continue;
+		}
+
+		for (auto &mem : it.second.memory) {
+			// frame can be finalized without release of attachment's resources (invalidation),
+			// memory is not used by device anyway after that
+			if (mem.second.frame == frame) {
+				mem.second.acquired = false;
+				mem.second.pending = false;
+			}
+		}
+	}
 }
 
 void FrameCache::addImageView(uint64_t id) { _imageViews.emplace(id); }
@@ -142,15 +227,14 @@ void FrameCache::removeImageView(uint64_t id) {
 	if (it != _imageViews.end()) {
 		_imageViews.erase(it);
 
-		auto iit = _framebuffers.begin();
-		while (iit != _framebuffers.end()) {
-			if (!isReachable(SpanView<uint64_t>(iit->first))) {
-				for (auto &it : iit->second.framebuffers) { _autorelease.emplace_back(it); }
-				iit = _framebuffers.erase(iit);
-			} else {
-				++iit;
+		_framebuffers.erase_if(
+				[&](const FrameCacheFramebufferKey &key, FrameCacheFramebuffer &value) {
+			if (!isReachable(key.getIds())) {
+				for (auto &it : value.framebuffers) { _autorelease.emplace_back(it); }
+				return true;
 			}
-		}
+			return false;
+		});
 	}
 }
 
@@ -161,19 +245,18 @@ void FrameCache::removeRenderPass(uint64_t id) {
 	if (it != _renderPasses.end()) {
 		_renderPasses.erase(it);
 
-		auto iit = _framebuffers.begin();
-		while (iit != _framebuffers.end()) {
-			if (!isReachable(SpanView<uint64_t>(iit->first))) {
-				for (auto &it : iit->second.framebuffers) { _autorelease.emplace_back(it); }
-				iit = _framebuffers.erase(iit);
-			} else {
-				++iit;
+		_framebuffers.erase_if(
+				[&](const FrameCacheFramebufferKey &key, FrameCacheFramebuffer &value) {
+			if (!isReachable(key.getIds())) {
+				for (auto &it : value.framebuffers) { _autorelease.emplace_back(it); }
+				return true;
 			}
-		}
+			return false;
+		});
 	}
 }
 
-void FrameCache::addAttachment(uint64_t id) { _attachments.emplace(id, nullptr); }
+void FrameCache::addAttachment(uint64_t id) { _attachments.emplace(id, std::nullopt); }
 
 void FrameCache::removeAttachment(uint64_t id) {
 	auto it = _attachments.find(id);
@@ -185,58 +268,96 @@ void FrameCache::removeAttachment(uint64_t id) {
 		removeImage(*it->second);
 	}
 	_attachments.erase(it);
+
+	auto gIt = _aliasingAttachments.find(id);
+	if (gIt != _aliasingAttachments.end()) {
+		removeAliasingGroup(gIt->second);
+	}
+}
+
+void FrameCache::addAliasingGroup(StringView queue, SpanView<uint64_t> ids) {
+	if (ids.empty()) {
+		return;
+	}
+
+	auto it = _aliasingGroups.emplace(ids.front(), FrameCacheAliasingGroup()).first;
+	it->second.queue = queue.str<Interface>();
+	it->second.attachments = ids.vec<Interface>();
+	for (auto &id : ids) { _aliasingAttachments.emplace(id, &it->second); }
+}
+
+Vector<FrameCacheAliasingStat> FrameCache::getAliasingStat() const {
+	Vector<FrameCacheAliasingStat> ret;
+	for (auto &it : _aliasingGroups) {
+		auto statIt = std::find_if(ret.begin(), ret.end(),
+				[&](const FrameCacheAliasingStat &stat) { return stat.queue == it.second.queue; });
+		if (statIt == ret.end()) {
+			statIt = ret.emplace(ret.end(), FrameCacheAliasingStat{it.second.queue});
+		}
+		for (auto &mem : it.second.memory) {
+			statIt->allocated += mem.second.memory.size;
+			statIt->unaliased += mem.second.memory.unaliasedSize;
+		}
+	}
+	return ret;
+}
+
+FrameCacheAliasingStat FrameCache::getAliasingTotal() const {
+	FrameCacheAliasingStat ret;
+	for (auto &it : _aliasingGroups) {
+		for (auto &mem : it.second.memory) {
+			ret.allocated += mem.second.memory.size;
+			ret.unaliased += mem.second.memory.unaliasedSize;
+		}
+	}
+	return ret;
 }
 
 void FrameCache::removeUnreachableFramebuffers() {
-	auto fbsIt = _framebuffers.begin();
-	while (fbsIt != _framebuffers.end()) {
-		auto e = fbsIt->second.extent;
+	_framebuffers.erase_if([&](const FrameCacheFramebufferKey &, FrameCacheFramebuffer &value) {
+		auto e = value.extent;
 		bool found = false;
-		for (auto &it : _images) {
-			if (it.first.extent.width == e.width && it.first.extent.height == e.height) {
+		_images.foreach([&](const FrameCacheImageKey &key, const FrameCacheImageAttachment &) {
+			if (key.info.extent.width == e.width && key.info.extent.height == e.height) {
 				found = true;
 			}
-		}
+		});
 		if (!found) {
-			for (auto &it : fbsIt->second.framebuffers) { _autorelease.emplace_back(it); }
-			fbsIt = _framebuffers.erase(fbsIt);
-		} else {
-			auto fbIt = fbsIt->second.framebuffers.begin();
-			while (fbIt != fbsIt->second.framebuffers.end()) {
-				auto e = (*fbIt)->getFramebufferExtent();
-				Vector<uint64_t> ids;
-				ids.reserve((*fbIt)->getViewIds().size() + 2);
-				ids.emplace_back((*fbIt)->getRenderPass()->getIndex());
-				ids.emplace_back(uint64_t(e.depth) << uint64_t(48)
-						| uint64_t(e.height) << uint64_t(24) | uint64_t(e.width));
-				for (auto &it : (*fbIt)->getViewIds()) { ids.emplace_back(it); }
-
-				if (isReachable(SpanView<uint64_t>(ids))) {
-					_autorelease.emplace_back(*fbIt);
-					fbIt = fbsIt->second.framebuffers.erase(fbIt);
-				} else {
-					++fbIt;
-				}
-			}
+			for (auto &it : value.framebuffers) { _autorelease.emplace_back(it); }
+			return true;
+		}
 
-			if (fbsIt->second.framebuffers.empty()) {
-				fbsIt = _framebuffers.erase(fbsIt);
+		auto fbIt = value.framebuffers.begin();
+		while (fbIt != value.framebuffers.end()) {
+			FrameCacheFramebufferKey key((*fbIt)->getRenderPass()->getIndex(),
+					(*fbIt)->getFramebufferExtent(), (*fbIt)->getViewIds());
+
+			if (isReachable(key.getIds())) {
+				_autorelease.emplace_back(*fbIt);
+				fbIt = value.framebuffers.erase(fbIt);
 			} else {
-				++fbsIt;
+				++fbIt;
 			}
 		}
-	}
+
+		return value.framebuffers.empty();
+	});
 }
 
 size_t FrameCache::getFramebuffersCount() const {
 	size_t ret = 0;
-	for (auto &it : _framebuffers) { ret += it.second.framebuffers.size(); }
+	_framebuffers.foreach([&](const FrameCacheFramebufferKey &, const FrameCacheFramebuffer &value) {
+		ret += value.framebuffers.size();
+	});
 	return ret;
 }
 
 size_t FrameCache::getImagesCount() const {
 	size_t ret = 0;
-	for (auto &it : _images) { ret += it.second.images.size(); }
+	_images.foreach([&](const FrameCacheImageKey &, const FrameCacheImageAttachment &value) {
+		ret += value.images.size();
+	});
+	ret += _aliasingImages.size();
 	return ret;
 }
 
@@ -272,31 +393,23 @@ bool FrameCache::isReachable(SpanView<uint64_t> ids) const {
 	return true;
 }
 
-bool FrameCache::isReachable(const ImageInfoData &info) const {
-	auto it = _images.find(info);
-	return it != _images.end();
+bool FrameCache::isReachable(const FrameCacheImageKey &key) const {
+	return _images.find(key) != nullptr;
 }
 
-const ImageInfoData *FrameCache::addImage(const ImageInfoData &info) {
-	auto it = _images.find(info);
-	if (it == _images.end()) {
-		it = _images.emplace(info,
-							FrameCacheImageAttachment{uint32_t(1), Vector<Rc<ImageStorage>>()})
-					 .first;
-	} else {
-		++it->second.refCount;
-	}
-	return &it->first;
+void FrameCache::addImage(const FrameCacheImageKey &key) {
+	// new entry is value-initialized with zero refCount
+	auto &it = _images.emplace(key);
+	++it.refCount;
 }
 
-void FrameCache::removeImage(const ImageInfoData &info) {
-	auto it = _images.find(info);
-	if (it != _images.end()) {
-		if (it->second.refCount == 1) {
-			for (auto &iit : it->second.images) { _autorelease.emplace_back(iit); }
-			_images.erase(it);
+void FrameCache::removeImage(const FrameCacheImageKey &key) {
+	if (auto it = _images.find(key)) {
+		if (it->refCount == 1) {
+			for (auto &iit : it->images) { _autorelease.emplace_back(iit); }
+			_images.erase(key);
 		} else {
-			--it->second.refCount;
+			--it->refCount;
 		}
 	}
 }
@@ -316,4 +429,125 @@ void FrameCache::makeViews(const Rc<ImageStorage> &img, SpanView<ImageViewInfo>
 	}
 }
 
+Rc<ImageStorage> FrameCache::acquireAliasedImage(FrameCacheAliasingGroup &group,
+		const ImageInfoData &info, SpanView<ImageViewInfo> views, uint64_t frame) {
+	if (group.dirty) {
+		updateAliasingInfos(group);
+	}
+
+	FrameCacheAliasingMemory *target = nullptr;
+	auto memIt = group.memory.begin();
+	while (memIt != group.memory.end()) {
+		auto &mem = memIt->second;
+		if (mem.acquired || (mem.pending && mem.frame != frame)) {
+			++memIt;
+		} else if (mem.infos != group.infos) {
+			if (mem.pending) {
+				++memIt;
+			} else {
+				// outdated memory block, release it
+				removeAliasingMemory(mem);
+				memIt = group.memory.erase(memIt);
+			}
+		} else {
+			if (!target) {
+				target = &mem;
+			}
+			++memIt;
+		}
+	}
+
+	if (!target) {
+		auto mem = _device->makeAliasingMemory(group.infos);
+		if (!mem) {
+			log::source().warn("FrameCache", "Memory aliasing is not available for queue '",
+					group.queue, "', fallback to separate allocation");
+			group.disabled = true;
+			return nullptr;
+		}
+
+		target = &group.memory
+						  .emplace(group.nextMemoryId++,
+								  FrameCacheAliasingMemory{move(mem), group.infos})
+						  .first->second;
+	}
+
+	auto imageIt = target->images.find(info);
+	if (imageIt == target->images.end()) {
+		auto img = _device->makeAliasedImage("TransientAliasedImage", info,
+				target->memory.memory.get());
+		if (!img) {
+			return nullptr;
+		}
+
+		_aliasingImages.emplace(img->getImageIndex(), target);
+		imageIt = target->images.emplace(info, move(img)).first;
+	}
+
+	auto ret = imageIt->second;
+
+	// previous image in this memory can still be in use by GPU, so we should wait on it
+	if (target->current) {
+		ret->takeSemaphores(*target->current);
+	}
+	ret->rearmSemaphores(*_loop);
+	makeViews(ret, views);
+
+	target->current = ret;
+	target->frame = frame;
+	target->acquired = true;
+	target->pending = false;
+	return ret;
+}
+
+void FrameCache::updateAliasingInfos(FrameCacheAliasingGroup &group) {
+	// memory should be able to hold any image, currently used by group's attachments
+	group.infos.clear();
+	for (auto &id : group.attachments) {
+		auto it = _attachments.find(id);
+		if (it != _attachments.end() && it->second) {
+			group.infos.emplace_back(it->second->info);
+		}
+	}
+
+	std::sort(group.infos.begin(), group.infos.end());
+	group.infos.erase(std::unique(group.infos.begin(), group.infos.end()), group.infos.end());
+	group.dirty = false;
+}
+
+void FrameCache::removeAliasingMemory(FrameCacheAliasingMemory &mem) {
+	for (auto &it : mem.images) {
+		_aliasingImages.erase(it.second->getImageIndex());
+		_autorelease.emplace_back(it.second);
+	}
+	mem.images.clear();
+	mem.current = nullptr;
+	_autorelease.emplace_back(mem.memory.memory);
+	mem.memory.memory = nullptr;
+}
+
+void FrameCache::removeAliasingGroup(FrameCacheAliasingGroup *group) {
+	auto it = _aliasingGroups.begin();
+	while (it != _aliasingGroups.end()) {
+		if (&it->second == group) {
+			for (auto &mem : it->second.memory) {
+				if (mem.second.acquired) {
+					// image is still in use, it will be released with the frame
+					for (auto &img : mem.second.images) {
+						_aliasingImages.erase(img.second->getImageIndex());
+					}
+					mem.second.images.clear();
+					mem.second.current = nullptr;
+				} else {
+					removeAliasingMemory(mem.second);
+				}
+			}
+			for (auto &id : it->second.attachments) { _aliasingAttachments.erase(id); }
+			_aliasingGroups.erase(it);
+			return;
+		}
+		++it;
+	}
+}
+
 } // namespace stappler::xenolith::core
@@ -24,19 +24,133 @@
 #define XENOLITH_CORE_XLCOREFRAMECACHE_H_
 
 #include "XLCoreQueueData.h"
+#include "XLCoreDevice.h"
 
 namespace STAPPLER_VERSIONIZED stappler::xenolith::core {
 
+// Framebuffer lookup key: render pass index, packed extent and image view indexes
+// Ids stored inline for common framebuffers, hash is computed once on construction
+struct SP_PUBLIC FrameCacheFramebufferKey final {
+	static constexpr size_t InlineIds = 14;
+
+	FrameCacheFramebufferKey() = default;
+	FrameCacheFramebufferKey(uint64_t pass, Extent3, SpanView<uint64_t> views);
+	FrameCacheFramebufferKey(uint64_t pass, Extent3, SpanView<Rc<ImageView>> views);
+
+	SpanView<uint64_t> getIds() const;
+
+	bool operator==(const FrameCacheFramebufferKey &) const;
+	bool operator!=(const FrameCacheFramebufferKey &other) const { return !(*this == other); }
+
+	uint64_t hash = 0;
+	uint32_t count = 0;
+	std::array<uint64_t, InlineIds + 2> ids;
+	Vector<uint64_t> extra; // used only when ids not fit into inline storage
+
+protected:
+	uint64_t *prepare(uint64_t pass, Extent3, size_t);
+};
+
+struct SP_PUBLIC FrameCacheImageKey final {
+	FrameCacheImageKey() = default;
+	FrameCacheImageKey(const ImageInfoData &);
+
+	bool operator==(const FrameCacheImageKey &other) const {
+		return hash == other.hash && info == other.info;
+	}
+	bool operator!=(const FrameCacheImageKey &other) const { return !(*this == other); }
+
+	uint64_t hash = 0;
+	ImageInfoData info;
+};
+
+// Open-addressing hash table with linear probing
+// Erased slots are marked as deleted, so iteration and erasure can be combined
+template <typename Key, typename Value>
+class SP_PUBLIC FrameCacheTable final {
+public:
+	enum class SlotState : uint8_t {
+		Empty,
+		Used,
+		Deleted
+	};
+
+	struct Slot {
+		SlotState state = SlotState::Empty;
+		Key key;
+		Value value;
+	};
+
+	Value *find(const Key &);
+	const Value *find(const Key &) const;
+
+	// returns existing value or inserts default one
+	Value &emplace(const Key &);
+
+	bool erase(const Key &);
+
+	// callback returns true, if element should be erased
+	template <typename Callback>
+	void erase_if(const Callback &);
+
+	template <typename Callback>
+	void foreach(const Callback &) const;
+
+	size_t size() const { return _size; }
+	bool empty() const { return _size == 0; }
+
+	void clear();
+
+protected:
+	size_t lookup(const Key &) const;
+	void rehash(size_t);
+
+	size_t _size = 0;
+	size_t _deleted = 0;
+	Vector<Slot> _slots;
+};
+
 struct SP_PUBLIC FrameCacheFramebuffer final {
 	Vector<Rc<Framebuffer>> framebuffers;
 	Extent3 extent;
 };
 
 struct SP_PUBLIC FrameCacheImageAttachment final {
-	uint32_t refCount;
+	uint32_t refCount = 0;
 	Vector<Rc<ImageStorage>> images;
 };
 
+struct SP_PUBLIC FrameCacheAliasingMemory final {
+	AliasingMemory memory;
+	Vector<ImageInfoData> infos; // images, for which memory was allocated
+	Map<ImageInfoData, Rc<ImageStorage>> images;
+	Rc<ImageStorage> current; // last image, that was bound to this memory
+	uint64_t frame = 0; // order of the frame, that last acquired this memory
+	bool acquired = false;
+
+	// memory was released by attachment, but the frame is still executed by device;
+	// only the same frame can reuse it, ordered by subpass dependencies on the same queue
+	bool pending = false;
+};
+
+struct SP_PUBLIC FrameCacheAliasingGroup final {
+	String queue;
+	Vector<uint64_t> attachments;
+	Vector<ImageInfoData> infos; // sorted unique infos of group's attachments
+	Map<uint64_t, FrameCacheAliasingMemory> memory;
+	uint64_t nextMemoryId = 0;
+	bool disabled = false;
+	bool dirty = true; // infos should be rebuilt
+};
+
+struct SP_PUBLIC FrameCacheAliasingStat final {
+	String queue;
+	uint64_t allocated = 0; // device memory, used for aliased images
+	uint64_t unaliased = 0; // device memory, that would be used without aliasing
+
+	uint64_t getSaved() const { return unaliased - allocated; }
+};
+
 class SP_PUBLIC FrameCache final : public Ref {
 public:
 	virtual ~FrameCache();
@@ -47,9 +161,14 @@ public:
 	Rc<Framebuffer> acquireFramebuffer(const QueuePassData *, SpanView<Rc<ImageView>>);
 	void releaseFramebuffer(Rc<Framebuffer> &&);
 
-	Rc<ImageStorage> acquireImage(uint64_t attachment, const ImageInfoData &, SpanView<ImageViewInfo> v);
+	Rc<ImageStorage> acquireImage(uint64_t attachment, const ImageInfoData &,
+			SpanView<ImageViewInfo> v, uint64_t frame = 0);
 	void releaseImage(Rc<ImageStorage> &&);
 
+	// all passes of the queue within the frame were finalized, aliased memory,
+	// used by this frame, can be acquired by other frames
+	void releaseFrame(StringView queue, uint64_t frame);
+
 	void addImageView(uint64_t);
 	void removeImageView(uint64_t);
 
@@ -59,6 +178,14 @@ public:
 	void addAttachment(uint64_t);
 	void removeAttachment(uint64_t);
 
+	// attachments from AttachmentAliasingData, images for them will share device memory
+	void addAliasingGroup(StringView queue, SpanView<uint64_t>);
+
+	Vector<FrameCacheAliasingStat> getAliasingStat() const;
+
+	// summary for all queues
+	FrameCacheAliasingStat getAliasingTotal() const;
+
 	void removeUnreachableFramebuffers();
 
 	size_t getFramebuffersCount() const;
@@ -72,25 +199,170 @@ public:
 
 protected:
 	bool isReachable(SpanView<uint64_t> ids) const;
-	bool isReachable(const ImageInfoData &) const;
+	bool isReachable(const FrameCacheImageKey &) const;
 
-	const ImageInfoData * addImage(const ImageInfoData &);
-	void removeImage(const ImageInfoData &);
+	void addImage(const FrameCacheImageKey &);
+	void removeImage(const FrameCacheImageKey &);
 
 	void makeViews(const Rc<ImageStorage> &, SpanView<ImageViewInfo>);
 
+	Rc<ImageStorage> acquireAliasedImage(FrameCacheAliasingGroup &, const ImageInfoData &,
+			SpanView<ImageViewInfo>, uint64_t frame);
+	void updateAliasingInfos(FrameCacheAliasingGroup &);
+	void removeAliasingMemory(FrameCacheAliasingMemory &);
+	void removeAliasingGroup(FrameCacheAliasingGroup *);
+
 	Loop *_loop = nullptr;
 	Device *_device = nullptr;
-	Map<ImageInfoData, FrameCacheImageAttachment> _images;
-	Map<Vector<uint64_t>, FrameCacheFramebuffer> _framebuffers;
-	Set<uint64_t> _imageViews;
-	Set<uint64_t> _renderPasses;
-	Map<uint64_t, const ImageInfoData *> _attachments;
+	FrameCacheTable<FrameCacheImageKey, FrameCacheImageAttachment> _images;
+	FrameCacheTable<FrameCacheFramebufferKey, FrameCacheFramebuffer> _framebuffers;
+	HashSet<uint64_t> _imageViews;
+	HashSet<uint64_t> _renderPasses;
+	Map<uint64_t, std::optional<FrameCacheImageKey>> _attachments;
+	Map<uint64_t, FrameCacheAliasingGroup> _aliasingGroups;
+	Map<uint64_t, FrameCacheAliasingGroup *> _aliasingAttachments;
+	Map<uint64_t, FrameCacheAliasingMemory *> _aliasingImages;
 
 	bool _freezed = false;
 	Vector<Rc<Ref>> _autorelease;
 };
 
+template <typename Key, typename Value>
+auto FrameCacheTable<Key, Value>::find(const Key &key) -> Value * {
+	auto idx = lookup(key);
+	if (idx != maxOf<size_t>() && _slots[idx].state == SlotState::Used) {
+		return &_slots[idx].value;
+	}
+	return nullptr;
 }
 
+template <typename Key, typename Value>
+auto FrameCacheTable<Key, Value>::find(const Key &key) const -> const Value * {
+	auto idx = lookup(key);
+	if (idx != maxOf<size_t>() && _slots[idx].state == SlotState::Used) {
+		return &_slots[idx].value;
+	}
+	return nullptr;
+}
+
+template <typename Key, typename Value>
+auto FrameCacheTable<Key, Value>::emplace(const Key &key) -> Value & {
+	// keep load factor (including deleted slots) below 3/4
+	if ((_size + _deleted + 1) * 4 > _slots.size() * 3) {
+		size_t capacity = std::max(size_t(16), _slots.size());
+		while ((_size + 1) * 2 > capacity) { capacity *= 2; }
+		rehash(capacity);
+	}
+
+	auto mask = _slots.size() - 1;
+	auto idx = size_t(key.hash) & mask;
+	size_t firstDeleted = maxOf<size_t>();
+	while (_slots[idx].state != SlotState::Empty) {
+		if (_slots[idx].state == SlotState::Used) {
+			if (_slots[idx].key == key) {
+				return _slots[idx].value;
+			}
+		} else if (firstDeleted == maxOf<size_t>()) {
+			firstDeleted = idx;
+		}
+		idx = (idx + 1) & mask;
+	}
+
+	if (firstDeleted != maxOf<size_t>()) {
+		idx = firstDeleted;
+		--_deleted;
+	}
+
+	auto &slot = _slots[idx];
+	slot.state = SlotState::Used;
+	slot.key = key;
+	slot.value = Value();
+	++_size;
+	return slot.value;
+}
+
+template <typename Key, typename Value>
+auto FrameCacheTable<Key, Value>::erase(const Key &key) -> bool {
+	auto idx = lookup(key);
+	if (idx != maxOf<size_t>() && _slots[idx].state == SlotState::Used) {
+		_slots[idx].state = SlotState::Deleted;
+		_slots[idx].key = Key();
+		_slots[idx].value = Value();
+		--_size;
+		++_deleted;
+		return true;
+	}
+	return false;
+}
+
+template <typename Key, typename Value>
+template <typename Callback>
+auto FrameCacheTable<Key, Value>::erase_if(const Callback &cb) -> void {
+	for (auto &it : _slots) {
+		if (it.state == SlotState::Used && cb(it.key, it.value)) {
+			it.state = SlotState::Deleted;
+			it.key = Key();
+			it.value = Value();
+			--_size;
+			++_deleted;
+		}
+	}
+}
+
+template <typename Key, typename Value>
+template <typename Callback>
+auto FrameCacheTable<Key, Value>::foreach(const Callback &cb) const -> void {
+	for (auto &it : _slots) {
+		if (it.state == SlotState::Used) {
+			cb(it.key, it.value);
+		}
+	}
+}
+
+template <typename Key, typename Value>
+auto FrameCacheTable<Key, Value>::clear() -> void {
+	_slots.clear();
+	_size = 0;
+	_deleted = 0;
+}
+
+template <typename Key, typename Value>
+auto FrameCacheTable<Key, Value>::lookup(const Key &key) const -> size_t {
+	if (_slots.empty()) {
+		return maxOf<size_t>();
+	}
+
+	auto mask = _slots.size() - 1;
+	auto idx = size_t(key.hash) & mask;
+	while (_slots[idx].state != SlotState::Empty) {
+		if (_slots[idx].state == SlotState::Used && _slots[idx].key == key) {
+			return idx;
+		}
+		idx = (idx + 1) & mask;
+	}
+	return maxOf<size_t>();
+}
+
+template <typename Key, typename Value>
+auto FrameCacheTable<Key, Value>::rehash(size_t capacity) -> void {
+	Vector<Slot> slots;
+	slots.resize(capacity);
+
+	auto mask = capacity - 1;
+	for (auto &it : _slots) {
+		if (it.state == SlotState::Used) {
+			auto idx = size_t(it.key.hash) & mask;
+			while (slots[idx].state != SlotState::Empty) { idx = (idx + 1) & mask; }
+			slots[idx].state = SlotState::Used;
+			slots[idx].key = move(it.key);
+			slots[idx].value = move(it.value);
+		}
+	}
+
+	_slots = move(slots);
+	_deleted = 0;
+}
+
+} // namespace stappler::xenolith::core
+
 #endif /* XENOLITH_CORE_XLCOREFRAMECACHE_H_ */
@@ -25,6 +25,7 @@
 #include "XLCoreLoop.h"
 #include "XLCoreFrameRequest.h"
 #include "XLCoreFrameQueue.h"
+#include "XLCoreTrace.h"
 
 namespace STAPPLER_VERSIONIZED stappler::xenolith::core {
 
@@ -427,6 +428,8 @@ void FrameHandle::onComplete() {
 		_timeEnd = sp::platform::clock(FrameClockType);
 		_completed = true;
 
+		Trace::addSpan(TraceCategory::Frame, "Frame", _timeStart, _timeEnd - _timeStart, _order);
+
 		HashMap<const AttachmentData *, FrameAttachmentData *> attachments;
 		for (auto &it : _queues) {
 			for (auto &iit : it->getAttachments()) {
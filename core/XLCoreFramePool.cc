@@ -0,0 +1,103 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "XLCoreFramePool.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::core {
+
+FramePoolRing::~FramePoolRing() {
+	_refs.clear();
+	for (auto &it : _pools) { memory::pool::destroy(it); }
+	_pools.clear();
+}
+
+bool FramePoolRing::init(Rc<AllocRef> &&alloc, uint32_t count) {
+	_allocator = move(alloc);
+	if (!_allocator) {
+		_allocator = Rc<AllocRef>::alloc();
+	}
+
+	_refs.reserve(count);
+	for (uint32_t i = 0; i < count; ++i) { _refs.emplace_back(Rc<PoolRef>::alloc(_allocator)); }
+	_pools.reserve(count);
+	return true;
+}
+
+Rc<PoolRef> FramePoolRing::acquireRef() {
+	std::unique_lock lock(_mutex);
+	++_stats.acquired;
+
+	// start search from next slot to give frame objects time to release previous ones
+	auto size = uint32_t(_refs.size());
+	for (uint32_t i = 0; i < size; ++i) {
+		auto idx = (_nextRef + i) % size;
+		auto &ref = _refs[idx];
+		if (ref->getReferenceCount() == 1) {
+			updateStats(ref->getPool());
+			memory::pool::clear(ref->getPool());
+			_nextRef = (idx + 1) % size;
+			return ref;
+		}
+	}
+
+	++_stats.created;
+	return _refs.emplace_back(Rc<PoolRef>::alloc(_allocator));
+}
+
+memory::pool_t *FramePoolRing::acquire() {
+	std::unique_lock lock(_mutex);
+	++_stats.acquired;
+	if (!_pools.empty()) {
+		auto pool = _pools.back();
+		_pools.pop_back();
+		return pool;
+	}
+
+	++_stats.created;
+	++_rawPools;
+	return memory::pool::create();
+}
+
+void FramePoolRing::release(memory::pool_t *pool) {
+	if (!pool) {
+		return;
+	}
+
+	std::unique_lock lock(_mutex);
+	updateStats(pool);
+	memory::pool::clear(pool);
+	_pools.emplace_back(pool);
+}
+
+FramePoolStats FramePoolRing::getStats() const {
+	std::unique_lock lock(_mutex);
+	auto ret = _stats;
+	ret.pools = uint32_t(_refs.size()) + _rawPools;
+	return ret;
+}
+
+void FramePoolRing::updateStats(memory::pool_t *pool) {
+	_stats.lastBytes = memory::pool::get_allocated_bytes(pool);
+	_stats.peakBytes = std::max(_stats.peakBytes, _stats.lastBytes);
+}
+
+} // namespace stappler::xenolith::core
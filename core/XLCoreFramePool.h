@@ -0,0 +1,78 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef XENOLITH_CORE_XLCOREFRAMEPOOL_H_
+#define XENOLITH_CORE_XLCOREFRAMEPOOL_H_
+
+#include "XLCore.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::core {
+
+struct SP_PUBLIC FramePoolStats final {
+	uint32_t pools = 0; // pools, owned by ring
+	uint64_t acquired = 0; // total acquire calls
+	uint64_t created = 0; // acquire calls, that required new pool
+	size_t lastBytes = 0; // memory, used by last released frame pool
+	size_t peakBytes = 0; // high-water mark for memory, used by single frame pool
+};
+
+/* Ring of reusable memory pools for per-frame data
+ *
+ * Pools are cleared instead of destroyed when frame is done with them, so memory blocks stay
+ * in pool's allocator and steady-state rendering does not touch system allocator. Ring is
+ * preallocated for config::FramePoolsInFlight pools and grows when more frames are in flight.
+ *
+ * PoolRef slots are returned implicitly, when ring holds the only reference; raw pools should be
+ * returned with release(). Ring is thread-safe.
+ */
+class SP_PUBLIC FramePoolRing final : public Ref {
+public:
+	virtual ~FramePoolRing();
+
+	// allocator is used for PoolRef slots, raw pools own their allocators
+	bool init(Rc<AllocRef> &&, uint32_t count = config::FramePoolsInFlight);
+
+	// Pool for frame data, that can be captured by frame objects
+	Rc<PoolRef> acquireRef();
+
+	// Pool for scratch data within single task
+	memory::pool_t *acquire();
+	void release(memory::pool_t *);
+
+	FramePoolStats getStats() const;
+
+protected:
+	void updateStats(memory::pool_t *);
+
+	Rc<AllocRef> _allocator;
+	Vector<Rc<PoolRef>> _refs;
+	Vector<memory::pool_t *> _pools; // free raw pools
+	uint32_t _nextRef = 0;
+	uint32_t _rawPools = 0;
+
+	mutable Mutex _mutex;
+	FramePoolStats _stats;
+};
+
+} // namespace stappler::xenolith::core
+
+#endif /* XENOLITH_CORE_XLCOREFRAMEPOOL_H_ */
@@ -25,7 +25,9 @@
 #include "XLCoreFrameHandle.h"
 #include "XLCoreLoop.h"
 #include "XLCoreDevice.h"
+#include "XLCoreFrameCache.h"
 #include "XLCoreQueuePass.h"
+#include "XLCoreTrace.h"
 
 #ifndef XL_FRAME_QUEUE_LOG
 #define XL_FRAME_QUEUE_LOG(...)
@@ -376,7 +378,8 @@ void FrameQueue::onAttachmentAcquire(FrameAttachmentData &attachment) {
 			if (auto spec = _frame->getImageSpecialization(img)) {
 				attachment.info = *spec;
 			}
-			attachment.image = _loop->acquireImage(img, attachment.handle.get(), attachment.info);
+			attachment.image = _loop->acquireImage(img, attachment.handle.get(), attachment.info,
+					_frame->getOrder());
 			if (!attachment.image) {
 				log::source().warn("FrameQueue", "Fail to acquire image for attachment ",
 						attachment.handle->getName());
@@ -700,6 +703,10 @@ void FrameQueue::onRenderPassResourcesAcquired(FramePassData &data) {
 		}
 	}
 
+	if (Trace::isEnabled()) {
+		data.prepareTime = sp::platform::clock(ClockType::Monotonic);
+	}
+
 	if (data.handle->prepare(*this,
 				[this, guard = Rc<FrameQueue>(this), data = &data](bool success) mutable {
 		_loop->performOnThread([this, data, success] {
@@ -725,6 +732,11 @@ void FrameQueue::onRenderPassPrepared(FramePassData &data) {
 		return;
 	}
 
+	if (data.prepareTime && Trace::isEnabled()) {
+		Trace::addSpan(TraceCategory::Pass, data.handle->getName(), data.prepareTime,
+				sp::platform::clock(ClockType::Monotonic) - data.prepareTime, _order);
+	}
+
 	updateRenderPassState(data, FrameRenderPassState::Submission);
 }
 
@@ -795,7 +807,19 @@ void FrameQueue::onRenderPassSubmitted(FramePassData &data) {
 }
 
 void FrameQueue::onRenderPassComplete(FramePassData &data) {
-	auto t = sp::platform::clock(ClockType::Monotonic) - data.submitTime;
+	auto now = sp::platform::clock(ClockType::Monotonic);
+	auto t = now - data.submitTime;
+
+	if (data.submitTime && Trace::isEnabled()) {
+		// device timestamps are not in the host clock domain, so align GPU span with completion
+		if (data.deviceTime && data.deviceTime <= t) {
+			Trace::addDeviceSpan(TraceCategory::Device, data.handle->getName(),
+					now - data.deviceTime, data.deviceTime, _order);
+		} else {
+			Trace::addDeviceSpan(TraceCategory::Device, data.handle->getName(), data.submitTime,
+					t, _order);
+		}
+	}
 
 	_submissionTime += t;
 	_deviceTime += data.deviceTime;
@@ -946,6 +970,8 @@ void FrameQueue::invalidate(FramePassData &data) {
 void FrameQueue::tryReleaseFrame() {
 	if (_finalizedObjects == _renderPasses.size() + _attachments.size()) {
 		if (_frame) {
+			// no pass is waiting for device anymore, memory of aliased attachments is free
+			_loop->getFrameCache()->releaseFrame(_queue->getName(), _order);
 			_frame = nullptr;
 		}
 	}
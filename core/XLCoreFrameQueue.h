@@ -54,6 +54,7 @@ struct SP_PUBLIC FramePassData {
 	Rc<Framebuffer> framebuffer;
 	bool waitForResult = false;
 
+	uint64_t prepareTime = 0;
 	uint64_t submitTime = 0;
 	uint64_t deviceTime = 0;
 };
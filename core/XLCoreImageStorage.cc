@@ -112,6 +112,17 @@ void ImageStorage::releaseSemaphore(Semaphore *) {
 
 }
 
+void ImageStorage::takeSemaphores(ImageStorage &other) {
+	if (&other == this) {
+		return;
+	}
+
+	_waitSem = move(other._waitSem);
+	_signalSem = move(other._signalSem);
+	other._waitSem = nullptr;
+	other._signalSem = nullptr;
+}
+
 void ImageStorage::setReady(bool value) {
 	if (_ready != value) {
 		_ready = value;
@@ -41,6 +41,9 @@ public:
 	virtual void rearmSemaphores(Loop &);
 	virtual void releaseSemaphore(Semaphore *);
 
+	// take synchronization state from the image, that shares memory with this one
+	virtual void takeSemaphores(ImageStorage &);
+
 	void invalidate();
 
 	bool isReady() const { return isStatic() || (_ready && !_invalid); }
@@ -109,6 +109,14 @@ struct PresentationOptions {
 	// Не стоит применять без выделенного или интегрированного GPU (то есть, для рендеринга на CPU)
 	bool preStartFrame = true;
 
+	// Глубина конвейера кадров: сколько кадров может одновременно находиться между обходом сцены
+	// и готовностью результата. При значении больше 1 следующий кадр запрашивается сразу после
+	// получения данных текущего, так что обход сцены для кадра N+1 выполняется параллельно
+	// с обработкой вершин и отправкой кадра N. Увеличивает задержку ввода на кадр на каждую
+	// дополнительную ступень. Ограничена числом изображений цепочки обмена, которые могут быть
+	// захвачены одновременно (imageCount - minImageCount + 1)
+	uint32_t pipelineDepth = 1;
+
 	// Использовать временное окно для презентации кадра
 	// Вместо презентации по готовности, система будет стараться удерживать целевую частоту кадров за счёт откладывания
 	// презентации до следующего окна времени
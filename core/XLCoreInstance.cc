@@ -28,6 +28,10 @@
 #include "XLVkPlatform.h"
 #endif
 
+#ifdef MODULE_XENOLITH_BACKEND_NULL
+#include "XLNullInstance.h"
+#endif
+
 namespace STAPPLER_VERSIONIZED stappler::xenolith::core {
 
 Value InstanceInfo::encode() const {
@@ -69,6 +73,15 @@ Rc<Instance> Instance::create(Rc<InstanceInfo> &&info) {
 			return createInstance(move(info));
 		}
 	}
+#endif
+#ifdef MODULE_XENOLITH_BACKEND_NULL
+	if (info->api == InstanceApi::Null) {
+		auto createInstance = SharedModule::acquireTypedSymbol<decltype(&null::createInstance)>(
+				buildconfig::MODULE_XENOLITH_BACKEND_NULL_NAME, "createInstance");
+		if (createInstance) {
+			return createInstance(move(info));
+		}
+	}
 #endif
 	return nullptr;
 }
@@ -88,6 +101,7 @@ StringView getInstanceApiName(InstanceApi backend) {
 	switch (backend) {
 	case InstanceApi::None: return "None"; break;
 	case InstanceApi::Vulkan: return "Vulkan"; break;
+	case InstanceApi::Null: return "Null"; break;
 	}
 	return StringView();
 }
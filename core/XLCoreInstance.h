@@ -38,6 +38,7 @@ static constexpr uint16_t InstanceDefaultDevice = maxOf<uint16_t>();
 enum class InstanceApi {
 	None = 0,
 	Vulkan = 1,
+	Null = 2, // headless device without GPU, see backend/null
 };
 
 enum class InstanceFlags : uint32_t {
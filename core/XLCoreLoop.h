@@ -89,8 +89,9 @@ public:
 	virtual Rc<Framebuffer> acquireFramebuffer(const PassData *, SpanView<Rc<ImageView>>) = 0;
 	virtual void releaseFramebuffer(Rc<Framebuffer> &&) = 0;
 
+	// frame is the order of the frame, that acquires image
 	virtual Rc<ImageStorage> acquireImage(const ImageAttachment *, const AttachmentHandle *,
-			const ImageInfoData &) = 0;
+			const ImageInfoData &, uint64_t frame) = 0;
 	virtual void releaseImage(Rc<ImageStorage> &&) = 0;
 
 	virtual Rc<Semaphore> makeSemaphore() = 0;
@@ -31,6 +31,85 @@
 
 namespace STAPPLER_VERSIONIZED stappler::xenolith::core {
 
+Material *MaterialTable::get(MaterialId id) const {
+	auto it = _chunks.find(id >> ChunkBits);
+	if (it != _chunks.end()) {
+		return it->second->materials[id & (ChunkSize - 1)].get();
+	}
+	return nullptr;
+}
+
+Rc<Material> MaterialTable::set(MaterialId id, Rc<Material> &&material) {
+	auto chunk = getMutableChunk(id >> ChunkBits, true);
+	auto &slot = chunk->materials[id & (ChunkSize - 1)];
+	auto ret = sp::move(slot);
+	slot = sp::move(material);
+	if (!ret) {
+		++chunk->count;
+		++_size;
+	}
+	return ret;
+}
+
+Rc<Material> MaterialTable::erase(MaterialId id) {
+	if (!get(id)) {
+		return nullptr;
+	}
+
+	auto chunkIdx = id >> ChunkBits;
+	auto chunk = getMutableChunk(chunkIdx, false);
+	auto ret = sp::move(chunk->materials[id & (ChunkSize - 1)]);
+	--_size;
+	if (--chunk->count == 0) {
+		_chunks.erase(chunkIdx);
+	}
+	return ret;
+}
+
+void MaterialTable::foreach(const Callback<void(MaterialId, NotNull<Material>)> &cb) const {
+	for (auto &it : _chunks) {
+		MaterialId id = it.first << ChunkBits;
+		for (auto &m : it.second->materials) {
+			if (m) {
+				cb(id, m.get());
+			}
+			++id;
+		}
+	}
+}
+
+auto MaterialTable::getMutableChunk(uint32_t idx, bool create) -> Chunk * {
+	auto it = _chunks.find(idx);
+	if (it == _chunks.end()) {
+		if (!create) {
+			return nullptr;
+		}
+		it = _chunks.emplace(idx, Rc<Chunk>::alloc()).first;
+	} else if (it->second->getReferenceCount() > 1) {
+		// chunk is shared with other generation, copy it before modification
+		auto chunk = Rc<Chunk>::alloc();
+		chunk->materials = it->second->materials;
+		chunk->count = it->second->count;
+		it->second = sp::move(chunk);
+		++_copiedChunks;
+	}
+	return it->second.get();
+}
+
+MaterialSet::~MaterialSet() {
+	// descriptor sets, that was not shared with the next generation, can be reused
+	auto layout = _owner ? _owner->getTargetLayout() : nullptr;
+	if (layout && layout->layout) {
+		for (auto &it : _layouts) {
+			// layout, shared with other generation, still owns its set
+			if (it->getReferenceCount() == 1 && it->layout.set
+					&& it->layout.set->getReferenceCount() == 1) {
+				layout->layout->releaseSet(move(it->layout.set));
+			}
+		}
+	}
+}
+
 bool MaterialSet::init(uint32_t imagesInSet, const MaterialAttachment *owner) {
 	_imagesInSet = imagesInSet;
 	_owner = owner;
@@ -38,15 +117,19 @@ bool MaterialSet::init(uint32_t imagesInSet, const MaterialAttachment *owner) {
 }
 
 bool MaterialSet::init(const Rc<MaterialSet> &other) {
+	auto t = sp::platform::clock(ClockType::Monotonic);
+
 	_generation = other->_generation + 1;
 	_materials = other->_materials;
+	_materials.resetCopiedChunks();
 	_imagesInSet = other->_imagesInSet;
-	_layouts = other->_layouts;
 	_owner = other->_owner;
 	_updatedMaterials = other->_updatedMaterials;
 
-	for (auto &it : _layouts) { it.set = nullptr; }
+	// layouts and its descriptor sets are shared with previous generation until modified
+	_layouts = other->_layouts;
 
+	_stats.cloneTime = sp::platform::clock(ClockType::Monotonic) - t;
 	return true;
 }
 
@@ -59,22 +142,22 @@ Vector<Rc<Material>> MaterialSet::updateMaterials(const Rc<MaterialInputData> &d
 Vector<Rc<Material>> MaterialSet::updateMaterials(SpanView<Rc<Material>> materials,
 		SpanView<MaterialId> dynamicMaterials, SpanView<MaterialId> materialsToRemove,
 		const Callback<Rc<ImageView>(const MaterialImage &)> &cb) {
+	auto t = sp::platform::clock(ClockType::Monotonic);
+
 	Vector<MaterialId> updatedIds;
 	updatedIds.reserve(materials.size() + dynamicMaterials.size());
 	Vector<Rc<Material>> ret;
 	ret.reserve(materials.size());
 
 	for (auto &it : materialsToRemove) {
-		auto mIt = _materials.find(it);
-		if (mIt != _materials.end()) {
-			ret.emplace_back(mIt->second);
-			removeMaterial(mIt->second);
-			for (auto &it : mIt->second->getImages()) {
+		if (auto material = _materials.erase(it)) {
+			removeMaterial(material);
+			for (auto &it : material->getImages()) {
 				if (it.dynamic && _owner) {
-					_owner->removeDynamicTracker(mIt->second->getId(), it.dynamic->image);
+					_owner->removeDynamicTracker(material->getId(), it.dynamic->image);
 				}
 			}
-			_materials.erase(mIt);
+			ret.emplace_back(sp::move(material));
 		}
 	}
 
@@ -115,20 +198,19 @@ Vector<Rc<Material>> MaterialSet::updateMaterials(SpanView<Rc<Material>> materia
 
 		updatedIds.emplace_back(material->getId());
 
-		auto mIt = _materials.find(material->getId());
-		if (mIt != _materials.end()) {
-			emplaceMaterialImages(mIt->second, material.get(), cb);
-			mIt->second = move(material);
-			ret.emplace_back(mIt->second.get());
-			for (auto &it : mIt->second->getImages()) {
+		if (auto prev = _materials.get(material->getId())) {
+			emplaceMaterialImages(prev, material.get(), cb);
+			_materials.set(material->getId(), Rc<Material>(material));
+			ret.emplace_back(material);
+			for (auto &it : material->getImages()) {
 				if (it.dynamic && _owner) {
 					_owner->removeDynamicTracker(material->getId(), it.dynamic->image);
 				}
 			}
 		} else {
-			auto it = _materials.emplace(material->getId(), move(material)).first;
-			emplaceMaterialImages(nullptr, it->second.get(), cb);
-			ret.emplace_back(it->second.get());
+			_materials.set(material->getId(), Rc<Material>(material));
+			emplaceMaterialImages(nullptr, material.get(), cb);
+			ret.emplace_back(material);
 		}
 	}
 
@@ -140,14 +222,12 @@ Vector<Rc<Material>> MaterialSet::updateMaterials(SpanView<Rc<Material>> materia
 			}
 		}
 
-		auto mIt = _materials.find(it);
-		if (mIt != _materials.end()) {
-			auto &material = mIt->second;
+		if (auto material = _materials.get(it)) {
 			bool hasUpdates = false;
 			Vector<Rc<DynamicImageInstance>> dynamics;
-			dynamics.reserve(mIt->second->getImages().size());
+			dynamics.reserve(material->getImages().size());
 
-			for (auto &image : mIt->second->getImages()) {
+			for (auto &image : material->getImages()) {
 				if (image.dynamic) {
 					auto current = image.dynamic->image->getInstance();
 					if (current != image.dynamic) {
@@ -182,12 +262,13 @@ Vector<Rc<Material>> MaterialSet::updateMaterials(SpanView<Rc<Material>> materia
 					}
 				}
 
-				emplaceMaterialImages(mIt->second, mat.get(), cb);
-				mIt->second = sp::move(mat);
-				ret.emplace_back(mIt->second.get());
-				for (auto &it : mIt->second->getImages()) {
+				emplaceMaterialImages(material, mat.get(), cb);
+
+				_materials.set(it, Rc<Material>(mat));
+				ret.emplace_back(mat);
+				for (auto &it : mat->getImages()) {
 					if (it.dynamic && _owner) {
-						_owner->removeDynamicTracker(material->getId(), it.dynamic->image);
+						_owner->removeDynamicTracker(mat->getId(), it.dynamic->image);
 					}
 				}
 			}
@@ -196,23 +277,24 @@ Vector<Rc<Material>> MaterialSet::updateMaterials(SpanView<Rc<Material>> materia
 
 	for (auto &it : ret) { emplace_ordered(_updatedMaterials, it->getId()); }
 
+	_stats.updateTime = sp::platform::clock(ClockType::Monotonic) - t;
+	_stats.materials = uint32_t(_materials.size());
+	_stats.updated = uint32_t(ret.size());
+	_stats.copiedChunks = _materials.getCopiedChunks();
+	_stats.layouts = uint32_t(_layouts.size());
+	_stats.dirtyLayouts = uint32_t(_dirtyLayouts.size());
+
 	return ret;
 }
 
 const MaterialLayout *MaterialSet::getLayout(uint32_t idx) const {
 	if (idx < _layouts.size()) {
-		return &_layouts[idx];
+		return &_layouts[idx]->layout;
 	}
 	return nullptr;
 }
 
-const Material *MaterialSet::getMaterialById(MaterialId idx) const {
-	auto it = _materials.find(idx);
-	if (it != _materials.end()) {
-		return it->second.get();
-	}
-	return nullptr;
-}
+const Material *MaterialSet::getMaterialById(MaterialId idx) const { return _materials.get(idx); }
 
 const TextureSetLayoutData *MaterialSet::getTargetLayout() const {
 	return _owner->getTargetLayout();
@@ -221,9 +303,8 @@ const TextureSetLayoutData *MaterialSet::getTargetLayout() const {
 void MaterialSet::foreachUpdated(const Callback<void(MaterialId, NotNull<Material>)> &cb,
 		bool clear) {
 	for (auto &it : _updatedMaterials) {
-		auto mIt = _materials.find(it);
-		if (mIt != _materials.end()) {
-			cb(mIt->first, mIt->second.get());
+		if (auto m = _materials.get(it)) {
+			cb(it, m);
 		}
 	}
 	if (clear) {
@@ -231,12 +312,42 @@ void MaterialSet::foreachUpdated(const Callback<void(MaterialId, NotNull<Materia
 	}
 }
 
+void MaterialSet::foreachDirtyLayout(const Callback<void(uint32_t, MaterialLayout &)> &cb) {
+	// dirty layouts are always owned by this generation, see setLayoutDirty
+	for (auto &it : _dirtyLayouts) { cb(it, _layouts[it]->layout); }
+}
+
+void MaterialSet::foreachLayout(
+		const Callback<void(uint32_t, const MaterialLayout &)> &cb) const {
+	uint32_t idx = 0;
+	for (auto &it : _layouts) { cb(idx++, it->layout); }
+}
+
+MaterialLayout &MaterialSet::getMutableLayout(uint32_t idx) {
+	auto &entry = _layouts[idx];
+	if (entry->getReferenceCount() > 1) {
+		// layout is shared with other generation, copy it before modification
+		auto layout = Rc<LayoutEntry>::alloc();
+		layout->layout = entry->layout;
+		entry = sp::move(layout);
+		++_stats.copiedLayouts;
+	}
+	return entry->layout;
+}
+
+void MaterialSet::setLayoutDirty(uint32_t idx) {
+	// new descriptor set will be written into layout, so it can not be shared
+	getMutableLayout(idx);
+	emplace_ordered(_dirtyLayouts, idx);
+}
+
 void MaterialSet::removeMaterial(Material *oldMaterial) {
-	auto &oldSet = _layouts[oldMaterial->getLayoutIndex()];
+	auto &oldSet = getMutableLayout(oldMaterial->getLayoutIndex());
 	for (auto &oIt : oldMaterial->_images) {
 		--oldSet.imageSlots[oIt.descriptor].refCount;
 		if (oldSet.imageSlots[oIt.descriptor].refCount == 0) {
 			oldSet.imageSlots[oIt.descriptor].image = nullptr;
+			setLayoutDirty(oldMaterial->getLayoutIndex());
 		}
 		oIt.view = nullptr;
 	}
@@ -253,7 +364,6 @@ void MaterialSet::emplaceMaterialImages(Material *oldMaterial, Material *newMate
 
 	auto &newImages = newMaterial->_images;
 	if (oldImages) {
-		auto &oldSet = _layouts[targetSet];
 		// remove non-aliased images
 		for (auto &oIt : *oldImages) {
 			bool hasAlias = false;
@@ -264,9 +374,11 @@ void MaterialSet::emplaceMaterialImages(Material *oldMaterial, Material *newMate
 				}
 			}
 			if (!hasAlias) {
-				--oldSet.imageSlots[oIt.descriptor].refCount;
-				if (oldSet.imageSlots[oIt.descriptor].refCount == 0) {
-					oldSet.imageSlots[oIt.descriptor].image = nullptr;
+				auto &slot = getMutableLayout(targetSet).imageSlots[oIt.descriptor];
+				--slot.refCount;
+				if (slot.refCount == 0) {
+					slot.image = nullptr;
+					setLayoutDirty(targetSet);
 				}
 				oIt.view = nullptr;
 			}
@@ -293,8 +405,8 @@ void MaterialSet::emplaceMaterialImages(Material *oldMaterial, Material *newMate
 		++imageIdx;
 	}
 
-	auto emplaceMaterial = [&, this](uint32_t setIdx, MaterialLayout &set,
-								   Vector<uint32_t> &imageLocations) {
+	auto emplaceMaterial = [&, this](uint32_t setIdx, Vector<uint32_t> &imageLocations) {
+		auto &set = getMutableLayout(setIdx);
 		if (imageLocations.empty()) {
 			for (uint32_t imageIdx = 0; imageIdx < uniqueImages.size(); ++imageIdx) {
 				imageLocations.emplace_back(imageIdx);
@@ -313,6 +425,7 @@ void MaterialSet::emplaceMaterialImages(Material *oldMaterial, Material *newMate
 				set.imageSlots[loc].image->setLocation(setIdx, loc);
 				set.imageSlots[loc].refCount = uint32_t(it.second.size());
 				set.usedImageSlots = std::max(set.usedImageSlots, loc + 1);
+				setLayoutDirty(setIdx);
 			}
 
 			// fill refs
@@ -328,13 +441,14 @@ void MaterialSet::emplaceMaterialImages(Material *oldMaterial, Material *newMate
 		newMaterial->setLayoutIndex(setIdx);
 
 		if (oldImages) {
-			auto &oldSet = _layouts[targetSet];
 			// remove non-aliased images
 			for (auto &oIt : *oldImages) {
 				if (oIt.view) {
-					--oldSet.imageSlots[oIt.descriptor].refCount;
-					if (oldSet.imageSlots[oIt.descriptor].refCount == 0) {
-						oldSet.imageSlots[oIt.descriptor].image = nullptr;
+					auto &slot = getMutableLayout(targetSet).imageSlots[oIt.descriptor];
+					--slot.refCount;
+					if (slot.refCount == 0) {
+						slot.image = nullptr;
+						setLayoutDirty(targetSet);
 					}
 					oIt.view = nullptr;
 				}
@@ -342,7 +456,8 @@ void MaterialSet::emplaceMaterialImages(Material *oldMaterial, Material *newMate
 		}
 	};
 
-	auto tryToEmplaceSet = [&](uint32_t setIndex, MaterialLayout &set) -> bool {
+	auto tryToEmplaceSet = [&](uint32_t setIndex) -> bool {
+		auto &set = _layouts[setIndex]->layout;
 		uint32_t emplacedImages = 0;
 		Vector<uint32_t> imagePositions;
 		imagePositions.resize(uniqueImages.size(), maxOf<uint32_t>());
@@ -382,39 +497,35 @@ void MaterialSet::emplaceMaterialImages(Material *oldMaterial, Material *newMate
 
 		// if all images emplaced, perform actual emplace and return
 		if (emplacedImages == uniqueImages.size()) {
-			emplaceMaterial(setIndex, set, imagePositions);
+			emplaceMaterial(setIndex, imagePositions);
 			return true;
 		}
 		return false;
 	};
 
 	if (targetSet != maxOf<uint32_t>()) {
-		if (tryToEmplaceSet(targetSet, _layouts[targetSet])) {
+		if (tryToEmplaceSet(targetSet)) {
 			return;
 		}
 	}
 
-	// process existed sets
-	uint32_t setIndex = 0;
-	for (auto &set : _layouts) {
+	// process existed sets, search is read-only, only target layout will be copied
+	for (uint32_t setIndex = 0; setIndex < _layouts.size(); ++setIndex) {
 		if (setIndex == targetSet) {
 			continue;
 		}
 
-		if (tryToEmplaceSet(setIndex, set)) {
+		if (tryToEmplaceSet(setIndex)) {
 			return;
 		}
-
-		// or continue to search for appropriate set
-		++setIndex;
 	}
 
 	// no available set, create new one;
-	auto &nIt = _layouts.emplace_back(MaterialLayout());
-	nIt.imageSlots.resize(_imagesInSet);
+	auto &nIt = _layouts.emplace_back(Rc<LayoutEntry>::alloc());
+	nIt->layout.imageSlots.resize(_imagesInSet);
 
 	Vector<uint32_t> imageLocations;
-	emplaceMaterial(uint32_t(_layouts.size() - 1), nIt, imageLocations);
+	emplaceMaterial(uint32_t(_layouts.size() - 1), imageLocations);
 }
 
 bool MaterialImage::canAlias(const MaterialImage &other) const {
@@ -488,6 +599,7 @@ bool Material::init(MaterialId id, const PipelineData *pipeline, const ImageData
 bool Material::init(const Material *master, Rc<ImageObject> &&image, Rc<DataAtlas> &&atlas,
 		Rc<Ref> &&data) {
 	_id = master->getId();
+	_flags = master->getFlags();
 	_pipeline = master->getPipeline();
 
 	auto otherData = master->getOwnedData();
@@ -511,6 +623,7 @@ bool Material::init(const Material *master, Rc<ImageObject> &&image, Rc<DataAtla
 
 bool Material::init(const Material *master, Vector<MaterialImage> &&images) {
 	_id = master->getId();
+	_flags = master->getFlags();
 	_pipeline = master->getPipeline();
 	_images = sp::move(images);
 	for (auto &it : _images) {
@@ -609,10 +722,13 @@ void MaterialAttachment::removeDynamicTracker(MaterialId id, const Rc<DynamicIma
 	}
 }
 
-void MaterialAttachment::updateDynamicImage(Loop &loop, const DynamicImage *image,
+void MaterialAttachment::updateDynamicImage(Loop &loop, const DynamicImage *image, uint32_t gen,
 		const Vector<Rc<DependencyEvent>> &deps) const {
 	auto input = Rc<MaterialInputData>::alloc();
 	input->attachment = this;
+	input->callback = [image = Rc<DynamicImage>(const_cast<DynamicImage *>(image)), gen] {
+		image->setCompiledGeneration(gen);
+	};
 	std::unique_lock<Mutex> lock(_dynamicMutex);
 	auto it = _dynamicTrackers.find(image);
 	if (it != _dynamicTrackers.end()) {
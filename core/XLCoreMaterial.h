@@ -38,6 +38,19 @@ class MaterialAttachment;
 
 using MaterialId = uint32_t;
 
+enum class MaterialFlags : uint32_t {
+	None = 0,
+
+	// Material vertexes are written in compact layout: 2d position, packed color and UV;
+	// support depends on backend and pipeline
+	CompactVertexes = 1 << 0,
+
+	// Texture contains signed distance field (edge at 0.5) instead of coverage
+	DistanceField = 1 << 1,
+};
+
+SP_DEFINE_ENUM_AS_MASK(MaterialFlags);
+
 struct SP_PUBLIC MaterialInputData : AttachmentInputData {
 	const MaterialAttachment *attachment;
 	Vector<Rc<Material>> materialsToAddOrUpdate;
@@ -58,11 +71,66 @@ struct SP_PUBLIC MaterialImage {
 	bool canAlias(const MaterialImage &) const;
 };
 
+/* Persistent table of materials
+ *
+ * Materials are stored in fixed-size chunks by id. Copy of the table shares all chunks with
+ * origin, chunk is copied only on first modification, if it's still used by other generation.
+ */
+class SP_PUBLIC MaterialTable {
+public:
+	static constexpr uint32_t ChunkBits = 6;
+	static constexpr uint32_t ChunkSize = 1 << ChunkBits;
+
+	struct Chunk : Ref {
+		std::array<Rc<Material>, ChunkSize> materials;
+		uint32_t count = 0;
+	};
+
+	size_t size() const { return _size; }
+	bool empty() const { return _size == 0; }
+
+	Material *get(MaterialId) const;
+
+	// returns material, that was replaced
+	Rc<Material> set(MaterialId, Rc<Material> &&);
+	Rc<Material> erase(MaterialId);
+
+	void foreach(const Callback<void(MaterialId, NotNull<Material>)> &) const;
+
+	// number of chunks, copied from other generations since last reset
+	uint32_t getCopiedChunks() const { return _copiedChunks; }
+	void resetCopiedChunks() { _copiedChunks = 0; }
+
+protected:
+	Chunk *getMutableChunk(uint32_t, bool create);
+
+	Map<uint32_t, Rc<Chunk>> _chunks;
+	size_t _size = 0;
+	uint32_t _copiedChunks = 0;
+};
+
+struct SP_PUBLIC MaterialSetStats {
+	uint64_t cloneTime = 0; // time to create generation from previous one (microseconds)
+	uint64_t updateTime = 0; // time, spent in updateMaterials (microseconds)
+	uint32_t materials = 0;
+	uint32_t updated = 0; // materials, that was added, updated or removed
+	uint32_t copiedChunks = 0; // material table chunks, copied from previous generation
+	uint32_t layouts = 0;
+	uint32_t copiedLayouts = 0; // layouts, copied from previous generation
+	uint32_t dirtyLayouts = 0; // layouts, that requires new descriptor set
+};
+
 class SP_PUBLIC MaterialSet final : public Ref {
 public:
 	using ImageSlot = MaterialImageSlot;
 
-	virtual ~MaterialSet() = default;
+	// Layouts are shared with previous generation the same way as material table chunks;
+	// layout is copied only on first modification, if it's still used by other generation
+	struct LayoutEntry : Ref {
+		MaterialLayout layout;
+	};
+
+	virtual ~MaterialSet();
 
 	bool init(uint32_t imagesInSet, const MaterialAttachment * = nullptr);
 	bool init(const Rc<MaterialSet> &);
@@ -75,11 +143,11 @@ public:
 
 	uint32_t getImagesInSet() const { return _imagesInSet; }
 	uint64_t getGeneration() const { return _generation; }
-	const HashMap<MaterialId, Rc<Material>> &getMaterials() const { return _materials; }
+	const MaterialTable &getMaterials() const { return _materials; }
 
 	const MaterialAttachment *getOwner() const { return _owner; }
 
-	Vector<MaterialLayout> &getLayouts() { return _layouts; }
+	uint32_t getLayoutsCount() const { return uint32_t(_layouts.size()); }
 	const MaterialLayout *getLayout(uint32_t) const;
 	const Material *getMaterialById(MaterialId) const;
 
@@ -87,7 +155,17 @@ public:
 
 	void foreachUpdated(const Callback<void(MaterialId, NotNull<Material>)> &, bool clear);
 
+	// Layouts, that was changed within this generation; other layouts share descriptor sets
+	// with previous generation
+	void foreachDirtyLayout(const Callback<void(uint32_t, MaterialLayout &)> &);
+
+	void foreachLayout(const Callback<void(uint32_t, const MaterialLayout &)> &) const;
+
+	const MaterialSetStats &getStats() const { return _stats; }
+
 protected:
+	MaterialLayout &getMutableLayout(uint32_t);
+	void setLayoutDirty(uint32_t);
 	void removeMaterial(Material *oldMaterial);
 	void emplaceMaterialImages(Material *oldMaterial, Material *newMaterial,
 			const Callback<Rc<ImageView>(const MaterialImage &)> &);
@@ -95,13 +173,15 @@ protected:
 	uint32_t _imagesInSet = 16;
 
 	uint32_t _generation = 1;
-	HashMap<MaterialId, Rc<Material>> _materials;
+	MaterialTable _materials;
 
 	// describes image location in descriptor sets
 	// all images from same material must be in one set
-	Vector<MaterialLayout> _layouts;
+	Vector<Rc<LayoutEntry>> _layouts;
 	const MaterialAttachment *_owner = nullptr;
 	Vector<MaterialId> _updatedMaterials;
+	Vector<uint32_t> _dirtyLayouts;
+	MaterialSetStats _stats;
 };
 
 class SP_PUBLIC Material final : public Ref {
@@ -130,6 +210,10 @@ public:
 
 	uint32_t getLayoutIndex() const { return _layoutIndex; }
 
+	// flags should be set before material is added into set
+	void setFlags(MaterialFlags flags) { _flags = flags; }
+	MaterialFlags getFlags() const { return _flags; }
+
 	DataAtlas *getAtlas() const { return _atlas; }
 	BufferObject *getBuffer() const { return _buffer; }
 
@@ -145,6 +229,7 @@ protected:
 	bool _dirty = true;
 	MaterialId _id = 0;
 	uint32_t _layoutIndex = 0; // set after compilation
+	MaterialFlags _flags = MaterialFlags::None;
 	const PipelineData *_pipeline;
 	Vector<MaterialImage> _images;
 	Rc<DataAtlas> _atlas;
@@ -179,7 +264,7 @@ public:
 	virtual void addDynamicTracker(MaterialId, const Rc<DynamicImage> &) const;
 	virtual void removeDynamicTracker(MaterialId, const Rc<DynamicImage> &) const;
 
-	virtual void updateDynamicImage(Loop &, const DynamicImage *,
+	virtual void updateDynamicImage(Loop &, const DynamicImage *, uint32_t gen,
 			const Vector<Rc<DependencyEvent>> & = Vector<Rc<DependencyEvent>>()) const;
 
 	MaterialId getNextMaterialId() const;
@@ -83,7 +83,7 @@ bool PresentationEngine::waitUntilFramePresentation() {
 
 void PresentationEngine::scheduleNextImage(Function<void(PresentationFrame *, bool)> &&cb,
 		PresentationFrame::Flags frameFlags) {
-	if (!_activeFrames.empty() || !_swapchain || _swapchain->isDeprecated()) {
+	if (!hasFrameSlot() || !_swapchain || _swapchain->isDeprecated()) {
 		return;
 	}
 
@@ -155,6 +155,12 @@ bool PresentationEngine::scheduleSwapchainImage(Rc<PresentationFrame> &&frame) {
 
 				_window->setFrameOrder(nextFrame->getOrder());
 			}
+
+			if (getPipelineDepth() > 1 && canScheduleNextFrame()) {
+				// frame data was acquired, start next frame, while this one is processed
+				XL_COREPRESENT_LOG("scheduleSwapchainImage - pipelined scheduleNextImage");
+				scheduleNextImage();
+			}
 		} else {
 			log::source().error("core::PresentationEngine",
 					"acquireFrameData - Swapchain was invalidated");
@@ -480,6 +486,17 @@ void PresentationEngine::setRenderOnDemand(bool value) { _options.renderOnDemand
 
 bool PresentationEngine::isRenderOnDemand() const { return _options.renderOnDemand; }
 
+void PresentationEngine::setPipelineDepth(uint32_t value) { _options.pipelineDepth = value; }
+
+uint32_t PresentationEngine::getPipelineDepth() const {
+	auto depth = std::max(_options.pipelineDepth, uint32_t(1));
+	if (_swapchain) {
+		// every active frame can hold an acquired swapchain image
+		depth = std::min(depth, _swapchain->getAcquirableImagesCount());
+	}
+	return depth;
+}
+
 bool PresentationEngine::isRunning() const {
 	return _running && _swapchain && !_swapchain->isDeprecated();
 }
@@ -789,7 +806,25 @@ void PresentationEngine::presentSwapchainImage(Rc<DeviceQueue> &&queue,
 }
 
 bool PresentationEngine::canScheduleNextFrame() const {
-	return (!_options.renderOnDemand || _readyForNextFrame) && _swapchain && _activeFrames.empty();
+	return (!_options.renderOnDemand || _readyForNextFrame) && _swapchain && hasFrameSlot();
+}
+
+bool PresentationEngine::hasFrameSlot() const {
+	if (_activeFrames.empty()) {
+		return true;
+	}
+
+	if (_activeFrames.size() >= getPipelineDepth()) {
+		return false;
+	}
+
+	// frames should acquire their data in order, so, all active frames should already have it
+	for (auto &it : _activeFrames) {
+		if (!it->hasFlag(PresentationFrame::InputAcquired)) {
+			return false;
+		}
+	}
+	return true;
 }
 
 } // namespace stappler::xenolith::core
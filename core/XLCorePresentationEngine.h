@@ -155,6 +155,11 @@ public:
 	void setRenderOnDemand(bool value);
 	bool isRenderOnDemand() const;
 
+	void setPipelineDepth(uint32_t);
+
+	// Effective pipeline depth, limited by number of swapchain images, that can be acquired
+	uint32_t getPipelineDepth() const;
+
 	bool isRunning() const;
 
 	void enableExclusiveFullscreen();
@@ -199,6 +204,9 @@ protected:
 
 	bool canScheduleNextFrame() const;
 
+	// Checks if pipeline has a free slot for a new frame (see PresentationOptions::pipelineDepth)
+	bool hasFrameSlot() const;
+
 	PresentationOptions _options;
 	FrameConstraints _constraints;
 
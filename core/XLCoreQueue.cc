@@ -508,6 +508,177 @@ static void Queue_buildRequirements(QueueData *data, Device &dev) {
 	}
 }
 
+static bool Queue_isAliasingCandidate(const AttachmentData *attachment) {
+	if (attachment->type != AttachmentType::Image || attachment->usage != AttachmentUsage::None
+			|| attachment->passes.empty()) {
+		return false;
+	}
+
+	auto img = (const ImageAttachment *)attachment->attachment.get();
+	if (img->isStatic()
+			|| (img->getImageInfo().hints & ImageHints::DoNotCache) != ImageHints::None) {
+		return false;
+	}
+
+	// image contents should not be preserved between frames
+	if (img->getInitialLayout() != AttachmentLayout::Ignored
+			&& img->getInitialLayout() != AttachmentLayout::Undefined) {
+		return false;
+	}
+
+	auto first = attachment->passes.front();
+	if (first->loadOp == AttachmentLoadOp::Load || first->stencilLoadOp == AttachmentLoadOp::Load) {
+		return false;
+	}
+
+	// subpass dependencies order only work on the same device queue,
+	// so all passes, that use aliased attachment, should have the same type
+	for (auto &it : attachment->passes) {
+		if (it->pass->type != first->pass->type) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// Returns true if resources of attachment, last used in `source` pass, will be released
+// before `target` pass acquires resources for its attachments
+static bool Queue_isReleasedBefore(const AttachmentData *attachment, const QueuePassData *source,
+		const QueuePassData *target) {
+	auto releaseState = attachment->passes.back()->dependency.requiredRenderPassState;
+	if (releaseState == FrameRenderPassState::Initial) {
+		releaseState = FrameRenderPassState::Submitted;
+	}
+
+	memory::set<const QueuePassData *> visited;
+	memory::vector<const QueuePassData *> stack{target};
+
+	while (!stack.empty()) {
+		auto pass = stack.back();
+		stack.pop_back();
+
+		for (auto &it : pass->required) {
+			// requirement should block pass before resources acquisition
+			if (toInt(it.lockedState) > toInt(FrameRenderPassState::Ready)) {
+				continue;
+			}
+
+			if (it.data == source && toInt(it.requiredState) >= toInt(releaseState)) {
+				return true;
+			}
+
+			if (toInt(it.requiredState) >= toInt(FrameRenderPassState::Ready)
+					&& visited.emplace(it.data).second) {
+				stack.emplace_back(it.data);
+			}
+		}
+	}
+	return false;
+}
+
+static void Queue_buildAliasing(QueueData *data, Device &dev) {
+	if constexpr (!config::EnableAttachmentAliasing) {
+		return;
+	}
+
+	memory::vector<AttachmentData *> candidates;
+	for (auto &it : data->attachments) {
+		if (Queue_isAliasingCandidate(it)) {
+			candidates.emplace_back(it);
+		}
+	}
+
+	if (candidates.size() < 2) {
+		return;
+	}
+
+	std::sort(candidates.begin(), candidates.end(),
+			[](const AttachmentData *l, const AttachmentData *r) {
+		return l->passes.front()->pass->ordering < r->passes.front()->pass->ordering;
+	});
+
+	auto isDisjoint = [](const AttachmentData *l, const AttachmentData *r) {
+		if (l->passes.front()->pass->type != r->passes.front()->pass->type) {
+			return false;
+		}
+		return Queue_isReleasedBefore(l, l->passes.back()->pass, r->passes.front()->pass)
+				|| Queue_isReleasedBefore(r, r->passes.back()->pass, l->passes.front()->pass);
+	};
+
+	// greedy coloring: attachment joins first group, where all lifetimes are disjoint with its own
+	memory::vector<AttachmentAliasingData *> groups;
+	for (auto &it : candidates) {
+		AttachmentAliasingData *target = nullptr;
+		for (auto &group : groups) {
+			bool disjoint = true;
+			for (auto &a : group->attachments) {
+				if (!isDisjoint(a, it)) {
+					disjoint = false;
+					break;
+				}
+			}
+			if (disjoint) {
+				target = group;
+				break;
+			}
+		}
+
+		if (!target) {
+			target = new (data->pool) AttachmentAliasingData;
+			target->queue = data;
+			groups.emplace_back(target);
+		}
+
+		target->attachments.emplace_back(it);
+	}
+
+	for (auto &group : groups) {
+		if (group->attachments.size() < 2) {
+			continue;
+		}
+
+		group->index = uint32_t(data->aliasing.size());
+		for (auto &a : group->attachments) {
+			const_cast<AttachmentData *>(a)->aliasing = group;
+		}
+		data->aliasing.emplace_back(group);
+
+		// first usage of aliased image should wait for previous writes into shared memory
+		for (auto &a : group->attachments) {
+			auto first = a->passes.front();
+			if (first->subpasses.empty()) {
+				continue;
+			}
+
+			auto srcStage = PipelineStage::None;
+			auto srcAccess = AccessType::None;
+			for (auto &other : group->attachments) {
+				if (other != a) {
+					srcStage |= other->passes.back()->dependency.finalUsageStage;
+					srcAccess |= other->passes.back()->dependency.finalAccessMask;
+				}
+			}
+
+			if (srcStage == PipelineStage::None) {
+				srcStage = PipelineStage::AllCommands;
+				srcAccess = AccessType::MemoryWrite;
+			}
+
+			auto dstStage = first->dependency.initialUsageStage;
+			auto dstAccess = first->dependency.initialAccessMask;
+			if (dstStage == PipelineStage::None) {
+				dstStage = PipelineStage::AllCommands;
+			}
+
+			const_cast<QueuePassData *>(first->pass)
+					->dependencies.emplace_back(SubpassDependency{SubpassDependency::External,
+						srcStage, srcAccess, first->subpasses.front()->subpass->index, dstStage,
+						dstAccess, false});
+		}
+	}
+}
+
 static void Queue_updateLayout(AttachmentSubpassData *attachemnt, Device &dev) {
 	if (attachemnt->pass->attachment->type != AttachmentType::Image) {
 		return;
@@ -836,6 +1007,10 @@ const memory::vector<AttachmentData *> &Queue::getOutputAttachments() const {
 	return _data->output;
 }
 
+const memory::vector<AttachmentAliasingData *> &Queue::getAttachmentAliasing() const {
+	return _data->aliasing;
+}
+
 const Attachment *Queue::getInputAttachment(std::type_index name) const {
 	auto it = _data->typedInput.find(name);
 	if (it != _data->typedInput.end()) {
@@ -961,6 +1136,7 @@ bool Queue::prepare(Device &dev) {
 	for (auto &it : _data->passes) { it->pass->prepare(dev); }
 
 	Queue_buildRequirements(_data, dev);
+	Queue_buildAliasing(_data, dev);
 
 	return true;
 }
@@ -1013,6 +1189,14 @@ void Queue::describe(const Callback<void(StringView)> &out) {
 			}
 		}
 	}
+	if (!_data->aliasing.empty()) {
+		out << "Aliasing:\n";
+		for (auto &it : _data->aliasing) {
+			out << "\t[" << it->index << "]:";
+			for (auto &a : it->attachments) { out << " " << a->key; }
+			out << "\n";
+		}
+	}
 	out << "Passes:\n";
 	for (auto &it : _data->passes) {
 		auto passPtr = it->pass.get();
@@ -84,6 +84,9 @@ public:
 	const memory::vector<AttachmentData *> &getInputAttachments() const;
 	const memory::vector<AttachmentData *> &getOutputAttachments() const;
 
+	// groups of attachments, that can share device memory within frame
+	const memory::vector<AttachmentAliasingData *> &getAttachmentAliasing() const;
+
 	template <typename T>
 	auto getInputAttachment() const -> const T *;
 
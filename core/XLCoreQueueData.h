@@ -64,6 +64,7 @@ struct QueueData;
 struct PipelineFamilyInfo;
 
 struct AttachmentInputData;
+struct AttachmentAliasingData;
 
 struct FramePassData;
 struct FrameAttachmentData;
@@ -307,6 +308,17 @@ struct SP_PUBLIC AttachmentData : NamedMem {
 
 	Rc<Attachment> attachment;
 	bool transient = false;
+
+	// group of attachments, that can share device memory with this one (or nullptr)
+	const AttachmentAliasingData *aliasing = nullptr;
+};
+
+// Image attachments with non-overlapping lifetimes within a frame
+// Images for this attachments can be bound to the same device memory (see FrameCache)
+struct SP_PUBLIC AttachmentAliasingData {
+	const QueueData *queue = nullptr;
+	uint32_t index = 0;
+	memory::vector<const AttachmentData *> attachments;
 };
 
 struct SP_PUBLIC DescriptorSetData : NamedMem {
@@ -441,6 +453,7 @@ struct SP_PUBLIC QueueData : NamedMem {
 	memory::map<std::type_index, Attachment *> typedOutput;
 
 	memory::vector<QueuePassDependency> passDependencies;
+	memory::vector<AttachmentAliasingData *> aliasing;
 
 	const ImageData *emptyImage = nullptr;
 	const ImageData *solidImage = nullptr;
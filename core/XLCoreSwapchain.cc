@@ -66,12 +66,76 @@ bool Swapchain::isOptimal() const { return _presentMode == _config.presentMode;
 
 bool Swapchain::isValid() const { return !_invalid; }
 
+uint32_t Swapchain::getAcquirableImagesCount() const {
+	// presentation engine keeps minImageCount - 1 images, see vkAcquireNextImageKHR
+	if (_config.imageCount < _surfaceInfo.minImageCount) {
+		return 1;
+	}
+	return _config.imageCount - _surfaceInfo.minImageCount + 1;
+}
+
 bool Swapchain::deprecate() {
 	auto tmp = _deprecated;
 	_deprecated = true;
 	return !tmp;
 }
 
+static URect unionRect(const URect &a, const URect &b) {
+	if (a.width == 0 || a.height == 0) {
+		return b;
+	} else if (b.width == 0 || b.height == 0) {
+		return a;
+	}
+
+	auto x = std::min(a.x, b.x);
+	auto y = std::min(a.y, b.y);
+	return URect{x, y, std::max(a.x + a.width, b.x + b.width) - x,
+		std::max(a.y + a.height, b.y + b.height) - y};
+}
+
+bool Swapchain::updateImageDamage(uint32_t imageIndex, uint64_t frameOrder, const URect &damage,
+		URect &target) {
+	std::unique_lock<Mutex> lock(_damageMutex);
+
+	_damageHistory.insert_or_assign(frameOrder, damage);
+	while (_damageHistory.size() > config::SwapchainDamageHistory) {
+		_damageHistory.erase(_damageHistory.begin());
+	}
+
+	if (imageIndex >= _imageDamageOrder.size()) {
+		_imageDamageOrder.resize(imageIndex + 1, 0);
+	}
+
+	auto lastOrder = _imageDamageOrder[imageIndex];
+	_imageDamageOrder[imageIndex] = frameOrder;
+
+	if (lastOrder == 0 || lastOrder >= frameOrder) {
+		return false;
+	}
+
+	// image contains frame `lastOrder`, collect damage of all frames after it;
+	// if some frame is missed (dropped or not yet recorded) - contents is unknown
+	auto it = _damageHistory.find(lastOrder + 1);
+	auto order = lastOrder + 1;
+	target = URect{0, 0, 0, 0};
+	while (order <= frameOrder) {
+		if (it == _damageHistory.end() || it->first != order) {
+			return false;
+		}
+		target = unionRect(target, it->second);
+		++it;
+		++order;
+	}
+	return true;
+}
+
+void Swapchain::invalidateImageDamage(uint32_t imageIndex) {
+	std::unique_lock<Mutex> lock(_damageMutex);
+	if (imageIndex < _imageDamageOrder.size()) {
+		_imageDamageOrder[imageIndex] = 0;
+	}
+}
+
 ImageViewInfo Swapchain::getSwapchainImageViewInfo(const ImageInfo &image) const {
 	ImageViewInfo info;
 	switch (image.imageType) {
@@ -173,6 +237,11 @@ void SwapchainImage::setPresented() {
 	_image = nullptr;
 }
 
+void SwapchainImage::setPresentRegion(const URect &region) {
+	_presentRegion = region;
+	_hasPresentRegion = true;
+}
+
 void SwapchainImage::invalidateImage() {
 	if (_image && _swapchain) {
 		_swapchain->invalidateImage(this, false);
@@ -81,6 +81,9 @@ public:
 	const SurfaceInfo &getSurfaceInfo() const { return _surfaceInfo; }
 
 	uint32_t getAcquiredImagesCount() const { return _acquiredImages; }
+
+	// Number of images, that can be acquired at the same time without blocking on acquire
+	uint32_t getAcquirableImagesCount() const;
 	uint64_t getPresentedFramesCount() const { return _presentedFrames; }
 
 	bool isDeprecated();
@@ -102,6 +105,15 @@ public:
 	virtual Rc<Semaphore> acquireSemaphore() = 0;
 	virtual bool releaseSemaphore(Rc<Semaphore> &&) = 0;
 
+	// Partial redraw support: registers damage for the frame, and writes into `target` area of
+	// the image, that should be redrawn to bring it's previous contents up to date with the frame.
+	// Returns false if image contents is unknown, and full redraw is required
+	bool updateImageDamage(uint32_t imageIndex, uint64_t frameOrder, const URect &damage,
+			URect &target);
+
+	// Image contents was not presented, it's no longer can be used for partial redraw
+	void invalidateImageDamage(uint32_t imageIndex);
+
 protected:
 	using core::Object::init;
 
@@ -122,6 +134,10 @@ protected:
 	Rc<Surface> _surface;
 
 	Vector<Rc<Semaphore>> _invalidatedSemaphores;
+
+	Mutex _damageMutex;
+	Map<uint64_t, URect> _damageHistory; // frame order -> damage
+	Vector<uint64_t> _imageDamageOrder; // image index -> last rendered frame order
 };
 
 class SP_PUBLIC SwapchainImage : public ImageStorage {
@@ -159,9 +175,16 @@ public:
 
 	void invalidateImage();
 
+	// Area of the image, changed within frame (for incremental present)
+	void setPresentRegion(const URect &);
+	bool hasPresentRegion() const { return _hasPresentRegion; }
+	const URect &getPresentRegion() const { return _presentRegion; }
+
 protected:
 	using core::ImageStorage::init;
 
+	bool _hasPresentRegion = false;
+	URect _presentRegion;
 	uint64_t _order = 0;
 	State _state = State::Initial;
 	Rc<Swapchain> _swapchain;
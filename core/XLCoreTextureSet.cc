@@ -39,20 +39,45 @@ void TextureSet::write(const MaterialLayout &set) {
 	_layoutIndexes.resize(_count, 0);
 }
 
-Rc<TextureSet> TextureSetLayout::acquireSet(Device &dev) {
+Rc<TextureSet> TextureSetLayout::acquireSet(Device &dev, const MaterialLayout *layout) {
 	std::unique_lock<Mutex> lock(_mutex);
 	if (_sets.empty()) {
 		lock.unlock();
 		return dev.makeTextureSet(*this);
-	} else {
-		auto v = move(_sets.back());
-		_sets.pop_back();
-		return v;
 	}
+
+	auto target = _sets.end() - 1;
+	if (layout) {
+		// count slots, that will not be rewritten
+		uint32_t bestMatch = 0;
+		for (auto it = _sets.begin(); it != _sets.end(); ++it) {
+			auto indexes = (*it)->getIndexes();
+			auto count = std::min(uint32_t(indexes.size()), layout->usedImageSlots);
+			uint32_t match = 0;
+			for (uint32_t i = 0; i < count; ++i) {
+				auto &image = layout->imageSlots[i].image;
+				if (image && image->getIndex() == indexes[i]) {
+					++match;
+				}
+			}
+			if (match > bestMatch) {
+				bestMatch = match;
+				target = it;
+			}
+		}
+	}
+
+	auto v = move(*target);
+	_sets.erase(target);
+	return v;
 }
 
 void TextureSetLayout::releaseSet(Rc<TextureSet> &&set) {
 	std::unique_lock<Mutex> lock(_mutex);
+	if (_sets.size() >= config::RecycledTextureSets) {
+		// drop oldest one
+		_sets.erase(_sets.begin());
+	}
 	_sets.emplace_back(move(set));
 }
 
@@ -59,7 +59,10 @@ public:
 	const ImageData *getEmptyImage() const { return _emptyImage; }
 	const ImageData *getSolidImage() const { return _solidImage; }
 
-	Rc<TextureSet> acquireSet(Device &dev);
+	// Reuses released set, that has most of the layout's images already written, if any
+	Rc<TextureSet> acquireSet(Device &dev, const MaterialLayout * = nullptr);
+
+	// Set should not be in use by device, when released
 	void releaseSet(Rc<TextureSet> &&);
 
 	bool isPartiallyBound() const { return _partiallyBound; }
@@ -0,0 +1,250 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+
+#include "XLCoreTrace.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::core {
+
+std::atomic<bool> Trace::s_enabled = false;
+
+static std::atomic<uint32_t> s_traceThreadCounter = 1;
+
+Trace *Trace::getInstance() {
+	static Trace s_instance;
+	return &s_instance;
+}
+
+uint32_t Trace::getThreadId() {
+	static thread_local uint32_t tl_threadId = 0;
+	if (!tl_threadId) {
+		tl_threadId = s_traceThreadCounter.fetch_add(1);
+	}
+	return tl_threadId;
+}
+
+StringView Trace::getCategoryName(TraceCategory cat) {
+	switch (cat) {
+	case TraceCategory::Frame: return StringView("frame"); break;
+	case TraceCategory::Scene: return StringView("scene"); break;
+	case TraceCategory::Commands: return StringView("commands"); break;
+	case TraceCategory::Vertex: return StringView("vertex"); break;
+	case TraceCategory::Pass: return StringView("pass"); break;
+	case TraceCategory::Device: return StringView("device"); break;
+	case TraceCategory::Font: return StringView("font"); break;
+	case TraceCategory::Transfer: return StringView("transfer"); break;
+	case TraceCategory::Custom: return StringView("custom"); break;
+	}
+	return StringView();
+}
+
+void Trace::start(size_t capacity, bool ring) {
+	if constexpr (!config::EnableTrace) {
+		log::source().warn("core::Trace", "Tracing is disabled with config::EnableTrace");
+		return;
+	}
+
+	std::unique_lock<Mutex> lock(_mutex);
+	_capacity = std::max(capacity, size_t(1));
+	_ring.store(ring);
+	_dropped.store(0);
+	for (auto &it : _buffers) {
+		std::unique_lock<Mutex> bufferLock(it->mutex);
+		it->events.clear();
+		it->events.resize(_capacity);
+		it->next = 0;
+		it->count = 0;
+	}
+	s_enabled.store(true);
+}
+
+void Trace::stop() { s_enabled.store(false); }
+
+void Trace::clear() {
+	std::unique_lock<Mutex> lock(_mutex);
+	_dropped.store(0);
+	for (auto &it : _buffers) {
+		std::unique_lock<Mutex> bufferLock(it->mutex);
+		it->next = 0;
+		it->count = 0;
+	}
+}
+
+void Trace::setThreadName(StringView name) {
+	auto id = getThreadId();
+
+	std::unique_lock<Mutex> lock(_mutex);
+	_threadNames[id] = name.str<Interface>();
+}
+
+Vector<TraceEvent> Trace::getEvents() const {
+	Vector<TraceEvent> ret;
+
+	std::unique_lock<Mutex> lock(_mutex);
+	for (auto &it : _buffers) {
+		std::unique_lock<Mutex> bufferLock(it->mutex);
+		if (it->events.empty()) {
+			continue;
+		}
+
+		auto first = (it->next + it->events.size() - it->count) % it->events.size();
+		for (size_t i = 0; i < it->count; ++i) {
+			ret.emplace_back(it->events[(first + i) % it->events.size()]);
+		}
+	}
+	lock.unlock();
+
+	std::stable_sort(ret.begin(), ret.end(), [](const TraceEvent &l, const TraceEvent &r) {
+		return l.start < r.start;
+	});
+	return ret;
+}
+
+Value Trace::exportChromeTrace() const {
+	auto events = getEvents();
+
+	Map<uint32_t, String> threadNames;
+	do {
+		std::unique_lock<Mutex> lock(_mutex);
+		threadNames = _threadNames;
+	} while (0);
+
+	Set<uint32_t> threads;
+
+	Value traceEvents;
+	for (auto &it : events) {
+		if (it.category == TraceCategory::Frame) {
+			// frames in flight overlap, so they are exported as async events, keyed by frame order
+			for (auto ph : {"b", "e"}) {
+				Value ev;
+				ev.setString(it.getName(), "name");
+				ev.setString(getCategoryName(it.category), "cat");
+				ev.setString(ph, "ph");
+				ev.setInteger(it.start + (ph[0] == 'e' ? it.duration : 0), "ts");
+				ev.setInteger(1, "pid");
+				ev.setInteger(it.thread, "tid");
+				ev.setInteger(it.frame, "id");
+				traceEvents.addValue(move(ev));
+			}
+			threads.emplace(it.thread);
+			continue;
+		}
+
+		Value ev;
+		ev.setString(it.getName(), "name");
+		ev.setString(getCategoryName(it.category), "cat");
+		ev.setString("X", "ph");
+		ev.setInteger(it.start, "ts");
+		ev.setInteger(it.duration, "dur");
+		ev.setInteger(1, "pid");
+		ev.setInteger(it.thread, "tid");
+		if (it.frame) {
+			Value args;
+			args.setInteger(it.frame, "frame");
+			ev.setValue(move(args), "args");
+		}
+		traceEvents.addValue(move(ev));
+		threads.emplace(it.thread);
+	}
+
+	for (auto &it : threads) {
+		Value args;
+		auto nameIt = threadNames.find(it);
+		if (it == DeviceThread) {
+			args.setString("Device", "name");
+		} else if (nameIt != threadNames.end()) {
+			args.setString(nameIt->second, "name");
+		} else {
+			args.setString(toString("Thread ", it), "name");
+		}
+
+		Value ev;
+		ev.setString("thread_name", "name");
+		ev.setString("M", "ph");
+		ev.setInteger(1, "pid");
+		ev.setInteger(it, "tid");
+		ev.setValue(move(args), "args");
+		traceEvents.addValue(move(ev));
+	}
+
+	Value ret;
+	ret.setValue(move(traceEvents), "traceEvents");
+	ret.setString("ms", "displayTimeUnit");
+	return ret;
+}
+
+bool Trace::write(const FileInfo &path) const {
+	auto val = exportChromeTrace();
+
+	filesystem::remove(path);
+	if (!data::save(val, path, data::EncodeFormat::Json)) {
+		log::source().error("core::Trace", "Fail to write trace file");
+		return false;
+	}
+	return true;
+}
+
+void Trace::push(TraceCategory cat, StringView name, uint64_t start, uint64_t duration,
+		uint64_t frame, uint32_t thread) {
+	auto buf = getThreadBuffer();
+
+	std::unique_lock<Mutex> lock(buf->mutex);
+	if (buf->events.empty()) {
+		return;
+	}
+
+	if (buf->count == buf->events.size()) {
+		_dropped.fetch_add(1, std::memory_order_relaxed);
+		if (!_ring.load(std::memory_order_relaxed)) {
+			return;
+		}
+	} else {
+		++buf->count;
+	}
+
+	auto &ev = buf->events[buf->next];
+	ev.category = cat;
+	ev.thread = thread;
+	ev.frame = frame;
+	ev.start = start;
+	ev.duration = duration;
+
+	auto len = std::min(name.size(), TraceEvent::NameLength - 1);
+	memcpy(ev.name.data(), name.data(), len);
+	ev.name[len] = 0;
+
+	buf->next = (buf->next + 1) % buf->events.size();
+}
+
+auto Trace::getThreadBuffer() -> ThreadBuffer * {
+	static thread_local ThreadBuffer *tl_buffer = nullptr;
+	if (!tl_buffer) {
+		auto buf = Rc<ThreadBuffer>::alloc();
+
+		std::unique_lock<Mutex> lock(_mutex);
+		buf->events.resize(_capacity);
+		tl_buffer = _buffers.emplace_back(move(buf)).get();
+	}
+	return tl_buffer;
+}
+
+} // namespace stappler::xenolith::core
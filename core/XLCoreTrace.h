@@ -0,0 +1,169 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef XENOLITH_CORE_XLCORETRACE_H_
+#define XENOLITH_CORE_XLCORETRACE_H_
+
+#include "XLCore.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::core {
+
+enum class TraceCategory : uint16_t {
+	Frame,
+	Scene,
+	Commands,
+	Vertex,
+	Pass,
+	Device,
+	Font,
+	Transfer,
+	Custom,
+};
+
+struct SP_PUBLIC TraceEvent final {
+	static constexpr size_t NameLength = 48;
+
+	TraceCategory category = TraceCategory::Custom;
+	uint32_t thread = 0; // Trace::DeviceThread for GPU-side spans
+	uint64_t frame = 0;
+	uint64_t start = 0; // monotonic clock, microseconds
+	uint64_t duration = 0;
+	std::array<char, NameLength> name; // truncated, null-terminated
+
+	StringView getName() const { return StringView(name.data()); }
+};
+
+/* Timeline recorder for frame processing spans
+ *
+ * Events are stored in preallocated per-thread ring buffers, so recording threads do not
+ * contend with each other, and can be exported in Chrome trace event format (JSON),
+ * that can be opened with chrome://tracing or Perfetto UI.
+ *
+ * When recording is not started, each trace point costs one relaxed atomic load. With
+ * config::EnableTrace set to false trace points are removed at compile time.
+ */
+class SP_PUBLIC Trace final {
+public:
+	static constexpr uint32_t DeviceThread = 0;
+
+	// events per recording thread
+	static constexpr size_t DefaultCapacity = 16 * 1'024;
+
+	static Trace *getInstance();
+
+	static bool isEnabled() {
+		if constexpr (config::EnableTrace) {
+			return s_enabled.load(std::memory_order_relaxed);
+		} else {
+			return false;
+		}
+	}
+
+	// Record CPU span on current thread
+	static void addSpan(TraceCategory cat, StringView name, uint64_t start, uint64_t duration,
+			uint64_t frame = 0) {
+		if (isEnabled()) {
+			getInstance()->push(cat, name, start, duration, frame, getThreadId());
+		}
+	}
+
+	// Record span on device timeline
+	static void addDeviceSpan(TraceCategory cat, StringView name, uint64_t start,
+			uint64_t duration, uint64_t frame = 0) {
+		if (isEnabled()) {
+			getInstance()->push(cat, name, start, duration, frame, DeviceThread);
+		}
+	}
+
+	static uint32_t getThreadId();
+
+	static StringView getCategoryName(TraceCategory);
+
+	// ring - overwrite oldest events when buffer is full, otherwise stop recording
+	void start(size_t capacity = DefaultCapacity, bool ring = true);
+	void stop();
+	void clear();
+
+	// set name for current thread in exported trace
+	void setThreadName(StringView);
+
+	// events from all threads, ordered by start time
+	Vector<TraceEvent> getEvents() const;
+
+	Value exportChromeTrace() const;
+
+	bool write(const FileInfo &) const;
+
+	size_t getDroppedEvents() const { return _dropped.load(std::memory_order_relaxed); }
+
+protected:
+	// Buffer is locked only by its own thread and by readers, buffers are never released,
+	// so events from finished threads are still available for export
+	struct ThreadBuffer : Ref {
+		Mutex mutex;
+		Vector<TraceEvent> events;
+		size_t next = 0;
+		size_t count = 0;
+	};
+
+	void push(TraceCategory, StringView, uint64_t start, uint64_t duration, uint64_t frame,
+			uint32_t thread);
+
+	ThreadBuffer *getThreadBuffer();
+
+	static std::atomic<bool> s_enabled;
+
+	mutable Mutex _mutex; // protects buffer list, thread names and recording parameters
+	Vector<Rc<ThreadBuffer>> _buffers;
+	Map<uint32_t, String> _threadNames;
+	std::atomic<size_t> _dropped = 0;
+	std::atomic<bool> _ring = true;
+	size_t _capacity = DefaultCapacity;
+};
+
+// Records CPU span from construction to destruction
+struct SP_PUBLIC TraceScope final {
+	TraceScope(TraceCategory c, StringView n, uint64_t f = 0)
+	: start(Trace::isEnabled() ? sp::platform::clock(ClockType::Monotonic) : 0)
+	, frame(f)
+	, name(n)
+	, category(c) { }
+
+	~TraceScope() {
+		if (start && Trace::isEnabled()) {
+			Trace::addSpan(category, name, start,
+					sp::platform::clock(ClockType::Monotonic) - start, frame);
+		}
+	}
+
+	TraceScope(const TraceScope &) = delete;
+	TraceScope &operator=(const TraceScope &) = delete;
+
+	uint64_t start;
+	uint64_t frame;
+	StringView name;
+	TraceCategory category;
+};
+
+} // namespace stappler::xenolith::core
+
+#endif /* XENOLITH_CORE_XLCORETRACE_H_ */
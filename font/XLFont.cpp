@@ -27,6 +27,7 @@
 #include "XLFontLocale.cc"
 #include "XLFontLabelBase.cc"
 #include "XLFontDeferredRequest.cc"
+#include "XLFontDistanceField.cc"
 #include "XLFontShared.cc"
 
 #include "backend/vk/XLVkFontQueue.cc"
@@ -190,14 +190,30 @@ Rc<FontController> FontComponent::acquireController(event::Looper *looper,
 			}
 
 			looper->performOnThread([this]() {
+				Map<const FontController::FontSource *, StringView> names;
+				for (auto &it : builder.getDataQueries()) { names.emplace(&it.second, it.first); }
+
 				for (const Pair<const String, FontController::FamilyQuery> &it :
 						builder.getFamilyQueries()) {
+					StringStream signature;
+					signature << it.second.family << (it.second.addInFront ? "<" : ">");
+
 					Vector<Rc<FontFaceData>> d;
 					d.reserve(it.second.sources.size());
-					for (auto &iit : it.second.sources) { d.emplace_back(move(iit->data)); }
+					for (auto &iit : it.second.sources) {
+						signature << names[iit] << "," << iit->fontFilePath << ","
+								  << iit->fontMemoryData.size() << ","
+								  << iit->fontExternalData.size() << ";";
+						d.emplace_back(move(iit->data));
+					}
+					controller->updateSignature(signature.str());
 					controller->addFont(it.second.family, sp::move(d), it.second.addInFront);
 				}
 
+				for (auto &it : builder.getAliases()) {
+					controller->updateSignature(toString(it.first, "=", it.second));
+				}
+
 				if (builder.getTarget()) {
 					for (auto &it : builder.getAliases()) {
 						controller->addAlias(it.first, it.second);
@@ -205,6 +221,7 @@ Rc<FontController> FontComponent::acquireController(event::Looper *looper,
 					controller->sendFontUpdatedEvent();
 				} else {
 					controller->setAliases(Map<String, String>(builder.getAliases()));
+					controller->setRenderMode(builder.getRenderMode());
 					controller->setLoaded(true);
 				}
 				controller = nullptr;
@@ -267,12 +284,13 @@ Rc<FontController> FontComponent::acquireController(event::Looper *looper,
 }
 
 void FontComponent::updateImage(event::Looper *looper, const Rc<core::DynamicImage> &image,
-		Vector<font::FontUpdateRequest> &&data, Rc<core::DependencyEvent> &&dep,
-		Function<void(bool)> &&complete) {
+		FontRenderMode mode, Vector<font::FontUpdateRequest> &&data,
+		Rc<core::DependencyEvent> &&dep, Function<void(bool)> &&complete) {
 	if (!_active || !_queue) {
 		_pendingImageQueries.emplace_back(ImageQuery{
 			looper,
 			image,
+			mode,
 			sp::move(data),
 			sp::move(dep),
 			sp::move(complete),
@@ -285,6 +303,7 @@ void FontComponent::updateImage(event::Looper *looper, const Rc<core::DynamicIma
 	input->image = image;
 	input->ext = this;
 	input->requests = sp::move(data);
+	input->mode = mode;
 	//input->output = [](const core::ImageInfoData &info, BytesView data) {
 	//	Bitmap bmp(data, info.extent.width, info.extent.height, bitmap::PixelFormat::A8);
 	//	bmp.save(bitmap::FileFormat::Png, FileInfo(toString(Time::now().toMicros(), ".png")));
@@ -307,7 +326,7 @@ void FontComponent::handleActivated() {
 	_active = true;
 
 	for (auto &it : _pendingImageQueries) {
-		updateImage(it.looper, it.image, sp::move(it.chars), sp::move(it.dependency),
+		updateImage(it.looper, it.image, it.mode, sp::move(it.chars), sp::move(it.dependency),
 				sp::move(it.complete));
 	}
 
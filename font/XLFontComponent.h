@@ -38,6 +38,7 @@ struct SP_PUBLIC RenderFontInput : public core::AttachmentInputData {
 	Rc<core::DynamicImage> image;
 	Rc<FontComponent> ext;
 	Vector<FontUpdateRequest> requests;
+	FontRenderMode mode = FontRenderMode::Coverage;
 	Function<void(const core::ImageInfoData &, BytesView)> output;
 };
 
@@ -74,8 +75,9 @@ public:
 	// run font rendering query for DynamicImage
 	// Looper will be used for async font rendering via FreeType
 	// Rendering will use all of Looper's async threads, so, avoid to stall main (GL) looper
-	void updateImage(event::Looper *, const Rc<core::DynamicImage> &, Vector<FontUpdateRequest> &&,
-			Rc<core::DependencyEvent> &&, Function<void(bool)> &&complete);
+	void updateImage(event::Looper *, const Rc<core::DynamicImage> &, FontRenderMode,
+			Vector<FontUpdateRequest> &&, Rc<core::DependencyEvent> &&,
+			Function<void(bool)> &&complete);
 
 protected:
 	void handleActivated();
@@ -83,6 +85,7 @@ protected:
 	struct ImageQuery {
 		Rc<event::Looper> looper;
 		Rc<core::DynamicImage> image;
+		FontRenderMode mode;
 		Vector<FontUpdateRequest> chars;
 		Rc<core::DependencyEvent> dependency;
 		Function<void(bool)> complete;
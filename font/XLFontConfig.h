@@ -32,6 +32,29 @@ namespace STAPPLER_VERSIONIZED stappler::xenolith::config {
 // max chars count, used by locale::hasLocaleTagsFast
 static constexpr size_t MaxFastLocaleChars = size_t(127);
 
+// Font size (in pixels) for glyphs, rendered in FontRenderMode::DistanceField
+static constexpr uint16_t FontDistanceFieldBaseSize = 32;
+
+// Distance field spread (in pixels of base size), also used as glyph padding
+static constexpr uint16_t FontDistanceFieldRadius = 4;
+
+// Default byte budget for the font atlas image (one byte per texel); when atlas exceeds it,
+// glyphs, not used by any text view, are evicted in LRU order
+static constexpr size_t FontAtlasDefaultBudget = size_t(8 * 1024 * 1024);
+
+// Released glyph can not be evicted earlier than this number of FontController updates
+static constexpr uint64_t FontGlyphMinUnusedUpdates = 120;
+
+// Persistent glyph is dropped on the buffer compaction, if it was not requested for this
+// number of atlas updates
+static constexpr uint32_t FontPersistentUnusedUpdates = 8;
+
+// Fraction of unused bytes in persistent glyph buffer, that triggers compaction
+static constexpr float FontPersistentCompactionThreshold = 0.5f;
+
+// Persistent glyph buffers smaller then this are never compacted
+static constexpr size_t FontPersistentCompactionMinSize = size_t(1024 * 1024);
+
 }
 
 namespace STAPPLER_VERSIONIZED stappler::xenolith::font {
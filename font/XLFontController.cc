@@ -39,6 +39,7 @@ struct FontController::Builder::Data {
 	Map<String, FontSource> dataQueries;
 	Map<String, FamilyQuery> familyQueries;
 	Map<String, String> aliases;
+	FontRenderMode renderMode = FontRenderMode::Coverage;
 };
 
 FontController::Builder::~Builder() {
@@ -254,6 +255,10 @@ bool FontController::Builder::addAlias(StringView newAlias, StringView familyNam
 	}
 }
 
+void FontController::Builder::setRenderMode(FontRenderMode mode) { _data->renderMode = mode; }
+
+FontRenderMode FontController::Builder::getRenderMode() const { return _data->renderMode; }
+
 Vector<const FontController::FamilyQuery *> FontController::Builder::getFontFamily(
 		StringView family) const {
 	Vector<const FontController::FamilyQuery *> families;
@@ -481,6 +486,11 @@ Rc<FontFaceSet> FontController::getLayout(FontParameters style) {
 		initDependency();
 	}
 
+	if (_renderMode == FontRenderMode::DistanceField) {
+		uniqueLock.unlock();
+		linkDistanceFieldSource(ret, style);
+	}
+
 	return ret;
 }
 
@@ -499,13 +509,104 @@ Rc<FontFaceSet> FontController::getLayoutForString(const FontParameters &f, cons
 
 Rc<core::DependencyEvent> FontController::addTextureChars(const Rc<FontFaceSet> &l,
 		SpanView<CharLayoutData> chars) {
-	if (l->addTextureChars(chars)) {
+	bool requested = l->addTextureChars(chars);
+
+	std::unique_lock<Mutex> lock(_glyphMutex);
+	for (auto &it : chars) {
+		auto key = CharId::getCharId(it.face, it.charID, CharAnchor::BottomLeft);
+		_glyphUsage[key].lastUsed = _glyphClock;
+		if (restoreEvictedGlyph(key)) {
+			// glyph was dropped from atlas, request it again
+			requested = true;
+		}
+	}
+	lock.unlock();
+
+	if (requested) {
 		initDependency();
 	}
 	// return dependency if it set
 	return _dependency;
 }
 
+bool FontController::retainGlyphs(Vector<uint32_t> &keys, SpanView<CharLayoutData> chars) {
+	Vector<uint32_t> retained;
+	retained.reserve(chars.size());
+	for (auto &it : chars) {
+		retained.emplace_back(CharId::getCharId(it.face, it.charID, CharAnchor::BottomLeft));
+	}
+
+	std::sort(retained.begin(), retained.end());
+	retained.erase(std::unique(retained.begin(), retained.end()), retained.end());
+
+	bool evicted = false;
+
+	std::unique_lock<Mutex> lock(_glyphMutex);
+	// retain new glyphs before release, so common glyphs never lose all references
+	for (auto &it : retained) {
+		auto &usage = _glyphUsage[it];
+		++usage.refs;
+		usage.lastUsed = _glyphClock;
+		if (restoreEvictedGlyph(it)) {
+			evicted = true;
+		}
+	}
+
+	for (auto &it : keys) {
+		auto uIt = _glyphUsage.find(it);
+		if (uIt != _glyphUsage.end() && uIt->second.refs > 0) {
+			--uIt->second.refs;
+			uIt->second.lastUsed = _glyphClock;
+		}
+	}
+	lock.unlock();
+
+	keys = sp::move(retained);
+
+	if (evicted) {
+		initDependency();
+	}
+	return evicted;
+}
+
+void FontController::releaseGlyphs(Vector<uint32_t> &keys) {
+	if (keys.empty()) {
+		return;
+	}
+
+	std::unique_lock<Mutex> lock(_glyphMutex);
+	for (auto &it : keys) {
+		auto uIt = _glyphUsage.find(it);
+		if (uIt != _glyphUsage.end() && uIt->second.refs > 0) {
+			--uIt->second.refs;
+			uIt->second.lastUsed = _glyphClock;
+		}
+	}
+	keys.clear();
+}
+
+void FontController::setAtlasBudget(size_t value) {
+	if (_atlasBudget != value) {
+		_atlasBudget = value;
+		_evictionExtent = Extent3();
+	}
+}
+
+FontController::Stats FontController::getStats() const {
+	Stats ret;
+	ret.atlasUpdates = _atlasUpdates.load();
+	ret.requestedGlyphs = _requestedGlyphs.load();
+
+	std::unique_lock<Mutex> glyphLock(_glyphMutex);
+	ret.trackedGlyphs = _glyphUsage.size();
+	ret.evictedGlyphs = _evictedGlyphs.size();
+	glyphLock.unlock();
+
+	std::shared_lock lock(_layoutSharedMutex);
+	ret.layouts = _layouts.size();
+	return ret;
+}
+
 uint32_t FontController::getFamilyIndex(StringView name) const {
 	std::shared_lock lock(_layoutSharedMutex);
 	auto it = std::find(_familiesNames.begin(), _familiesNames.end(), name);
@@ -526,10 +627,29 @@ StringView FontController::getFamilyName(uint32_t idx) const {
 void FontController::update(AppThread *app, const UpdateTime &clock, bool) {
 	_clock = clock.global;
 	removeUnusedLayouts();
+
+	{
+		std::unique_lock<Mutex> lock(_glyphMutex);
+		++_glyphClock;
+	}
+
+	if (_loaded && evictGlyphs()) {
+		_dirty = true;
+	}
+
 	if (_dirty && _loaded) {
 		Vector<FontUpdateRequest> objects;
+		Vector<uint32_t> filtered;
 		std::shared_lock lock(_layoutSharedMutex);
 		for (auto &it : _layouts) {
+			if (_renderMode == FontRenderMode::DistanceField) {
+				auto sIt = _distanceFieldSources.find(it.first);
+				if (sIt != _distanceFieldSources.end()) {
+					// glyphs for this layout will be rendered with the base layout
+					continue;
+				}
+			}
+
 			for (auto &iit : it.second->getFaces()) {
 				if (!iit) {
 					continue;
@@ -541,12 +661,14 @@ void FontController::update(AppThread *app, const UpdateTime &clock, bool) {
 				});
 				if (lb == objects.end()) {
 					auto req = iit->getRequiredChars();
+					filterEvictedGlyphs(iit->getId(), req, filtered);
 					if (!req.empty()) {
 						objects.emplace_back(
 								FontUpdateRequest{iit, sp::move(req), it.second->isPersistent()});
 					}
 				} else if (lb != objects.end() && lb->object != iit) {
 					auto req = iit->getRequiredChars();
+					filterEvictedGlyphs(iit->getId(), req, filtered);
 					if (!req.empty()) {
 						objects.emplace(lb,
 								FontUpdateRequest{iit, sp::move(req), it.second->isPersistent()});
@@ -554,9 +676,52 @@ void FontController::update(AppThread *app, const UpdateTime &clock, bool) {
 				}
 			}
 		}
+		if (_renderMode == FontRenderMode::DistanceField) {
+			for (auto &it : _distanceFieldSources) {
+				auto lIt = _layouts.find(it.first);
+				if (lIt == _layouts.end()) {
+					continue;
+				}
+
+				auto &faces = lIt->second->getFaces();
+				auto &baseFaces = it.second.base->getFaces();
+				for (size_t i = 0; i < faces.size() && i < baseFaces.size(); ++i) {
+					if (!faces[i] || !baseFaces[i]) {
+						continue;
+					}
+
+					auto req = faces[i]->getRequiredChars();
+					filterEvictedGlyphs(faces[i]->getId(), req, filtered);
+					if (req.empty()) {
+						continue;
+					}
+
+					auto lb = std::lower_bound(objects.begin(), objects.end(), baseFaces[i],
+							[](const FontUpdateRequest &l, FontFaceObject *r) {
+						return l.object.get() < r;
+					});
+					if (lb == objects.end() || lb->object != baseFaces[i]) {
+						lb = objects.emplace(lb, FontUpdateRequest{baseFaces[i]});
+					}
+
+					lb->chars.insert(lb->chars.end(), req.begin(), req.end());
+					std::sort(lb->chars.begin(), lb->chars.end());
+					lb->chars.erase(std::unique(lb->chars.begin(), lb->chars.end()),
+							lb->chars.end());
+					lb->scaledFaces.emplace_back(faces[i]->getId(), it.second.scale);
+					lb->persistent = lb->persistent || lIt->second->isPersistent();
+				}
+			}
+		}
+		// glyphs, no longer required by any face, should not be tracked as evicted
+		pruneEvictedGlyphs(filtered);
+
 		if (!objects.empty()) {
-			_component->updateImage(app->getLooper(), _image, sp::move(objects), move(_dependency),
-					[app = Rc<AppThread>(app)](bool) {
+			++_atlasUpdates;
+			for (auto &it : objects) { _requestedGlyphs += it.chars.size(); }
+
+			_component->updateImage(app->getLooper(), _image, _renderMode, sp::move(objects),
+					move(_dependency), [app = Rc<AppThread>(app)](bool) {
 				// perform views update
 				app->wakeup();
 			});
@@ -581,6 +746,20 @@ void FontController::setLoaded(bool value) {
 	}
 }
 
+void FontController::setRenderMode(FontRenderMode mode) {
+	if (_renderMode == mode) {
+		return;
+	}
+
+	if (_loaded) {
+		log::source().warn("FontController",
+				"Render mode can not be changed after controller was loaded");
+		return;
+	}
+
+	_renderMode = mode;
+}
+
 void FontController::sendFontUpdatedEvent() { onFontSourceUpdated(this); }
 
 void FontController::setAliases(Map<String, String> &&aliases) {
@@ -591,6 +770,11 @@ void FontController::setAliases(Map<String, String> &&aliases) {
 	}
 }
 
+void FontController::updateSignature(StringView value) {
+	auto sig = _signature.load();
+	_signature.store(hash::hash64(value.data(), value.size(), sig));
+}
+
 FontSpecializationVector FontController::findSpecialization(const FamilySpec &family,
 		const FontParameters &params, Vector<Rc<FontFaceData>> *dataList) {
 	auto getFontFaceScore = [](const FontLayoutParameters &required,
@@ -708,6 +892,7 @@ void FontController::removeUnusedLayouts() {
 				== 1) {
 			auto c = it->second->getRequiredCharsCount();
 			log::source().debug("FontController", "Removed: ", it->first);
+			_distanceFieldSources.erase(it->first);
 			it = _layouts.erase(it);
 			if (c > 0) {
 				_dirty = true;
@@ -718,6 +903,119 @@ void FontController::removeUnusedLayouts() {
 	}
 }
 
+void FontController::linkDistanceFieldSource(const Rc<FontFaceSet> &layout,
+		const FontParameters &style) {
+	if (style.fontSize.get() == config::FontDistanceFieldBaseSize) {
+		return;
+	}
+
+	auto baseStyle = style;
+	baseStyle.fontSize = FontSize(config::FontDistanceFieldBaseSize);
+	baseStyle.density = 1.0f;
+
+	auto base = getLayout(baseStyle);
+	if (!base || base == layout) {
+		return;
+	}
+
+	std::unique_lock lock(_layoutSharedMutex);
+	_distanceFieldSources.insert_or_assign(layout->getName(),
+			DistanceFieldSource{base,
+				float(style.fontSize.get()) / float(config::FontDistanceFieldBaseSize)});
+}
+
+bool FontController::evictGlyphs() {
+	if (!_image) {
+		return false;
+	}
+
+	auto extent = _image->getExtent();
+	auto atlasBytes = size_t(extent.width) * size_t(extent.height) * size_t(extent.depth);
+	if (atlasBytes <= _atlasBudget || extent == _evictionExtent) {
+		return false;
+	}
+
+	// evict once for every new atlas, eviction result is visible only after rebuild
+	_evictionExtent = extent;
+
+	std::unique_lock<Mutex> lock(_glyphMutex);
+
+	// (key, lastUsed)
+	Vector<Pair<uint32_t, uint64_t>> candidates;
+	for (auto &it : _glyphUsage) {
+		if (it.second.refs == 0
+				&& _glyphClock - it.second.lastUsed > config::FontGlyphMinUnusedUpdates) {
+			candidates.emplace_back(it.first, it.second.lastUsed);
+		}
+	}
+
+	if (candidates.empty()) {
+		return false;
+	}
+
+	// average glyph footprint in the current atlas
+	auto glyphBytes = std::max(atlasBytes / _glyphUsage.size(), size_t(1));
+	auto nevict = std::min((atlasBytes - _atlasBudget + glyphBytes - 1) / glyphBytes,
+			candidates.size());
+
+	std::nth_element(candidates.begin(), candidates.begin() + (nevict - 1), candidates.end(),
+			[](const Pair<uint32_t, uint64_t> &l, const Pair<uint32_t, uint64_t> &r) {
+		return l.second < r.second;
+	});
+
+	// evicted glyphs have no users, so there is nothing to track, until they are requested again
+	for (size_t i = 0; i < nevict; ++i) {
+		_glyphUsage.erase(candidates[i].first);
+		_evictedGlyphs.emplace_back(candidates[i].first);
+	}
+
+	std::sort(_evictedGlyphs.begin(), _evictedGlyphs.end());
+	_evictedGlyphs.erase(std::unique(_evictedGlyphs.begin(), _evictedGlyphs.end()),
+			_evictedGlyphs.end());
+
+	log::source().debug("FontController", "Evicted ", nevict, " glyphs, atlas: ", atlasBytes,
+			" bytes, budget: ", _atlasBudget, " bytes");
+	return true;
+}
+
+void FontController::filterEvictedGlyphs(uint16_t faceId, Vector<char32_t> &chars,
+		Vector<uint32_t> &filtered) {
+	std::unique_lock<Mutex> lock(_glyphMutex);
+	if (_evictedGlyphs.empty()) {
+		return;
+	}
+
+	auto it = std::remove_if(chars.begin(), chars.end(), [&](char32_t c) {
+		auto key = CharId::getCharId(faceId, c, CharAnchor::BottomLeft);
+		if (std::binary_search(_evictedGlyphs.begin(), _evictedGlyphs.end(), key)) {
+			filtered.emplace_back(key);
+			return true;
+		}
+		return false;
+	});
+	chars.erase(it, chars.end());
+}
+
+void FontController::pruneEvictedGlyphs(Vector<uint32_t> &filtered) {
+	std::sort(filtered.begin(), filtered.end());
+
+	std::unique_lock<Mutex> lock(_glyphMutex);
+	// glyphs, restored after filtering, are not in the list any more, so list is intersected
+	auto it = std::remove_if(_evictedGlyphs.begin(), _evictedGlyphs.end(), [&](uint32_t key) {
+		return !std::binary_search(filtered.begin(), filtered.end(), key);
+	});
+	_evictedGlyphs.erase(it, _evictedGlyphs.end());
+}
+
+bool FontController::restoreEvictedGlyph(uint32_t key) {
+	auto it = std::lower_bound(_evictedGlyphs.begin(), _evictedGlyphs.end(), key);
+	if (it != _evictedGlyphs.end() && *it == key) {
+		_evictedGlyphs.erase(it);
+		return true;
+	}
+	return false;
+}
+
 void FontController::initDependency() {
 	if (!_dependency) {
 		_dependency = Rc<core::DependencyEvent>::alloc(
@@ -33,10 +33,22 @@ namespace STAPPLER_VERSIONIZED stappler::xenolith::font {
 
 class FontComponent;
 
+enum class FontRenderMode : uint32_t {
+	// Glyphs rasterized with coverage for every requested font size
+	Coverage,
+
+	// Glyphs rendered once in FontDistanceFieldBaseSize as signed distance field,
+	// then reused for all other sizes of the same font face
+	DistanceField,
+};
+
 struct SP_PUBLIC FontUpdateRequest {
 	Rc<FontFaceObject> object;
 	Vector<char32_t> chars;
 	bool persistent = false;
+
+	// Faces of other sizes, that use glyphs of this object with a scale (DistanceField mode)
+	Vector<Pair<uint16_t, float>> scaledFaces;
 };
 
 class SP_PUBLIC FontController : public ApplicationExtension {
@@ -103,6 +115,9 @@ public:
 
 		bool addAlias(StringView newAlias, StringView familyName);
 
+		void setRenderMode(FontRenderMode);
+		FontRenderMode getRenderMode() const;
+
 		Vector<const FamilyQuery *> getFontFamily(StringView family) const;
 
 		Map<String, FontSource> &getDataQueries();
@@ -127,6 +142,16 @@ public:
 	virtual void invalidate(AppThread *) override;
 
 	bool isLoaded() const { return _loaded; }
+
+	// Changed every time font families or aliases are changed, it's built from family and source
+	// names, so it's the same between application runs with the same font configuration and
+	// can be used to identify stored results of text layout
+	uint64_t getSignature() const { return _signature.load(); }
+
+	// Render mode can only be changed before controller is loaded
+	FontRenderMode getRenderMode() const { return _renderMode; }
+	void setRenderMode(FontRenderMode);
+
 	const Rc<core::DynamicImage> &getImage() const { return _image; }
 	const Rc<Texture> &getTexture() const { return _texture; }
 
@@ -135,6 +160,27 @@ public:
 
 	Rc<core::DependencyEvent> addTextureChars(const Rc<FontFaceSet> &, SpanView<CharLayoutData>);
 
+	// Glyphs, retained by text views, always stay in atlas; released glyphs stay until atlas
+	// exceeds its byte budget, then least recently used of them are evicted.
+	// Keys of retained glyphs are stored in `keys`, previously retained keys are released.
+	// Returns true if some of the glyphs were evicted and should be requested again
+	bool retainGlyphs(Vector<uint32_t> &keys, SpanView<CharLayoutData>);
+	void releaseGlyphs(Vector<uint32_t> &keys);
+
+	void setAtlasBudget(size_t);
+	size_t getAtlasBudget() const { return _atlasBudget; }
+
+	// Counters for atlas updates, can be read from any thread
+	struct Stats {
+		uint64_t atlasUpdates = 0; // requests to rebuild atlas image
+		uint64_t requestedGlyphs = 0; // glyphs, sent for rasterization with those requests
+		size_t layouts = 0; // font face sets, loaded for now
+		size_t trackedGlyphs = 0; // glyphs with usage records, that stay in atlas
+		size_t evictedGlyphs = 0; // evicted glyphs, still required by loaded faces
+	};
+
+	Stats getStats() const;
+
 	uint32_t getFamilyIndex(StringView) const;
 	StringView getFamilyName(uint32_t idx) const;
 
@@ -158,15 +204,44 @@ protected:
 
 	void setAliases(Map<String, String> &&);
 
+	// Mixes description of added families or aliases into signature
+	void updateSignature(StringView);
+
 	FontSpecializationVector findSpecialization(const FamilySpec &, const FontParameters &,
 			Vector<Rc<FontFaceData>> *);
 	void removeUnusedLayouts();
 
+	// Binds layout to the layout of the base size, that provides distance field glyphs for it
+	void linkDistanceFieldSource(const Rc<FontFaceSet> &, const FontParameters &);
+
 	void initDependency();
 
+	struct DistanceFieldSource {
+		Rc<FontFaceSet> base;
+		float scale = 1.0f;
+	};
+
+	struct GlyphUsage {
+		uint32_t refs = 0;
+		uint64_t lastUsed = 0;
+	};
+
+	// Drops usage of least recently used glyphs and marks them as evicted, if atlas exceeds budget
+	bool evictGlyphs();
+
+	// Removes evicted glyphs from the request, keys of removed glyphs are added to `filtered`
+	void filterEvictedGlyphs(uint16_t faceId, Vector<char32_t> &, Vector<uint32_t> &filtered);
+
+	// Keeps only evicted glyphs, that were filtered from the last request
+	void pruneEvictedGlyphs(Vector<uint32_t> &filtered);
+
+	// Returns true if glyph was evicted, it's no longer evicted after that (_glyphMutex is locked)
+	bool restoreEvictedGlyph(uint32_t key);
+
 	bool _loaded = false;
 	String _name;
 	std::atomic<uint64_t> _clock;
+	std::atomic<uint64_t> _signature = 0;
 	TimeInterval _unusedInterval = 100_msec;
 	String _defaultFontFamily = "default";
 	Rc<Texture> _texture;
@@ -177,8 +252,20 @@ protected:
 	Vector<StringView> _familiesNames;
 	Map<String, FamilySpec> _families;
 	HashMap<StringView, Rc<FontFaceSet>> _layouts;
+	HashMap<StringView, DistanceFieldSource> _distanceFieldSources;
+	FontRenderMode _renderMode = FontRenderMode::Coverage;
 	Rc<core::DependencyEvent> _dependency;
 
+	HashMap<uint32_t, GlyphUsage> _glyphUsage;
+	Vector<uint32_t> _evictedGlyphs; // sorted
+	uint64_t _glyphClock = 0;
+	size_t _atlasBudget = config::FontAtlasDefaultBudget;
+	Extent3 _evictionExtent;
+	mutable Mutex _glyphMutex;
+
+	std::atomic<uint64_t> _atlasUpdates = 0;
+	std::atomic<uint64_t> _requestedGlyphs = 0;
+
 	bool _dirty = false;
 	mutable std::shared_mutex _layoutSharedMutex;
 };
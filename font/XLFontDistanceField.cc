@@ -0,0 +1,135 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "XLFontDistanceField.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::font {
+
+static constexpr float DistanceFieldInf = 1e20f;
+
+// Felzenszwalb & Huttenlocher, squared distance transform for one row or column
+static void makeDistanceField_edt1d(float *grid, uint32_t offset, uint32_t stride, uint32_t length,
+		float *f, uint32_t *v, float *z) {
+	v[0] = 0;
+	z[0] = -DistanceFieldInf;
+	z[1] = DistanceFieldInf;
+	f[0] = grid[offset];
+
+	int32_t k = 0;
+	for (uint32_t q = 1; q < length; ++q) {
+		f[q] = grid[offset + q * stride];
+		const float q2 = float(q * q);
+		float s = 0.0f;
+		do {
+			const auto r = v[k];
+			s = (f[q] - f[r] + q2 - float(r * r)) / float(q - r) / 2.0f;
+		} while (s <= z[k] && --k > -1);
+
+		++k;
+		v[k] = q;
+		z[k] = s;
+		z[k + 1] = DistanceFieldInf;
+	}
+
+	k = 0;
+	for (uint32_t q = 0; q < length; ++q) {
+		while (z[k + 1] < float(q)) { ++k; }
+		const auto r = v[k];
+		const float qr = float(q) - float(r);
+		grid[offset + q * stride] = f[r] + qr * qr;
+	}
+}
+
+static void makeDistanceField_edt(float *grid, uint32_t width, uint32_t height, float *f,
+		uint32_t *v, float *z) {
+	for (uint32_t x = 0; x < width; ++x) {
+		makeDistanceField_edt1d(grid, x, width, height, f, v, z);
+	}
+	for (uint32_t y = 0; y < height; ++y) {
+		makeDistanceField_edt1d(grid, y * width, 1, width, f, v, z);
+	}
+}
+
+bool makeDistanceField(Bytes &target, const uint8_t *bitmap, uint32_t width, uint32_t height,
+		int32_t pitch, uint32_t radius) {
+	if (!bitmap || width == 0 || height == 0 || radius == 0) {
+		return false;
+	}
+
+	const uint32_t fieldWidth = width + radius * 2;
+	const uint32_t fieldHeight = height + radius * 2;
+	const uint32_t size = fieldWidth * fieldHeight;
+	const uint32_t maxSide = std::max(fieldWidth, fieldHeight);
+
+	// squared distances to the glyph (outer) and to the background (inner)
+	Vector<float> outer;
+	Vector<float> inner;
+	outer.resize(size, DistanceFieldInf);
+	inner.resize(size, 0.0f);
+
+	Vector<float> f;
+	Vector<float> z;
+	Vector<uint32_t> v;
+	f.resize(maxSide);
+	z.resize(maxSide + 1);
+	v.resize(maxSide);
+
+	const uint8_t *row = bitmap;
+	if (pitch < 0) {
+		row = bitmap + size_t(-pitch) * (height - 1);
+	}
+
+	for (uint32_t y = 0; y < height; ++y) {
+		for (uint32_t x = 0; x < width; ++x) {
+			const auto a = row[x];
+			if (a == 0) {
+				continue;
+			}
+
+			const auto idx = (y + radius) * fieldWidth + x + radius;
+			if (a == 255) {
+				outer[idx] = 0.0f;
+				inner[idx] = DistanceFieldInf;
+			} else {
+				// edge crosses the pixel, approximate its offset with coverage
+				const float d = 0.5f - float(a) / 255.0f;
+				outer[idx] = d > 0.0f ? d * d : 0.0f;
+				inner[idx] = d < 0.0f ? d * d : 0.0f;
+			}
+		}
+		row += pitch;
+	}
+
+	makeDistanceField_edt(outer.data(), fieldWidth, fieldHeight, f.data(), v.data(), z.data());
+	makeDistanceField_edt(inner.data(), fieldWidth, fieldHeight, f.data(), v.data(), z.data());
+
+	target.resize(size);
+	for (uint32_t i = 0; i < size; ++i) {
+		const float dist = sqrtf(outer[i]) - sqrtf(inner[i]);
+		const float value = 0.5f - dist / float(radius * 2);
+		target[i] = uint8_t(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+	}
+
+	return true;
+}
+
+} // namespace stappler::xenolith::font
@@ -0,0 +1,43 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef XENOLITH_FONT_XLFONTDISTANCEFIELD_H_
+#define XENOLITH_FONT_XLFONTDISTANCEFIELD_H_
+
+#include "XLFontConfig.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::font {
+
+/* Builds single-channel signed distance field from 8-bit coverage bitmap
+ *
+ * Result has size (width + radius * 2) x (height + radius * 2) with tight rows, edge of the
+ * glyph is at value 128, values above are inside. Partial coverage is used for sub-pixel
+ * edge position, distances are computed with exact euclidean distance transform.
+ *
+ * Negative pitch means bottom-up bitmap, like in FreeType
+ */
+SP_PUBLIC bool makeDistanceField(Bytes &target, const uint8_t *bitmap, uint32_t width,
+		uint32_t height, int32_t pitch, uint32_t radius);
+
+} // namespace stappler::xenolith::font
+
+#endif /* XENOLITH_FONT_XLFONTDISTANCEFIELD_H_ */
@@ -25,7 +25,7 @@
 
 namespace STAPPLER_VERSIONIZED stappler::xenolith::font {
 
-TextLayout::~TextLayout() { }
+TextLayout::~TextLayout() { releaseGlyphs(); }
 
 TextLayout::TextLayout(FontController *h, size_t nchars, size_t nranges) : _handle(h) {
 	if (nchars) {
@@ -40,6 +40,7 @@ TextLayout::TextLayout(FontController *h, size_t nchars, size_t nranges) : _hand
 void TextLayout::reserve(size_t nchars, size_t nranges) { _data.reserve(nchars, nranges); }
 
 void TextLayout::clear() {
+	releaseGlyphs();
 	_data.chars.clear();
 	_data.lines.clear();
 	_data.ranges.clear();
@@ -54,6 +55,19 @@ Rc<FontFaceSet> TextLayout::getLayout(const FontParameters &f) {
 	return font;
 }
 
+bool TextLayout::retainGlyphs() {
+	if (!_handle) {
+		return false;
+	}
+	return _handle->retainGlyphs(_glyphs, _data.chars);
+}
+
+void TextLayout::releaseGlyphs() {
+	if (_handle) {
+		_handle->releaseGlyphs(_glyphs);
+	}
+}
+
 RangeLineIterator TextLayout::begin() const { return _data.begin(); }
 
 RangeLineIterator TextLayout::end() const { return _data.end(); }
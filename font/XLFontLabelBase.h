@@ -52,6 +52,11 @@ public:
 
 	Rc<FontFaceSet> getLayout(const FontParameters &f);
 
+	// Marks glyphs of the layout as used in atlas until released or layout destroyed,
+	// returns true if some of them were evicted before
+	bool retainGlyphs();
+	void releaseGlyphs();
+
 	RangeLineIterator begin() const;
 	RangeLineIterator end() const;
 
@@ -83,6 +88,7 @@ protected:
 	TextLayoutData<memory::StandartInterface> _data;
 	Rc<FontController> _handle;
 	Set<Rc<FontFaceSet>> _fonts;
+	Vector<uint32_t> _glyphs;
 };
 
 class SP_PUBLIC LabelBase {
@@ -23,7 +23,9 @@
 
 #include "XLFontComponent.h"
 #include "XLCoreFrameQueue.h"
+#include "XLCoreTrace.h"
 #include "XLFontDeferredRequest.h"
+#include "XLFontDistanceField.h"
 #include "SPFontEmplace.h"
 
 #if MODULE_XENOLITH_BACKEND_VK
@@ -46,12 +48,18 @@ struct RenderFontCharPersistentData {
 	uint32_t objectId;
 	uint32_t bufferIdx;
 	uint32_t offset;
+	uint32_t size = 0;
+
+	// last atlas update, that requested this char
+	uint32_t generation = 0;
 };
 
 struct RenderFontPersistentBufferUserdata : public Ref {
 	Rc<DeviceMemoryPool> mempool;
 	Vector<Rc<Buffer>> buffers;
 	HashMap<uint32_t, RenderFontCharPersistentData> chars;
+	font::FontRenderMode mode = font::FontRenderMode::Coverage;
+	uint32_t generation = 0;
 };
 
 class FontAttachment : public core::GenericAttachment {
@@ -86,6 +94,9 @@ public:
 	const Vector<VkBufferCopy> &getCopyToPersistentBufferData() const {
 		return _copyToPersistentBufferData;
 	}
+	const Map<Buffer *, Vector<VkBufferCopy>> &getCompactionData() const {
+		return _compactionData;
+	}
 
 protected:
 	void doSubmitInput(FrameHandle &, Function<void(bool)> &&cb, Rc<font::RenderFontInput> &&d);
@@ -95,7 +106,11 @@ protected:
 	uint32_t nextPersistentTransferOffset(size_t blockSize);
 
 	bool addPersistentCopy(uint16_t fontId, char32_t);
+
+	// Moves recently used persistent chars into new buffer, when old ones are too fragmented
+	bool compactPersistentBuffers();
 	void pushCopyTexture(uint32_t reqIdx, const font::CharTexture &texData);
+	void writeCopyTexture(uint32_t reqIdx, const font::CharTexture &texData);
 	void pushAtlasTexture(core::DataAtlas *, VkBufferImageCopy &);
 
 	Rc<font::RenderFontInput> _input;
@@ -116,7 +131,17 @@ protected:
 	Map<Buffer *, Vector<VkBufferImageCopy>> _copyFromPersistentBufferData;
 	Vector<VkBufferCopy> _copyToPersistentBufferData;
 	Vector<RenderFontCharPersistentData> _copyPersistentCharData;
+	Map<Buffer *, Vector<VkBufferCopy>> _compactionData;
+	Vector<Rc<Buffer>> _retiredBuffers; // keep compacted buffers until frame is complete
+	uint32_t _generation = 0;
 	Vector<RenderFontCharTextureData> _textureTarget;
+
+	// font id and char for every texture target, used to bind glyphs to scaled faces
+	Vector<Pair<uint16_t, char32_t>> _textureSource;
+
+	// font id -> faces, that reuse its glyphs with scale (FontRenderMode::DistanceField)
+	Map<uint16_t, SpanView<Pair<uint16_t, float>>> _scaledFaces;
+	uint32_t _scaledFacesCount = 0;
 	Extent2 _imageExtent;
 	Mutex _mutex;
 	Function<void(bool)> _onInput;
@@ -284,16 +309,28 @@ void FontAttachmentHandle::doSubmitInput(FrameHandle &handle, Function<void(bool
 	_input = d;
 	if (auto instance = d->image->getInstance()) {
 		if (auto ud = instance->userdata.cast<RenderFontPersistentBufferUserdata>()) {
-			_userdata = ud;
+			// persistent glyphs, rendered in other mode, can not be reused
+			if (ud->mode == _input->mode) {
+				_userdata = ud;
+			}
 		}
 	}
 
+	_generation = _userdata ? _userdata->generation + 1 : 1;
+
 	// process persistent chars
 	bool underlinePersistent = false;
 	uint32_t totalCount = 0;
-	for (auto &it : _input->requests) { totalCount += it.chars.size(); }
+	for (auto &it : _input->requests) {
+		totalCount += it.chars.size();
+		if (!it.scaledFaces.empty()) {
+			_scaledFaces.emplace(it.object->getId(), it.scaledFaces);
+			_scaledFacesCount += it.chars.size() * it.scaledFaces.size();
+		}
+	}
 
 	_textureTarget.resize(totalCount + 1); // used in addPersistentCopy
+	_textureSource.resize(totalCount + 1);
 
 	uint32_t extraPersistent = 0;
 	uint32_t processedPersistent = 0;
@@ -314,6 +351,8 @@ void FontAttachmentHandle::doSubmitInput(FrameHandle &handle, Function<void(bool
 		if (addPersistentCopy(font::CharId::SourceMax, 0)) {
 			underlinePersistent = true;
 		}
+
+		compactPersistentBuffers();
 	} else {
 		for (auto &it : _input->requests) {
 			if (it.persistent) {
@@ -347,6 +386,7 @@ void FontAttachmentHandle::doSubmitInput(FrameHandle &handle, Function<void(bool
 
 		if (!_userdata) {
 			_userdata = Rc<RenderFontPersistentBufferUserdata>::alloc();
+			_userdata->mode = _input->mode;
 			_userdata->mempool = Rc<DeviceMemoryPool>::create(memPool->getAllocator(), false);
 			_userdata->buffers.emplace_back(_userdata->mempool->spawn(AllocationUsage::DeviceLocal,
 					core::BufferInfo(core::ForceBufferUsage(core::BufferUsage::TransferSrc
@@ -356,6 +396,7 @@ void FontAttachmentHandle::doSubmitInput(FrameHandle &handle, Function<void(bool
 		} else {
 			auto tmp = move(_userdata);
 			_userdata = Rc<RenderFontPersistentBufferUserdata>::alloc();
+			_userdata->mode = tmp->mode;
 			_userdata->mempool = tmp->mempool;
 			_userdata->chars = tmp->chars;
 			_userdata->buffers = tmp->buffers;
@@ -366,16 +407,27 @@ void FontAttachmentHandle::doSubmitInput(FrameHandle &handle, Function<void(bool
 		}
 	}
 
+	auto traceStart =
+			core::Trace::isEnabled() ? sp::platform::clock(ClockType::Monotonic) : uint64_t(0);
+
 	font::DeferredRequest::runFontRenderer(_input->queue, _input->ext, _input->requests,
 			[this](uint32_t reqIdx, const font::CharTexture &texData) {
 		pushCopyTexture(reqIdx, texData);
-	}, [this, handle = Rc<FrameHandle>(&handle), underlinePersistent] {
+	}, [this, handle = Rc<FrameHandle>(&handle), underlinePersistent, traceStart] {
+		if (traceStart) {
+			core::Trace::addSpan(core::TraceCategory::Font, "FontRenderer", traceStart,
+					sp::platform::clock(ClockType::Monotonic) - traceStart, handle->getOrder());
+		}
 		writeAtlasData(*handle, underlinePersistent);
 	});
 }
 
 void FontAttachmentHandle::writeAtlasData(FrameHandle &handle, bool underlinePersistent) {
 	Vector<SpanView<VkBufferImageCopy>> commands;
+	if (_userdata) {
+		_userdata->generation = _generation;
+	}
+
 	if (!underlinePersistent) {
 		// write single white pixel for underlines
 		auto offset = _frontBuffer->reserveBlock(1, _optimalTextureAlignment);
@@ -392,16 +444,24 @@ void FontAttachmentHandle::writeAtlasData(FrameHandle &handle, bool underlinePer
 
 			auto targetOffset = _persistentTargetBuffer->reserveBlock(1, _optimalTextureAlignment);
 			_textureTarget[texOffset] = RenderFontCharTextureData{0, 0, 1, 1};
+			_textureSource[texOffset] = pair(font::CharId::SourceMax, char32_t(0));
 			_copyToPersistentBufferData[_copyToPersistentBufferData.size() - 1] =
 					VkBufferCopy({offset, targetOffset, 1});
 			_copyPersistentCharData[_copyPersistentCharData.size() - 1] =
 					RenderFontCharPersistentData{RenderFontCharTextureData{0, 0, 1, 1}, objectId, 0,
-						uint32_t(targetOffset)};
+						uint32_t(targetOffset), 1, _generation};
 		}
 	}
 
+	// drop persistent copies, that was not written (empty glyphs or persistent buffer overflow)
+	std::erase_if(_copyToPersistentBufferData, [](const VkBufferCopy &c) { return c.size == 0; });
+
 	// fill new persistent chars
 	for (auto &it : _copyPersistentCharData) {
+		if (it.size == 0) {
+			continue;
+		}
+
 		it.bufferIdx = uint32_t(_userdata->buffers.size() - 1);
 		auto cIt = _userdata->chars.find(it.objectId);
 		if (cIt == _userdata->chars.end()) {
@@ -419,8 +479,8 @@ void FontAttachmentHandle::writeAtlasData(FrameHandle &handle, bool underlinePer
 		_imageExtent = FontAttachmentHandle_buildTextureData(commands);
 
 		auto atlas = Rc<core::DataAtlas>::create(core::DataAtlas::ImageAtlas,
-				uint32_t(_copyFromTmpBufferData.size() * 4), uint32_t(sizeof(font::FontAtlasValue)),
-				_imageExtent);
+				uint32_t((_copyFromTmpBufferData.size() + _scaledFacesCount) * 4),
+				uint32_t(sizeof(font::FontAtlasValue)), _imageExtent);
 
 		for (auto &c : commands) {
 			for (auto &it : c) { pushAtlasTexture(atlas, const_cast<VkBufferImageCopy &>(it)); }
@@ -463,12 +523,114 @@ bool FontAttachmentHandle::addPersistentCopy(uint16_t fontId, char32_t theChar)
 			VkExtent3D({it->second.texture.width, it->second.texture.height, 1})});
 
 		_textureTarget[texTarget] = it->second.texture;
+		_textureSource[texTarget] = pair(fontId, theChar);
+		it->second.generation = _generation;
 		return true;
 	}
 	return false;
 }
 
+bool FontAttachmentHandle::compactPersistentBuffers() {
+	uint64_t reserved = 0;
+	for (auto &it : _userdata->buffers) {
+		reserved += std::min(it->getReservedSize(), it->getSize());
+	}
+
+	auto isUsed = [&](const RenderFontCharPersistentData &data) {
+		return data.size > 0 && _generation - data.generation < config::FontPersistentUnusedUpdates;
+	};
+
+	uint64_t used = 0;
+	for (auto &it : _userdata->chars) {
+		if (isUsed(it.second)) {
+			used += math::align(uint64_t(it.second.size), _optimalTextureAlignment);
+		}
+	}
+
+	if (reserved == 0 || used >= reserved) {
+		return false;
+	}
+
+	auto fragmentation = 1.0f - float(used) / float(reserved);
+	auto nearlyFull = reserved > CopyBlockSize * 3 / 4;
+	if (!nearlyFull
+			&& (reserved < config::FontPersistentCompactionMinSize
+					|| fragmentation < config::FontPersistentCompactionThreshold)) {
+		return false;
+	}
+
+	auto tmp = move(_userdata);
+	_userdata = Rc<RenderFontPersistentBufferUserdata>::alloc();
+	_userdata->mode = tmp->mode;
+	_userdata->mempool = tmp->mempool;
+	_userdata->generation = tmp->generation;
+
+	auto buffer = _userdata->mempool->spawn(AllocationUsage::DeviceLocal,
+			core::BufferInfo(core::ForceBufferUsage(core::BufferUsage::TransferSrc
+									 | core::BufferUsage::TransferDst),
+					size_t(CopyBlockSize)));
+	_userdata->buffers.emplace_back(buffer);
+
+	for (auto &it : tmp->chars) {
+		if (!isUsed(it.second)) {
+			continue;
+		}
+
+		auto offset = buffer->reserveBlock(it.second.size, _optimalTextureAlignment);
+		if (offset == maxOf<uint64_t>()) {
+			break;
+		}
+
+		auto &source = tmp->buffers[it.second.bufferIdx];
+		_compactionData[source.get()].emplace_back(
+				VkBufferCopy{it.second.offset, offset, it.second.size});
+
+		auto data = it.second;
+		data.bufferIdx = 0;
+		data.offset = uint32_t(offset);
+		_userdata->chars.emplace(it.first, data);
+	}
+
+	log::source().debug("FontAttachmentHandle", "Persistent buffer compacted: ", reserved, " -> ",
+			buffer->getReservedSize(), " bytes, chars: ", tmp->chars.size(), " -> ",
+			_userdata->chars.size());
+
+	_retiredBuffers = sp::move(tmp->buffers);
+	_persistentTargetBuffer = buffer;
+	return true;
+}
+
 void FontAttachmentHandle::pushCopyTexture(uint32_t reqIdx, const font::CharTexture &texData) {
+	if (_input->mode != font::FontRenderMode::DistanceField || !texData.bitmap
+			|| texData.bitmapWidth == 0 || texData.bitmapRows == 0) {
+		writeCopyTexture(reqIdx, texData);
+		return;
+	}
+
+	// Glyph is rendered in base size, distance field extends it with spread on each side
+	constexpr auto radius = config::FontDistanceFieldRadius;
+
+	Bytes field;
+	if (!font::makeDistanceField(field, texData.bitmap, texData.bitmapWidth, texData.bitmapRows,
+				texData.pitch, radius)) {
+		writeCopyTexture(reqIdx, texData);
+		return;
+	}
+
+	auto fieldData = texData;
+	fieldData.x -= radius;
+	fieldData.y -= radius;
+	fieldData.width += radius * 2;
+	fieldData.height += radius * 2;
+	fieldData.bitmapWidth += radius * 2;
+	fieldData.bitmapRows += radius * 2;
+	fieldData.pitch = fieldData.bitmapWidth;
+	fieldData.bitmap = field.data();
+
+	writeCopyTexture(reqIdx, fieldData);
+}
+
+void FontAttachmentHandle::writeCopyTexture(uint32_t reqIdx, const font::CharTexture &texData) {
 	if (texData.width != texData.bitmapWidth || texData.height != texData.bitmapRows) {
 		log::source().error("FontAttachmentHandle", "Invalid size: ", texData.width, ";",
 				texData.height, " vs. ", texData.bitmapWidth, ";", texData.bitmapRows, "\n");
@@ -502,15 +664,22 @@ void FontAttachmentHandle::pushCopyTexture(uint32_t reqIdx, const font::CharText
 				VkOffset3D({0, 0, 0}), VkExtent3D({texData.bitmapWidth, texData.bitmapRows, 1})});
 	_textureTarget[texOffset] =
 			RenderFontCharTextureData{texData.x, texData.y, texData.width, texData.height};
+	_textureSource[texOffset] = pair(texData.fontID, texData.charID);
 
 	if (_input->requests[reqIdx].persistent) {
 		auto targetIdx = _copyToPersistentOffset.fetch_add(1);
 		auto targetOffset = _persistentTargetBuffer->reserveBlock(size, _optimalTextureAlignment);
+		if (targetOffset == maxOf<uint64_t>()) {
+			// char stays non-persistent, buffer will be compacted on next updates
+			log::source().warn("FontAttachmentHandle", "Not enough space in persistent buffer");
+			return;
+		}
+
 		_copyToPersistentBufferData[targetIdx] =
 				VkBufferCopy({offset, targetOffset, VkDeviceSize(size)});
 		_copyPersistentCharData[targetIdx] = RenderFontCharPersistentData{
 			RenderFontCharTextureData{texData.x, texData.y, texData.width, texData.height},
-			objectId, 0, uint32_t(targetOffset)};
+			objectId, 0, uint32_t(targetOffset), size, _generation};
 	}
 }
 
@@ -524,10 +693,20 @@ void FontAttachmentHandle::pushAtlasTexture(core::DataAtlas *atlas, VkBufferImag
 
 	auto &tex = _textureTarget[texOffset];
 
-	const float x = float(d.imageOffset.x);
-	const float y = float(d.imageOffset.y);
-	const float w = float(d.imageExtent.width);
-	const float h = float(d.imageExtent.height);
+	float x = float(d.imageOffset.x);
+	float y = float(d.imageOffset.y);
+	float w = float(d.imageExtent.width);
+	float h = float(d.imageExtent.height);
+
+	auto &source = _textureSource[texOffset];
+	if (_input->mode == font::FontRenderMode::DistanceField
+			&& source.first == font::CharId::SourceMax) {
+		// linear filtering of a single pixel on the edge should not blend with neighbours
+		x += 0.5f;
+		y += 0.5f;
+		w = 0.0f;
+		h = 0.0f;
+	}
 
 	data[0].pos = Vec2(tex.x, -tex.y);
 	data[0].tex = Vec2(x / _imageExtent.width, y / _imageExtent.height);
@@ -545,6 +724,30 @@ void FontAttachmentHandle::pushAtlasTexture(core::DataAtlas *atlas, VkBufferImag
 	atlas->addObject(font::CharId::rebindCharId(id, font::CharAnchor::TopLeft), &data[1]);
 	atlas->addObject(font::CharId::rebindCharId(id, font::CharAnchor::TopRight), &data[2]);
 	atlas->addObject(font::CharId::rebindCharId(id, font::CharAnchor::BottomRight), &data[3]);
+
+	auto scaledIt = _scaledFaces.find(source.first);
+	if (scaledIt == _scaledFaces.end()) {
+		return;
+	}
+
+	for (auto &face : scaledIt->second) {
+		font::FontAtlasValue scaled[4];
+		for (size_t i = 0; i < 4; ++i) {
+			scaled[i].pos = data[i].pos * face.second;
+			scaled[i].tex = data[i].tex;
+		}
+
+		auto scaledId = font::CharId::getCharId(face.first, source.second,
+				font::CharAnchor::BottomLeft);
+		atlas->addObject(font::CharId::rebindCharId(scaledId, font::CharAnchor::BottomLeft),
+				&scaled[0]);
+		atlas->addObject(font::CharId::rebindCharId(scaledId, font::CharAnchor::TopLeft),
+				&scaled[1]);
+		atlas->addObject(font::CharId::rebindCharId(scaledId, font::CharAnchor::TopRight),
+				&scaled[2]);
+		atlas->addObject(font::CharId::rebindCharId(scaledId, font::CharAnchor::BottomRight),
+				&scaled[3]);
+	}
 }
 
 FontRenderPass::~FontRenderPass() { }
@@ -621,6 +824,7 @@ Vector<const core::CommandBuffer *> FontRenderPassHandle::doPrepareCommands(Fram
 	auto &copyFromTmp = _fontAttachment->getCopyFromTmpBufferData();
 	auto &copyFromPersistent = _fontAttachment->getCopyFromPersistentBufferData();
 	auto &copyToPersistent = _fontAttachment->getCopyToPersistentBufferData();
+	auto &compaction = _fontAttachment->getCompactionData();
 
 	auto &masterImage = input->image;
 	auto instance = masterImage->getInstance();
@@ -675,6 +879,12 @@ Vector<const core::CommandBuffer *> FontRenderPassHandle::doPrepareCommands(Fram
 				it.first->dropPendingBarrier();
 			}
 		}
+		for (auto &it : compaction) {
+			if (auto b = it.first->getPendingBarrier()) {
+				persistentBarriers.emplace_back(*b);
+				it.first->dropPendingBarrier();
+			}
+		}
 
 		ImageMemoryBarrier inputBarrier(_targetImage, 0, VK_ACCESS_MEMORY_WRITE_BIT,
 				VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
@@ -708,14 +918,22 @@ Vector<const core::CommandBuffer *> FontRenderPassHandle::doPrepareCommands(Fram
 					it.second);
 		}
 
-		if (!copyToPersistent.empty()) {
+		if (!copyToPersistent.empty() || !compaction.empty()) {
 			if (auto b = _fontAttachment->getPersistentTargetBuffer()->getPendingBarrier()) {
 				buf.cmdPipelineBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT,
 						VK_PIPELINE_STAGE_TRANSFER_BIT, 0, makeSpanView(b, 1));
 			}
 
-			buf.cmdCopyBuffer(_fontAttachment->getTmpBuffer(),
-					_fontAttachment->getPersistentTargetBuffer(), copyToPersistent);
+			// move used chars from fragmented buffers into compacted one
+			for (auto &it : compaction) {
+				buf.cmdCopyBuffer(it.first, _fontAttachment->getPersistentTargetBuffer(),
+						it.second);
+			}
+
+			if (!copyToPersistent.empty()) {
+				buf.cmdCopyBuffer(_fontAttachment->getTmpBuffer(),
+						_fontAttachment->getPersistentTargetBuffer(), copyToPersistent);
+			}
 			_fontAttachment->getPersistentTargetBuffer()->setPendingBarrier(BufferMemoryBarrier(
 					_fontAttachment->getPersistentTargetBuffer(), VK_ACCESS_TRANSFER_WRITE_BIT,
 					VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT,
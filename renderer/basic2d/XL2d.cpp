@@ -25,6 +25,7 @@
 
 #include "XL2dCommandList.cc"
 #include "XL2dVertexArray.cc"
+#include "XL2dVertexKernels.cc"
 #include "XL2dFrameContext.cc"
 
 #include "XL2dSprite.cc"
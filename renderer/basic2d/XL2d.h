@@ -40,6 +40,8 @@ using glsl::VertexConstantData;
 using glsl::PSDFConstantData;
 
 using glsl::Vertex;
+using glsl::CompactVertex;
+using glsl::QuadInstance;
 using glsl::MaterialData;
 using glsl::TransformData;
 using glsl::ShadowData;
@@ -93,11 +95,44 @@ struct VertexSpan {
 	uint32_t gradientCount = 0;
 	float outlineOffset = 0;
 	uint64_t particleSystemId = 0;
+
+	// when not 0, span is drawn without indexes as instanced quads,
+	// vertexOffset is used as first vertex
+	uint32_t vertexCount = 0;
+
+	// vertexes are in full layout, while material uses compact vertexes
+	bool fullVertexes = false;
 };
 
 struct alignas(16) VertexData : public Ref {
 	Vector<Vertex> data;
 	Vector<uint32_t> indexes;
+
+	enum class QuadLayout : uint8_t {
+		None, // data can not be written as QuadInstance records
+		Plain, // quads without atlas objects
+		Objects, // quads with atlas objects, encoded as corner deltas
+	};
+
+	// Corner objects as QuadInstance deltas, false if they can not be encoded
+	static bool getObjectDeltas(const Vertex *, uint32_t &);
+
+	// data is a sequence of quads in VertexArray layout (tl bl tr br, indexes 0 1 2 3 2 1),
+	// such data can be drawn as instanced quads
+	bool quads = false;
+
+	// verdict for vertex pass, updated by VertexArray::pop when data was changed
+	QuadLayout quadLayout = QuadLayout::None;
+
+	// data can be written as CompactVertex without loss: 2d position, color and UV within
+	// [0, 1]; when false, data is written in full layout even for compact materials
+	bool compactLayout = false;
+
+	void updateQuadLayout();
+	void updateCompactLayout();
+
+	// 2d bounds of vertex positions with transform applied, empty rect for empty data
+	Rect getBounds(const Mat4 & = Mat4::IDENTITY) const;
 };
 
 struct InstanceVertexData {
@@ -218,6 +253,9 @@ struct SP_PUBLIC WindowDecorationsInput {
 	Vec2 shadowOffset;
 	ViewConstraints viewConstraints = ViewConstraints::None;
 	bool drawUserShadows = false;
+
+	bool operator==(const WindowDecorationsInput &) const = default;
+	bool operator!=(const WindowDecorationsInput &) const = default;
 };
 
 } // namespace stappler::xenolith::basic2d
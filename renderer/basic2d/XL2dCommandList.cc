@@ -94,6 +94,96 @@ void CmdSdfGroup2D::addPolygon2D(SpanView<Vec2> view) {
 		BytesView(reinterpret_cast<const uint8_t *>(polygon), sizeof(SdfPolygon2D))});
 }
 
+static void DrawOrder_sortKeys(memory::vector<Pair<uint64_t, uint32_t>> &keys) {
+	memory::vector<Pair<uint64_t, uint32_t>> tmp;
+	tmp.resize(keys.size());
+
+	// stable LSD radix sort by bytes, passes with the same byte in all keys are skipped
+	for (uint32_t shift = 0; shift < 64; shift += 8) {
+		std::array<uint32_t, 256> offsets;
+		offsets.fill(0);
+
+		for (auto &it : keys) { ++offsets[(it.first >> shift) & 0xFF]; }
+
+		if (offsets[(keys.front().first >> shift) & 0xFF] == keys.size()) {
+			continue;
+		}
+
+		uint32_t offset = 0;
+		for (auto &it : offsets) {
+			auto count = it;
+			it = offset;
+			offset += count;
+		}
+
+		for (auto &it : keys) { tmp[offsets[(it.first >> shift) & 0xFF]++] = it; }
+
+		keys.swap(tmp);
+	}
+}
+
+void DrawOrder::sort(SpanView<Command> commands) {
+	paths.clear();
+	ranks.clear();
+	keys.clear();
+
+	if (commands.empty()) {
+		return;
+	}
+
+	ZOrderLess zLess;
+
+	// rank z-paths, equal paths share the rank
+	memory::vector<uint32_t> order;
+	order.resize(commands.size());
+	for (uint32_t i = 0; i < order.size(); ++i) { order[i] = i; }
+
+	std::sort(order.begin(), order.end(), [&](uint32_t l, uint32_t r) {
+		return zLess(commands[l].info->zPath, commands[r].info->zPath);
+	});
+
+	ranks.resize(commands.size());
+	for (auto idx : order) {
+		auto &zPath = commands[idx].info->zPath;
+		if (paths.empty() || zLess(paths.back(), zPath)) {
+			paths.emplace_back(zPath);
+		}
+		ranks[idx] = uint32_t(paths.size() - 1);
+	}
+
+	memory::vector<uint64_t> materials;
+	memory::vector<StateId> states;
+	materials.reserve(commands.size());
+	states.reserve(commands.size());
+
+	for (auto &it : commands) {
+		materials.emplace_back(it.material);
+		states.emplace_back(it.info->state);
+	}
+
+	std::sort(materials.begin(), materials.end());
+	materials.erase(std::unique(materials.begin(), materials.end()), materials.end());
+
+	std::sort(states.begin(), states.end());
+	states.erase(std::unique(states.begin(), states.end()), states.end());
+
+	keys.reserve(commands.size());
+	for (uint32_t i = 0; i < commands.size(); ++i) {
+		auto &it = commands[i];
+		auto materialRank = std::lower_bound(materials.begin(), materials.end(), it.material)
+				- materials.begin();
+		auto stateRank = std::lower_bound(states.begin(), states.end(), it.info->state)
+				- states.begin();
+
+		keys.emplace_back((uint64_t(it.level) << KeyLevelShift)
+						| (uint64_t(it.ordered ? ranks[i] : 0) << KeyPathShift)
+						| (uint64_t(materialRank) << KeyMaterialShift) | uint64_t(stateRank),
+				i);
+	}
+
+	DrawOrder_sortKeys(keys);
+}
+
 Command *Command::create(memory::pool_t *p, CommandType t, CommandFlags f) {
 	auto commandSize = sizeof(Command);
 
@@ -79,6 +79,37 @@ struct SP_PUBLIC CmdSdfGroup2D {
 	void addPolygon2D(SpanView<Vec2>);
 };
 
+/* Draw order for command stream
+ *
+ * Commands are ranked by z-path, material and state, ranks are packed into 64-bit keys: level
+ * (2 bits), z-path rank (22 bits, only for ordered commands), material rank (20 bits) and state
+ * rank (20 bits). Keys are sorted with stable radix sort, so commands with equal keys keep
+ * submission order. Containers are allocated from current memory pool.
+ */
+struct SP_PUBLIC DrawOrder {
+	static constexpr uint32_t KeyLevelShift = 62;
+	static constexpr uint32_t KeyPathShift = 40;
+	static constexpr uint32_t KeyMaterialShift = 20;
+
+	struct Command {
+		const CmdInfo *info = nullptr;
+		uint64_t material = 0; // material layout index in high 32 bits, material id in low
+		uint8_t level = 0; // levels are drawn in ascending order
+		bool ordered = false; // z-path is the part of key
+	};
+
+	// unique z-paths in ZOrderLess order
+	memory::vector<SpanView<ZOrder>> paths;
+
+	// z-path rank for every command
+	memory::vector<uint32_t> ranks;
+
+	// key and command index, in draw order
+	memory::vector<Pair<uint64_t, uint32_t>> keys;
+
+	void sort(SpanView<Command>);
+};
+
 struct SP_PUBLIC Command {
 	static Command *create(memory::pool_t *, CommandType t, CommandFlags = CommandFlags::None);
 
@@ -90,6 +90,10 @@ void FrameContext2d::submitHandle(FrameInfo &frame, FrameContextHandle *handle)
 	if (_materialDependency) {
 		handle->waitDependencies.emplace_back(_materialDependency);
 	}
+	if (_submittedMaterialDependency) {
+		// materials from previous frame can still be in compilation, when frames are pipelined
+		handle->waitDependencies.emplace_back(_submittedMaterialDependency);
+	}
 
 	frame.director->getGlLoop()->performOnThread(
 			[this, req = frame.request, q = _queue, dir = frame.director,
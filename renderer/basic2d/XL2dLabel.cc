@@ -319,6 +319,7 @@ void Label::handleEnter(xenolith::Scene *scene) {
 	Sprite::handleEnter(scene);
 
 	if (_source) {
+		updateRenderMode();
 		return;
 	}
 
@@ -337,10 +338,18 @@ void Label::handleEnter(xenolith::Scene *scene) {
 		}
 
 		_source = source;
+		updateRenderMode();
 	}
 }
 
-void Label::handleExit() { Sprite::handleExit(); }
+void Label::handleExit() {
+	// glyphs of detached label can be evicted from atlas, request them again on enter
+	if (_format) {
+		_format->releaseGlyphs();
+		_vertexesDirty = true;
+	}
+	Sprite::handleExit();
+}
 
 void Label::tryUpdateLabel() {
 	if (_parent) {
@@ -489,20 +498,58 @@ NodeVisitFlags Label::processParentFlags(FrameInfo &info, NodeVisitFlags parentF
 }
 
 void Label::pushCommands(FrameInfo &frame, NodeVisitFlags flags) {
+	if (!_deferred && !_distanceField) {
+		Sprite::pushCommands(frame, flags);
+		return;
+	}
+
+	auto normalized = _normalized;
+	auto model = frame.modelTransformStack.back();
+	if (_distanceField) {
+		// layout is made for the screen density, glyphs follow transform scale without relayout
+		normalized = false;
+		model.scale(1.0f / _labelDensity, 1.0f / _labelDensity, 1.0f);
+	}
+
+	FrameContextHandle2d *handle = static_cast<FrameContextHandle2d *>(frame.currentContext);
+
 	if (_deferred) {
 		if (!_deferredResult
 				|| (_deferredResult->isReady() && _deferredResult->getResult()->data.empty())) {
 			return;
 		}
 
-		FrameContextHandle2d *handle = static_cast<FrameContextHandle2d *>(frame.currentContext);
-
 		handle->commands->pushDeferredVertexResult(_deferredResult,
-				frame.viewProjectionStack.back(), frame.modelTransformStack.back(), _normalized,
+				frame.viewProjectionStack.back(), model, normalized, buildCmdInfo(frame),
+				_commandFlags);
+	} else {
+		auto data = _vertexes.pop();
+		handle->commands->pushVertexArray(data.get(), frame.viewProjectionStack.back() * model,
 				buildCmdInfo(frame), _commandFlags);
+	}
+}
+
+bool Label::updateVertexBounds() {
+	// same transform as in pushCommands
+	Mat4 transform;
+	if (_distanceField) {
+		transform.scale(1.0f / _labelDensity, 1.0f / _labelDensity, 1.0f);
+	}
+
+	if (!_deferred) {
+		_vertexBounds = _vertexes.getBounds(transform);
+	} else if (_deferredResult) {
+		if (!_deferredResult->isReady()) {
+			return false;
+		}
+		_deferredResult->acquireResult(
+				[&, this](SpanView<InstanceVertexData> data, DeferredVertexResult::Flags) {
+			_vertexBounds = getInstanceBounds(data, transform);
+		});
 	} else {
-		Sprite::pushCommands(frame, flags);
+		_vertexBounds = Rect();
 	}
+	return true;
 }
 
 void Label::updateLabelScale(const Mat4 &parent) {
@@ -520,6 +567,10 @@ void Label::updateLabelScale(const Mat4 &parent) {
 	}
 
 	auto density = std::min(std::min(scale.x, scale.y), scale.z);
+	if (_distanceField && _director) {
+		density = _director->getFrameConstraints().density;
+	}
+
 	if (density != _labelDensity) {
 		_labelDensity = density;
 		setLabelDirty();
@@ -588,6 +639,8 @@ void Label::updateVertexes(FrameInfo &frame) {
 		}
 	}
 
+	_format->retainGlyphs();
+
 	if (_deferred) {
 		_deferredResult =
 				runDeferred(_director->getApplication()->getLooper(), _format, _displayedColor);
@@ -601,6 +654,7 @@ void Label::updateVertexes(FrameInfo &frame) {
 }
 
 void Label::onFontSourceUpdated() {
+	updateRenderMode();
 	setLabelDirty();
 	_vertexesDirty = true;
 }
@@ -608,11 +662,26 @@ void Label::onFontSourceUpdated() {
 void Label::onFontSourceLoaded() {
 	if (_source) {
 		setTexture(Rc<Texture>(_source->getTexture()));
+		updateRenderMode();
 		_vertexesDirty = true;
 		setLabelDirty();
 	}
 }
 
+void Label::updateRenderMode() {
+	auto distanceField = _source && _source->isLoaded()
+			&& _source->getRenderMode() == font::FontRenderMode::DistanceField;
+	if (distanceField == _distanceField) {
+		return;
+	}
+
+	setDistanceField(distanceField);
+	if (distanceField && _director) {
+		_labelDensity = _director->getFrameConstraints().density;
+	}
+	setLabelDirty();
+}
+
 void Label::onLayoutUpdated() { _labelDirty = false; }
 
 Vec2 Label::getCursorPosition(uint32_t charIndex, bool front) const {
@@ -184,8 +184,13 @@ protected:
 
 	virtual void pushCommands(FrameInfo &, NodeVisitFlags flags) override;
 
+	virtual bool updateVertexBounds() override;
+
 	void updateLabelScale(const Mat4 &parent);
 
+	// Enables distance field rendering, when font source uses FontRenderMode::DistanceField
+	void updateRenderMode();
+
 	EventListener *_listener = nullptr;
 	Time _quadRequestTime;
 	Rc<font::FontController> _source;
@@ -122,7 +122,9 @@ void Scene2d::FpsDisplay::update(const UpdateTime &) {
 				break;
 			case Cache:
 				str = toString(std::setprecision(3), "Cache:", stat.cachedFramebuffers, "/",
-						stat.cachedImages, "/", stat.cachedImageViews, "\nF12 to switch");
+						stat.cachedImages, "/", stat.cachedImageViews, "\nAlias: ",
+						stat.aliasedMemory, "KiB (-", stat.aliasingSavedMemory, "KiB)",
+						"\nF12 to switch");
 				break;
 			case Full:
 				str = toString(configData, " ", std::setprecision(3), "FPS: ", fps, " SPF: ", spf,
@@ -615,6 +615,14 @@ void SceneContent2d::draw(FrameInfo &info, NodeVisitFlags flags) {
 		ctx->decorations.viewConstraints =
 				core::getViewConstraints(_director->getWindow()->getWindowState());
 	}
+
+	auto lightsHash = hash::hash64(reinterpret_cast<const char *>(&ctx->lights),
+			sizeof(ShadowLightInput));
+	if (lightsHash != _lightsHash || ctx->decorations != _decorations) {
+		_lightsHash = lightsHash;
+		_decorations = ctx->decorations;
+		info.damage.setFull();
+	}
 }
 
 Vector<Rc<SceneLight>>::iterator SceneContent2d::removeLight(
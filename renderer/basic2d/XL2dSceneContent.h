@@ -116,6 +116,10 @@ protected:
 
 	Color4F _globalLight = Color4F(1.0f, 1.0f, 1.0f, 1.0f);
 
+	// lights and decorations affects the whole screen, so, it's changes are full damage
+	uint64_t _lightsHash = 0;
+	WindowDecorationsInput _decorations;
+
 	Vector<Function<void()>> _visitNotification;
 };
 
@@ -33,6 +33,14 @@
 
 namespace STAPPLER_VERSIONIZED stappler::xenolith::basic2d {
 
+static Rect Sprite_unionRect(const Rect &a, const Rect &b) {
+	auto minX = std::min(a.getMinX(), b.getMinX());
+	auto minY = std::min(a.getMinY(), b.getMinY());
+	auto maxX = std::max(a.getMaxX(), b.getMaxX());
+	auto maxY = std::max(a.getMaxY(), b.getMaxY());
+	return Rect(minX, minY, maxX - minX, maxY - minY);
+}
+
 Sprite::Sprite() {
 	_blendInfo = core::BlendInfo(core::BlendFactor::SrcAlpha, core::BlendFactor::OneMinusSrcAlpha,
 			core::BlendOp::Add, core::BlendFactor::Zero, core::BlendFactor::One,
@@ -183,6 +191,14 @@ bool Sprite::visitDraw(FrameInfo &frame, NodeVisitFlags parentFlags) {
 		if (loaded != _isTextureLoaded && loaded) {
 			handleTextureLoaded();
 			_isTextureLoaded = loaded;
+			_damaged = true;
+		}
+
+		// dynamic image was updated without changes in the sprite itself
+		auto gen = _texture->getDynamicGeneration();
+		if (gen != _textureGeneration) {
+			_textureGeneration = gen;
+			_damaged = true;
 		}
 	}
 	return Node::visitDraw(frame, parentFlags);
@@ -206,15 +222,25 @@ void Sprite::draw(FrameInfo &frame, NodeVisitFlags flags) {
 	if (checkVertexDirty()) {
 		updateVertexes(frame);
 		_vertexesDirty = false;
+		_vertexBoundsDirty = true;
+		_damaged = true;
+	}
+
+	if (_vertexBoundsDirty && updateVertexBounds()) {
+		// bounds can become available later than vertexes, redraw area with actual bounds
+		_vertexBoundsDirty = false;
+		_damaged = true;
 	}
 
 	if (_vertexColorDirty) {
 		updateVertexesColor();
 		_vertexColorDirty = false;
+		_damaged = true;
 	}
 
 	if (_materialDirty) {
 		updateBlendAndDepth();
+		_damaged = true;
 
 		auto info = getMaterialInfo();
 		_materialId = frame.currentContext->context->getMaterial(info);
@@ -332,6 +358,23 @@ void Sprite::setTextureLayer(float value) {
 	if (_textureLayer != value) {
 		_textureLayer = value;
 		_vertexesDirty = true;
+		if (_compactVertexes) {
+			_materialDirty = true;
+		}
+	}
+}
+
+void Sprite::setCompactVertexes(bool value) {
+	if (_compactVertexes != value) {
+		_compactVertexes = value;
+		_materialDirty = true;
+	}
+}
+
+void Sprite::setDistanceField(bool value) {
+	if (_distanceField != value) {
+		_distanceField = value;
+		_materialDirty = true;
 	}
 }
 
@@ -412,6 +455,13 @@ MaterialInfo Sprite::getMaterialInfo() const {
 	ret.samplers[0] = _samplerIdx.get();
 	ret.colorModes[0] = _colorMode;
 	ret.pipeline = _materialInfo;
+	if (_compactVertexes && _textureLayer == 0.0f) {
+		ret.flags |= core::MaterialFlags::CompactVertexes;
+	}
+	if (_distanceField) {
+		ret.samplers[0] = SamplerIndex::DefaultFilterLinear.get();
+		ret.flags |= core::MaterialFlags::DistanceField;
+	}
 	return ret;
 }
 
@@ -458,6 +508,37 @@ void Sprite::updateVertexes(FrameInfo &frame) {
 	_vertexColorDirty = false;
 }
 
+Rect Sprite::getDrawBounds() const {
+	auto ret = Node::getDrawBounds();
+	if (_vertexBounds.size.width > 0.0f && _vertexBounds.size.height > 0.0f) {
+		ret = Sprite_unionRect(ret, _vertexBounds);
+	}
+	return ret;
+}
+
+bool Sprite::updateVertexBounds() {
+	_vertexBounds = _vertexes.getBounds();
+	return true;
+}
+
+Rect Sprite::getInstanceBounds(SpanView<InstanceVertexData> data, const Mat4 &transform) {
+	Rect ret;
+	for (auto &it : data) {
+		if (!it.data) {
+			continue;
+		}
+		for (auto &inst : it.instances) {
+			auto bounds = it.data->getBounds(transform * inst.transform);
+			if (ret.size.width > 0.0f && ret.size.height > 0.0f) {
+				ret = Sprite_unionRect(ret, bounds);
+			} else {
+				ret = bounds;
+			}
+		}
+	}
+	return ret;
+}
+
 void Sprite::updateBlendAndDepth() {
 	bool shouldBlendColors = false;
 	bool shouldWriteDepth = false;
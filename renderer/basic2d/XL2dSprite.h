@@ -77,6 +77,16 @@ public:
 	virtual void setTextureLayer(float);
 	virtual float getTextureLayer() const { return _textureLayer; }
 
+	// Use compact vertex layout (2d position, RGBA8 color, unorm16 UV) for sprite material
+	// Ignored when texture layer is not 0; sprites with compact vertexes do not cast shadows
+	// Vertex data with UV or color outside [0, 1] is still written in full layout
+	virtual void setCompactVertexes(bool);
+	virtual bool isCompactVertexes() const { return _compactVertexes; }
+
+	// Texture contains signed distance field, sampled with linear filter and thresholded in shader
+	virtual void setDistanceField(bool);
+	virtual bool isDistanceField() const { return _distanceField; }
+
 	// used for debug purposes only, follow rules from PipelineMaterialInfo.lineWidth:
 	// 0.0f - draw triangles, < 0.0f - points,  > 0.0f - lines with width
 	// corresponding pipeline should be precompiled
@@ -138,6 +148,15 @@ protected:
 
 	virtual void doScheduleTextureUpdate(Rc<Texture> &&);
 
+	virtual Rect getDrawBounds() const override;
+
+	// Updates bounds of the sprite's vertexes, returns false if vertexes are not ready yet
+	// (like for deferred results), then it will be called again within next draw
+	virtual bool updateVertexBounds();
+
+	// Bounds of instanced vertex data, drawn with transform, in node's local coordinates
+	static Rect getInstanceBounds(SpanView<InstanceVertexData>, const Mat4 &);
+
 	String _textureName;
 	Rc<Texture> _texture;
 	VertexArray _vertexes;
@@ -148,6 +167,9 @@ protected:
 	bool _normalized = false;
 	bool _vertexesDirty = true;
 	bool _vertexColorDirty = true;
+	bool _vertexBoundsDirty = true;
+	bool _compactVertexes = false;
+	bool _distanceField = false;
 
 	bool _flippedX = false;
 	bool _flippedY = false;
@@ -158,6 +180,12 @@ protected:
 	float _textureLayer = 0.0f;
 	float _outlineOffset = 0.0f;
 
+	// compiled generation of the dynamic texture, that was last drawn
+	uint32_t _textureGeneration = 0;
+
+	// vertexes can be placed outside of the content rect, damage tracking should cover them
+	Rect _vertexBounds;
+
 	ImagePlacementInfo _texturePlacement;
 
 	// Track dynamic texture size
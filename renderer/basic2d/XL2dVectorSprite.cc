@@ -358,6 +358,23 @@ void VectorSprite::pushCommands(FrameInfo &frame, NodeVisitFlags flags) {
 	}
 }
 
+bool VectorSprite::updateVertexBounds() {
+	if (_result) {
+		_vertexBounds = getInstanceBounds(_result->mut, _imageTargetTransform);
+	} else if (_deferredResult) {
+		if (!_deferredResult->isReady()) {
+			return false;
+		}
+		_deferredResult->acquireResult(
+				[&, this](SpanView<InstanceVertexData> data, DeferredVertexResult::Flags) {
+			_vertexBounds = getInstanceBounds(data, _imageTargetTransform);
+		});
+	} else {
+		_vertexBounds = Rect();
+	}
+	return true;
+}
+
 void VectorSprite::initVertexes() {
 	// prevent to do anything
 }
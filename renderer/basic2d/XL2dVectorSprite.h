@@ -112,6 +112,8 @@ protected:
 
 	virtual bool checkVertexDirty() const override;
 
+	virtual bool updateVertexBounds() override;
+
 	bool _deferred = true;
 	bool _waitDeferred = true;
 	bool _imageIsSolid = false;
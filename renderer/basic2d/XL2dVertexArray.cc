@@ -25,6 +25,125 @@
 
 namespace STAPPLER_VERSIONIZED stappler::xenolith::basic2d {
 
+bool VertexData::getObjectDeltas(const Vertex *v, uint32_t &deltas) {
+	auto d1 = v[1].object ^ v[0].object;
+	auto d2 = v[2].object ^ v[0].object;
+	auto d3 = v[3].object ^ v[0].object;
+	auto diff = d1 | d2 | d3;
+	if (diff == 0) {
+		deltas = 0;
+		return true;
+	}
+
+	// corner objects should differ only within 8 bits window
+	auto shift = uint32_t(std::countr_zero(diff));
+	if ((diff >> shift) > 0xFF) {
+		return false;
+	}
+
+	deltas = (d1 >> shift) | (d2 >> shift) << 8 | (d3 >> shift) << 16 | shift << 24;
+	return true;
+}
+
+// QuadInstance stores color as RGBA8, so only colors, that are exact in RGBA8, can be used
+static bool VertexData_isColorRgba8(const Vec4 &color) {
+	auto isExact = [](float v) {
+		return v >= 0.0f && v <= 1.0f && float(std::nearbyint(v * 255.0f)) / 255.0f == v;
+	};
+	return isExact(color.x) && isExact(color.y) && isExact(color.z) && isExact(color.w);
+}
+
+// Every quad should be an axis-aligned rect with axis-aligned texture rect, single color and
+// layer. Texture coordinates are stored as unorm16, that is exact for atlases up to 64K texels
+void VertexData::updateQuadLayout() {
+	static constexpr uint32_t QuadIndexes[6] = {0, 1, 2, 3, 2, 1};
+
+	quadLayout = QuadLayout::None;
+
+	if (!quads || data.empty() || data.size() % 4 != 0 || indexes.size() != data.size() / 4 * 6) {
+		return;
+	}
+
+	auto isUnorm = [](const Vec2 &v) {
+		return v.x >= 0.0f && v.x <= 1.0f && v.y >= 0.0f && v.y <= 1.0f;
+	};
+
+	bool hasObjects = false;
+	for (uint32_t quad = 0; quad < data.size() / 4; ++quad) {
+		auto idx = indexes.data() + quad * 6;
+		for (uint32_t i = 0; i < 6; ++i) {
+			if (idx[i] != quad * 4 + QuadIndexes[i]) {
+				return;
+			}
+		}
+
+		// tl bl tr br
+		auto v = data.data() + quad * 4;
+		if (v[0].pos.x != v[1].pos.x || v[2].pos.x != v[3].pos.x || v[0].pos.y != v[2].pos.y
+				|| v[1].pos.y != v[3].pos.y) {
+			return;
+		}
+
+		if (v[0].tex.x != v[1].tex.x || v[2].tex.x != v[3].tex.x || v[0].tex.y != v[2].tex.y
+				|| v[1].tex.y != v[3].tex.y || !isUnorm(v[0].tex) || !isUnorm(v[3].tex)) {
+			return;
+		}
+
+		for (uint32_t i = 0; i < 4; ++i) {
+			if (v[i].pos.z != v[0].pos.z || v[i].pos.w != 1.0f || v[i].color != v[0].color) {
+				return;
+			}
+		}
+
+		if (!VertexData_isColorRgba8(v[0].color)) {
+			return;
+		}
+
+		uint32_t deltas = 0;
+		if (v[0].object || v[1].object || v[2].object || v[3].object) {
+			if (!getObjectDeltas(v, deltas)) {
+				return;
+			}
+			hasObjects = true;
+		}
+	}
+
+	quadLayout = hasObjects ? QuadLayout::Objects : QuadLayout::Plain;
+}
+
+// CompactVertex stores color as RGBA8 and UV as unorm16, values outside [0, 1] would be clamped
+void VertexData::updateCompactLayout() {
+	auto isUnorm = [](float v) { return v >= 0.0f && v <= 1.0f; };
+
+	compactLayout = false;
+	for (auto &it : data) {
+		if (it.pos.z != 0.0f || it.pos.w != 1.0f || !isUnorm(it.tex.x) || !isUnorm(it.tex.y)
+				|| !isUnorm(it.color.x) || !isUnorm(it.color.y) || !isUnorm(it.color.z)
+				|| !isUnorm(it.color.w)) {
+			return;
+		}
+	}
+	compactLayout = true;
+}
+
+Rect VertexData::getBounds(const Mat4 &transform) const {
+	if (data.empty()) {
+		return Rect();
+	}
+
+	auto first = transform.transformPoint(Vec2(data.front().pos.x, data.front().pos.y));
+	Vec2 min = first;
+	Vec2 max = first;
+	for (auto &it : data) {
+		auto pt = transform.transformPoint(Vec2(it.pos.x, it.pos.y));
+		min.x = std::min(min.x, pt.x);
+		min.y = std::min(min.y, pt.y);
+		max.x = std::max(max.x, pt.x);
+		max.y = std::max(max.y, pt.y);
+	}
+	return Rect(min.x, min.y, max.x - min.x, max.y - min.y);
+}
+
 VertexArray::Quad &VertexArray::Quad::setTextureRect(const Rect &texRect, float texWidth,
 		float texHeight, bool flippedX, bool flippedY, bool rotated) {
 
@@ -224,6 +343,7 @@ VertexArray::~VertexArray() { _data = nullptr; }
 
 bool VertexArray::init(uint32_t bufferCapacity, uint32_t indexCapacity) {
 	_data = Rc<VertexData>::alloc();
+	_data->quads = true;
 	_data->data.reserve(bufferCapacity);
 	_data->indexes.reserve(indexCapacity);
 	return true;
@@ -249,6 +369,11 @@ void VertexArray::reserve(uint32_t bufferCapacity, uint32_t indexCapacity) {
 }
 
 Rc<VertexData> VertexArray::pop() {
+	if (!_copyOnWrite) {
+		// data was changed since last pop, or is new
+		_data->updateQuadLayout();
+		_data->updateCompactLayout();
+	}
 	_copyOnWrite = true;
 	return _data;
 }
@@ -257,6 +382,9 @@ Rc<VertexData> VertexArray::dup() {
 	auto data = Rc<VertexData>::alloc();
 	data->data = _data->data;
 	data->indexes = _data->indexes;
+	data->quads = _data->quads;
+	data->updateQuadLayout();
+	data->updateCompactLayout();
 	return data;
 }
 
@@ -265,6 +393,7 @@ bool VertexArray::empty() const { return _data->indexes.empty() || _data->data.e
 void VertexArray::clear() {
 	if (_copyOnWrite) {
 		_data = Rc<VertexData>::alloc();
+		_data->quads = true;
 	} else {
 		_data->data.clear();
 		_data->indexes.clear();
@@ -399,11 +528,14 @@ size_t VertexArray::getVertexCount() const { return _data->data.size(); }
 
 size_t VertexArray::getIndexCount() const { return _data->indexes.size(); }
 
+Rect VertexArray::getBounds(const Mat4 &transform) const { return _data->getBounds(transform); }
+
 void VertexArray::copy() {
 	if (_copyOnWrite) {
 		auto data = Rc<VertexData>::alloc();
 		data->data = _data->data;
 		data->indexes = _data->indexes;
+		data->quads = _data->quads;
 		_data = data;
 		_copyOnWrite = false;
 	}
@@ -87,6 +87,8 @@ public:
 	size_t getVertexCount() const;
 	size_t getIndexCount() const;
 
+	Rect getBounds(const Mat4 & = Mat4::IDENTITY) const;
+
 protected:
 	void copy();
 
@@ -0,0 +1,205 @@
+/**
+ Copyright (c) 2023 Stappler LLC <admin@stappler.dev>
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "XL2dVertexKernels.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#elif __aarch64__
+#include <arm_neon.h>
+#endif
+
+#if __x86_64__ && (__GNUC__ || __clang__)
+#define XL2D_VERTEX_KERNELS_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::basic2d {
+
+static_assert(sizeof(Vertex) == 48 && offsetof(Vertex, material) == 40,
+		"Vertex kernels require 48-byte vertex with material in third 16-byte chunk");
+
+static void VertexKernels_copyVertexesScalar(Vertex *target, const Vertex *source, size_t count,
+		uint32_t material) {
+	memcpy(target, source, count * sizeof(Vertex));
+	for (size_t i = 0; i < count; ++i) { target[i].material = material; }
+}
+
+static void VertexKernels_rebaseIndexesScalar(uint32_t *target, const uint32_t *source,
+		size_t count, uint32_t offset) {
+	for (size_t i = 0; i < count; ++i) { target[i] = source[i] + offset; }
+}
+
+static uint32_t VertexKernels_packColorScalar(const Vec4 &color) {
+	return VertexKernels::packUnorm(color.x, 255.0f)
+			| VertexKernels::packUnorm(color.y, 255.0f) << 8
+			| VertexKernels::packUnorm(color.z, 255.0f) << 16
+			| VertexKernels::packUnorm(color.w, 255.0f) << 24;
+}
+
+#if __SSE2__
+static void VertexKernels_copyVertexesSse2(Vertex *target, const Vertex *source, size_t count,
+		uint32_t material) {
+	const __m128i mask = _mm_set_epi32(0, -1, 0, 0);
+	const __m128i value = _mm_set_epi32(0, int(material), 0, 0);
+
+	auto src = reinterpret_cast<const __m128i *>(source);
+	auto dst = reinterpret_cast<__m128i *>(target);
+	for (size_t i = 0; i < count; ++i) {
+		_mm_storeu_si128(dst, _mm_loadu_si128(src));
+		_mm_storeu_si128(dst + 1, _mm_loadu_si128(src + 1));
+		_mm_storeu_si128(dst + 2,
+				_mm_or_si128(_mm_andnot_si128(mask, _mm_loadu_si128(src + 2)), value));
+		src += 3;
+		dst += 3;
+	}
+}
+
+static void VertexKernels_rebaseIndexesSse2(uint32_t *target, const uint32_t *source,
+		size_t count, uint32_t offset) {
+	size_t i = 0;
+	const __m128i value = _mm_set1_epi32(int(offset));
+	for (; i + 4 <= count; i += 4) {
+		auto v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(target + i), _mm_add_epi32(v, value));
+	}
+	VertexKernels_rebaseIndexesScalar(target + i, source + i, count - i, offset);
+}
+
+static uint32_t VertexKernels_packColorSse2(const Vec4 &color) {
+	auto v = _mm_set_ps(color.w, color.z, color.y, color.x);
+
+	// maxps returns the second operand when the first one is NaN
+	v = _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+	auto i = _mm_cvtps_epi32(_mm_mul_ps(v, _mm_set1_ps(255.0f)));
+	i = _mm_packs_epi32(i, i);
+	i = _mm_packus_epi16(i, i);
+	return uint32_t(_mm_cvtsi128_si32(i));
+}
+#endif
+
+#if XL2D_VERTEX_KERNELS_AVX2
+// two vertexes in three 32-byte chunks: material is in lane 2 of the second chunk and
+// in lane 6 of the third one
+__attribute__((target("avx2"))) static void VertexKernels_copyVertexesAvx2(Vertex *target,
+		const Vertex *source, size_t count, uint32_t material) {
+	const __m256i mask1 = _mm256_set_epi32(0, 0, 0, 0, 0, -1, 0, 0);
+	const __m256i mask2 = _mm256_set_epi32(0, -1, 0, 0, 0, 0, 0, 0);
+	const __m256i value = _mm256_set1_epi32(int(material));
+
+	auto src = reinterpret_cast<const __m256i *>(source);
+	auto dst = reinterpret_cast<__m256i *>(target);
+	size_t i = 0;
+	for (; i + 2 <= count; i += 2) {
+		_mm256_storeu_si256(dst, _mm256_loadu_si256(src));
+		_mm256_storeu_si256(dst + 1, _mm256_blendv_epi8(_mm256_loadu_si256(src + 1), value, mask1));
+		_mm256_storeu_si256(dst + 2, _mm256_blendv_epi8(_mm256_loadu_si256(src + 2), value, mask2));
+		src += 3;
+		dst += 3;
+	}
+	VertexKernels_copyVertexesSse2(target + i, source + i, count - i, material);
+}
+
+__attribute__((target("avx2"))) static void VertexKernels_rebaseIndexesAvx2(uint32_t *target,
+		const uint32_t *source, size_t count, uint32_t offset) {
+	size_t i = 0;
+	const __m256i value = _mm256_set1_epi32(int(offset));
+	for (; i + 8 <= count; i += 8) {
+		auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(target + i), _mm256_add_epi32(v, value));
+	}
+	VertexKernels_rebaseIndexesSse2(target + i, source + i, count - i, offset);
+}
+#endif
+
+#if __aarch64__
+static void VertexKernels_copyVertexesNeon(Vertex *target, const Vertex *source, size_t count,
+		uint32_t material) {
+	auto src = reinterpret_cast<const uint32_t *>(source);
+	auto dst = reinterpret_cast<uint32_t *>(target);
+	for (size_t i = 0; i < count; ++i) {
+		vst1q_u32(dst, vld1q_u32(src));
+		vst1q_u32(dst + 4, vld1q_u32(src + 4));
+		vst1q_u32(dst + 8, vsetq_lane_u32(material, vld1q_u32(src + 8), 2));
+		src += 12;
+		dst += 12;
+	}
+}
+
+static void VertexKernels_rebaseIndexesNeon(uint32_t *target, const uint32_t *source,
+		size_t count, uint32_t offset) {
+	size_t i = 0;
+	const uint32x4_t value = vdupq_n_u32(offset);
+	for (; i + 4 <= count; i += 4) {
+		vst1q_u32(target + i, vaddq_u32(vld1q_u32(source + i), value));
+	}
+	VertexKernels_rebaseIndexesScalar(target + i, source + i, count - i, offset);
+}
+
+static uint32_t VertexKernels_packColorNeon(const Vec4 &color) {
+	float32x4_t v = {color.x, color.y, color.z, color.w};
+
+	// maxnm returns the numeric operand when the other one is NaN, unlike max
+	v = vminq_f32(vmaxnmq_f32(v, vdupq_n_f32(0.0f)), vdupq_n_f32(1.0f));
+	auto i = vcvtnq_u32_f32(vmulq_n_f32(v, 255.0f));
+	auto b = vmovn_u16(vcombine_u16(vmovn_u32(i), vmovn_u32(i)));
+	return vget_lane_u32(vreinterpret_u32_u8(b), 0);
+}
+#endif
+
+static SpanView<VertexKernels> VertexKernels_init() {
+	static VertexKernels s_kernels[3];
+	size_t count = 0;
+
+	s_kernels[count++] = VertexKernels{"scalar", &VertexKernels_copyVertexesScalar,
+		&VertexKernels_rebaseIndexesScalar, &VertexKernels_packColorScalar};
+
+#if __SSE2__
+	s_kernels[count++] = VertexKernels{"sse2", &VertexKernels_copyVertexesSse2,
+		&VertexKernels_rebaseIndexesSse2, &VertexKernels_packColorSse2};
+#if XL2D_VERTEX_KERNELS_AVX2
+	if (__builtin_cpu_supports("avx2")) {
+		s_kernels[count++] = VertexKernels{"avx2", &VertexKernels_copyVertexesAvx2,
+			&VertexKernels_rebaseIndexesAvx2, &VertexKernels_packColorSse2};
+	}
+#endif
+#elif __aarch64__
+	s_kernels[count++] = VertexKernels{"neon", &VertexKernels_copyVertexesNeon,
+		&VertexKernels_rebaseIndexesNeon, &VertexKernels_packColorNeon};
+#endif
+
+	return SpanView<VertexKernels>(s_kernels, count);
+}
+
+SpanView<VertexKernels> VertexKernels::getAvailable() {
+	static SpanView<VertexKernels> s_available = VertexKernels_init();
+	return s_available;
+}
+
+const VertexKernels &VertexKernels::get() {
+	// variants are ordered from the slowest to the fastest
+	static const VertexKernels &s_kernels = getAvailable()[getAvailable().size() - 1];
+	return s_kernels;
+}
+
+} // namespace stappler::xenolith::basic2d
@@ -0,0 +1,68 @@
+/**
+ Copyright (c) 2023 Stappler LLC <admin@stappler.dev>
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef XENOLITH_RENDERER_BASIC2D_XL2DVERTEXKERNELS_H_
+#define XENOLITH_RENDERER_BASIC2D_XL2DVERTEXKERNELS_H_
+
+#include "XL2d.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::basic2d {
+
+// Vertex write kernels for the vertex pass
+//
+// Every variant produces results, identical to the scalar one: colors and texture coordinates
+// are clamped to [0, 1] with NaN packed as 0, rounding is to nearest even.
+// SSE2 and NEON are baseline for x86_64 and aarch64, AVX2 is selected at runtime when CPU
+// supports it.
+struct SP_PUBLIC VertexKernels {
+	// Copy vertexes and replace material field
+	using CopyVertexes = void (*)(Vertex *target, const Vertex *source, size_t count,
+			uint32_t material);
+
+	// Write indexes with vertex offset added
+	using RebaseIndexes = void (*)(uint32_t *target, const uint32_t *source, size_t count,
+			uint32_t offset);
+
+	// Pack color into RGBA8 unorm
+	using PackColor = uint32_t (*)(const Vec4 &);
+
+	// Best variant for the current CPU, selected once
+	static const VertexKernels &get();
+
+	// All variants, supported by the current CPU, scalar variant is the first one
+	static SpanView<VertexKernels> getAvailable();
+
+	static uint32_t packUnorm(float value, float max) {
+		// comparison is false for NaN, so it's packed as 0
+		return uint32_t(std::nearbyint((value > 0.0f ? std::min(value, 1.0f) : 0.0f) * max));
+	}
+
+	StringView name;
+	CopyVertexes copyVertexes = nullptr;
+	RebaseIndexes rebaseIndexes = nullptr;
+	PackColor packColor = nullptr;
+};
+
+} // namespace stappler::xenolith::basic2d
+
+#endif /* XENOLITH_RENDERER_BASIC2D_XL2DVERTEXKERNELS_H_ */
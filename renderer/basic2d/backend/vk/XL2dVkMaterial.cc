@@ -70,6 +70,12 @@ Bytes MaterialAttachment::getMaterialData(NotNull<core::Material> m) const {
 				}
 			}
 		}
+		if (hasFlag(m->getFlags(), core::MaterialFlags::CompactVertexes)) {
+			material.flags |= XL_GLSL_MATERIAL_FLAG_COMPACT_VERTEX;
+		}
+		if (hasFlag(m->getFlags(), core::MaterialFlags::DistanceField)) {
+			material.flags |= XL_GLSL_MATERIAL_FLAG_DISTANCE_FIELD;
+		}
 		memcpy(ret.data(), &material, sizeof(MaterialData));
 	}
 	return ret;
@@ -609,8 +609,7 @@ void ShadowPassHandle::prepareMaterialCommands(core::MaterialSet *materials, Com
 			float(currentExtent.height), 0.0f, 1.0f};
 		buf.cmdSetViewport(0, makeSpanView(&viewport, 1));
 
-		auto scissorRect = VkRect2D{{0, 0}, {currentExtent.width, currentExtent.height}};
-		buf.cmdSetScissor(0, makeSpanView(&scissorRect, 1));
+		setScissor(buf, VkRect2D{{0, 0}, {currentExtent.width, currentExtent.height}});
 
 		buf.cmdDrawIndexed(6, // indexCount
 				1, // instanceCount
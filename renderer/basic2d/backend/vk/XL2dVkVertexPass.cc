@@ -26,12 +26,15 @@
 #include "XLCoreEnum.h"
 #include "XLCoreFrameHandle.h"
 #include "XLCoreFrameQueue.h"
+#include "XLCoreSwapchain.h"
+#include "XLCoreTrace.h"
 #include "XLDirector.h"
 #include "XLVkDeviceQueue.h"
 #include "XLVkRenderPass.h"
 #include "XLVkTextureSet.h"
 #include "XLVkPipeline.h"
 #include "XL2dFrameContext.h"
+#include "XL2dVertexKernels.h"
 #include "XLLinearGradient.h"
 #include "backend/vk/XL2dVkParticlePass.h"
 #include "glsl/include/XL2dGlslVertexData.h"
@@ -39,6 +42,12 @@
 
 namespace STAPPLER_VERSIONIZED stappler::xenolith::basic2d::vk {
 
+static uint32_t VertexMaterialDynamicData_packTex(const Vec2 &tex) {
+	return VertexKernels::packUnorm(tex.x, 65535.0f)
+			| VertexKernels::packUnorm(tex.y, 65535.0f) << 16;
+}
+
+
 struct VertexMaterialVertexProcessor;
 
 struct VertexMaterialWriteTarget {
@@ -46,9 +55,18 @@ struct VertexMaterialWriteTarget {
 	uint8_t *vertexes = nullptr;
 	uint8_t *indexes = nullptr;
 
-	uint32_t vertexOffset = 0;
+	uint32_t vertexOffset = 0; // in units of vertexStride
+	uint32_t vertexStride = sizeof(Vertex);
 	uint32_t indexOffset = 0;
 	uint32_t transtormOffset = 0;
+
+	// switch between Vertex and CompactVertex layouts, offset is aligned up for the new stride
+	void setVertexStride(uint32_t stride) {
+		if (stride != vertexStride) {
+			vertexOffset = (vertexOffset * vertexStride + stride - 1) / stride;
+			vertexStride = stride;
+		}
+	}
 };
 
 struct VertexMaterialDynamicData : public InterfaceObject<memory::PoolInterface>,
@@ -56,10 +74,20 @@ struct VertexMaterialDynamicData : public InterfaceObject<memory::PoolInterface>
 	using VertexProcessor = VertexMaterialVertexProcessor;
 	using WriteTarget = VertexMaterialWriteTarget;
 
+	// Sort keys are built by DrawOrder, z-path is the part of key only for transparent level
+	static constexpr uint32_t KeyPathShift = DrawOrder::KeyPathShift;
+	static constexpr uint32_t KeyMaterialShift = DrawOrder::KeyMaterialShift;
+
+	enum PlanLevel : uint8_t {
+		PlanSolid, // objects, that do depth-write and can be drawn out of order
+		PlanSurface, // objects without depth-write, that can be drawn out of order
+		PlanTransparent, // transparent objects, that should be drawn in order
+	};
+
 	struct VertexDataPlanInfo : public memory::PoolInterface::AllocBaseType {
 		VertexDataPlanInfo *next = nullptr;
 		SpanView<InstanceVertexData> vertexes;
-		SpanView<ZOrder> zOrder;
+		uint32_t path = 0; // z-path rank
 		float depthValue = 0.0f;
 
 		uint32_t vertexOffset = 0;
@@ -69,41 +97,70 @@ struct VertexMaterialDynamicData : public InterfaceObject<memory::PoolInterface>
 	};
 
 	struct StatePlanInfo {
+		StateId state = StateIdNone;
 		const StateData *stateData = nullptr;
 
 		VertexDataPlanInfo *instanced = nullptr;
 		VertexDataPlanInfo *packed = nullptr;
 
-		Vector<const CmdParticleEmitter *> particles;
+		// blocks, written as QuadInstance records
+		VertexDataPlanInfo *instancedQuads = nullptr;
+		VertexDataPlanInfo *packedQuads = nullptr;
+
+		// blocks of compact material, that can not be written as CompactVertex without loss
+		VertexDataPlanInfo *instancedFull = nullptr;
+		VertexDataPlanInfo *packedFull = nullptr;
+
+		// emitters with z-path ranks
+		Vector<Pair<const CmdParticleEmitter *, uint32_t>> particles;
 
 		uint32_t gradientStart = 0;
 		uint32_t gradientCount = 0;
 	};
 
 	struct MaterialWritePlan {
+		core::MaterialId id = 0;
 		const core::Material *material = nullptr;
 		Rc<core::DataAtlas> atlas;
+		bool compact = false; // vertexes are written as CompactVertex
 		uint32_t vertexes = 0;
 		uint32_t indexes = 0;
 		uint32_t transforms = 0;
 		uint32_t instances = 0;
-		Map<StateId, StatePlanInfo> states;
+
+		// ordered by state id
+		Vector<StatePlanInfo> states;
 	};
 
-	Map<SpanView<ZOrder>, float, ZOrderLess> paths;
+	// ordered by material layout index, then by material id
+	using WritePlan = Vector<MaterialWritePlan>;
+
+	struct PlanCommand {
+		uint64_t key = 0;
+		const Command *command = nullptr;
+		const CmdInfo *info = nullptr;
+		const core::Material *material = nullptr;
+		const CmdParticleEmitter *particle = nullptr;
+		SpanView<InstanceVertexData> vertexes;
+		PlanLevel level = PlanSolid;
+		uint32_t path = 0;
+	};
+
+	// commands in submission order, sorted by key before plans are built
+	Vector<PlanCommand> commands;
+
+	// unique z-paths in ZOrderLess order, and depth values for them
+	Vector<SpanView<ZOrder>> paths;
+	Vector<float> pathsDepth;
 
 	// fill write plan
 	MaterialWritePlan globalWritePlan;
 
-	// write plan for objects, that do depth-write and can be drawn out of order
-	Map<core::MaterialId, MaterialWritePlan> solidWritePlan;
+	WritePlan solidWritePlan;
+	WritePlan surfaceWritePlan;
 
-	// write plan for objects without depth-write, that can be drawn out of order
-	Map<core::MaterialId, MaterialWritePlan> surfaceWritePlan;
-
-	// write plan for transparent objects, that should be drawn in order
-	Map<SpanView<ZOrder>, Map<core::MaterialId, MaterialWritePlan>, ZOrderLess>
-			transparentWritePlan;
+	// one plan for each z-path rank
+	Vector<Pair<uint32_t, WritePlan>> transparentWritePlan;
 
 	Extent3 surfaceExtent;
 	core::SurfaceTransformFlags transform = core::SurfaceTransformFlags::Identity;
@@ -112,16 +169,24 @@ struct VertexMaterialDynamicData : public InterfaceObject<memory::PoolInterface>
 
 	uint32_t excludeVertexes = 0;
 	uint32_t excludeIndexes = 0;
+
+	// vertexes in compact layout, and states, that can require alignment padding after them
+	uint32_t compactVertexes = 0;
+	uint32_t compactStates = 0;
+
+	uint32_t quadInstances = 0;
 	float maxShadowValue = 0.0f;
 
 	memory::pool_t *pool = nullptr;
 
-	StatePlanInfo *acquireStatePlan(FrameContextHandle2d *input, const core::Material *material,
-			Map<core::MaterialId, MaterialWritePlan> &writePlan, const CmdInfo *c);
+	void addCommand(PlanLevel, const core::Material *, const Command *, const CmdInfo *,
+			SpanView<InstanceVertexData>, const CmdParticleEmitter * = nullptr);
+
+	void sortCommands();
+	void buildWritePlans(FrameContextHandle2d *input);
 
-	void emplaceWritePlan(FrameContextHandle2d *input, const core::Material *material,
-			Map<core::MaterialId, MaterialWritePlan> &writePlan, const Command *c,
-			const CmdInfo *cmd, SpanView<InstanceVertexData> vertexes);
+	void emplaceStatePlan(FrameContextHandle2d *input, MaterialWritePlan &, const CmdInfo *);
+	void emplaceVertexes(MaterialWritePlan &, StatePlanInfo &, const PlanCommand &);
 
 	void applyNormalized(SpanView<InstanceVertexData> &vertexes, const CmdDeferred *cmd);
 	void pushVertexData(VertexProcessor *, const Command *c, const CmdVertexArray *cmd);
@@ -131,10 +196,9 @@ struct VertexMaterialDynamicData : public InterfaceObject<memory::PoolInterface>
 	void updatePathsDepth();
 
 	void pushInitial(WriteTarget &writeTarget);
-	void pushPlanVertexes(WriteTarget &writeTarget,
-			Map<core::MaterialId, MaterialWritePlan> &writePlan);
+	void pushPlanVertexes(WriteTarget &writeTarget, WritePlan &writePlan);
 	void drawWritePlan(VertexProcessor *processor, WriteTarget &writeTarget,
-			Map<core::MaterialId, MaterialWritePlan> &writePlan);
+			WritePlan &writePlan);
 	void pushAll(VertexProcessor *, WriteTarget &writeTarget);
 };
 
@@ -152,6 +216,7 @@ struct VertexMaterialVertexProcessor : public Ref {
 	Vector<VertexSpan> shadowSdfSpans;
 
 	uint64_t _time = 0;
+	uint64_t _frame = 0;
 
 	Rc<Buffer> _indexes;
 	Rc<Buffer> _vertexes;
@@ -179,6 +244,7 @@ VertexMaterialVertexProcessor::VertexMaterialVertexProcessor(VertexAttachmentHan
 }
 
 void VertexMaterialVertexProcessor::run(core::FrameHandle &frame) {
+	_frame = frame.getOrder();
 	frame.performInQueue([this](core::FrameHandle &handle) {
 		if (!loadVertexes(handle)) {
 			_callback(false);
@@ -192,13 +258,20 @@ bool VertexMaterialVertexProcessor::loadVertexes(core::FrameHandle &fhandle) {
 		return false;
 	}
 
-	auto pool = memory::pool::create(memory::pool::acquire());
+	auto framePools =
+			static_cast<VertexAttachment *>(_attachment->getAttachment().get())->getFramePools();
+
+	auto pool = framePools->acquire();
 	auto ret = mem_pool::perform([&] {
 		auto cache = handle->getLoop()->getFrameCache();
 
 		_drawStat.cachedFramebuffers = uint32_t(cache->getFramebuffersCount());
 		_drawStat.cachedImages = uint32_t(cache->getImagesCount());
 		_drawStat.cachedImageViews = uint32_t(cache->getImageViewsCount());
+
+		auto aliasing = cache->getAliasingTotal();
+		_drawStat.aliasedMemory = uint32_t(aliasing.allocated / 1024);
+		_drawStat.aliasingSavedMemory = uint32_t(aliasing.getSaved() / 1024);
 		_drawStat.materials = uint32_t(_attachment->getMaterialSet()->getMaterials().size());
 
 		auto dynamicData = new (pool) DynamicData;
@@ -237,6 +310,8 @@ bool VertexMaterialVertexProcessor::loadVertexes(core::FrameHandle &fhandle) {
 			cmd = cmd->next;
 		}
 
+		dynamicData->buildWritePlans(_input);
+
 		auto devFrame = static_cast<DeviceFrameHandle *>(handle);
 		auto devPool = devFrame->getMemPool(this);
 
@@ -245,10 +320,14 @@ bool VertexMaterialVertexProcessor::loadVertexes(core::FrameHandle &fhandle) {
 				BufferInfo(StringView("IndexBuffer"), core::BufferUsage::IndexBuffer,
 						(dynamicData->globalWritePlan.indexes + 12) * sizeof(uint32_t)));
 
+		// compact states can require padding up to one Vertex when layout switches back
 		_vertexes = devPool->spawn(AllocationUsage::DeviceLocalHostVisible,
 				BufferInfo(StringView("VertexBuffer"), core::BufferUsage::StorageBuffer,
 						core::BufferUsage::ShaderDeviceAddress,
-						(dynamicData->globalWritePlan.vertexes + 8) * sizeof(Vertex)));
+						(dynamicData->globalWritePlan.vertexes + dynamicData->compactStates + 8)
+										* sizeof(Vertex)
+								+ dynamicData->compactVertexes * sizeof(CompactVertex)
+								+ dynamicData->quadInstances * sizeof(QuadInstance)));
 
 		_transforms = devPool->spawn(AllocationUsage::DeviceLocalHostVisible,
 				BufferInfo(StringView("TransformBuffer"), core::BufferUsage::StorageBuffer,
@@ -283,8 +362,11 @@ bool VertexMaterialVertexProcessor::loadVertexes(core::FrameHandle &fhandle) {
 			writeTarget.transform = reinterpret_cast<TransformData *>(transformData.data());
 		}
 
-		if (dynamicData->globalWritePlan.vertexes == 0
-				|| dynamicData->globalWritePlan.indexes == 0) {
+		bool hasIndexedVertexes = (dynamicData->globalWritePlan.vertexes > 0
+										  || dynamicData->compactVertexes > 0)
+				&& dynamicData->globalWritePlan.indexes > 0;
+
+		if (!hasIndexedVertexes && dynamicData->quadInstances == 0) {
 			dynamicData->pushInitial(writeTarget);
 		} else {
 			dynamicData->updatePathsDepth();
@@ -307,123 +389,238 @@ bool VertexMaterialVertexProcessor::loadVertexes(core::FrameHandle &fhandle) {
 		delete dynamicData;
 		return true;
 	}, pool);
-	memory::pool::destroy(pool);
+	framePools->release(pool);
 	return ret;
 }
 
-VertexMaterialDynamicData::StatePlanInfo *VertexMaterialDynamicData::acquireStatePlan(
-		FrameContextHandle2d *input, const core::Material *material,
-		Map<core::MaterialId, MaterialWritePlan> &writePlan, const CmdInfo *cmd) {
-	auto materialIt = writePlan.find(cmd->material);
-	if (materialIt == writePlan.end()) {
-		if (material) {
-			materialIt = writePlan.emplace(cmd->material, MaterialWritePlan()).first;
-			materialIt->second.material = material;
-			if (auto atlas = materialIt->second.material->getAtlas()) {
-				materialIt->second.atlas = atlas;
+void VertexMaterialDynamicData::addCommand(PlanLevel level, const core::Material *material,
+		const Command *c, const CmdInfo *cmd, SpanView<InstanceVertexData> vertexes,
+		const CmdParticleEmitter *particle) {
+	auto &plan = commands.emplace_back();
+	plan.command = c;
+	plan.info = cmd;
+	plan.material = material;
+	plan.particle = particle;
+	plan.vertexes = vertexes;
+	plan.level = level;
+}
+
+void VertexMaterialDynamicData::sortCommands() {
+	// materials are drawn in order of layout index, then material id
+	memory::vector<DrawOrder::Command> input;
+	input.reserve(commands.size());
+	for (auto &it : commands) {
+		input.emplace_back(DrawOrder::Command{it.info,
+			(uint64_t(it.material->getLayoutIndex()) << 32) | uint64_t(it.info->material),
+			uint8_t(it.level), it.level == PlanTransparent});
+	}
+
+	DrawOrder order;
+	order.sort(input);
+
+	paths.assign(order.paths.begin(), order.paths.end());
+
+	Vector<PlanCommand> sorted;
+	sorted.reserve(commands.size());
+	for (auto &it : order.keys) {
+		auto &cmd = sorted.emplace_back(commands[it.second]);
+		cmd.key = it.first;
+		cmd.path = order.ranks[it.second];
+	}
+
+	commands = move(sorted);
+}
+
+void VertexMaterialDynamicData::buildWritePlans(FrameContextHandle2d *input) {
+	if (commands.empty()) {
+		return;
+	}
+
+	sortCommands();
+
+	// sorted commands form contiguous runs for level/z-path, material and state
+	WritePlan *writePlan = nullptr;
+	MaterialWritePlan *materialPlan = nullptr;
+	StatePlanInfo *statePlan = nullptr;
+	uint64_t prevKey = 0;
+
+	for (auto &it : commands) {
+		if (!writePlan || (it.key >> KeyPathShift) != (prevKey >> KeyPathShift)) {
+			switch (it.level) {
+			case PlanSolid: writePlan = &solidWritePlan; break;
+			case PlanSurface: writePlan = &surfaceWritePlan; break;
+			case PlanTransparent:
+				writePlan = &transparentWritePlan.emplace_back(it.path, WritePlan()).second;
+				break;
+			}
+			materialPlan = nullptr;
+		}
+
+		if (!materialPlan || (it.key >> KeyMaterialShift) != (prevKey >> KeyMaterialShift)) {
+			materialPlan = &writePlan->emplace_back();
+			materialPlan->id = it.info->material;
+			materialPlan->material = it.material;
+			if (auto atlas = it.material->getAtlas()) {
+				materialPlan->atlas = atlas;
 			}
+			// material data with compact flag is written only for materials with images
+			materialPlan->compact =
+					hasFlag(it.material->getFlags(), core::MaterialFlags::CompactVertexes)
+					&& !it.material->getImages().empty();
+			statePlan = nullptr;
+		}
+
+		if (!statePlan || it.key != prevKey) {
+			emplaceStatePlan(input, *materialPlan, it.info);
+			statePlan = &materialPlan->states.back();
+		}
+
+		prevKey = it.key;
+
+		if (it.particle) {
+			statePlan->particles.emplace_back(it.particle, it.path);
+		} else {
+			emplaceVertexes(*materialPlan, *statePlan, it);
 		}
 	}
+}
+
+void VertexMaterialDynamicData::emplaceStatePlan(FrameContextHandle2d *input,
+		MaterialWritePlan &materialPlan, const CmdInfo *cmd) {
+	auto &statePlan = materialPlan.states.emplace_back();
+	statePlan.state = cmd->state;
+
+	if (materialPlan.compact) {
+		++compactStates;
+	}
 
-	if (materialIt != writePlan.end() && materialIt->second.material) {
-		auto stateIt = materialIt->second.states.find(cmd->state);
-		if (stateIt == materialIt->second.states.end()) {
-			stateIt = materialIt->second.states.emplace(cmd->state, StatePlanInfo()).first;
-
-			if (cmd->state != StateIdNone) {
-				auto state = input->getState(cmd->state);
-				if (state) {
-					auto stateData =
-							dynamic_cast<StateData *>(state->data ? state->data.get() : nullptr);
-
-					if (stateData) {
-						stateIt->second.stateData = stateData;
-						if (stateData->gradient) {
-							globalWritePlan.vertexes += stateData->gradient->steps.size() + 2;
-						}
-					}
+	if (cmd->state != StateIdNone) {
+		auto state = input->getState(cmd->state);
+		if (state) {
+			auto stateData = dynamic_cast<StateData *>(state->data ? state->data.get() : nullptr);
+
+			if (stateData) {
+				statePlan.stateData = stateData;
+				if (stateData->gradient) {
+					globalWritePlan.vertexes += stateData->gradient->steps.size() + 2;
 				}
 			}
 		}
+	}
+}
 
-		auto pathsIt = paths.find(cmd->zPath);
-		if (pathsIt == paths.end()) {
-			paths.emplace(cmd->zPath, 0.0f);
-		}
+// Quad verdict is computed, when data is built, see VertexData::updateQuadLayout
+static bool VertexMaterialDynamicData_isQuadArray(const InstanceVertexData &vertexes,
+		bool allowObjects) {
+	if (vertexes.sdfIndexes > 0) {
+		return false;
+	}
 
-		return &stateIt->second;
+	switch (vertexes.data->quadLayout) {
+	case VertexData::QuadLayout::None: return false;
+	case VertexData::QuadLayout::Plain: return true;
+	case VertexData::QuadLayout::Objects: return allowObjects;
 	}
-	return nullptr;
+	return false;
 }
-void VertexMaterialDynamicData::emplaceWritePlan(FrameContextHandle2d *input,
-		const core::Material *material, Map<core::MaterialId, MaterialWritePlan> &writePlan,
-		const Command *c, const CmdInfo *cmd, SpanView<InstanceVertexData> vertexes) {
-	auto statePlan = acquireStatePlan(input, material, writePlan, cmd);
-
-	if (statePlan) {
-		InstanceVertexData *packedStart = const_cast<InstanceVertexData *>(vertexes.data());
-		size_t packedCommands = 0;
-
-		for (auto &vIt : vertexes) {
-			// count data objects
-			globalWritePlan.vertexes += vIt.data->data.size();
+
+void VertexMaterialDynamicData::emplaceVertexes(MaterialWritePlan &materialPlan,
+		StatePlanInfo &statePlan, const PlanCommand &plan) {
+	auto c = plan.command;
+	auto cmd = plan.info;
+
+	// atlas objects in quads are resolved in shader, so CPU-side atlases can not be used
+	bool allowObjects = !materialPlan.atlas || hasGpuSideAtlases;
+
+	const InstanceVertexData *packedStart = plan.vertexes.data();
+	size_t packedCommands = 0;
+	VertexDataPlanInfo **packedList = nullptr;
+
+	auto pushBlock = [&](VertexDataPlanInfo *&list, SpanView<InstanceVertexData> vertexes) {
+		auto vertexData = new (pool) VertexDataPlanInfo;
+		vertexData->next = list;
+		vertexData->vertexes = vertexes;
+		vertexData->path = plan.path;
+		vertexData->depthValue = cmd->depthValue;
+		list = vertexData;
+	};
+
+	auto flushPacked = [&] {
+		if (packedCommands > 0) {
+			// write packed blocks
+			pushBlock(*packedList, makeSpanView(packedStart, packedCommands));
+			packedCommands = 0;
+		}
+	};
+
+	for (auto &vIt : plan.vertexes) {
+		bool drawAsQuads = VertexMaterialDynamicData_isQuadArray(vIt, allowObjects);
+
+		// UV or color outside [0, 1] would be clamped in CompactVertex,
+		// see VertexData::compactLayout
+		bool drawAsFull = materialPlan.compact && !drawAsQuads && !vIt.data->compactLayout;
+
+		// count data objects
+		if (drawAsQuads) {
+			quadInstances += vIt.data->data.size() / 4;
+		} else {
+			if (materialPlan.compact && !drawAsFull) {
+				compactVertexes += vIt.data->data.size();
+			} else {
+				globalWritePlan.vertexes += vIt.data->data.size();
+			}
 			globalWritePlan.indexes += vIt.data->indexes.size();
 
 			if (vIt.sdfIndexes > 0) {
 				globalWritePlan.indexes += (vIt.sdfIndexes + vIt.fillIndexes);
 			}
+		}
 
-			if ((c->flags & CommandFlags::DoNotCount) != CommandFlags::None) {
-				excludeVertexes += vIt.data->data.size();
-				excludeIndexes += vIt.data->indexes.size();
-			}
-
-			maxShadowValue = std::max(maxShadowValue, cmd->depthValue);
+		if ((c->flags & CommandFlags::DoNotCount) != CommandFlags::None) {
+			excludeVertexes += vIt.data->data.size();
+			excludeIndexes += vIt.data->indexes.size();
+		}
 
-			bool drawAsInstances = false;
-			if (vIt.instances.size() > 1) {
-				drawAsInstances = true;
-			}
+		maxShadowValue = std::max(maxShadowValue, cmd->depthValue);
 
-			// pack non-instanced blocks
-			if (drawAsInstances) {
-				globalWritePlan.transforms += vIt.instances.size();
-
-				if (packedCommands > 0) {
-					// write packed blocks
-					auto vertexData = new (pool) VertexDataPlanInfo;
-					vertexData->next = statePlan->packed;
-					vertexData->vertexes = makeSpanView(packedStart, packedCommands);
-					vertexData->zOrder = cmd->zPath;
-					vertexData->depthValue = cmd->depthValue;
-					statePlan->packed = vertexData;
-				}
+		bool drawAsInstances = false;
+		if (vIt.instances.size() > 1) {
+			drawAsInstances = true;
+		}
 
-				auto vertexData = new (pool) VertexDataPlanInfo;
-				vertexData->next = statePlan->instanced;
-				vertexData->vertexes = makeSpanView(&vIt, 1);
-				vertexData->zOrder = cmd->zPath;
-				vertexData->depthValue = cmd->depthValue;
-				statePlan->instanced = vertexData;
+		// pack non-instanced blocks of the same kind
+		if (drawAsInstances) {
+			globalWritePlan.transforms += vIt.instances.size();
 
-				packedCommands = 0;
-				packedStart = const_cast<InstanceVertexData *>(&vIt + 1);
+			flushPacked();
+			if (drawAsQuads) {
+				pushBlock(statePlan.instancedQuads, makeSpanView(&vIt, 1));
+			} else if (drawAsFull) {
+				pushBlock(statePlan.instancedFull, makeSpanView(&vIt, 1));
 			} else {
-				++globalWritePlan.transforms;
-				++packedCommands;
+				pushBlock(statePlan.instanced, makeSpanView(&vIt, 1));
+			}
+		} else {
+			auto list = &statePlan.packed;
+			if (drawAsQuads) {
+				list = &statePlan.packedQuads;
+			} else if (drawAsFull) {
+				list = &statePlan.packedFull;
 			}
-		}
 
-		if (packedCommands > 0) {
-			// write packed blocks
-			auto vertexData = new (pool) VertexDataPlanInfo;
-			vertexData->next = statePlan->packed;
-			vertexData->vertexes = makeSpanView(packedStart, packedCommands);
-			vertexData->zOrder = cmd->zPath;
-			vertexData->depthValue = cmd->depthValue;
-			statePlan->packed = vertexData;
+			if (packedCommands > 0 && packedList != list) {
+				flushPacked();
+			}
+			if (packedCommands == 0) {
+				packedStart = &vIt;
+				packedList = list;
+			}
+			++globalWritePlan.transforms;
+			++packedCommands;
 		}
 	}
+
+	flushPacked();
 }
 
 void VertexMaterialDynamicData::pushVertexData(VertexProcessor *processor, const Command *c,
@@ -433,16 +630,11 @@ void VertexMaterialDynamicData::pushVertexData(VertexProcessor *processor, const
 		return;
 	}
 	if (material->getPipeline()->isSolid()) {
-		emplaceWritePlan(processor->_input, material, solidWritePlan, c, cmd, cmd->vertexes);
+		addCommand(PlanSolid, material, c, cmd, cmd->vertexes);
 	} else if (cmd->renderingLevel == RenderingLevel::Surface) {
-		emplaceWritePlan(processor->_input, material, surfaceWritePlan, c, cmd, cmd->vertexes);
+		addCommand(PlanSurface, material, c, cmd, cmd->vertexes);
 	} else {
-		auto v = transparentWritePlan.find(cmd->zPath);
-		if (v == transparentWritePlan.end()) {
-			v = transparentWritePlan.emplace(cmd->zPath, Map<core::MaterialId, MaterialWritePlan>())
-						.first;
-		}
-		emplaceWritePlan(processor->_input, material, v->second, c, cmd, cmd->vertexes);
+		addCommand(PlanTransparent, material, c, cmd, cmd->vertexes);
 	}
 };
 
@@ -511,16 +703,11 @@ void VertexMaterialDynamicData::pushDeferred(VertexProcessor *processor, const C
 	});
 
 	if (cmd->renderingLevel == RenderingLevel::Solid) {
-		emplaceWritePlan(processor->_input, material, solidWritePlan, c, cmd, storedVertexes);
+		addCommand(PlanSolid, material, c, cmd, storedVertexes);
 	} else if (cmd->renderingLevel == RenderingLevel::Surface) {
-		emplaceWritePlan(processor->_input, material, surfaceWritePlan, c, cmd, storedVertexes);
+		addCommand(PlanSurface, material, c, cmd, storedVertexes);
 	} else {
-		auto v = transparentWritePlan.find(cmd->zPath);
-		if (v == transparentWritePlan.end()) {
-			v = transparentWritePlan.emplace(cmd->zPath, Map<core::MaterialId, MaterialWritePlan>())
-						.first;
-		}
-		emplaceWritePlan(processor->_input, material, v->second, c, cmd, storedVertexes);
+		addCommand(PlanTransparent, material, c, cmd, storedVertexes);
 	}
 }
 
@@ -531,36 +718,50 @@ void VertexMaterialDynamicData::pushParticleEmitter(VertexProcessor *processor,
 		return;
 	}
 
-	auto emplacePlan = [&](Map<core::MaterialId, MaterialWritePlan> &writePlan) {
-		auto statePlan = acquireStatePlan(processor->_input, material, writePlan, cmd);
-		if (statePlan) {
-			statePlan->particles.emplace_back(cmd);
-		}
-	};
-
 	if (material->getPipeline()->isSolid()) {
-		emplacePlan(solidWritePlan);
+		addCommand(PlanSolid, material, c, cmd, SpanView<InstanceVertexData>(), cmd);
 	} else if (cmd->renderingLevel == RenderingLevel::Surface) {
-		emplacePlan(surfaceWritePlan);
+		addCommand(PlanSurface, material, c, cmd, SpanView<InstanceVertexData>(), cmd);
 	} else {
-		auto v = transparentWritePlan.find(cmd->zPath);
-		if (v == transparentWritePlan.end()) {
-			v = transparentWritePlan.emplace(cmd->zPath, Map<core::MaterialId, MaterialWritePlan>())
-						.first;
-		}
-		emplacePlan(v->second);
+		addCommand(PlanTransparent, material, c, cmd, SpanView<InstanceVertexData>(), cmd);
 	}
 }
 
 void VertexMaterialDynamicData::updatePathsDepth() {
 	float depthScale = 1.0f / float(paths.size() + 1);
 	float depthOffset = 1.0f - depthScale;
-	for (auto &it : paths) {
-		it.second = depthOffset;
+	pathsDepth.resize(paths.size());
+	for (auto &it : pathsDepth) {
+		it = depthOffset;
 		depthOffset -= depthScale;
 	}
 }
 
+static void VertexMaterialDynamicData_packVertex(CompactVertex &target, const Vertex &source,
+		uint32_t material) {
+	target.pos = Vec2(source.pos.x, source.pos.y);
+	target.color = VertexKernels::get().packColor(source.color);
+	target.tex = VertexMaterialDynamicData_packTex(source.tex);
+	target.material = material;
+	target.object = source.object;
+}
+
+// quad vertexes: tl bl tr br
+static void VertexMaterialDynamicData_packQuad(QuadInstance &target, const Vertex *v,
+		uint32_t material) {
+	target.pos0 = Vec2(v[1].pos.x, v[1].pos.y);
+	target.pos1 = Vec2(v[2].pos.x, v[2].pos.y);
+	target.tex = UVec2(VertexMaterialDynamicData_packTex(v[0].tex),
+			VertexMaterialDynamicData_packTex(v[3].tex));
+	target.color = VertexKernels::get().packColor(v[0].color);
+	target.material = material;
+	target.object = v[0].object;
+	target.objectDeltas = 0;
+	VertexData::getObjectDeltas(v, target.objectDeltas);
+	target.layer = v[0].pos.z;
+	target.padding0 = 0;
+}
+
 void VertexMaterialDynamicData::pushInitial(WriteTarget &writeTarget) {
 	if (writeTarget.transform) {
 		TransformData nullTransforml;
@@ -629,63 +830,82 @@ void VertexMaterialDynamicData::pushInitial(WriteTarget &writeTarget) {
 	}
 }
 
-void VertexMaterialDynamicData::pushPlanVertexes(WriteTarget &writeTarget,
-		Map<core::MaterialId, MaterialWritePlan> &writePlan) {
-	auto pushVertexes = [&](core::MaterialId materialId, const MaterialWritePlan &plan,
-								uint32_t transform, const InstanceVertexData &vertexes) {
-		auto target = reinterpret_cast<Vertex *>(writeTarget.vertexes) + writeTarget.vertexOffset;
-		memcpy(target, vertexes.data->data.data(), vertexes.data->data.size() * sizeof(Vertex));
-
-		size_t idx = 0;
-		if (plan.atlas) {
-			if (hasGpuSideAtlases) {
-				for (; idx < vertexes.data->data.size(); ++idx) {
-					target[idx].material = materialId | transform << 16;
-				}
-			} else {
-				auto ext = plan.atlas->getImageExtent();
-				float atlasScaleX = 1.0f / ext.width;
-				float atlasScaleY = 1.0f / ext.height;
-
-				for (; idx < vertexes.data->data.size(); ++idx) {
-					auto &t = target[idx];
-					t.material = materialId | transform << 16;
-
-					struct AtlasData {
-						Vec2 pos;
-						Vec2 tex;
-					};
-
-					if (auto d = reinterpret_cast<const AtlasData *>(
-								plan.atlas->getObjectByName(t.object))) {
-						t.pos += Vec4(d->pos.x, d->pos.y, 0, 0);
-						t.tex = d->tex;
-						t.object = 0;
-					} else {
+void VertexMaterialDynamicData::pushPlanVertexes(WriteTarget &writeTarget, WritePlan &writePlan) {
+	// patch vertex with CPU-side atlas data
+	auto applyAtlas = [&](const MaterialWritePlan &plan, Vertex &t, float atlasScaleX,
+							  float atlasScaleY) {
+		struct AtlasData {
+			Vec2 pos;
+			Vec2 tex;
+		};
+
+		if (auto d = reinterpret_cast<const AtlasData *>(plan.atlas->getObjectByName(t.object))) {
+			t.pos += Vec4(d->pos.x, d->pos.y, 0, 0);
+			t.tex = d->tex;
+			t.object = 0;
+		} else {
 #if DEBUG
-						log::source().warn("VertexMaterialDrawPlan", "Object not found: ", t.object,
-								" ", string::toUtf8<Interface>(char16_t(t.object)));
+			log::source().warn("VertexMaterialDrawPlan", "Object not found: ", t.object, " ",
+					string::toUtf8<Interface>(char16_t(t.object)));
 #endif
-						auto anchor = font::CharId::getAnchorForChar(t.object);
-						switch (anchor) {
-						case font::CharAnchor::BottomLeft:
-							t.tex = Vec2(1.0f - atlasScaleX, 0.0f);
-							break;
-						case font::CharAnchor::TopLeft:
-							t.tex = Vec2(1.0f - atlasScaleX, 0.0f + atlasScaleY);
-							break;
-						case font::CharAnchor::TopRight:
-							t.tex = Vec2(1.0f, 0.0f + atlasScaleY);
-							break;
-						case font::CharAnchor::BottomRight: t.tex = Vec2(1.0f, 0.0f); break;
-						}
-					}
-				}
+			auto anchor = font::CharId::getAnchorForChar(t.object);
+			switch (anchor) {
+			case font::CharAnchor::BottomLeft: t.tex = Vec2(1.0f - atlasScaleX, 0.0f); break;
+			case font::CharAnchor::TopLeft:
+				t.tex = Vec2(1.0f - atlasScaleX, 0.0f + atlasScaleY);
+				break;
+			case font::CharAnchor::TopRight: t.tex = Vec2(1.0f, 0.0f + atlasScaleY); break;
+			case font::CharAnchor::BottomRight: t.tex = Vec2(1.0f, 0.0f); break;
 			}
-		} else {
-			for (; idx < vertexes.data->data.size(); ++idx) {
-				//target[idx].pos = transform.transform * target[idx].pos * transform.mask + transform.offset;
-				target[idx].material = materialId | transform << 16;
+		}
+	};
+
+	auto pushCompactVertexes = [&](core::MaterialId materialId, const MaterialWritePlan &plan,
+									   uint32_t transform, const InstanceVertexData &vertexes) {
+		auto target = reinterpret_cast<CompactVertex *>(writeTarget.vertexes)
+				+ writeTarget.vertexOffset;
+
+		bool cpuAtlas = plan.atlas && !hasGpuSideAtlases;
+		float atlasScaleX = 1.0f;
+		float atlasScaleY = 1.0f;
+		if (cpuAtlas) {
+			auto ext = plan.atlas->getImageExtent();
+			atlasScaleX = 1.0f / ext.width;
+			atlasScaleY = 1.0f / ext.height;
+		}
+
+		for (auto &it : vertexes.data->data) {
+			if (cpuAtlas) {
+				Vertex t = it;
+				applyAtlas(plan, t, atlasScaleX, atlasScaleY);
+				VertexMaterialDynamicData_packVertex(*(target++), t, materialId | transform << 16);
+			} else {
+				VertexMaterialDynamicData_packVertex(*(target++), it, materialId | transform << 16);
+			}
+		}
+
+		writeTarget.vertexOffset += vertexes.data->data.size();
+	};
+
+	auto pushVertexes = [&](core::MaterialId materialId, const MaterialWritePlan &plan,
+								uint32_t transform, const InstanceVertexData &vertexes,
+								bool compact) {
+		if (compact) {
+			pushCompactVertexes(materialId, plan, transform, vertexes);
+			return;
+		}
+
+		auto target = reinterpret_cast<Vertex *>(writeTarget.vertexes) + writeTarget.vertexOffset;
+		VertexKernels::get().copyVertexes(target, vertexes.data->data.data(),
+				vertexes.data->data.size(), materialId | transform << 16);
+
+		if (plan.atlas && !hasGpuSideAtlases) {
+			auto ext = plan.atlas->getImageExtent();
+			float atlasScaleX = 1.0f / ext.width;
+			float atlasScaleY = 1.0f / ext.height;
+
+			for (size_t idx = 0; idx < vertexes.data->data.size(); ++idx) {
+				applyAtlas(plan, target[idx], atlasScaleX, atlasScaleY);
 			}
 		}
 
@@ -712,21 +932,31 @@ void VertexMaterialDynamicData::pushPlanVertexes(WriteTarget &writeTarget,
 		return ret;
 	};
 
+	auto pushQuads = [&](core::MaterialId materialId, uint32_t transform,
+							 const InstanceVertexData &vertexes) {
+		auto target = reinterpret_cast<QuadInstance *>(writeTarget.vertexes)
+				+ writeTarget.vertexOffset;
+
+		auto &data = vertexes.data->data;
+		for (size_t i = 0; i < data.size(); i += 4) {
+			VertexMaterialDynamicData_packQuad(*(target++), data.data() + i,
+					materialId | transform << 16);
+		}
+
+		writeTarget.vertexOffset += data.size() / 4;
+	};
+
 	auto pushVertexList = [&](core::MaterialId mId, MaterialWritePlan &plan,
 								  const StatePlanInfo &state, VertexDataPlanInfo *packedInstance,
-								  bool instances) {
+								  bool instances, bool quads, bool compact) {
 		while (packedInstance) {
 			packedInstance->vertexOffset = writeTarget.vertexOffset;
 
 			// used as firstInstance for instanced drawing to access transform array
 			packedInstance->transformOffset = writeTarget.transtormOffset;
 
-			float zOffset = 0.0f;
+			float zOffset = pathsDepth[packedInstance->path];
 			float depthValue = 0.0f;
-			auto pathIt = paths.find(packedInstance->zOrder);
-			if (pathIt != paths.end()) {
-				zOffset = pathIt->second;
-			}
 
 			if (packedInstance->depthValue > 0.0f) {
 				auto f16 = halffloat::encode(packedInstance->depthValue);
@@ -740,11 +970,19 @@ void VertexMaterialDynamicData::pushPlanVertexes(WriteTarget &writeTarget,
 						writeTransform(inst, zOffset, depthValue, state.stateData, 0);
 					}
 
-					pushVertexes(mId, plan, 0, iit);
+					if (quads) {
+						pushQuads(mId, 0, iit);
+					} else {
+						pushVertexes(mId, plan, 0, iit, compact);
+					}
 				} else {
 					auto transform = writeTransform(iit.instances.front(), zOffset, depthValue,
 							state.stateData, 0);
-					pushVertexes(mId, plan, transform, iit);
+					if (quads) {
+						pushQuads(mId, transform, iit);
+					} else {
+						pushVertexes(mId, plan, transform, iit, compact);
+					}
 				}
 			}
 
@@ -757,16 +995,18 @@ void VertexMaterialDynamicData::pushPlanVertexes(WriteTarget &writeTarget,
 	};
 
 	for (auto &plan : writePlan) {
-		for (auto &state : plan.second.states) {
+		for (auto &state : plan.states) {
 			// write gradient vertexes (2 + n: start, end, anchors)
-			if (state.second.stateData && state.second.stateData->gradient) {
+			if (state.stateData && state.stateData->gradient) {
+				writeTarget.setVertexStride(sizeof(Vertex));
+
 				auto target =
 						reinterpret_cast<Vertex *>(writeTarget.vertexes) + writeTarget.vertexOffset;
 
 				Vec2 start =
-						state.second.stateData->transform * state.second.stateData->gradient->start;
+						state.stateData->transform * state.stateData->gradient->start;
 				Vec2 end =
-						state.second.stateData->transform * state.second.stateData->gradient->end;
+						state.stateData->transform * state.stateData->gradient->end;
 
 				start.y = surfaceExtent.height - start.y;
 				end.y = surfaceExtent.height - end.y;
@@ -792,86 +1032,72 @@ void VertexMaterialDynamicData::pushPlanVertexes(WriteTarget &writeTarget,
 				target->tex = axisAngle;
 				++target;
 
-				for (auto &it : state.second.stateData->gradient->steps) {
+				for (auto &it : state.stateData->gradient->steps) {
 					target->pos = Vec4(math::lerp(start, end, it.value), it.value, it.factor);
 					target->tex = axisAngle;
 					target->color = Vec4(it.color.r, it.color.g, it.color.b, it.color.a);
 					++target;
 				}
 
-				state.second.gradientStart = writeTarget.vertexOffset;
-				state.second.gradientCount =
-						uint32_t(state.second.stateData->gradient->steps.size());
+				state.gradientStart = writeTarget.vertexOffset;
+				state.gradientCount =
+						uint32_t(state.stateData->gradient->steps.size());
+
+				writeTarget.vertexOffset += state.stateData->gradient->steps.size() + 2;
+			}
+
+			// full layout blocks are written before compact ones, right after gradient, so
+			// state still requires only one alignment padding for compact layout
+			if (state.instancedFull || state.packedFull) {
+				writeTarget.setVertexStride(sizeof(Vertex));
 
-				writeTarget.vertexOffset += state.second.stateData->gradient->steps.size() + 2;
+				pushVertexList(plan.id, plan, state, state.instancedFull, true, false, false);
+				pushVertexList(plan.id, plan, state, state.packedFull, false, false, false);
 			}
 
-			pushVertexList(plan.first, plan.second, state.second, state.second.instanced, true);
-			pushVertexList(plan.first, plan.second, state.second, state.second.packed, false);
+			writeTarget.setVertexStride(plan.compact ? sizeof(CompactVertex) : sizeof(Vertex));
 
-			for (auto &it : state.second.particles) {
-				TransformData inst(it->transform);
+			pushVertexList(plan.id, plan, state, state.instanced, true, false, plan.compact);
+			pushVertexList(plan.id, plan, state, state.packed, false, false, plan.compact);
 
-				float zOffset = 0.0f;
+			if (state.instancedQuads || state.packedQuads) {
+				writeTarget.setVertexStride(sizeof(QuadInstance));
+
+				pushVertexList(plan.id, plan, state, state.instancedQuads, true, true, false);
+				pushVertexList(plan.id, plan, state, state.packedQuads, false, true, false);
+			}
+
+			for (auto &it : state.particles) {
+				TransformData inst(it.first->transform);
+
+				float zOffset = pathsDepth[it.second];
 				float depthValue = 0.0f;
-				auto pathIt = paths.find(it->zPath);
-				if (pathIt != paths.end()) {
-					zOffset = pathIt->second;
-				}
 
-				if (it->depthValue > 0.0f) {
-					auto f16 = halffloat::encode(it->depthValue);
+				if (it.first->depthValue > 0.0f) {
+					auto f16 = halffloat::encode(it.first->depthValue);
 					auto value = halffloat::decode(f16);
 					depthValue = value;
 				}
 
-				writeTransform(inst, zOffset, depthValue, state.second.stateData,
-						it->transformIndex);
+				writeTransform(inst, zOffset, depthValue, state.stateData,
+						it.first->transformIndex);
 			}
 		}
 	}
 }
 
 void VertexMaterialDynamicData::drawWritePlan(VertexProcessor *processor, WriteTarget &writeTarget,
-		Map<core::MaterialId, MaterialWritePlan> &writePlan) {
-	// optimize draw order, minimize switching pipeline, textureSet and descriptors
-	Vector<const Pair<const core::MaterialId, MaterialWritePlan> *> drawOrder;
-
-	// optimize pipeline switching strategy
-	for (auto &it : writePlan) {
-		if (drawOrder.empty()) {
-			drawOrder.emplace_back(&it);
-		} else {
-			auto lb = std::lower_bound(drawOrder.begin(), drawOrder.end(), &it,
-					[](const Pair<const core::MaterialId, MaterialWritePlan> *l,
-							const Pair<const core::MaterialId, MaterialWritePlan> *r) {
-				if (l->second.material->getPipeline() != l->second.material->getPipeline()) {
-					return GraphicPipeline::comparePipelineOrdering(
-							*l->second.material->getPipeline(), *r->second.material->getPipeline());
-				} else if (l->second.material->getLayoutIndex()
-						!= r->second.material->getLayoutIndex()) {
-					return l->second.material->getLayoutIndex()
-							< r->second.material->getLayoutIndex();
-				} else {
-					return l->first < r->first;
-				}
-			});
-			if (lb == drawOrder.end()) {
-				drawOrder.emplace_back(&it);
-			} else {
-				drawOrder.emplace(lb, &it);
-			}
-		}
-	}
+		WritePlan &writePlan) {
+	// write plan is already ordered by layout index and material id by sort keys, so
+	// textureSet and descriptors switching is minimized
 
 	auto writeIndexes = [](uint32_t *indexTarget, const uint32_t *indexSource, uint32_t indexCount,
 								uint32_t vertexOffset) {
 		if (vertexOffset == 0) {
 			memcpy(indexTarget, indexSource, indexCount * sizeof(uint32_t));
 		} else {
-			for (size_t i = 0; i < indexCount; ++i) {
-				*(indexTarget++) = *(indexSource++) + vertexOffset;
-			}
+			VertexKernels::get().rebaseIndexes(indexTarget, indexSource, indexCount,
+					vertexOffset);
 		}
 		return indexCount;
 	};
@@ -914,53 +1140,108 @@ void VertexMaterialDynamicData::drawWritePlan(VertexProcessor *processor, WriteT
 	auto processStatePlan = [&](core::MaterialId materialId, StateId stateId,
 									const StatePlanInfo &statePlan, StatePlanPhase phase,
 									mem_std::Vector<VertexSpan> &target) {
-		size_t localVertexOffset = 0;
-		auto materialIndexes = writeTarget.indexOffset;
+		// indexed blocks, instanced blocks are drawn one by one, packed - with a single call
+		auto processIndexed = [&](VertexDataPlanInfo *instanced, VertexDataPlanInfo *packed,
+									  bool fullVertexes) {
+			size_t localVertexOffset = 0;
+			auto materialIndexes = writeTarget.indexOffset;
+
+			auto packedInstance = instanced;
+			while (packedInstance) {
+				for (auto &vertexes : packedInstance->vertexes) {
+					processStatePlanIndexes(vertexes, phase, 0);
+					if (writeTarget.indexOffset > materialIndexes) {
+						target.emplace_back(VertexSpan{.material = materialId,
+							.indexCount = writeTarget.indexOffset - materialIndexes,
+							.instanceCount = packedInstance->transformCount,
+							.firstIndex = materialIndexes,
+							.vertexOffset = packedInstance->vertexOffset,
+							.firstInstance = packedInstance->transformOffset,
+							.state = stateId,
+							.gradientOffset = statePlan.gradientStart,
+							.gradientCount = statePlan.gradientCount,
+							.outlineOffset = (statePlan.stateData
+											? statePlan.stateData->outlineOffset
+											: 0.0f),
+							.fullVertexes = fullVertexes});
+					}
+					materialIndexes = writeTarget.indexOffset;
+				}
+				packedInstance = packedInstance->next;
+			}
 
-		auto packedInstance = statePlan.instanced;
-		while (packedInstance) {
-			for (auto &vertexes : packedInstance->vertexes) {
-				processStatePlanIndexes(vertexes, phase, 0);
-				if (writeTarget.indexOffset > materialIndexes) {
+			materialIndexes = writeTarget.indexOffset;
+			packedInstance = packed;
+			while (packedInstance) {
+				for (auto &vertexes : packedInstance->vertexes) {
+					processStatePlanIndexes(vertexes, phase, uint32_t(localVertexOffset));
+					localVertexOffset += vertexes.data->data.size();
+				}
+				packedInstance = packedInstance->next;
+			}
+
+			if (writeTarget.indexOffset > materialIndexes) {
+				target.emplace_back(VertexSpan{.material = materialId,
+					.indexCount = writeTarget.indexOffset - materialIndexes,
+					.instanceCount = 1,
+					.firstIndex = materialIndexes,
+					.vertexOffset = packed->vertexOffset,
+					.firstInstance = 0,
+					.state = stateId,
+					.gradientOffset = statePlan.gradientStart,
+					.gradientCount = statePlan.gradientCount,
+					.outlineOffset =
+							(statePlan.stateData ? statePlan.stateData->outlineOffset : 0.0f),
+					.fullVertexes = fullVertexes});
+			}
+		};
+
+		processIndexed(statePlan.instancedFull, statePlan.packedFull, true);
+		processIndexed(statePlan.instanced, statePlan.packed, false);
+
+		// quads are drawn without indexes, 6 vertexes per record; quads have no shadow geometry
+		if (phase == StatePlanPhase::StatePlanGeneral) {
+			auto packedInstance = statePlan.instancedQuads;
+			while (packedInstance) {
+				if (packedInstance->vertexCount > 0) {
 					target.emplace_back(VertexSpan{.material = materialId,
-						.indexCount = writeTarget.indexOffset - materialIndexes,
+						.indexCount = 0,
 						.instanceCount = packedInstance->transformCount,
-						.firstIndex = materialIndexes,
-						.vertexOffset = packedInstance->vertexOffset,
+						.firstIndex = 0,
+						.vertexOffset = packedInstance->vertexOffset * 6,
 						.firstInstance = packedInstance->transformOffset,
 						.state = stateId,
 						.gradientOffset = statePlan.gradientStart,
 						.gradientCount = statePlan.gradientCount,
 						.outlineOffset =
-								(statePlan.stateData ? statePlan.stateData->outlineOffset : 0.0f)});
+								(statePlan.stateData ? statePlan.stateData->outlineOffset : 0.0f),
+						.vertexCount = packedInstance->vertexCount * 6});
 				}
-				materialIndexes = writeTarget.indexOffset;
+				packedInstance = packedInstance->next;
 			}
-			packedInstance = packedInstance->next;
-		}
 
-		materialIndexes = writeTarget.indexOffset;
-		packedInstance = statePlan.packed;
-		while (packedInstance) {
-			for (auto &vertexes : packedInstance->vertexes) {
-				processStatePlanIndexes(vertexes, phase, uint32_t(localVertexOffset));
-				localVertexOffset += vertexes.data->data.size();
+			// packed quads are written contiguously, so they are drawn with a single call
+			uint32_t quadsCount = 0;
+			packedInstance = statePlan.packedQuads;
+			while (packedInstance) {
+				quadsCount += packedInstance->vertexCount;
+				packedInstance = packedInstance->next;
 			}
-			packedInstance = packedInstance->next;
-		}
 
-		if (writeTarget.indexOffset > materialIndexes) {
-			target.emplace_back(VertexSpan{.material = materialId,
-				.indexCount = writeTarget.indexOffset - materialIndexes,
-				.instanceCount = 1,
-				.firstIndex = materialIndexes,
-				.vertexOffset = statePlan.packed->vertexOffset,
-				.firstInstance = 0,
-				.state = stateId,
-				.gradientOffset = statePlan.gradientStart,
-				.gradientCount = statePlan.gradientCount,
-				.outlineOffset =
-						(statePlan.stateData ? statePlan.stateData->outlineOffset : 0.0f)});
+			if (quadsCount > 0) {
+				target.emplace_back(VertexSpan{.material = materialId,
+					.indexCount = 0,
+					.instanceCount = 1,
+					.firstIndex = 0,
+					.vertexOffset = statePlan.packedQuads->vertexOffset * 6,
+					.firstInstance = 0,
+					.state = stateId,
+					.gradientOffset = statePlan.gradientStart,
+					.gradientCount = statePlan.gradientCount,
+					.outlineOffset =
+							(statePlan.stateData ? statePlan.stateData->outlineOffset : 0.0f),
+					.vertexCount = quadsCount * 6});
+			}
 		}
 
 		// do not draw shadows for a particles for now
@@ -977,31 +1258,38 @@ void VertexMaterialDynamicData::drawWritePlan(VertexProcessor *processor, WriteT
 					.gradientCount = statePlan.gradientCount,
 					.outlineOffset =
 							(statePlan.stateData ? statePlan.stateData->outlineOffset : 0.0f),
-					.particleSystemId = it->id});
+					.particleSystemId = it.first->id});
 			}
 		}
 	};
 
 	// General drawing
-	for (auto &it : drawOrder) {
-		for (auto &state : it->second.states) {
-			processStatePlan(it->first, state.first, state.second, StatePlanGeneral,
+	for (auto &it : writePlan) {
+		for (auto &state : it.states) {
+			processStatePlan(it.id, state.state, state, StatePlanGeneral,
 					processor->materialSpans);
 		}
 	}
 
-	// Shadow solids
-	for (auto &it : drawOrder) {
-		for (auto &state : it->second.states) {
-			processStatePlan(it->first, state.first, state.second, StatePlanShadowSolid,
+	// Shadow solids; pseudo-sdf shaders read only full vertex layout, so materials with
+	// compact vertexes do not cast shadows
+	for (auto &it : writePlan) {
+		if (it.compact) {
+			continue;
+		}
+		for (auto &state : it.states) {
+			processStatePlan(it.id, state.state, state, StatePlanShadowSolid,
 					processor->shadowSolidSpans);
 		}
 	}
 
 	// Shadow volumes
-	for (auto &it : drawOrder) {
-		for (auto &state : it->second.states) {
-			processStatePlan(it->first, state.first, state.second, StatePlanShadowVolumes,
+	for (auto &it : writePlan) {
+		if (it.compact) {
+			continue;
+		}
+		for (auto &state : it.states) {
+			processStatePlan(it.id, state.state, state, StatePlanShadowVolumes,
 					processor->shadowSdfSpans);
 		}
 	}
@@ -1031,8 +1319,11 @@ void VertexMaterialDynamicData::pushAll(VertexProcessor *processor, WriteTarget
 
 void VertexMaterialVertexProcessor::finalize(DynamicData *data) {
 	auto t = sp::platform::clock(ClockType::Monotonic);
-	_drawStat.vertexes = data->globalWritePlan.vertexes - data->excludeVertexes;
-	_drawStat.triangles = (data->globalWritePlan.indexes - data->excludeIndexes) / 3;
+	// quads are counted as 4 vertexes and 2 triangles
+	_drawStat.vertexes = data->globalWritePlan.vertexes + data->compactVertexes
+			+ data->quadInstances * 4 - data->excludeVertexes;
+	_drawStat.triangles =
+			(data->globalWritePlan.indexes + data->quadInstances * 6 - data->excludeIndexes) / 3;
 	_drawStat.zPaths = uint32_t(data->paths.size());
 	_drawStat.drawCalls = uint32_t(materialSpans.size());
 	_drawStat.solidCmds = solidCmds;
@@ -1042,6 +1333,9 @@ void VertexMaterialVertexProcessor::finalize(DynamicData *data) {
 	_drawStat.vertexInputTime = uint32_t(t - _time);
 	_input->director->pushDrawStat(_drawStat);
 
+	core::Trace::addSpan(core::TraceCategory::Vertex, "VertexMaterialVertexProcessor", _time,
+			t - _time, _frame);
+
 	_attachment->loadData(sp::move(_input), sp::move(_indexes), sp::move(_vertexes),
 			sp::move(_transforms), sp::move(materialSpans), sp::move(shadowSolidSpans),
 			sp::move(shadowSdfSpans), data->maxShadowValue);
@@ -1052,6 +1346,7 @@ void VertexMaterialVertexProcessor::finalize(DynamicData *data) {
 bool VertexAttachment::init(AttachmentBuilder &builder, const AttachmentData *m) {
 	if (core::GenericAttachment::init(builder)) {
 		_materials = m;
+		_framePools = Rc<core::FramePoolRing>::create(nullptr, 0);
 		return true;
 	}
 	return false;
@@ -1172,6 +1467,8 @@ Vector<const core::CommandBuffer *> VertexPassHandle::doPrepareCommands(FrameHan
 		info.timestampQueries = _data->acquireTimestamps;
 	}
 
+	updateRenderArea(handle);
+
 	auto buf = _pool->recordBuffer(*_device, Vector<Rc<DescriptorPool>>(_descriptors),
 			[&, this](CommandBuffer &buf) {
 		auto materials = _materialBuffer->getSet().get();
@@ -1245,6 +1542,8 @@ void VertexPassHandle::prepareMaterialCommands(core::MaterialSet *materials, Com
 	uint32_t boundTextureSetIndex = maxOf<uint32_t>();
 
 	VertexConstantData pcb;
+	pcb.vertexFlags = 0;
+	pcb.padding0 = 0;
 	pcb.vertexPointer =
 			UVec2::convertFromPacked(buf.bindBufferAddress(_vertexBuffer->getVertexes().get()));
 	pcb.transformPointer =
@@ -1284,6 +1583,12 @@ void VertexPassHandle::prepareMaterialCommands(core::MaterialSet *materials, Com
 		pcb.samplerIdx = material->getImages().front().sampler;
 		pcb.gradientOffset = materialVertexSpan.gradientOffset;
 		pcb.gradientCount = materialVertexSpan.gradientCount;
+		pcb.vertexFlags = 0;
+		if (materialVertexSpan.vertexCount > 0) {
+			pcb.vertexFlags = XL_GLSL_VERTEX_FLAG_QUADS;
+		} else if (materialVertexSpan.fullVertexes) {
+			pcb.vertexFlags = XL_GLSL_VERTEX_FLAG_FULL;
+		}
 		//pcb.outlineOffset = materialVertexSpan.outlineOffset;
 
 		if (auto a = material->getAtlas()) {
@@ -1337,6 +1642,16 @@ void VertexPassHandle::prepareMaterialCommands(core::MaterialSet *materials, Com
 						emitterRenderInfo->index * sizeof(ParticleIndirectCommand), 1,
 						sizeof(ParticleIndirectCommand));
 			}
+		} else if (materialVertexSpan.vertexCount > 0) {
+			buf.cmdPushConstants(pass->getPipelineLayout(0),
+					VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0,
+					BytesView(reinterpret_cast<const uint8_t *>(&pcb), sizeof(VertexConstantData)));
+
+			buf.cmdDraw(materialVertexSpan.vertexCount, // vertexCount
+					materialVertexSpan.instanceCount, // instanceCount
+					materialVertexSpan.vertexOffset, // firstVertex
+					materialVertexSpan.firstInstance // firstInstance
+			);
 		} else {
 			buf.cmdPushConstants(pass->getPipelineLayout(0),
 					VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0,
@@ -1358,6 +1673,103 @@ void VertexPassHandle::finalizeRenderPass(CommandBuffer &buf) {
 	buf.cmdWriteTimestamp(core::PipelineStage::BottomOfPipe, TimestampEndTag);
 }
 
+void VertexPassHandle::updateRenderArea(FrameHandle &handle) {
+	_hasRenderArea = false;
+
+	auto pass = static_cast<VertexPass *>(_queuePass.get());
+	auto output = pass->getOutput() ? getAttachmentHandle(pass->getOutput()) : nullptr;
+	if (!output || !output->getQueueData()->image
+			|| !output->getQueueData()->image->isSwapchainImage()
+			|| !static_cast<RenderPass *>(_data->impl.get())->getPreserveRenderPass()) {
+		return;
+	}
+
+	auto image = static_cast<core::SwapchainImage *>(output->getQueueData()->image);
+	auto &swapchain = image->getSwapchain();
+	if (!swapchain) {
+		return;
+	}
+
+	// damage is defined in world space, that can be rotated from the image space
+	Extent2 extent(_constraints.extent.width, _constraints.extent.height);
+	switch (core::getPureTransform(_constraints.transform)) {
+	case core::SurfaceTransformFlags::Rotate90:
+	case core::SurfaceTransformFlags::Rotate270:
+	case core::SurfaceTransformFlags::MirrorRotate90:
+	case core::SurfaceTransformFlags::MirrorRotate270:
+		std::swap(extent.width, extent.height);
+		break;
+	default: break;
+	}
+
+	URect damageRect{0, 0, extent.width, extent.height};
+
+	bool isFull = true;
+	auto commands = _vertexBuffer->getCommands();
+	if (commands && !commands->damage.isFull()) {
+		isFull = false;
+
+		// particles are simulated on GPU, so, it's area can not be tracked
+		for (auto &it : _vertexBuffer->getVertexData()) {
+			if (it.particleSystemId > 0) {
+				isFull = true;
+				break;
+			}
+		}
+	}
+
+	if (!isFull) {
+		auto &rect = commands->damage.rect;
+		auto minX = std::clamp(std::floor(rect.getMinX()), 0.0f, float(extent.width));
+		auto minY = std::clamp(std::floor(rect.getMinY()), 0.0f, float(extent.height));
+		auto maxX = std::clamp(std::ceil(rect.getMaxX()), 0.0f, float(extent.width));
+		auto maxY = std::clamp(std::ceil(rect.getMaxY()), 0.0f, float(extent.height));
+
+		damageRect = URect{uint32_t(minX), uint32_t(minY), uint32_t(std::max(maxX - minX, 0.0f)),
+			uint32_t(std::max(maxY - minY, 0.0f))};
+	}
+
+	// damage should be registered for every frame to keep swapchain history consistent
+	URect target;
+	if (!swapchain->updateImageDamage(image->getImageIndex(), handle.getOrder(), damageRect,
+				target)
+			|| isFull) {
+		return;
+	}
+
+	// render area can not be empty, redraw single unchanged pixel
+	if (target.width == 0 || target.height == 0) {
+		target = URect{0, 0, 1, 1};
+	}
+	if (damageRect.width == 0 || damageRect.height == 0) {
+		damageRect = URect{0, 0, 1, 1};
+	}
+
+	_renderArea = rotateScissor(_constraints, target);
+	_hasRenderArea = true;
+
+	auto region = rotateScissor(_constraints, damageRect);
+	image->setPresentRegion(URect{uint32_t(region.offset.x), uint32_t(region.offset.y),
+		region.extent.width, region.extent.height});
+}
+
+void VertexPassHandle::setScissor(CommandBuffer &buf, VkRect2D rect) {
+	if (_hasRenderArea) {
+		auto minX = std::max(rect.offset.x, _renderArea.offset.x);
+		auto minY = std::max(rect.offset.y, _renderArea.offset.y);
+		auto maxX = std::min(rect.offset.x + int32_t(rect.extent.width),
+				_renderArea.offset.x + int32_t(_renderArea.extent.width));
+		auto maxY = std::min(rect.offset.y + int32_t(rect.extent.height),
+				_renderArea.offset.y + int32_t(_renderArea.extent.height));
+
+		rect.offset = VkOffset2D{minX, minY};
+		rect.extent = VkExtent2D{uint32_t(std::max(maxX - minX, 0)),
+			uint32_t(std::max(maxY - minY, 0))};
+	}
+
+	buf.cmdSetScissor(0, makeSpanView(&rect, 1));
+}
+
 void VertexPassHandle::clearDynamicState(CommandBuffer &buf) {
 	auto currentExtent = getFramebuffer()->getExtent();
 
@@ -1372,7 +1784,7 @@ void VertexPassHandle::clearDynamicState(CommandBuffer &buf) {
 	buf.cmdSetViewport(0, makeSpanView(&viewport, 1));
 
 	VkRect2D scissorRect{{0, 0}, {currentExtent.width, currentExtent.height}};
-	buf.cmdSetScissor(0, makeSpanView(&scissorRect, 1));
+	setScissor(buf, scissorRect);
 
 	_dynamicStateId = maxOf<StateId>();
 	_dynamicState = DrawStateValues();
@@ -1391,27 +1803,27 @@ void VertexPassHandle::applyDynamicState(const FrameContextHandle2d *commands, C
 		if (_dynamicState.isScissorEnabled()) {
 			_dynamicState.enabled &= ~(core::DynamicState::Scissor);
 			VkRect2D scissorRect{{0, 0}, {currentExtent.width, currentExtent.height}};
-			buf.cmdSetScissor(0, makeSpanView(&scissorRect, 1));
+			setScissor(buf, scissorRect);
 		}
 	} else {
 		if (state->isScissorEnabled()) {
 			if (_dynamicState.isScissorEnabled()) {
 				if (_dynamicState.scissor != state->scissor) {
 					auto scissorRect = rotateScissor(_constraints, state->scissor);
-					buf.cmdSetScissor(0, makeSpanView(&scissorRect, 1));
+					setScissor(buf, scissorRect);
 					_dynamicState.scissor = state->scissor;
 				}
 			} else {
 				_dynamicState.enabled |= core::DynamicState::Scissor;
 				auto scissorRect = rotateScissor(_constraints, state->scissor);
-				buf.cmdSetScissor(0, makeSpanView(&scissorRect, 1));
+				setScissor(buf, scissorRect);
 				_dynamicState.scissor = state->scissor;
 			}
 		} else {
 			if (_dynamicState.isScissorEnabled()) {
 				_dynamicState.enabled &= ~(core::DynamicState::Scissor);
 				VkRect2D scissorRect{{0, 0}, {currentExtent.width, currentExtent.height}};
-				buf.cmdSetScissor(0, makeSpanView(&scissorRect, 1));
+				setScissor(buf, scissorRect);
 			}
 		}
 	}
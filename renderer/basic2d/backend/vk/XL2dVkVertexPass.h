@@ -27,6 +27,7 @@
 #include "XL2dVkMaterial.h"
 #include "XL2dCommandList.h"
 #include "XL2dVkParticlePass.h"
+#include "XLCoreFramePool.h"
 
 #if MODULE_XENOLITH_BACKEND_VK
 
@@ -40,12 +41,16 @@ public:
 
 	const AttachmentData *getMaterials() const { return _materials; }
 
+	// scratch pools for vertex processing, reused between frames
+	core::FramePoolRing *getFramePools() const { return _framePools; }
+
 protected:
 	using GenericAttachment::init;
 
 	virtual Rc<AttachmentHandle> makeFrameHandle(const FrameQueue &) override;
 
 	const AttachmentData *_materials = nullptr;
+	Rc<core::FramePoolRing> _framePools;
 };
 
 class SP_PUBLIC VertexAttachmentHandle : public core::AttachmentHandle {
@@ -99,6 +104,7 @@ public:
 
 	virtual ~VertexPass() = default;
 
+	const AttachmentData *getOutput() const { return _output; }
 	const AttachmentData *getVertexes() const { return _vertexes; }
 	const AttachmentData *getMaterials() const { return _materials; }
 	const AttachmentData *getParticles() const { return _particles; }
@@ -136,6 +142,12 @@ protected:
 	virtual void prepareMaterialCommands(core::MaterialSet *materials, CommandBuffer &);
 	virtual void finalizeRenderPass(CommandBuffer &);
 
+	// Limits drawing with frame damage, when previous contents of the output image is known
+	virtual void updateRenderArea(FrameHandle &);
+
+	// Set scissor, clipped by render area
+	void setScissor(CommandBuffer &buf, VkRect2D);
+
 	void clearDynamicState(CommandBuffer &buf);
 	void applyDynamicState(const FrameContextHandle2d *commands, CommandBuffer &buf,
 			uint32_t stateId);
@@ -34,8 +34,13 @@ namespace STAPPLER_VERSIONIZED stappler::glsl {
 #define XL_GLSL_MATERIAL_FLAG_HAS_ATLAS_DATA 2
 #define XL_GLSL_MATERIAL_FLAG_HAS_ATLAS 3 // (XL_GLSL_MATERIAL_FLAG_HAS_ATLAS_INDEX | XL_GLSL_MATERIAL_FLAG_HAS_ATLAS_DATA)
 #define XL_GLSL_MATERIAL_FLAG_ATLAS_IS_BDA 4
+#define XL_GLSL_MATERIAL_FLAG_COMPACT_VERTEX 8
+#define XL_GLSL_MATERIAL_FLAG_DISTANCE_FIELD 16
 #define XL_GLSL_MATERIAL_FLAG_ATLAS_POW2_INDEX_BIT_OFFSET 24
 
+#define XL_GLSL_VERTEX_FLAG_QUADS 1
+#define XL_GLSL_VERTEX_FLAG_FULL 2
+
 #define XL_GLSL_FLAG_POSITION_MASK_X (1 << 0)
 #define XL_GLSL_FLAG_POSITION_MASK_Y (1 << 1)
 #define XL_GLSL_FLAG_POSITION_MASK_Z (1 << 2)
@@ -52,6 +57,8 @@ struct VertexConstantData {
 	uint samplerIdx; // 36-40
 	uint gradientOffset; // 40-44
 	uint gradientCount; // 44-48
+	uint vertexFlags; // 48-52
+	uint padding0; // 52-56
 };
 
 struct PSDFConstantData {
@@ -72,6 +79,32 @@ struct Vertex {
 	uint object;
 };
 
+// Compact vertex layout for materials with XL_GLSL_MATERIAL_FLAG_COMPACT_VERTEX:
+// position is 2d (z = 0, w = 1), color is RGBA8 unorm, tex is 2x unorm16,
+// material and object are the same as for Vertex; draws with XL_GLSL_VERTEX_FLAG_FULL
+// use full layout for such materials
+struct CompactVertex {
+	vec2 pos;
+	uint color;
+	uint tex;
+	uint material;
+	uint object;
+};
+
+// Quad record for XL_GLSL_VERTEX_FLAG_QUADS draws, expanded into 6 vertexes from gl_VertexIndex
+// Corners: 0 - top-left, 1 - bottom-left, 2 - top-right, 3 - bottom-right
+struct QuadInstance {
+	vec2 pos0; // bottom-left corner
+	vec2 pos1; // top-right corner
+	uvec2 tex; // unorm16: top-left u, v; bottom-right u, v
+	uint color; // RGBA8 unorm
+	uint material;
+	uint object; // top-left corner object
+	uint objectDeltas; // 8-bit xor deltas for corners 1-3, shift for them in high byte
+	float layer;
+	uint padding0;
+};
+
 struct MaterialData {
 	uint samplerImageIdx;
 	uint setIdx;
@@ -115,7 +115,20 @@ void main() {
 		textureColor = texture(SAMPLER2D_PC, fragTexCoord.xy);
 	}
 
-	if (outlineOffset > 0.0) {
+	if (tex.z != 0) {
+		// distance field: edge at 0.5, antialiasing width from screen-space derivatives
+		const float dist = textureColor.a;
+		const float width = max(fwidth(dist) * 0.5, 0.0001);
+		const float fill = smoothstep(0.5 - width, 0.5 + width, dist);
+
+		if (outlineOffset > 0.0) {
+			const float edge = 0.5 - outlineOffset * width * 2.0;
+			const float outline = smoothstep(edge - width, edge + width, dist);
+			outColor = mix(outlineColor * outline, fragColor, fill);
+		} else {
+			outColor = fragColor * vec4(textureColor.rgb, fill);
+		}
+	} else if (outlineOffset > 0.0) {
 		float outlineSample = getOutlineSample(fragTexCoord.xy, textureColor.a, fragTexCoord.z);
 
 		outColor = outlineColor * outlineSample + textureColor * (1.0 - outlineSample);
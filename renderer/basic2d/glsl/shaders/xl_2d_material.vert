@@ -14,6 +14,8 @@
 layout (constant_id = 0) const int BUFFERS_ARRAY_SIZE = 8;
 
 layout(buffer_reference) readonly buffer VertexBuffer;
+layout(buffer_reference) readonly buffer CompactVertexBuffer;
+layout(buffer_reference) readonly buffer QuadInstanceBuffer;
 layout(buffer_reference) readonly buffer TransformBuffer;
 layout(buffer_reference) readonly buffer MaterialDataBuffer;
 layout(buffer_reference) readonly buffer DataAtlasBuffer;
@@ -22,6 +24,14 @@ layout(std430, buffer_reference, buffer_reference_align = 8) readonly buffer Ver
 	Vertex vertices[];
 };
 
+layout(std430, buffer_reference, buffer_reference_align = 8) readonly buffer CompactVertexBuffer {
+	CompactVertex vertices[];
+};
+
+layout(std430, buffer_reference, buffer_reference_align = 8) readonly buffer QuadInstanceBuffer {
+	QuadInstance quads[];
+};
+
 layout(std430, buffer_reference, buffer_reference_align = 8) readonly buffer TransformBuffer {
 	TransformData transforms[];
 };
@@ -55,12 +65,55 @@ uint hash(uint k, uint capacity) {
 	return k & (capacity - 1);
 }
 
+const uint QUAD_CORNERS[6] = uint[6](0, 1, 2, 3, 2, 1);
+
+Vertex readQuadVertex() {
+	QuadInstanceBuffer quadBuffer = QuadInstanceBuffer(pushConstants.vertexPointer);
+	const QuadInstance quad = quadBuffer.quads[gl_VertexIndex / 6];
+	const uint corner = QUAD_CORNERS[gl_VertexIndex % 6];
+
+	const bool right = corner >= 2;
+	const bool bottom = (corner & 1) != 0;
+	const vec2 texTL = unpackUnorm2x16(quad.tex.x);
+	const vec2 texBR = unpackUnorm2x16(quad.tex.y);
+	const uint delta = (corner == 0) ? 0 : ((quad.objectDeltas >> ((corner - 1) * 8)) & 0xFF);
+
+	Vertex ret;
+	ret.pos = vec4(right ? quad.pos1.x : quad.pos0.x, bottom ? quad.pos0.y : quad.pos1.y,
+			quad.layer, 1.0);
+	ret.color = unpackUnorm4x8(quad.color);
+	ret.tex = vec2(right ? texBR.x : texTL.x, bottom ? texBR.y : texTL.y);
+	ret.material = quad.material;
+	ret.object = quad.object ^ (delta << (quad.objectDeltas >> 24));
+	return ret;
+}
+
+Vertex readVertex(uint flags) {
+	if ((pushConstants.vertexFlags & XL_GLSL_VERTEX_FLAG_QUADS) != 0) {
+		return readQuadVertex();
+	} else if ((flags & XL_GLSL_MATERIAL_FLAG_COMPACT_VERTEX) != 0
+			&& (pushConstants.vertexFlags & XL_GLSL_VERTEX_FLAG_FULL) == 0) {
+		CompactVertexBuffer compactBuffer = CompactVertexBuffer(pushConstants.vertexPointer);
+		const CompactVertex compact = compactBuffer.vertices[gl_VertexIndex];
+
+		Vertex ret;
+		ret.pos = vec4(compact.pos, 0.0, 1.0);
+		ret.color = unpackUnorm4x8(compact.color);
+		ret.tex = unpackUnorm2x16(compact.tex);
+		ret.material = compact.material;
+		ret.object = compact.object;
+		return ret;
+	} else {
+		VertexBuffer vertexBuffer = VertexBuffer(pushConstants.vertexPointer);
+		return vertexBuffer.vertices[gl_VertexIndex];
+	}
+}
+
 void main() {
-	VertexBuffer vertexBuffer = VertexBuffer(pushConstants.vertexPointer);
 	TransformBuffer transformBuffer = TransformBuffer(pushConstants.transformPointer);
 	MaterialDataBuffer materialBuffer = MaterialDataBuffer(pushConstants.materialPointer);
 
-	const Vertex vertex = vertexBuffer.vertices[gl_VertexIndex];
+	const Vertex vertex = readVertex(materialBuffer.m.flags);
 	const TransformData transform = transformBuffer.transforms[vertex.material >> 16];
 	const TransformData instance = transformBuffer.transforms[gl_InstanceIndex];
 
@@ -107,5 +160,6 @@ void main() {
 	outlineColor = transform.outlineColor * instance.outlineColor;
 	outlineOffset = max(transform.outlineOffset, instance.outlineOffset);
 
-	texOut = uvec4(materialBuffer.m.samplerImageIdx & 0xFFFF, (materialBuffer.m.samplerImageIdx >> 16) & 0xFFFF, 0, 0);
+	texOut = uvec4(materialBuffer.m.samplerImageIdx & 0xFFFF, (materialBuffer.m.samplerImageIdx >> 16) & 0xFFFF,
+		(materialBuffer.m.flags & XL_GLSL_MATERIAL_FLAG_DISTANCE_FIELD) != 0 ? 1 : 0, 0);
 }
@@ -23,6 +23,7 @@
 #include "XLCommon.h"
 
 #include "base/MaterialColorScheme.cc"
+#include "base/MaterialColorCache.cc"
 #include "base/MaterialDataSource.cc"
 #include "base/MaterialStyleContainer.cc"
 #include "base/MaterialStyleMonitor.cc"
@@ -0,0 +1,184 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "MaterialColorCache.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::material2d {
+
+struct ColorCacheShard {
+	Mutex mutex;
+	HashMap<uint64_t, Color4F> colors;
+};
+
+struct ColorCacheData {
+	std::array<ColorCacheShard, ColorCache::Shards> shards;
+	std::atomic<uint64_t> hits = 0;
+	std::atomic<uint64_t> misses = 0;
+};
+
+static ColorCacheData s_colorCache;
+
+static constexpr size_t ColorCache_ShardEntries = ColorCache::MaxEntries / ColorCache::Shards;
+
+static uint64_t ColorCache_quantize(float value, float max) {
+	return uint64_t(std::round(std::clamp(value, 0.0f, max) * 10.0f));
+}
+
+static uint64_t ColorCache_getKey(const ColorHCT::Values &v) {
+	return (ColorCache_quantize(float(v.hue), 360.0f) << 40)
+			| (ColorCache_quantize(float(v.chroma), 10'000.0f) << 20)
+			| ColorCache_quantize(float(v.tone), 100.0f);
+}
+
+static size_t ColorCache_getShard(uint64_t key) {
+	return size_t((key * 0x9E37'79B9'7F4A'7C15ULL) >> 32) % ColorCache::Shards;
+}
+
+static Color4F ColorCache_solveKey(uint64_t key) {
+	auto hue = float(key >> 40) / 10.0f;
+	auto chroma = float((key >> 20) & 0xF'FFFF) / 10.0f;
+	auto tone = float(key & 0xF'FFFF) / 10.0f;
+	return ColorHCT::solveColor4F(geom::Cam16Float(hue), geom::Cam16Float(chroma),
+			geom::Cam16Float(tone), 1.0f);
+}
+
+static void ColorCache_store(ColorCacheShard &shard, uint64_t key, const Color4F &color) {
+	if (shard.colors.size() >= ColorCache_ShardEntries) {
+		// working set is small (scheme roles and transitions), so simple reset is enough
+		shard.colors.clear();
+	}
+	shard.colors.emplace(key, color);
+}
+
+Color4F ColorCache::solve(const ColorHCT::Values &values) {
+	auto key = ColorCache_getKey(values);
+	auto &shard = s_colorCache.shards[ColorCache_getShard(key)];
+
+	std::unique_lock lock(shard.mutex);
+	auto it = shard.colors.find(key);
+	if (it != shard.colors.end()) {
+		auto ret = it->second;
+		lock.unlock();
+
+		++s_colorCache.hits;
+		ret.a = values.alpha;
+		return ret;
+	}
+	lock.unlock();
+
+	// solve without lock, concurrent solve for the same key produces the same result
+	auto ret = ColorCache_solveKey(key);
+	++s_colorCache.misses;
+
+	lock.lock();
+	ColorCache_store(shard, key, ret);
+	lock.unlock();
+
+	ret.a = values.alpha;
+	return ret;
+}
+
+void ColorCache::solve(SpanView<ColorHCT::Values> values, Color4F *out) {
+	struct Item {
+		uint64_t key;
+		size_t shard;
+		size_t idx;
+	};
+
+	Vector<Item> items;
+	items.reserve(values.size());
+	for (size_t i = 0; i < values.size(); ++i) {
+		auto key = ColorCache_getKey(values[i]);
+		items.emplace_back(Item{key, ColorCache_getShard(key), i});
+	}
+
+	std::sort(items.begin(), items.end(), [](const Item &l, const Item &r) {
+		return (l.shard == r.shard) ? l.key < r.key : l.shard < r.shard;
+	});
+
+	// lookup, shard by shard
+	Vector<const Item *> missing;
+	auto it = items.begin();
+	while (it != items.end()) {
+		auto &shard = s_colorCache.shards[it->shard];
+		auto shardIdx = it->shard;
+
+		std::unique_lock lock(shard.mutex);
+		for (; it != items.end() && it->shard == shardIdx; ++it) {
+			auto cacheIt = shard.colors.find(it->key);
+			if (cacheIt != shard.colors.end()) {
+				out[it->idx] = cacheIt->second;
+				++s_colorCache.hits;
+			} else {
+				missing.emplace_back(&*it);
+			}
+		}
+	}
+
+	if (!missing.empty()) {
+		// solve unique keys without lock; missing items are still ordered by shard and key
+		const Item *prev = nullptr;
+		for (auto item : missing) {
+			if (prev && prev->key == item->key) {
+				out[item->idx] = out[prev->idx];
+				++s_colorCache.hits;
+			} else {
+				out[item->idx] = ColorCache_solveKey(item->key);
+				++s_colorCache.misses;
+			}
+			prev = item;
+		}
+
+		auto mit = missing.begin();
+		while (mit != missing.end()) {
+			auto &shard = s_colorCache.shards[(*mit)->shard];
+			auto shardIdx = (*mit)->shard;
+
+			std::unique_lock lock(shard.mutex);
+			for (; mit != missing.end() && (*mit)->shard == shardIdx; ++mit) {
+				ColorCache_store(shard, (*mit)->key, out[(*mit)->idx]);
+			}
+		}
+	}
+
+	for (size_t i = 0; i < values.size(); ++i) { out[i].a = values[i].alpha; }
+}
+
+ColorCache::Stats ColorCache::getStats() {
+	Stats ret;
+	ret.hits = s_colorCache.hits.load();
+	ret.misses = s_colorCache.misses.load();
+	for (auto &it : s_colorCache.shards) {
+		std::unique_lock lock(it.mutex);
+		ret.entries += it.colors.size();
+	}
+	return ret;
+}
+
+void ColorCache::clear() {
+	for (auto &it : s_colorCache.shards) {
+		std::unique_lock lock(it.mutex);
+		it.colors.clear();
+	}
+}
+
+} // namespace stappler::xenolith::material2d
@@ -0,0 +1,59 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef XENOLITH_RENDERER_MATERIAL2D_BASE_MATERIALCOLORCACHE_H_
+#define XENOLITH_RENDERER_MATERIAL2D_BASE_MATERIALCOLORCACHE_H_
+
+#include "MaterialColorScheme.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::material2d {
+
+/* Shared memo for HCT -> RGB resolution
+ *
+ * Solving HCT requires iterative search in CAM16 space, but surfaces use limited set of scheme
+ * colors and transitions between them. Values are quantized (0.1 for hue, chroma and tone),
+ * alpha is not the part of solution and applied after lookup. Cache is thread-safe.
+ */
+struct SP_PUBLIC ColorCache {
+	static constexpr size_t Shards = 8;
+	static constexpr size_t MaxEntries = 8'192;
+
+	struct Stats {
+		uint64_t hits = 0;
+		uint64_t misses = 0;
+		size_t entries = 0;
+	};
+
+	static Color4F solve(const ColorHCT::Values &);
+	static Color4F solve(const ColorHCT &color) { return solve(color.data); }
+
+	// Resolves set of colors at once: duplicates are solved once and every cache shard is locked
+	// only once per call
+	static void solve(SpanView<ColorHCT::Values>, Color4F *);
+
+	static Stats getStats();
+	static void clear();
+};
+
+} // namespace stappler::xenolith::material2d
+
+#endif /* XENOLITH_RENDERER_MATERIAL2D_BASE_MATERIALCOLORCACHE_H_ */
@@ -22,6 +22,7 @@
  **/
 
 #include "MaterialIconSprite.h"
+#include "MaterialColorCache.h"
 #include "MaterialStyleContainer.h"
 #include "XLAction.h"
 
@@ -97,7 +98,7 @@ bool IconSprite::visitDraw(FrameInfo &frame, NodeVisitFlags parentFlags) {
 			}
 		}
 
-		auto color = s.colorOn.asColor4F();
+		auto color = ColorCache::solve(s.colorOn);
 		if (_blendValue > 0.0f) {
 			color = color * (1.0f - _blendValue) + _blendColor * _blendValue;
 		}
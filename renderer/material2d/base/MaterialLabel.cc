@@ -22,6 +22,7 @@
  **/
 
 #include "MaterialLabel.h"
+#include "MaterialColorCache.h"
 #include "MaterialSurface.h"
 #include "MaterialStyleContainer.h"
 #include "MaterialSurfaceInterior.h"
@@ -220,7 +221,7 @@ bool TypescaleLabel::visitDraw(FrameInfo &frame, NodeVisitFlags parentFlags) {
 			}
 		}
 
-		auto color = s.colorOn.asColor4F();
+		auto color = ColorCache::solve(s.colorOn);
 		if (_blendValue > 0.0f) {
 			color = color * (1.0f - _blendValue) + _blendColor * _blendValue;
 		}
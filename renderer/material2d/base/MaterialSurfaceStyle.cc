@@ -22,6 +22,7 @@
  **/
 
 #include "MaterialSurfaceStyle.h"
+#include "MaterialColorCache.h"
 #include "MaterialStyleContainer.h"
 #include "MaterialSurfaceInterior.h"
 
@@ -330,7 +331,7 @@ bool SurfaceStyle::apply(SurfaceStyleData &data, const Size2 &contentSize, const
 
 	if (targetColorHCT != data.colorHCT.data) {
 		data.colorHCT = targetColorHCT;
-		data.colorScheme = data.colorHCT.asColor4F();
+		data.colorScheme = ColorCache::solve(data.colorHCT);
 		dirty = true;
 	}
 	if (targetColorBackground != data.colorBackground.data) {
@@ -371,7 +372,7 @@ bool SurfaceStyle::apply(SurfaceStyleData &data, const Size2 &contentSize, const
 	}
 
 	if (dirty) {
-		data.colorElevation = data.colorBackground.asColor4F() * (1.0f - data.elevationValue) + data.colorScheme * data.elevationValue;
+		data.colorElevation = ColorCache::solve(data.colorBackground) * (1.0f - data.elevationValue) + data.colorScheme * data.elevationValue;
 	}
 
 	if (targetColorOn != data.colorOn.data) {
@@ -416,14 +417,19 @@ SurfaceStyleData SurfaceStyleData::progress(const SurfaceStyleData &l, const Sur
 	ret.colorBackground = stappler::progress(l.colorBackground, r.colorBackground, p);
 	ret.colorOn = stappler::progress(l.colorOn, r.colorOn, p);
 
-	ret.colorScheme = ret.colorHCT;
+	// both colors are interpolated every frame of transition, resolve them together
+	ColorHCT::Values values[2] = {ret.colorHCT.data, ret.colorBackground.data};
+	Color4F colors[2];
+	ColorCache::solve(SpanView<ColorHCT::Values>(values, 2), colors);
+
+	ret.colorScheme = colors[0];
 	ret.elevationValue = stappler::progress(l.elevationValue, r.elevationValue, p);
 	ret.outlineValue = stappler::progress(l.outlineValue, r.outlineValue, p);
 	if (ret.outlineValue < 0.1f) {
 		ret.outlineValue = 0.0f;
 	}
 
-	ret.colorElevation = ret.colorBackground.asColor4F() * (1.0f - ret.elevationValue) + ret.colorScheme * ret.elevationValue;
+	ret.colorElevation = colors[1] * (1.0f - ret.elevationValue) + ret.colorScheme * ret.elevationValue;
 
 	if (l.shapeFamily == r.shapeFamily) {
 		ret.cornerRadius = stappler::progress(l.cornerRadius, r.cornerRadius, p);
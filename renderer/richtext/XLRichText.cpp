@@ -25,6 +25,7 @@
 #include "XLRTSourceAsset.cc"
 #include "XLRTCommonSource.cc"
 #include "XLRTRenderer.cc"
+#include "XLRTLayoutCache.cc"
 #include "XLRTCommonView.cc"
 #include "XLRTListenerView.cc"
 #include "XLRTView.cc"
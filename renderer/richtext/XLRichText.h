@@ -54,6 +54,7 @@ class CommonView;
 class ListenerView;
 class View;
 class ImageLayout;
+class LayoutCache;
 
 namespace config {
 
@@ -63,6 +64,9 @@ constexpr auto getDocumentAssetTtl() {
 
 constexpr uint32_t ENGINE_VERSION = 4;
 
+// Number of complete document layouts, kept in memory to reopen documents without relayout
+constexpr uint32_t LayoutCacheSize = 8;
+
 } // namespace config
 
 } // namespace stappler::xenolith::richtext
@@ -47,13 +47,32 @@ bool CommonSource::init(AssetLibrary *lib, SourceAsset *asset, bool enabled) {
 	return true;
 }
 
-void CommonSource::setHyphens(font::HyphenMap *map) { _hyphens = map; }
+void CommonSource::setHyphens(font::HyphenMap *map, StringView version) {
+	_hyphens = map;
+	_hyphensVersion = version.str<Interface>();
+}
 
 font::HyphenMap *CommonSource::getHyphens() const { return _hyphens; }
 
 Document *CommonSource::getDocument() const { return static_cast<Document *>(_document.get()); }
 SourceAsset *CommonSource::getAsset() const { return _documentAsset; }
 
+String CommonSource::getDocumentKey() const {
+	if (!_document) {
+		return String();
+	}
+
+	if (auto fileAsset = dynamic_cast<SourceFileAsset *>(_documentAsset.get())) {
+		return toString("file:", fileAsset->getFilePath(), ":", _documentMTime);
+	} else if (auto networkAsset = dynamic_cast<SourceNetworkAsset *>(_documentAsset.get())) {
+		if (auto asset = networkAsset->getAsset()) {
+			return toString("url:", asset->getUrl(), ":", _documentMTime);
+		}
+	}
+
+	return String();
+}
+
 Map<String, DocumentAssetMeta> CommonSource::getExternalAssetMeta() const {
 	Map<String, DocumentAssetMeta> ret;
 	for (auto &it : _networkAssets) {
@@ -188,6 +207,7 @@ void CommonSource::tryLoadDocument(SourceAssetLock *lock) {
 		if (success && l->document) {
 			auto lcb = [this, l] {
 				_documentLoading = false;
+				_documentMTime = l->lock->getMTime();
 				onDocumentLoaded(l->document.get());
 			};
 			if (onDocumentAssets(l->document, l->assets)) {
@@ -74,13 +74,21 @@ public:
 	virtual bool init(AssetLibrary *);
 	virtual bool init(AssetLibrary *, SourceAsset *, bool enabled = true);
 
-	void setHyphens(font::HyphenMap *);
+	// Hyphenation rules affect layout, version identifies dictionaries, loaded into map, in
+	// layout cache key, and should be changed when they are changed; layouts with map,
+	// that was set without version, are not reused
+	void setHyphens(font::HyphenMap *, StringView version = StringView());
 	font::HyphenMap *getHyphens() const;
+	StringView getHyphensVersion() const { return _hyphensVersion; }
 
 	Document *getDocument() const;
 	SourceAsset *getAsset() const;
 	Asset *getNetworkAsset() const;
 
+	// Identifies loaded document version between sources, views and application runs,
+	// returns empty key for documents without persistent origin
+	virtual String getDocumentKey() const;
+
 	virtual Map<String, DocumentAssetMeta> getExternalAssetMeta() const;
 	const Map<String, NetworkAssetData> &getNetworkAssets() const;
 	const Set<String> &getEmbeddedAssets() const;
@@ -139,6 +147,7 @@ protected:
 	Set<String> _embeddedAssets;
 
 	int64_t _loadedAssetMTime = 0;
+	int64_t _documentMTime = 0;
 	bool _documentLoading = false;
 	bool _enabled = true;
 
@@ -148,6 +157,7 @@ protected:
 	float _retryUpdate = nan();
 
 	Rc<font::HyphenMap> _hyphens;
+	String _hyphensVersion;
 
 	bool _dirty = true;
 	AssetLibrary *_assetLibrary = nullptr;
@@ -86,6 +86,15 @@ void CommonObject::handleEnter(Scene *scene) {
 	}
 }
 
+void CommonObject::handleExit() {
+	// glyphs of detached object can be evicted from atlas, request them again on enter
+	if (_fontSource) {
+		_fontSource->releaseGlyphs(_glyphs);
+		_vertexesDirty = true;
+	}
+	basic2d::Sprite::handleExit();
+}
+
 void CommonObject::handleContentSizeDirty() {
 	Sprite::handleContentSizeDirty();
 
@@ -104,6 +113,7 @@ void CommonObject::handleContentSizeDirty() {
 
 bool CommonObject::initAsLabel(document::Label *label) {
 	auto source = _director->getApplication()->getExtension<font::FontController>();
+	_fontSource = source;
 
 	setNormalized(true);
 	setColorMode(core::ColorMode::AlphaChannel);
@@ -116,10 +126,12 @@ bool CommonObject::initAsLabel(document::Label *label) {
 
 	if (source->isLoaded()) {
 		setTexture(Rc<Texture>(source->getTexture()));
+		setDistanceField(source->getRenderMode() == font::FontRenderMode::DistanceField);
 	} else {
 		el->listenForEventWithObject(font::FontController::onLoaded, source,
 				[this, source](const Event &) {
 			setTexture(Rc<Texture>(source->getTexture()));
+			setDistanceField(source->getRenderMode() == font::FontRenderMode::DistanceField);
 			_vertexesDirty = true;
 		}, true);
 	}
@@ -206,6 +218,8 @@ void CommonObject::updateLabel(document::Label *label) {
 		}
 	}
 
+	fc->retainGlyphs(_glyphs, SpanView<font::CharLayoutData>(label->layout.chars));
+
 	basic2d::Label::writeQuads(_vertexes, &label->layout, colorMap, _textureLayer);
 }
 
@@ -38,6 +38,7 @@ public:
 
 	virtual bool init(RendererResult *, document::Object *obj);
 	virtual void handleEnter(Scene *) override;
+	virtual void handleExit() override;
 	virtual void handleContentSizeDirty() override;
 
 protected:
@@ -59,6 +60,9 @@ protected:
 	Rc<basic2d::VectorSprite> _pathSprite;
 	Rc<basic2d::VectorSprite> _overlay;
 
+	Rc<font::FontController> _fontSource;
+	Vector<uint32_t> _glyphs;
+
 	bool _vertexesVisible = true;
 };
 
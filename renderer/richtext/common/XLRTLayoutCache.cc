@@ -0,0 +1,347 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "XLRTLayoutCache.h"
+#include "XLAppThread.h"
+#include "SPFilepath.h"
+#include "SPFilesystem.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::richtext {
+
+bool LayoutCache::init(uint32_t capacity) {
+	_capacity = std::max(capacity, uint32_t(1));
+	return true;
+}
+
+void LayoutCache::initialize(AppThread *app) { _application = app; }
+
+void LayoutCache::invalidate(AppThread *) {
+	clear();
+	_application = nullptr;
+}
+
+void LayoutCache::enableDiskCache(Codec &&codec, size_t budget) {
+	if (!codec.encode || !codec.decode) {
+		return;
+	}
+
+	std::unique_lock lock(_diskMutex);
+	_codec = sp::move(codec);
+	_diskBudget = budget;
+	if (_diskRoot.empty()) {
+		_diskRoot = filesystem::findWritablePath<Interface>(
+				FileInfo{"richtext.layouts", FileCategory::AppCache});
+		filesystem::mkdir(FileInfo{_diskRoot});
+		loadDiskIndex();
+	}
+	evictDisk();
+}
+
+void LayoutCache::acquire(Rc<RendererResult> &&req, AcquireCallback &&cb, Ref *ref) {
+	auto app = req->app;
+	if (auto result = get(req->cacheKey)) {
+		// result is published on next frame, as the result of layout
+		req->result = move(result);
+		app->performOnAppThread([req, cb]() mutable { cb(move(req)); }, ref, true);
+		return;
+	}
+
+	String path;
+	Function<Rc<document::LayoutResult>(BytesView, const RendererResult &)> decode;
+	if (isDiskCacheEnabled()) {
+		std::unique_lock lock(_diskMutex);
+		auto it = _diskEntries.find(req->cacheKey);
+		if (it != _diskEntries.end()) {
+			touchDiskEntry(it->second);
+			path = getDiskPath(it->second.id);
+			decode = _codec.decode;
+		}
+	}
+
+	if (path.empty()) {
+		do {
+			std::unique_lock lock(_diskMutex);
+			++_stats.misses;
+		} while (0);
+		cb(move(req));
+		return;
+	}
+
+	app->perform([req, path, decode](const thread::Task &) -> bool {
+		auto data = filesystem::readIntoMemory<Interface>(FileInfo{path});
+		if (!data.empty()) {
+			req->result = decode(data, *req);
+		}
+		return true;
+	}, [this, cache = Rc<LayoutCache>(this), req, cb](const thread::Task &, bool) mutable {
+		std::unique_lock lock(_diskMutex);
+		if (req->result) {
+			++_stats.diskHits;
+			lock.unlock();
+
+			auto it = _entries.find(req->cacheKey);
+			if (it == _entries.end()) {
+				it = _entries.emplace(req->cacheKey, Entry()).first;
+			}
+			it->second.result = req->result;
+			it->second.access = ++_clock;
+			evict();
+		} else {
+			// file is lost or can not be decoded with current codec
+			++_stats.misses;
+			auto it = _diskEntries.find(req->cacheKey);
+			if (it != _diskEntries.end()) {
+				eraseDiskEntry(it);
+				saveDiskIndex();
+			}
+			lock.unlock();
+		}
+		cb(move(req));
+	}, ref);
+}
+
+Rc<document::LayoutResult> LayoutCache::get(StringView key) {
+	auto it = _entries.find(key);
+	if (it == _entries.end()) {
+		return nullptr;
+	}
+
+	do {
+		std::unique_lock lock(_diskMutex);
+		++_stats.hits;
+	} while (0);
+
+	it->second.access = ++_clock;
+	return it->second.result;
+}
+
+void LayoutCache::store(StringView key, document::LayoutResult *result) {
+	if (key.empty() || !result) {
+		return;
+	}
+
+	auto it = _entries.find(key);
+	if (it == _entries.end()) {
+		it = _entries.emplace(key.str<Interface>(), Entry()).first;
+	}
+
+	it->second.result = result;
+	it->second.access = ++_clock;
+
+	evict();
+
+	if (!isDiskCacheEnabled() || !_application) {
+		return;
+	}
+
+	Function<Bytes(const document::LayoutResult *)> encode;
+	do {
+		std::unique_lock lock(_diskMutex);
+		if (_diskEntries.find(key) != _diskEntries.end()) {
+			return;
+		}
+		encode = _codec.encode;
+	} while (0);
+
+	// result is not changed after layout, so it's safe to encode it while it's shown
+	_application->perform([this, key = key.str<Interface>(),
+								  result = Rc<document::LayoutResult>(result),
+								  encode](const thread::Task &) -> bool {
+		auto data = encode(result);
+		if (!data.empty()) {
+			writeDiskEntry(key, sp::move(data));
+		}
+		return true;
+	}, nullptr, this);
+}
+
+void LayoutCache::remove(StringView key) {
+	auto it = _entries.find(key);
+	if (it != _entries.end()) {
+		_entries.erase(it);
+	}
+
+	std::unique_lock lock(_diskMutex);
+	auto dit = _diskEntries.find(key);
+	if (dit != _diskEntries.end()) {
+		eraseDiskEntry(dit);
+		saveDiskIndex();
+	}
+}
+
+void LayoutCache::clear() { _entries.clear(); }
+
+void LayoutCache::setCapacity(uint32_t capacity) {
+	_capacity = std::max(capacity, uint32_t(1));
+	evict();
+}
+
+LayoutCache::Stats LayoutCache::getStats() const {
+	std::unique_lock lock(_diskMutex);
+	auto ret = _stats;
+	ret.diskSize = _diskSize;
+	return ret;
+}
+
+void LayoutCache::evict() {
+	while (_entries.size() > _capacity) {
+		auto target = _entries.begin();
+		for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+			if (it->second.access < target->second.access) {
+				target = it;
+			}
+		}
+		_entries.erase(target);
+
+		std::unique_lock lock(_diskMutex);
+		++_stats.evicted;
+	}
+}
+
+void LayoutCache::loadDiskIndex() {
+	auto indexPath = filepath::merge<Interface>(_diskRoot, "index.cbor");
+	auto index = data::readFile<Interface>(FileInfo{indexPath});
+	if (!index) {
+		return;
+	}
+
+	if (index.getInteger("version") != DiskFormatVersion) {
+		// keys or results from previous format can not be reused
+		filesystem::remove(FileInfo{_diskRoot}, true, false);
+		return;
+	}
+
+	Vector<DiskEntry> entries;
+	_diskNextId = uint64_t(index.getInteger("next", 1));
+	for (auto &it : index.getArray("entries")) {
+		DiskEntry entry;
+		entry.key = it.getString("key");
+		entry.id = uint64_t(it.getInteger("id"));
+		entry.access = uint64_t(it.getInteger("access"));
+		entry.size = size_t(it.getInteger("size"));
+
+		if (entry.key.empty() || !filesystem::exists(FileInfo{getDiskPath(entry.id)})) {
+			continue;
+		}
+
+		_diskNextId = std::max(_diskNextId, entry.id + 1);
+		entries.emplace_back(sp::move(entry));
+	}
+
+	// restore LRU order with new sequence numbers
+	std::sort(entries.begin(), entries.end(),
+			[](const DiskEntry &l, const DiskEntry &r) { return l.access < r.access; });
+
+	for (auto &it : entries) {
+		it.access = ++_diskClock;
+		_diskSize += it.size;
+		_diskOrder.emplace(it.access, it.key);
+		_diskEntries.emplace(it.key, sp::move(it));
+	}
+}
+
+void LayoutCache::saveDiskIndex() {
+	Value entries;
+	for (auto &it : _diskEntries) {
+		entries.addValue(Value({
+			pair("key", Value(it.second.key)),
+			pair("id", Value(int64_t(it.second.id))),
+			pair("access", Value(int64_t(it.second.access))),
+			pair("size", Value(int64_t(it.second.size))),
+		}));
+	}
+
+	Value index({
+		pair("version", Value(int64_t(DiskFormatVersion))),
+		pair("next", Value(int64_t(_diskNextId))),
+		pair("entries", move(entries)),
+	});
+
+	data::save(index, FileInfo{filepath::merge<Interface>(_diskRoot, "index.cbor")},
+			data::EncodeFormat::Cbor);
+}
+
+String LayoutCache::getDiskPath(uint64_t id) const {
+	return filepath::merge<Interface>(_diskRoot, toString(id, ".bin"));
+}
+
+void LayoutCache::writeDiskEntry(StringView key, Bytes &&data) {
+	std::unique_lock lock(_diskMutex);
+	if (data.size() > _diskBudget || _diskEntries.find(key) != _diskEntries.end()) {
+		return;
+	}
+
+	auto id = _diskNextId++;
+	auto path = getDiskPath(id);
+	lock.unlock();
+
+	if (!filesystem::write(FileInfo{path}, data)) {
+		return;
+	}
+
+	lock.lock();
+	if (_diskEntries.find(key) != _diskEntries.end()) {
+		// stored by other task while file was written
+		filesystem::remove(FileInfo{path});
+		return;
+	}
+
+	auto it = _diskEntries.emplace(key.str<Interface>(), DiskEntry{key.str<Interface>(), id}).first;
+	it->second.size = data.size();
+	touchDiskEntry(it->second);
+
+	_diskSize += data.size();
+	++_stats.stored;
+
+	evictDisk();
+	saveDiskIndex();
+}
+
+void LayoutCache::touchDiskEntry(DiskEntry &entry) {
+	if (entry.access) {
+		_diskOrder.erase(entry.access);
+	}
+	entry.access = ++_diskClock;
+	_diskOrder.emplace(entry.access, entry.key);
+}
+
+void LayoutCache::eraseDiskEntry(Map<String, DiskEntry>::iterator it) {
+	filesystem::remove(FileInfo{getDiskPath(it->second.id)});
+	_diskOrder.erase(it->second.access);
+	_diskSize -= it->second.size;
+	_diskEntries.erase(it);
+}
+
+void LayoutCache::evictDisk() {
+	while (_diskSize > _diskBudget && !_diskOrder.empty()) {
+		auto it = _diskEntries.find(_diskOrder.begin()->second);
+		if (it == _diskEntries.end()) {
+			_diskOrder.erase(_diskOrder.begin());
+			continue;
+		}
+
+		eraseDiskEntry(it);
+		++_stats.evicted;
+	}
+}
+
+} // namespace stappler::xenolith::richtext
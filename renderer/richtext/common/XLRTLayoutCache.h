@@ -0,0 +1,143 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef EXTRA_DOCUMENT_RICHTEXT_COMMON_XLRTLAYOUTCACHE_H_
+#define EXTRA_DOCUMENT_RICHTEXT_COMMON_XLRTLAYOUTCACHE_H_
+
+#include "XLRTRenderer.h"
+#include "XLApplicationExtension.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::richtext {
+
+/* Application-wide cache for complete document layouts
+ *
+ * Results are keyed by document origin and version, media parameters, target ids, font set
+ * signature and hyphenation version (see Renderer::getLayoutCacheKey). Only layout results are
+ * kept, resources for rendering are prepared by renderer for every request.
+ *
+ * Last results are kept in memory. With enableDiskCache, results are also encoded with codec
+ * and stored in AppCache dir, so document can be reopened after application restart with
+ * reading and decoding instead of layout. Layout result is provided by the layout engine, so
+ * the codec for it is provided by application. Least recently used results are evicted when
+ * capacity or disk budget is exceeded. Should be used only from application thread.
+ */
+class SP_PUBLIC LayoutCache : public ApplicationExtension {
+public:
+	static constexpr size_t DefaultDiskBudget = 64 * 1'024 * 1'024;
+
+	// Increment when key or file format is changed
+	static constexpr uint32_t DiskFormatVersion = 1;
+
+	struct Codec {
+		Function<Bytes(const document::LayoutResult *)> encode;
+
+		// Request contains document, font controller, media and hyphens for the result
+		Function<Rc<document::LayoutResult>(BytesView, const RendererResult &)> decode;
+	};
+
+	using AcquireCallback = Function<void(Rc<RendererResult> &&)>;
+
+	struct Stats {
+		uint64_t hits = 0;
+		uint64_t diskHits = 0;
+		uint64_t misses = 0;
+		uint64_t stored = 0;
+		uint64_t evicted = 0;
+		size_t diskSize = 0;
+	};
+
+	virtual ~LayoutCache() = default;
+
+	bool init(uint32_t capacity = config::LayoutCacheSize);
+
+	virtual void initialize(AppThread *) override;
+	virtual void invalidate(AppThread *) override;
+
+	virtual void update(AppThread *, const UpdateTime &, bool) override { }
+
+	// Stores encoded results in AppCache dir and loads them on miss in memory
+	void enableDiskCache(Codec &&, size_t budget = DefaultDiskBudget);
+	bool isDiskCacheEnabled() const { return !_diskRoot.empty(); }
+
+	// Fills result for request with cacheKey, result from disk is read and decoded on worker
+	// thread; callback is called on application thread, request has no result on miss
+	void acquire(Rc<RendererResult> &&, AcquireCallback &&, Ref * = nullptr);
+
+	// Returns result from memory and marks it as recently used
+	Rc<document::LayoutResult> get(StringView key);
+
+	// Result is also encoded and stored on disk on worker thread, if disk cache is enabled
+	void store(StringView key, document::LayoutResult *);
+
+	void remove(StringView key);
+	void clear();
+
+	void setCapacity(uint32_t);
+	uint32_t getCapacity() const { return _capacity; }
+
+	Stats getStats() const;
+
+protected:
+	struct Entry {
+		Rc<document::LayoutResult> result;
+		uint64_t access = 0;
+	};
+
+	struct DiskEntry {
+		String key;
+		uint64_t id = 0; // name of data file
+		uint64_t access = 0;
+		size_t size = 0;
+	};
+
+	void evict();
+
+	// disk functions, except writeDiskEntry, should be called with _diskMutex locked
+	void loadDiskIndex();
+	void saveDiskIndex();
+	String getDiskPath(uint64_t id) const;
+	void writeDiskEntry(StringView key, Bytes &&);
+	void touchDiskEntry(DiskEntry &);
+	void eraseDiskEntry(Map<String, DiskEntry>::iterator);
+	void evictDisk();
+
+	AppThread *_application = nullptr;
+	uint32_t _capacity = config::LayoutCacheSize;
+	uint64_t _clock = 0;
+	Map<String, Entry> _entries;
+
+	// disk index is also updated from worker threads
+	mutable Mutex _diskMutex;
+	Codec _codec;
+	String _diskRoot;
+	size_t _diskBudget = DefaultDiskBudget;
+	size_t _diskSize = 0;
+	uint64_t _diskNextId = 1;
+	uint64_t _diskClock = 0;
+	Map<String, DiskEntry> _diskEntries;
+	Map<uint64_t, String> _diskOrder; // access sequence -> key, oldest first
+	Stats _stats;
+};
+
+} // namespace stappler::xenolith::richtext
+
+#endif /* EXTRA_DOCUMENT_RICHTEXT_COMMON_XLRTLAYOUTCACHE_H_ */
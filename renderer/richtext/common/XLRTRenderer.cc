@@ -22,6 +22,7 @@
 
 #include "XLRTRenderer.h"
 #include "XLRTCommonSource.h"
+#include "XLRTLayoutCache.h"
 #include "XLNode.h"
 #include "XL2dScrollView.h"
 #include "XLDirector.h"
@@ -63,6 +64,9 @@ RendererResult::RendererResult(const RendererResult &other) {
 	media = other.media;
 	ids = other.ids;
 	ctime = other.ctime;
+	cacheKey = other.cacheKey;
+	partial = other.partial;
+	partialPosition = other.partialPosition;
 }
 
 RendererResult &RendererResult::operator=(const RendererResult &other) {
@@ -77,6 +81,9 @@ RendererResult &RendererResult::operator=(const RendererResult &other) {
 	media = other.media;
 	ids = other.ids;
 	ctime = other.ctime;
+	cacheKey = other.cacheKey;
+	partial = other.partial;
+	partialPosition = other.partialPosition;
 	return *this;
 }
 
@@ -256,16 +263,20 @@ void Renderer::setPageMargin(const Padding &margin) {
 
 void Renderer::addOption(const StringView &str) {
 	_media.addOption(str);
+	_options.emplace(str.str<Interface>());
 	_renderingDirty = true;
 }
 
 void Renderer::removeOption(const StringView &str) {
 	_media.removeOption(str);
+	_options.erase(str.str<Interface>());
 	_renderingDirty = true;
 }
 
 bool Renderer::hasOption(const StringView &str) const { return _media.hasOption(str); }
 
+void Renderer::setLayoutCacheEnabled(bool value) { _layoutCacheEnabled = value; }
+
 void Renderer::addFlag(document::RenderFlags flag) {
 	_media.flags |= flag;
 	_renderingDirty = true;
@@ -319,43 +330,213 @@ bool Renderer::requestRendering() {
 		}
 		req->ids = _ids;
 
-		req->resource = _source->prepareResource(_owner->getDirector()->getResourceCache(),
-				req->document, req->ctime);
+		if (_layoutCacheEnabled) {
+			req->cacheKey = getLayoutCacheKey(*req);
+		}
 
 		_renderingInProgress = true;
 		if (_renderingCallback) {
 			_renderingCallback(nullptr, true);
 		}
 
-		app->perform([req](const thread::Task &) -> bool {
-			Vector<StringView> targetIds;
-			for (auto &it : req->ids) { targetIds.emplace_back(it); }
-
-			document::LayoutEngine impl(req->document,
-					[req](const document::FontStyleParameters &params) {
-				auto f = req->fc->getLayout(params);
-				if (!f) {
-					auto p = params;
-					p.fontFamily = "default";
-					f = req->fc->getLayout(p);
+		req->resource = _source->prepareResource(_owner->getDirector()->getResourceCache(),
+				req->document, req->ctime);
+
+		_renderingDirty = false;
+
+		auto cache = req->cacheKey.empty() ? nullptr : getLayoutCache();
+		if (cache) {
+			// document could be already laid out with the same parameters, then layout result
+			// is taken from memory or disk, and published with new resources
+			cache->acquire(move(req), [this](Rc<RendererResult> &&req) {
+				if (req->result) {
+					onResult(req);
+				} else {
+					startLayout(move(req));
 				}
-				return f;
-			}, req->media, targetIds);
-			impl.setExternalAssetsMeta(document::ExternalAssetsMap(req->resource->externalAssets));
-			impl.setHyphens(req->hyphen);
-			impl.render();
-
-			req->result = impl.getResult();
-			return true;
-		}, [this, req](const thread::Task &, bool) {
-			if (req->result) {
+			}, this);
+		} else {
+			startLayout(move(req));
+		}
+	}
+	return false;
+}
+
+void Renderer::startLayout(Rc<RendererResult> &&req) {
+	// when document is shown first time, lay out the page under the scroll position to show
+	// it as soon as possible; on relayout, previous result is shown until the new one is ready
+	if (!_result || _result->document != req->document) {
+		float position = nan();
+		auto priorityIds = getPriorityIds(req->document, position);
+		if (!priorityIds.empty()) {
+			auto partialReq = Rc<RendererResult>::alloc(*req);
+			partialReq->ids = sp::move(priorityIds);
+			partialReq->partial = true;
+			partialReq->partialPosition = position;
+			req = partialReq;
+		}
+	}
+
+	performLayout(move(req));
+}
+
+void Renderer::performLayout(Rc<RendererResult> &&req) {
+	auto app = req->app;
+	app->perform([req](const thread::Task &) -> bool {
+		Vector<StringView> targetIds;
+		for (auto &it : req->ids) { targetIds.emplace_back(it); }
+
+		document::LayoutEngine impl(req->document,
+				[req](const document::FontStyleParameters &params) {
+			auto f = req->fc->getLayout(params);
+			if (!f) {
+				auto p = params;
+				p.fontFamily = "default";
+				f = req->fc->getLayout(p);
+			}
+			return f;
+		}, req->media, targetIds);
+		impl.setExternalAssetsMeta(document::ExternalAssetsMap(req->resource->externalAssets));
+		impl.setHyphens(req->hyphen);
+		impl.render();
+
+		req->result = impl.getResult();
+		return true;
+	}, [this, req](const thread::Task &, bool) {
+		if (req->result) {
+			if (req->partial) {
+				onPartialResult(req);
+			} else {
 				onResult(req);
 			}
-		}, this);
+		} else {
+			_renderingInProgress = false;
+		}
+	}, this);
+}
 
-		_renderingDirty = false;
+Vector<String> Renderer::getPriorityIds(Document *document, float &position) const {
+	// position mapping is defined only for continuous scrolling
+	if (hasFlag(document::RenderFlags::PaginatedLayout)) {
+		return Vector<String>();
 	}
-	return false;
+
+	Vector<String> pages;
+	if (_ids.empty()) {
+		document->foreachPage([&](StringView name, const document::PageContainer *) {
+			pages.emplace_back(name.str<Interface>());
+		});
+	} else {
+		pages = _ids;
+	}
+
+	if (pages.size() <= 1) {
+		return Vector<String>();
+	}
+
+	// relative position is restored before the first layout or it's the current one;
+	// page heights are unknown until layout, so pages are taken as equal
+	float scrollPosition = 0.0f;
+	if (auto scroll = dynamic_cast<basic2d::ScrollViewBase *>(_owner)) {
+		scrollPosition = scroll->getScrollRelativePosition();
+		if (isnan(scrollPosition)) {
+			scrollPosition = 0.0f;
+		}
+		scrollPosition = std::clamp(scrollPosition, 0.0f, 1.0f);
+	}
+
+	auto index = std::min(size_t(scrollPosition * pages.size()), pages.size() - 1);
+	position = scrollPosition * pages.size() - float(index);
+
+	return Vector<String>{sp::move(pages[index])};
+}
+
+String Renderer::getLayoutCacheKey(const RendererResult &req) const {
+	if (!req.source || !req.fc || !req.fc->isLoaded()) {
+		return String();
+	}
+
+	auto documentKey = req.source->getDocumentKey();
+	if (documentKey.empty()) {
+		return String();
+	}
+
+	// hyphenation dictionaries can be identified only by the version, provided with them
+	auto hyphensVersion = req.source->getHyphensVersion();
+	if (req.hyphen && hyphensVersion.empty()) {
+		return String();
+	}
+
+	auto &media = req.media;
+
+	StringStream stream;
+	stream << documentKey << ";engine:" << config::ENGINE_VERSION
+		   << ";fonts:" << req.fc->getSignature() << ";hyphens:" << hyphensVersion;
+	stream << ";size:" << media.surfaceSize.width << "x" << media.surfaceSize.height
+		   << ";dpi:" << media.dpi << ";density:" << media.density
+		   << ";scale:" << media.fontScale;
+	stream << ";margin:" << media.pageMargin.top << "," << media.pageMargin.right << ","
+		   << media.pageMargin.bottom << "," << media.pageMargin.left;
+	stream << ";flags:" << toInt(media.flags) << ";media:" << toInt(media.mediaType) << ","
+		   << toInt(media.orientation) << "," << toInt(media.pointer) << ","
+		   << toInt(media.hover) << "," << toInt(media.lightLevel) << ","
+		   << toInt(media.scripting);
+	stream << ";bg:" << uint32_t(media.defaultBackground.r) << ","
+		   << uint32_t(media.defaultBackground.g) << "," << uint32_t(media.defaultBackground.b)
+		   << "," << uint32_t(media.defaultBackground.a);
+
+	stream << ";options:";
+	for (auto &it : _options) { stream << it << ","; }
+
+	stream << ";ids:";
+	for (auto &it : req.ids) { stream << it << ","; }
+
+	// image sizes affects layout, so assets state is the part of the key
+	stream << ";assets:";
+	for (auto &it : req.source->getExternalAssetMeta()) {
+		stream << it.first << "=" << it.second.type << "," << it.second.mtime << ","
+			   << it.second.imageWidth << "x" << it.second.imageHeight << ";";
+	}
+
+	return stream.str();
+}
+
+LayoutCache *Renderer::getLayoutCache() const {
+	if (!_owner || !_owner->getDirector()) {
+		return nullptr;
+	}
+
+	auto app = _owner->getDirector()->getApplication();
+	if (auto cache = app->getExtension<LayoutCache>()) {
+		return cache;
+	}
+	return app->addExtension(Rc<LayoutCache>::create());
+}
+
+void Renderer::onPartialResult(RendererResult *result) {
+	if (_renderingDirty) {
+		// parameters was changed, remaining layout is outdated, start over
+		_renderingInProgress = false;
+		requestRendering();
+		if (_owner && !_renderingInProgress && _renderingCallback) {
+			_renderingCallback(_result, false);
+		}
+		return;
+	}
+
+	_result = result;
+
+	if (_owner && _renderingCallback) {
+		_renderingCallback(_result, true);
+	}
+
+	// continue with the full document with the same parameters
+	auto req = Rc<RendererResult>::alloc(*result);
+	req->ids = _ids;
+	req->result = nullptr;
+	req->partial = false;
+
+	performLayout(move(req));
 }
 
 void Renderer::onResult(RendererResult *result) {
@@ -364,6 +545,11 @@ void Renderer::onResult(RendererResult *result) {
 		requestRendering();
 	} else {
 		_result = result;
+		if (!_result->cacheKey.empty()) {
+			if (auto cache = getLayoutCache()) {
+				cache->store(_result->cacheKey, _result->result);
+			}
+		}
 	}
 
 	if (_owner && !_renderingInProgress && _renderingCallback) {
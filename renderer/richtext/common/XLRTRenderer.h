@@ -42,6 +42,16 @@ struct SP_PUBLIC RendererResult : public Ref {
 	Vector<String> ids;
 	Time ctime;
 
+	// Key for LayoutCache, empty if result should not be cached
+	String cacheKey;
+
+	// Result contains only the page under the scroll position (the only one in ids),
+	// full layout is still in progress
+	bool partial = false;
+
+	// Estimated relative scroll position within the partial result
+	float partialPosition = nan();
+
 	RendererResult() = default;
 	RendererResult(const RendererResult &);
 	RendererResult &operator=(const RendererResult &);
@@ -96,6 +106,11 @@ public:
 	void removeOption(const StringView &);
 	bool hasOption(const StringView &) const;
 
+	// Complete layouts are stored in application-wide LayoutCache, so the same document
+	// with the same parameters can be shown again without layout (see LayoutCache)
+	void setLayoutCacheEnabled(bool);
+	bool isLayoutCacheEnabled() const { return _layoutCacheEnabled; }
+
 	void addFlag(document::RenderFlags flag);
 	void removeFlag(document::RenderFlags flag);
 	bool hasFlag(document::RenderFlags flag) const;
@@ -104,15 +119,37 @@ public:
 
 	virtual void setRenderingCallback(const RenderingCallback &);
 	virtual void onResult(RendererResult *result);
+	virtual void onPartialResult(RendererResult *result);
 
 protected:
 	virtual bool requestRendering();
+	virtual void startLayout(Rc<RendererResult> &&);
+	virtual void performLayout(Rc<RendererResult> &&);
+
+	// Selects the page under the scroll position, that should be laid out and shown before
+	// the whole document, and relative position within that page.
+	//
+	// Layout engine lays out a set of pages in one call, it can not lay out some blocks
+	// of a page or extend the existing result. So, viewport-first layout works only for
+	// documents with several pages in continuous scrolling, the full pass lays out the
+	// priority page again, and a running pass can not be cancelled, only discarded when it's
+	// finished. Single-page document (like long HTML) is shown only when it's laid out
+	// completely. Returns empty list if progressive layout is not applicable.
+	virtual Vector<String> getPriorityIds(Document *, float &position) const;
+
+	// Returns empty key if layout for the request can not be reused; key is the same
+	// between application runs, so it can be used for the disk cache
+	virtual String getLayoutCacheKey(const RendererResult &) const;
+
+	LayoutCache *getLayoutCache() const;
+
 	virtual void onSource();
 	virtual void pushVersionOptions();
 
 	bool _renderingDirty = false;
 	bool _renderingInProgress = false;
 	bool _isPageSplitted = false;
+	bool _layoutCacheEnabled = true;
 
 	float _fontScale = 1.0f;
 
@@ -120,6 +157,7 @@ protected:
 	Vector<String> _ids;
 	Size2 _surfaceSize;
 	MediaParameters _media;
+	Set<String> _options; // copy of media options, used for layout cache key
 	Rc<CommonSource> _source;
 	Rc<RendererResult> _result;
 	RenderingCallback _renderingCallback = nullptr;
@@ -162,7 +162,12 @@ int64_t SourceNetworkAsset::getMTime(const SourceAssetLock *l) const {
 	return 0;
 }
 
-bool SourceNetworkAsset::download() { return _asset->download(); }
+bool SourceNetworkAsset::download() {
+	if (!_asset->isDownloadInProgress()) {
+		attachStream();
+	}
+	return _asset->download();
+}
 
 bool SourceNetworkAsset::isDownloadAvailable() const { return _asset->isDownloadAvailable(); }
 bool SourceNetworkAsset::isDownloadInProgress() const { return _asset->isDownloadInProgress(); }
@@ -177,6 +182,12 @@ StringView SourceNetworkAsset::getContentType(const SourceAssetLock *l) const {
 
 bool SourceNetworkAsset::load(const SourceAssetLock *l, const Callback<void(BytesView)> &cb) const {
 	if (auto lock = dynamic_cast<AssetLock *>(l->getLock())) {
+		if (readStream(lock, cb)) {
+			// data is loaded for decoding once, next loads use version file
+			_stream->release();
+			return true;
+		}
+
 		auto d = filesystem::readIntoMemory<Interface>(FileInfo(lock->getPath()));
 		cb(d);
 		return true;
@@ -186,6 +197,18 @@ bool SourceNetworkAsset::load(const SourceAssetLock *l, const Callback<void(Byte
 
 bool SourceNetworkAsset::getImageSize(const SourceAssetLock *l, uint32_t &w, uint32_t &h) const {
 	if (auto lock = dynamic_cast<AssetLock *>(l->getLock())) {
+		bool found = false;
+		if (readStream(lock, [&](BytesView data) {
+			bitmap::ImageInfo info;
+			if (bitmap::getImageInfo(data, info)) {
+				w = info.width;
+				h = info.height;
+				found = true;
+			}
+		}) && found) {
+			return true;
+		}
+
 		return bitmap::getImageSize(FileInfo(lock->getPath()), w, h);
 	}
 	return false;
@@ -222,9 +245,29 @@ Rc<Ref> SourceNetworkAsset::doLockAsset(int64_t mtime) {
 void SourceNetworkAsset::onAsset(Asset *a) {
 	a->setForwardedSubscription(this);
 	_asset = a;
+	_stream = nullptr;
 	if (_asset) {
+		if (_asset->isDownloadInProgress()) {
+			attachStream();
+		}
 		setDirty(Subscription::Flags(Asset::CacheDataUpdated), true);
 	}
 }
 
+void SourceNetworkAsset::attachStream() {
+	if (_stream) {
+		_asset->removeStream(_stream);
+	}
+	_stream = Rc<storage::AssetStreamBuffer>::create();
+	_asset->addStream(Rc<storage::AssetStream>(_stream));
+}
+
+bool SourceNetworkAsset::readStream(const AssetLock *lock,
+		const Callback<void(BytesView)> &cb) const {
+	if (!_stream || !_stream->isComplete() || _stream->getPath() != lock->getPath()) {
+		return false;
+	}
+	return _stream->read(cb);
+}
+
 } // namespace stappler::xenolith::richtext
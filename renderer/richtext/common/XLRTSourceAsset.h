@@ -69,6 +69,8 @@ public:
 
 	virtual bool getImageSize(const SourceAssetLock *, uint32_t &w, uint32_t &h) const override;
 
+	StringView getFilePath() const { return _file; }
+
 protected:
 	String _type;
 	String _file;
@@ -113,7 +115,14 @@ protected:
 
 	virtual void onAsset(Asset *);
 
+	// attach staging buffer, so data of new version can be used without reading file back
+	void attachStream();
+
+	// returns true, if data for locked version was staged in memory
+	bool readStream(const AssetLock *, const Callback<void(BytesView)> &) const;
+
 	Rc<Asset> _asset;
+	Rc<storage::AssetStreamBuffer> _stream;
 };
 
 } // namespace stappler::xenolith::richtext
@@ -101,12 +101,37 @@ void View::onRestorePosition(document::LayoutResult *res, float pos) {
 	}
 }
 
+void View::onRestorePartialPosition(document::LayoutResult *res) {
+	// priority page is laid out the same way in the full result, so viewport keeps
+	// its offset from the start of this page
+	auto indexPoint = res->getIndexPoint(_partialPage);
+	if (indexPoint && !isnan(_partialOffset)) {
+		float pos = indexPoint->y + _partialOffset;
+		if (pos > getScrollMaxPosition()) {
+			pos = getScrollMaxPosition();
+		} else if (pos < getScrollMinPosition()) {
+			pos = getScrollMinPosition();
+		}
+		_savedPosition = ViewPosition{maxOf<size_t>(), 0.0f};
+		setScrollPosition(pos);
+	} else {
+		onRestorePosition(res, _partialRelativePosition);
+	}
+
+	_partialPage.clear();
+	_partialOffset = nan();
+	_partialRelativePosition = nan();
+}
+
 void View::onRenderer(RendererResult *res, bool status) {
 	_highlight->setDirty();
 	auto pos = getScrollRelativePosition();
 	if (!isnan(pos) && pos != 0.0f) {
 		_savedRelativePosition = pos;
 	}
+	if (!_partialPage.empty() && _renderSize != Size2::ZERO) {
+		_partialOffset = getScrollPosition();
+	}
 	if (_renderSize != Size2::ZERO && _savedPosition.object == maxOf<size_t>()) {
 		_savedPosition = getViewPosition();
 		_renderSize = Size2::ZERO;
@@ -122,11 +147,27 @@ void View::onRenderer(RendererResult *res, bool status) {
 		updateProgress();
 	}
 
-	if (res) {
+	if (res && res->partial) {
+		// only the page under the scroll position is ready, position in the document
+		// is restored with the full result
+		if (_partialPage.empty()) {
+			_partialRelativePosition = pos;
+		}
+		_partialPage = res->ids.empty() ? String() : res->ids.front();
+		_partialOffset = nan();
 		_renderSize = _contentSize;
 		_savedRelativePosition = nan();
 		updateScrollBounds();
-		onRestorePosition(res->result, pos);
+		setScrollRelativePosition(res->partialPosition);
+	} else if (res) {
+		_renderSize = _contentSize;
+		_savedRelativePosition = nan();
+		updateScrollBounds();
+		if (!_partialPage.empty()) {
+			onRestorePartialPosition(res->result);
+		} else {
+			onRestorePosition(res->result, pos);
+		}
 		_savedFontScale = res->result->getMedia().fontScale;
 		_layoutChanged = false;
 		onDocument(this);
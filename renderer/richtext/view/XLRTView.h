@@ -103,6 +103,7 @@ protected:
 	virtual void onPosition() override;
 
 	virtual void onRestorePosition(document::LayoutResult *res, float pos);
+	virtual void onRestorePartialPosition(document::LayoutResult *res);
 	virtual void onRenderer(RendererResult *, bool) override;
 
 	virtual void onLink(StringView ref, StringView target, WideStringView text, Vec2) override;
@@ -130,6 +131,12 @@ protected:
 	float _savedFontScale = nan();
 	Size2 _renderSize;
 	ViewPosition _savedPosition;
+
+	// page of the shown partial result, viewport offset on it and position in the document
+	String _partialPage;
+	float _partialOffset = nan();
+	float _partialRelativePosition = nan();
+
 	bool _layoutChanged = false;
 	bool _rendererUpdate = false;
 	bool _renderingEnabled = true;
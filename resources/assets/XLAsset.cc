@@ -26,6 +26,9 @@
 #include "XLAssetLibrary.h"
 #include "XLNetworkRequest.h"
 #include "XLAppThread.h" // IWYU pragma: keep
+#include "XLResourceCache.h"
+#include "XLTexture.h"
+#include "SPBitmap.h"
 
 #if WIN32
 #undef interface
@@ -37,6 +40,82 @@
 
 namespace STAPPLER_VERSIONIZED stappler::xenolith::storage {
 
+bool AssetStreamBuffer::init(size_t maxSize) {
+	_maxSize = maxSize;
+	return true;
+}
+
+void AssetStreamBuffer::handleStreamBegin(const AssetVersionData &data) {
+	std::unique_lock lock(_mutex);
+	_path = data.path;
+	_data.clear();
+	_complete = false;
+	_valid = data.size <= _maxSize;
+	if (_valid && data.size > 0) {
+		_data.reserve(data.size);
+	}
+}
+
+void AssetStreamBuffer::handleStreamData(BytesView data) {
+	std::unique_lock lock(_mutex);
+	if (!_valid) {
+		return;
+	}
+
+	if (_data.size() + data.size() > _maxSize) {
+		_valid = false;
+		_data = Bytes();
+		return;
+	}
+
+	_data.insert(_data.end(), data.begin(), data.end());
+}
+
+void AssetStreamBuffer::handleStreamEnd(bool success) {
+	std::unique_lock lock(_mutex);
+	_complete = true;
+	if (!success) {
+		_valid = false;
+		_data = Bytes();
+	}
+}
+
+bool AssetStreamBuffer::isComplete() const {
+	std::unique_lock lock(_mutex);
+	return _complete;
+}
+
+bool AssetStreamBuffer::isValid() const {
+	std::unique_lock lock(_mutex);
+	return _valid;
+}
+
+StringView AssetStreamBuffer::getPath() const {
+	std::unique_lock lock(_mutex);
+	return _path;
+}
+
+size_t AssetStreamBuffer::getSize() const {
+	std::unique_lock lock(_mutex);
+	return _data.size();
+}
+
+bool AssetStreamBuffer::read(const Callback<void(BytesView)> &cb) const {
+	std::unique_lock lock(_mutex);
+	if (!_valid || _data.empty()) {
+		return false;
+	}
+
+	cb(_data);
+	return true;
+}
+
+void AssetStreamBuffer::release() {
+	std::unique_lock lock(_mutex);
+	_valid = false;
+	_data = Bytes();
+}
+
 AssetLock::~AssetLock() {
 	if (_releaseFunction) {
 		_releaseFunction(_lockedVersion);
@@ -46,6 +125,45 @@ AssetLock::~AssetLock() {
 
 StringView AssetLock::getCachePath() const { return _asset->getCachePath(); }
 
+Rc<Texture> AssetLock::acquireTexture(ResourceCache *cache, AssetStreamBuffer *stream) {
+	Rc<AssetStreamBuffer> staged;
+	uint32_t width = 0;
+	uint32_t height = 0;
+	if (stream && stream->isComplete() && stream->getPath() == getPath()) {
+		stream->read([&](BytesView data) {
+			bitmap::ImageInfo info;
+			if (bitmap::getImageInfo(data, info)) {
+				width = info.width;
+				height = info.height;
+				staged = stream;
+			}
+		});
+	}
+
+	if (!staged && !bitmap::getImageSize(FileInfo(getPath()), width, height)) {
+		return nullptr;
+	}
+
+	return cache->addExternalImage(getPath(),
+			core::ImageInfo(core::ImageFormat::R8G8B8A8_UNORM, core::ImageUsage::Sampled,
+					Extent2(width, height)),
+			[lock = Rc<AssetLock>(this), staged](uint8_t *data, uint64_t size,
+					const core::ImageData::DataCallback &cb) {
+		auto load = [&](BytesView d) {
+			core::Resource::loadImageMemoryData(data, size, d, core::ImageFormat::R8G8B8A8_UNORM,
+					cb);
+		};
+
+		if (!staged || !staged->read(load)) {
+			load(filesystem::readIntoMemory<Interface>(FileInfo(lock->getPath())));
+		}
+
+		if (staged) {
+			staged->release();
+		}
+	});
+}
+
 AssetLock::AssetLock(Rc<Asset> &&asset, const AssetVersionData &data,
 		Function<void(const AssetVersionData &)> &&cb, Ref *owner)
 : _lockedVersion(data), _releaseFunction(sp::move(cb)), _asset(sp::move(asset)), _owner(owner) { }
@@ -276,6 +394,13 @@ void Asset::parseVersions(const db::Value &downloads) {
 				data.contentType = StringView(it.second.getString()).str<Interface>();
 			} else if (it.first == "complete") {
 				data.complete = it.second.getBool();
+			} else if (it.first == "ranges") {
+				data.ranges = it.second.getBool();
+			} else if (it.first == "segments" && it.second.isArray()) {
+				for (auto &seg : it.second.asArray()) {
+					data.segments.emplace_back(AssetSegmentData{size_t(seg.getInteger(0)),
+						size_t(seg.getInteger(1)), size_t(seg.getInteger(2))});
+				}
 			}
 		}
 
@@ -337,23 +462,73 @@ void Asset::parseVersions(const db::Value &downloads) {
 }
 
 struct AssetDownloadData : Ref {
+	// Segment data is written from network thread and read from application thread, so
+	// counters are atomic; data.segments is updated from them on application thread only
+	struct Segment {
+		FILE *file = nullptr;
+		bool partial = false; // server responded with requested range
+		std::atomic<size_t> received = 0; // bytes, written into file
+		std::atomic<size_t> flushed = 0; // part of received, that was flushed into file
+
+		Segment() = default;
+		Segment(const Segment &other)
+		: file(other.file)
+		, partial(other.partial)
+		, received(other.received.load())
+		, flushed(other.flushed.load()) { }
+	};
+
 	Rc<Asset> asset;
 	Asset::VersionData data;
 	FILE *inputFile = nullptr;
 	bool valid = true;
+	bool resumed = false; // download continues partial file from previous session
+	bool partial = false; // server responded with requested range
+	bool changed = false; // file was changed on server since partial file was started
+	bool encoded = false; // response has content encoding, byte offsets can not be used
 	float progress = 0.0f;
 
+	// runtime state for data.segments, pending is used from application thread only
+	Vector<Segment> segments;
+	uint32_t pending = 0;
+	Time persisted; // last time, when segments progress was stored
+
 	AssetDownloadData(Rc<Asset> &&a) : asset(move(a)) { }
 
 	AssetDownloadData(Rc<Asset> &&a, Asset::VersionData &data) : asset(move(a)), data(data) { }
 };
 
+// Strong ETag or modification time, that server can compare with current file version
+static String Asset_getRangeValidator(const AssetVersionData &data) {
+	if (!data.etag.empty() && !StringView(data.etag).starts_with("W/")) {
+		return data.etag;
+	}
+	if (data.ctime) {
+		return data.ctime.toHttp<Interface>();
+	}
+	return String();
+}
+
+static bool Asset_canResume(const AssetVersionData &data) {
+	return data.ranges && data.id && !Asset_getRangeValidator(data).empty();
+}
+
+static bool Asset_seek(FILE *file, size_t offset) {
+#if WIN32
+	return _fseeki64(file, int64_t(offset), SEEK_SET) == 0;
+#else
+	return fseeko(file, off_t(offset), SEEK_SET) == 0;
+#endif
+}
+
 bool Asset::startNewDownload(Time ctime, StringView etag) {
 	auto data = Rc<AssetDownloadData>::alloc(this);
 
 	auto req = Rc<network::Request>::create([&, this](network::Handle &handle) {
 		handle.init(network::Method::Get, _url);
 
+		// assets are versioned by library itself
+		handle.setCacheable(false);
 		handle.setMTime(ctime.toMicros());
 		handle.setETag(etag);
 
@@ -372,6 +547,10 @@ bool Asset::startNewDownload(Time ctime, StringView etag) {
 				data->data.size = std::max(size_t(value.readInteger(10).get(0)), data->data.size);
 			} else if (key == "content-type") {
 				data->data.contentType = value.str<Interface>();
+			} else if (key == "accept-ranges") {
+				data->data.ranges = (value == "bytes");
+			} else if (key == "content-encoding") {
+				data->encoded = (value != "identity");
 			}
 		});
 		handle.setReceiveCallback([this, data = data.get()](char *bytes, size_t size) {
@@ -379,26 +558,58 @@ bool Asset::startNewDownload(Time ctime, StringView etag) {
 				return size_t(CURL_WRITEFUNC_ERROR);
 			}
 
-			if (!data->inputFile) {
+			if (!data->inputFile && data->segments.empty()) {
 				auto tag = StringView(data->data.etag);
 				tag.trimChars<StringView::Chars<'"', '\'', ' ', '-'>>();
 				data->data.path = toString(_path, "/", data->data.ctime.toMicros(), "-", tag);
-				data->inputFile = filesystem::native::fopen_fn(data->data.path.data(), "w");
-				if (!data->inputFile) {
+				if (data->encoded) {
+					data->data.ranges = false;
+				}
+
+				if (planSegments(data)) {
+					// all segments are fetched with range requests; first chunk is kept as
+					// start of first segment, and this request is stopped
+					auto file = filesystem::native::fopen_fn(data->data.path.data(), "w");
+					if (!file) {
+						data->valid = false;
+						return size_t(CURL_WRITEFUNC_ERROR);
+					}
+
+					auto len = std::min(size, data->data.segments.front().size);
+					len = fwrite(bytes, len, 1, file) * len;
+					fclose(file);
+
+					data->data.segments.front().received = len;
+					data->segments.front().received = len;
+					data->segments.front().flushed = len;
+
+					addVersion(data);
+					_library->getApplication()->performOnAppThread(
+							[this, data] { performSegments(data); }, data);
 					return size_t(CURL_WRITEFUNC_ERROR);
+				} else {
+					data->inputFile = filesystem::native::fopen_fn(data->data.path.data(), "w");
+					if (!data->inputFile) {
+						return size_t(CURL_WRITEFUNC_ERROR);
+					}
+					addVersion(data);
+					beginStream(data);
 				}
-				addVersion(data);
 			}
 
-			return size_t(fwrite(bytes, size, 1, data->inputFile) * size);
+			return writeStream(data, bytes, size);
 		});
 		return true;
 	}, data);
 
 	req->setDownloadProgress(
 			[this, data = data.get()](const network::Request &, int64_t total, int64_t now) {
-		data->progress = float(now) / float(total);
-		setDownloadProgress(data->data.id, data->progress);
+		if (!data->segments.empty()) {
+			updateProgress(data);
+		} else {
+			data->progress = float(now) / float(total);
+			setDownloadProgress(data->data.id, data->progress);
+		}
 	});
 
 	_download = true;
@@ -406,14 +617,25 @@ bool Asset::startNewDownload(Time ctime, StringView etag) {
 
 	req->perform(_library->getController(),
 			[this, data = data.get()](const network::Request &req, bool success) {
-		if (data->inputFile) {
+		auto code = req.getHandle().getStatusCode();
+		if (!data->segments.empty()) {
+			// stopped after segments was planned, completion is handled by segment requests
+			return;
+		} else if (data->inputFile) {
+			endStream(data->valid && success);
+
 			fclose(data->inputFile);
 			data->inputFile = nullptr;
 
-			setDownloadComplete(data->data, data->valid && success);
+			if (!success && data->valid && code == 200 && Asset_canResume(data->data)) {
+				setDownloadSuspended(data->data);
+			} else {
+				setDownloadComplete(data->data, data->valid && success);
+			}
 			return;
 		} else {
-			auto code = req.getHandle().getResponseCode();
+			endStream(false);
+
 			if (code >= 300 && code < 400) {
 				setFileValidated(success);
 				return;
@@ -426,29 +648,47 @@ bool Asset::startNewDownload(Time ctime, StringView etag) {
 }
 
 bool Asset::resumeDownload(VersionData &d) {
+	if (!d.segments.empty()) {
+		return resumeSegments(d);
+	}
+
 	filesystem::Stat stat;
 	if (!filesystem::stat(FileInfo{d.path}, stat)) {
 		return false;
 	}
 
+	auto validator = Asset_getRangeValidator(d);
+	if (validator.empty()) {
+		return false;
+	}
+
 	auto data = Rc<AssetDownloadData>::alloc(this, d);
+	data->resumed = true;
+
+	size_t offset = stat.size;
 
 	auto req = Rc<network::Request>::create([&, this](network::Handle &handle) {
 		handle.init(network::Method::Get, _url);
 
-		handle.setResumeOffset(stat.size);
-		handle.setHeaderCallback([data = data.get()](StringView key, StringView value) {
-			if (key == "last-modified") {
-				if (Time::fromHttp(value) > data->data.ctime) {
-					data->valid = false;
-				}
-			} else if (key == "etag") {
-				if (data->data.etag != value) {
-					data->valid = false;
-				}
+		handle.setCacheable(false);
+		handle.setCoalescing(false);
+
+		// If-Range: server sends whole file instead of range, if it was changed
+		handle.addHeader("Range", toString("bytes=", offset, "-"));
+		handle.addHeader("If-Range", validator);
+
+		handle.setHeaderCallback([data = data.get(), expected = toString("bytes ", offset, "-")](
+										 StringView key, StringView value) {
+			if (key == "content-range") {
+				data->partial = value.starts_with(StringView(expected));
 			}
 		});
-		handle.setReceiveCallback([data = data.get()](char *bytes, size_t size) {
+		handle.setReceiveCallback([this, data = data.get()](char *bytes, size_t size) {
+			if (!data->partial) {
+				data->changed = true;
+				data->valid = false;
+			}
+
 			if (!data->valid) {
 				return size_t(CURL_WRITEFUNC_ERROR);
 			}
@@ -458,16 +698,19 @@ bool Asset::resumeDownload(VersionData &d) {
 				if (!data->inputFile) {
 					return size_t(CURL_WRITEFUNC_ERROR);
 				}
+
+				// streams receive part, that was downloaded before
+				beginStream(data);
 			}
 
-			return size_t(fwrite(bytes, size, 1, data->inputFile) * size);
+			return writeStream(data, bytes, size);
 		});
 		return true;
 	}, data);
 
-	req->setDownloadProgress(
-			[this, data = data.get()](const network::Request &, int64_t total, int64_t now) {
-		data->progress = float(now) / float(total);
+	req->setDownloadProgress([this, data = data.get(), offset](const network::Request &,
+									 int64_t total, int64_t now) {
+		data->progress = float(offset + now) / float(offset + total);
 		setDownloadProgress(data->data.id, data->progress);
 	});
 
@@ -476,17 +719,232 @@ bool Asset::resumeDownload(VersionData &d) {
 	_library->setAssetDownload(_id, _download);
 
 	req->perform(_library->getController(),
-			[this, data = data.get()](const network::Request &req, bool success) {
+			[this, data = data.get(), offset](const network::Request &req, bool success) {
+		auto code = req.getHandle().getStatusCode();
+
+		endStream(data->valid && success);
+
 		if (data->inputFile) {
 			fclose(data->inputFile);
 			data->inputFile = nullptr;
 		}
 
-		setDownloadComplete(data->data, data->valid && success);
+		if (data->changed) {
+			// partial file is outdated, start over with new version
+			setDownloadComplete(data->data, false);
+			download();
+		} else if (code == 416 && offset == data->data.size) {
+			// file was completely received before interruption
+			setDownloadComplete(data->data, true);
+		} else if (!success && data->valid && code == 206) {
+			setDownloadSuspended(data->data);
+		} else {
+			setDownloadComplete(data->data, data->valid && success);
+		}
 	});
 	return true;
 }
 
+bool Asset::planSegments(AssetDownloadData *data) {
+	auto count = _library->getDownloadSegments();
+	if (count <= 1 || !data->data.ranges || data->data.size < _library->getDownloadSegmentMinSize()
+			|| Asset_getRangeValidator(data->data).empty()) {
+		return false;
+	}
+
+	auto segmentSize = data->data.size / count;
+	for (uint32_t i = 0; i < count; ++i) {
+		auto &seg = data->data.segments.emplace_back();
+		seg.offset = segmentSize * i;
+		seg.size = (i == count - 1) ? data->data.size - seg.offset : segmentSize;
+	}
+
+	data->segments.resize(count);
+	return true;
+}
+
+bool Asset::resumeSegments(VersionData &d) {
+	if (!filesystem::exists(FileInfo{d.path}) || Asset_getRangeValidator(d).empty()) {
+		return false;
+	}
+
+	auto data = Rc<AssetDownloadData>::alloc(this, d);
+	data->resumed = true;
+	data->segments.resize(d.segments.size());
+	for (uint32_t i = 0; i < d.segments.size(); ++i) {
+		data->segments[i].received = d.segments[i].received;
+		data->segments[i].flushed = d.segments[i].received;
+	}
+
+	_downloadId = d.id;
+	_download = true;
+	_library->setAssetDownload(_id, _download);
+
+	// asset is locked now, segments can be finalized immediately, so defer
+	_library->getApplication()->performOnAppThread(
+			[this, data = data.get()] { performSegments(data); }, data);
+	return true;
+}
+
+void Asset::performSegments(AssetDownloadData *data) {
+	data->persisted = Time::now();
+	data->pending = 0;
+	for (uint32_t i = 0; i < data->segments.size(); ++i) {
+		if (data->segments[i].received < data->data.segments[i].size) {
+			++data->pending;
+			performSegment(data, i);
+		}
+	}
+
+	if (data->pending == 0) {
+		finalizeSegments(data);
+	}
+}
+
+void Asset::performSegment(AssetDownloadData *data, uint32_t idx) {
+	auto &seg = data->data.segments[idx];
+	auto offset = seg.offset + data->segments[idx].received;
+	auto validator = Asset_getRangeValidator(data->data);
+
+	auto req = Rc<network::Request>::create([&, this](network::Handle &handle) {
+		handle.init(network::Method::Get, _url);
+
+		handle.setCacheable(false);
+		handle.setCoalescing(false);
+		handle.addHeader("Range", toString("bytes=", offset, "-", seg.offset + seg.size - 1));
+		handle.addHeader("If-Range", validator);
+
+		handle.setHeaderCallback([data, idx, expected = toString("bytes ", offset, "-")](
+										 StringView key, StringView value) {
+			if (key == "content-range") {
+				data->segments[idx].partial = value.starts_with(StringView(expected));
+			}
+		});
+		handle.setReceiveCallback([this, data, idx](char *bytes, size_t size) {
+			return writeSegment(data, idx, bytes, size);
+		});
+		return true;
+	}, Rc<Ref>(data));
+
+	req->setDownloadProgress(
+			[this, data](const network::Request &, int64_t, int64_t) { updateProgress(data); });
+
+	req->perform(_library->getController(),
+			[this, data, idx](const network::Request &, bool) {
+		handleSegmentComplete(data, idx);
+	});
+}
+
+size_t Asset::writeSegment(AssetDownloadData *data, uint32_t idx, const char *bytes, size_t size) {
+	const auto &seg = data->data.segments[idx];
+	auto &state = data->segments[idx];
+	if (!state.partial) {
+		// server ignores range or file was changed
+		data->changed = true;
+		data->valid = false;
+	}
+
+	if (!data->valid) {
+		return size_t(CURL_WRITEFUNC_ERROR);
+	}
+
+	if (!state.file) {
+		state.file = filesystem::native::fopen_fn(data->data.path.data(), "r+");
+		if (!state.file) {
+			return size_t(CURL_WRITEFUNC_ERROR);
+		}
+		if (!Asset_seek(state.file, seg.offset + state.received)) {
+			return size_t(CURL_WRITEFUNC_ERROR);
+		}
+	}
+
+	auto len = std::min(size, seg.size - state.received);
+	if (len > 0) {
+		len = fwrite(bytes, len, 1, state.file) * len;
+		state.received += len;
+	}
+
+	// only flushed data can be stored as received, see updateProgress
+	if (state.received - state.flushed >= SegmentFlushSize) {
+		fflush(state.file);
+		state.flushed = state.received.load();
+	}
+
+	// returning less then received stops the transfer, if server sends more then requested
+	return len;
+}
+
+void Asset::handleSegmentComplete(AssetDownloadData *data, uint32_t idx) {
+	auto &state = data->segments[idx];
+	if (state.file) {
+		fclose(state.file);
+		state.file = nullptr;
+	}
+	state.flushed = state.received.load();
+
+	if (--data->pending == 0) {
+		finalizeSegments(data);
+	}
+}
+
+void Asset::finalizeSegments(AssetDownloadData *data) {
+	bool complete = data->valid;
+	for (uint32_t i = 0; i < data->segments.size(); ++i) {
+		auto &seg = data->data.segments[i];
+		seg.received = data->segments[i].received;
+		if (seg.received < seg.size) {
+			complete = false;
+		}
+	}
+
+	if (complete) {
+		// segments are written out of order, so streams receive whole file at once
+		beginStream(data);
+		endStream(true);
+
+		data->data.segments.clear();
+		if (data->data.id) {
+			_library->setVersionSegments(data->data.id, data->data.size, data->data.segments);
+		}
+		setDownloadComplete(data->data, true);
+	} else {
+		endStream(false);
+
+		if (data->valid && Asset_canResume(data->data)) {
+			setDownloadSuspended(data->data);
+		} else {
+			setDownloadComplete(data->data, false);
+			if (data->changed && data->resumed) {
+				// partial file is outdated, start over with new version
+				download();
+			}
+		}
+	}
+}
+
+void Asset::updateProgress(AssetDownloadData *data) {
+	if (data->data.size == 0) {
+		return;
+	}
+
+	size_t received = 0;
+	for (auto &it : data->segments) { received += it.received; }
+
+	data->progress = float(received) / float(data->data.size);
+	setDownloadProgress(data->data.id, data->progress);
+
+	// store progress, so segments can be resumed after crash; version id is assigned
+	// asynchronously, so it can still be zero here
+	auto now = Time::now();
+	if (data->data.id && now - data->persisted >= SegmentPersistInterval) {
+		data->persisted = now;
+		for (uint32_t i = 0; i < data->segments.size(); ++i) {
+			data->data.segments[i].received = data->segments[i].flushed;
+		}
+		_library->setVersionSegments(data->data.id, data->data.size, data->data.segments);
+	}
+}
+
 void Asset::setDownloadProgress(int64_t id, float progress) {
 	std::unique_lock ctx(_mutex);
 	for (auto &it : _versions) {
@@ -530,6 +988,26 @@ void Asset::setDownloadComplete(VersionData &data, bool success) {
 	_downloadId = 0;
 }
 
+void Asset::setDownloadSuspended(VersionData &data) {
+	std::unique_lock ctx(_mutex);
+
+	// asset keeps download flag in storage, so download is resumed on next launch
+	_download = false;
+
+	for (auto &it : _versions) {
+		if (it.id == data.id) {
+			it.size = data.size;
+			it.ranges = data.ranges;
+			it.segments = data.segments;
+		}
+	}
+
+	_library->setVersionSegments(data.id, data.size, data.segments);
+	setDirty(Flags(Update::DownloadCompleted | Update::DownloadFailed));
+
+	_downloadId = 0;
+}
+
 void Asset::setFileValidated(bool success) {
 	std::unique_lock ctx(_mutex);
 	_download = false;
@@ -571,6 +1049,110 @@ void Asset::dropVersion(const VersionData &data) {
 	_library->eraseVersion(data.id);
 }
 
+void Asset::addStream(Rc<AssetStream> &&stream) {
+	std::unique_lock lock(_streamMutex);
+	_streams.emplace_back(StreamState{stream});
+	if (_streamDownload) {
+		_streams.back().replay = true;
+		replayStreams(lock, Vector<Rc<AssetStream>>{sp::move(stream)});
+	}
+}
+
+void Asset::removeStream(AssetStream *stream) {
+	std::unique_lock lock(_streamMutex);
+	auto it = std::find_if(_streams.begin(), _streams.end(),
+			[&](const StreamState &it) { return it.stream.get() == stream; });
+	if (it != _streams.end()) {
+		_streams.erase(it);
+	}
+}
+
+void Asset::beginStream(AssetDownloadData *data) {
+	std::unique_lock lock(_streamMutex);
+	_streamDownload = data;
+	_streamOffset = 0;
+
+	// file can contain part of previous download
+	filesystem::Stat stat;
+	if (filesystem::stat(FileInfo{data->data.path}, stat)) {
+		_streamOffset = size_t(stat.size);
+	}
+
+	Vector<Rc<AssetStream>> streams;
+	for (auto &it : _streams) {
+		it.replay = true;
+		streams.emplace_back(it.stream);
+	}
+	replayStreams(lock, sp::move(streams));
+}
+
+size_t Asset::writeStream(AssetDownloadData *data, const char *bytes, size_t size) {
+	std::unique_lock lock(_streamMutex);
+	auto ret = size_t(fwrite(bytes, size, 1, data->inputFile) * size);
+	auto chunk = BytesView(reinterpret_cast<const uint8_t *>(bytes), ret);
+	_streamOffset += ret;
+	for (auto &it : _streams) {
+		if (it.replay) {
+			it.pending.insert(it.pending.end(), chunk.begin(), chunk.end());
+		} else {
+			it.stream->handleStreamData(chunk);
+		}
+	}
+	return ret;
+}
+
+void Asset::endStream(bool success) {
+	Vector<StreamState> streams;
+	do {
+		std::unique_lock lock(_streamMutex);
+		_streamDownload = nullptr;
+		streams = sp::move(_streams);
+	} while (0);
+
+	for (auto &it : streams) { it.stream->handleStreamEnd(success); }
+}
+
+void Asset::replayStreams(std::unique_lock<Mutex> &lock, Vector<Rc<AssetStream>> &&streams) {
+	if (streams.empty()) {
+		return;
+	}
+
+	auto data = _streamDownload->data;
+	auto size = _streamOffset;
+	if (_streamDownload->inputFile) {
+		fflush(_streamDownload->inputFile);
+	}
+
+	// data, written meanwhile, is queued in StreamState::pending
+	lock.unlock();
+
+	Bytes prefix;
+	if (size > 0) {
+		prefix = filesystem::readIntoMemory<Interface>(FileInfo{data.path}, 0, size);
+	}
+
+	for (auto &it : streams) {
+		it->handleStreamBegin(data);
+		if (!prefix.empty()) {
+			it->handleStreamData(prefix);
+		}
+	}
+
+	lock.lock();
+
+	for (auto &it : _streams) {
+		auto replayed = std::find_if(streams.begin(), streams.end(),
+				[&](const Rc<AssetStream> &s) { return s.get() == it.stream.get(); });
+		if (it.replay && replayed != streams.end()) {
+			if (!it.pending.empty()) {
+				it.stream->handleStreamData(it.pending);
+				it.pending = Bytes();
+			}
+			it.replay = false;
+		}
+	}
+}
+
 void Asset::releaseLock(const VersionData &data) {
 	std::unique_lock ctx(_mutex);
 	for (auto &it : _versions) {
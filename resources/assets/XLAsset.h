@@ -27,15 +27,30 @@
 #include "XLStorageServer.h"
 #include "SPSubscription.h"
 
+namespace STAPPLER_VERSIONIZED stappler::xenolith {
+
+class ResourceCache;
+class Texture;
+
+} // namespace stappler::xenolith
+
 namespace STAPPLER_VERSIONIZED stappler::xenolith::storage {
 
 class Asset;
 class AssetLibrary;
 struct AssetDownloadData;
 
+// Part of version file, fetched with own range request
+struct SP_PUBLIC AssetSegmentData {
+	size_t offset = 0; // first byte of segment within file
+	size_t size = 0; // segment length
+	size_t received = 0; // bytes, already written into file
+};
+
 struct SP_PUBLIC AssetVersionData {
 	bool complete = false;
 	bool download = false; // is download active for file
+	bool ranges = false; // server accepts byte ranges, so download can be resumed
 	uint32_t locked = 0;
 	int64_t id = 0;
 	Time ctime; // creation time
@@ -46,6 +61,59 @@ struct SP_PUBLIC AssetVersionData {
 	String path;
 	String contentType;
 	String etag;
+
+	// non-empty, if file is fetched in parallel segments
+	Vector<AssetSegmentData> segments;
+};
+
+/* Receives downloaded data as it arrives from network, in parallel with writing version file
+ *
+ * Begin and data handlers are called from network thread, end handler - from application thread.
+ * Stream should be attached from application thread; if download is in progress, it receives
+ * data, that was already written, on the attaching thread.
+ */
+class SP_PUBLIC AssetStream : public Ref {
+public:
+	virtual ~AssetStream() = default;
+
+	virtual void handleStreamBegin(const AssetVersionData &) { }
+	virtual void handleStreamData(BytesView) = 0;
+	virtual void handleStreamEnd(bool success) { }
+};
+
+// Stages downloaded data in memory, so consumer can use it without reading version file back
+class SP_PUBLIC AssetStreamBuffer : public AssetStream {
+public:
+	static constexpr size_t MaxSize = 32 * 1'024 * 1'024;
+
+	virtual ~AssetStreamBuffer() = default;
+
+	virtual bool init(size_t maxSize = MaxSize);
+
+	virtual void handleStreamBegin(const AssetVersionData &) override;
+	virtual void handleStreamData(BytesView) override;
+	virtual void handleStreamEnd(bool success) override;
+
+	bool isComplete() const;
+	bool isValid() const;
+
+	// path of version file, that is staged
+	StringView getPath() const;
+	size_t getSize() const;
+
+	// Can be used with incomplete data to read headers
+	bool read(const Callback<void(BytesView)> &) const;
+
+	// Drops staged data, when it was consumed; version file should be used after this
+	void release();
+
+protected:
+	mutable Mutex _mutex;
+	String _path;
+	Bytes _data;
+	size_t _maxSize = MaxSize;
+	bool _complete = false;
+	bool _valid = true;
 };
 
 class SP_PUBLIC AssetLock : public Ref {
@@ -66,6 +134,10 @@ public:
 
 	Ref *getOwner() const { return _owner; }
 
+	// Texture for image version: data, staged by stream for this version, is decoded without
+	// reading file back and released after decoding. Lock is retained by texture data callback
+	Rc<Texture> acquireTexture(ResourceCache *, AssetStreamBuffer * = nullptr);
+
 protected:
 	friend class Asset;
 
@@ -82,6 +154,11 @@ class SP_PUBLIC Asset : public Subscription {
 public:
 	using VersionData = AssetVersionData;
 
+	// while segmented download is in progress, segment files are flushed after this number
+	// of bytes, and flushed progress is stored with this interval
+	static constexpr size_t SegmentFlushSize = 1'024 * 1'024;
+	static constexpr TimeInterval SegmentPersistInterval = TimeInterval::seconds(1);
+
 	enum Update : uint8_t {
 		CacheDataUpdated = 1 << 1,
 		DownloadStarted = 1 << 2,
@@ -125,6 +202,10 @@ public:
 	void setData(Value &&d);
 	const Value &getData() const { return _data; }
 
+	// Stream is attached for current or next download and detached when download ends
+	void addStream(Rc<AssetStream> &&);
+	void removeStream(AssetStream *);
+
 	Value encode() const;
 
 protected:
@@ -136,8 +217,24 @@ protected:
 	bool startNewDownload(Time ctime, StringView etag);
 	bool resumeDownload(VersionData &);
 
+	// called from network thread, returns true if file should be fetched in segments
+	bool planSegments(AssetDownloadData *);
+
+	bool resumeSegments(VersionData &);
+
+	// called from application thread, starts requests for incomplete segments
+	void performSegments(AssetDownloadData *);
+	void performSegment(AssetDownloadData *, uint32_t);
+	size_t writeSegment(AssetDownloadData *, uint32_t, const char *, size_t);
+	void handleSegmentComplete(AssetDownloadData *, uint32_t);
+	void finalizeSegments(AssetDownloadData *);
+	void updateProgress(AssetDownloadData *);
+
 	void setDownloadProgress(int64_t, float progress);
 	void setDownloadComplete(VersionData &, bool success);
+
+	// download was interrupted, but partial file is valid and can be resumed later
+	void setDownloadSuspended(VersionData &);
 	void setFileValidated(bool success);
 	void replaceVersion(VersionData &);
 
@@ -147,6 +244,14 @@ protected:
 
 	void releaseLock(const VersionData &);
 
+	// called from network thread
+	void beginStream(AssetDownloadData *);
+	size_t writeStream(AssetDownloadData *, const char *, size_t);
+	void endStream(bool success);
+
+	// sends data, written before, to streams; file is read with _streamMutex unlocked
+	void replayStreams(std::unique_lock<Mutex> &, Vector<Rc<AssetStream>> &&);
+
 	String _path;
 	String _cache;
 	String _url;
@@ -160,6 +265,18 @@ protected:
 
 	Value _data;
 	AssetLibrary *_library = nullptr;
+
+	struct StreamState {
+		Rc<AssetStream> stream;
+		Bytes pending; // data, received while stream replays file
+		bool replay = false;
+	};
+
+	Mutex _streamMutex;
+	Vector<StreamState> _streams;
+	AssetDownloadData *_streamDownload = nullptr;
+	size_t _streamOffset = 0; // bytes, written into version file
+
 	bool _download = false;
 	bool _dirty = true;
 
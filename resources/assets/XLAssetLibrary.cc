@@ -104,6 +104,8 @@ AssetComponent::AssetComponent(AssetComponentContainer *c, ComponentLoader &load
 		Field::Integer("size"),
 		Field::Text("type"),
 		Field::Boolean("complete", db::Value(false)),
+		Field::Boolean("ranges", db::Value(false)),
+		Field::Data("segments"),
 		Field::Object("asset", _assets, RemovePolicy::Cascade),
 	}));
 }
@@ -411,6 +413,18 @@ bool AssetLibrary::acquireAssets(SpanView<AssetRequest> vec, AssetVecCallback &&
 	return true;
 }
 
+static db::Value AssetLibrary_encodeSegments(SpanView<AssetSegmentData> segments) {
+	db::Value ret;
+	for (auto &it : segments) {
+		ret.addValue(db::Value({
+			db::Value(int64_t(it.offset)),
+			db::Value(int64_t(it.size)),
+			db::Value(int64_t(it.received)),
+		}));
+	}
+	return ret;
+}
+
 int64_t AssetLibrary::addVersion(const db::Transaction &t, int64_t assetId,
 		const Asset::VersionData &data) {
 	auto version = _container->getComponent()->getVersions().create(t,
@@ -420,6 +434,8 @@ int64_t AssetLibrary::addVersion(const db::Transaction &t, int64_t assetId,
 				pair("ctime", db::Value(data.ctime)),
 				pair("size", db::Value(data.size)),
 				pair("type", db::Value(data.contentType)),
+				pair("ranges", db::Value(data.ranges)),
+				pair("segments", AssetLibrary_encodeSegments(data.segments)),
 			}));
 	return version.getInteger("__oid");
 }
@@ -448,6 +464,26 @@ void AssetLibrary::setVersionComplete(int64_t id, bool value) {
 	});
 }
 
+void AssetLibrary::setVersionSegments(int64_t id, size_t size,
+		SpanView<AssetSegmentData> segments) {
+	auto value = db::Value({
+		pair("size", db::Value(int64_t(size))),
+		pair("segments", AssetLibrary_encodeSegments(segments)),
+	});
+
+	_server->perform([this, id, value = sp::move(value)](const Server &serv,
+							 const db::Transaction &t) -> bool {
+		return _container->getComponent()->getVersions().update(t, id, db::Value(value))
+				? true
+				: false;
+	});
+}
+
+void AssetLibrary::setDownloadSegments(uint32_t count, size_t minSize) {
+	_downloadSegments = std::clamp(count, uint32_t(1), DownloadSegmentsMax);
+	_downloadSegmentMinSize = minSize;
+}
+
 void AssetLibrary::cleanup() {
 	if (!_controller->isNetworkOnline()) {
 		// if we had no network connection to restore assets - do not cleanup them
@@ -59,6 +59,9 @@ public:
 	using AssetVecCallback = Function<void(const SpanView<Rc<Asset>> &)>;
 	using TaskCallback = Function<bool(const Server &, const db::Transaction &)>;
 
+	static constexpr uint32_t DownloadSegmentsMax = 16;
+	static constexpr size_t DownloadSegmentMinSize = 4 * 1'024 * 1'024;
+
 	struct AssetRequest {
 		String url;
 		AssetCallback callback;
@@ -112,6 +115,12 @@ public:
 	AppThread *getApplication() const { return _application; }
 	network::Controller *getController() const { return _controller; }
 
+	// Assets of at least minSize bytes, served with byte ranges support, are fetched with `count`
+	// parallel range requests; count <= 1 disables segmented downloads (default)
+	void setDownloadSegments(uint32_t count, size_t minSize = DownloadSegmentMinSize);
+	uint32_t getDownloadSegments() const { return _downloadSegments; }
+	size_t getDownloadSegmentMinSize() const { return _downloadSegmentMinSize; }
+
 protected:
 	friend class Asset;
 	friend class AssetComponent;
@@ -121,6 +130,7 @@ protected:
 
 	void setAssetDownload(int64_t id, bool value);
 	void setVersionComplete(int64_t id, bool value);
+	void setVersionSegments(int64_t id, size_t size, SpanView<AssetSegmentData>);
 
 	void removeAsset(Asset *);
 
@@ -145,6 +155,9 @@ protected:
 	network::Controller *_controller = nullptr;
 	Rc<Server> _server;
 
+	std::atomic<uint32_t> _downloadSegments = 1;
+	std::atomic<size_t> _downloadSegmentMinSize = DownloadSegmentMinSize;
+
 	Vector<AssetRequest> _tmpRequests;
 	Vector<AssetMultiRequest> _tmpMultiRequest;
 };
@@ -24,4 +24,5 @@
 
 #include "XLNetworkController.cc"
 #include "XLNetworkRequest.cc"
+#include "XLNetworkCache.cc"
 #include "XLNetworkShared.cc"
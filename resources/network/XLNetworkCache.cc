@@ -0,0 +1,259 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "XLNetworkCache.h"
+#include "SPFilepath.h"
+#include "SPFilesystem.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::network {
+
+bool Cache::init(const FileInfo &root, size_t budget) {
+	_root = filesystem::findWritablePath<Interface>(root);
+	_budget = budget;
+
+	filesystem::mkdir(FileInfo{_root});
+
+	auto index =
+			data::readFile<Interface>(FileInfo{filepath::merge<Interface>(_root, "index.cbor")});
+	if (!index) {
+		return true;
+	}
+
+	Vector<Entry> entries;
+	_nextId = uint64_t(index.getInteger("next", 1));
+	for (auto &it : index.getArray("entries")) {
+		Entry entry;
+		entry.key = it.getString("key");
+		entry.etag = it.getString("etag");
+		entry.mtime = it.getInteger("mtime");
+		entry.expires = uint64_t(it.getInteger("expires"));
+		entry.access = uint64_t(it.getInteger("access"));
+		entry.size = size_t(it.getInteger("size"));
+		entry.id = uint64_t(it.getInteger("id"));
+		for (auto &h : it.getArray("headers")) {
+			entry.headers.emplace_back(h.getString(0), h.getString(1));
+		}
+
+		if (entry.key.empty() || !filesystem::exists(FileInfo{getPath(entry)})) {
+			continue;
+		}
+
+		_nextId = std::max(_nextId, entry.id + 1);
+		entries.emplace_back(sp::move(entry));
+	}
+
+	// restore LRU order with new sequence numbers
+	std::sort(entries.begin(), entries.end(),
+			[](const Entry &l, const Entry &r) { return l.access < r.access; });
+
+	for (auto &it : entries) {
+		it.access = _nextAccess++;
+		_size += it.size;
+		_order.emplace(it.access, it.key);
+		_entries.emplace(it.key, sp::move(it));
+	}
+
+	evict();
+	return true;
+}
+
+bool Cache::get(StringView key, Entry &ret) {
+	std::unique_lock lock(_mutex);
+	auto it = _entries.find(key);
+	if (it == _entries.end()) {
+		return false;
+	}
+
+	touch(it->second);
+	ret = it->second;
+	return true;
+}
+
+bool Cache::isFresh(const Entry &entry) const {
+	return entry.expires > 0 && Time::now().toMicros() < entry.expires;
+}
+
+String Cache::getPath(const Entry &entry) const {
+	return filepath::merge<Interface>(_root, toString(entry.id, ".bin"));
+}
+
+bool Cache::store(StringView key, StringView etag, int64_t mtime, uint64_t expires,
+		Headers &&headers, BytesView data) {
+	if (data.size() > _budget) {
+		remove(key);
+		return false;
+	}
+
+	std::unique_lock lock(_mutex);
+	auto entry = emplace(key, etag, mtime, expires, sp::move(headers), data.size());
+	if (!filesystem::write(FileInfo{getPath(*entry)}, data)) {
+		erase(_entries.find(key));
+		return false;
+	}
+
+	evict();
+	return true;
+}
+
+bool Cache::store(StringView key, StringView etag, int64_t mtime, uint64_t expires,
+		Headers &&headers, const FileInfo &file) {
+	filesystem::Stat stat;
+	if (!filesystem::stat(file, stat) || stat.size > _budget) {
+		remove(key);
+		return false;
+	}
+
+	std::unique_lock lock(_mutex);
+	auto entry = emplace(key, etag, mtime, expires, sp::move(headers), size_t(stat.size));
+	if (!filesystem::copy(file, FileInfo{getPath(*entry)})) {
+		erase(_entries.find(key));
+		return false;
+	}
+
+	evict();
+	return true;
+}
+
+void Cache::update(StringView key, uint64_t expires) {
+	std::unique_lock lock(_mutex);
+	auto it = _entries.find(key);
+	if (it != _entries.end()) {
+		it->second.expires = expires;
+	}
+}
+
+void Cache::remove(StringView key) {
+	std::unique_lock lock(_mutex);
+	auto it = _entries.find(key);
+	if (it != _entries.end()) {
+		erase(it);
+	}
+}
+
+void Cache::save() {
+	Value entries;
+	uint64_t next = 0;
+
+	do {
+		std::unique_lock lock(_mutex);
+		next = _nextId;
+		for (auto &it : _entries) {
+			Value headers;
+			for (auto &h : it.second.headers) {
+				headers.addValue(Value({Value(h.first), Value(h.second)}));
+			}
+
+			entries.addValue(Value({
+				pair("key", Value(it.second.key)),
+				pair("etag", Value(it.second.etag)),
+				pair("mtime", Value(it.second.mtime)),
+				pair("expires", Value(int64_t(it.second.expires))),
+				pair("access", Value(int64_t(it.second.access))),
+				pair("size", Value(int64_t(it.second.size))),
+				pair("id", Value(int64_t(it.second.id))),
+				pair("headers", move(headers)),
+			}));
+		}
+	} while (0);
+
+	Value index({
+		pair("next", Value(int64_t(next))),
+		pair("entries", move(entries)),
+	});
+
+	data::save(index, FileInfo{filepath::merge<Interface>(_root, "index.cbor")},
+			data::EncodeFormat::Cbor);
+}
+
+void Cache::addHit(bool revalidated) {
+	std::unique_lock lock(_mutex);
+	if (revalidated) {
+		++_stats.revalidated;
+	} else {
+		++_stats.hits;
+	}
+}
+
+void Cache::addMiss() {
+	std::unique_lock lock(_mutex);
+	++_stats.misses;
+}
+
+Cache::Stats Cache::getStats() const {
+	std::unique_lock lock(_mutex);
+	auto ret = _stats;
+	ret.size = _size;
+	ret.budget = _budget;
+	return ret;
+}
+
+auto Cache::emplace(StringView key, StringView etag, int64_t mtime, uint64_t expires,
+		Headers &&headers, size_t size) -> Entry * {
+	auto it = _entries.find(key);
+	if (it == _entries.end()) {
+		it = _entries.emplace(key.str<Interface>(), Entry{key.str<Interface>()}).first;
+		it->second.id = _nextId++;
+	} else {
+		_size -= it->second.size;
+	}
+
+	it->second.etag = etag.str<Interface>();
+	it->second.mtime = mtime;
+	it->second.expires = expires;
+	it->second.size = size;
+	it->second.headers = sp::move(headers);
+	touch(it->second);
+
+	_size += size;
+	++_stats.stored;
+	return &it->second;
+}
+
+void Cache::erase(Map<String, Entry>::iterator it) {
+	filesystem::remove(FileInfo{getPath(it->second)});
+	_order.erase(it->second.access);
+	_size -= it->second.size;
+	_entries.erase(it);
+}
+
+void Cache::touch(Entry &entry) {
+	if (entry.access) {
+		_order.erase(entry.access);
+	}
+	entry.access = _nextAccess++;
+	_order.emplace(entry.access, entry.key);
+}
+
+void Cache::evict() {
+	while (_size > _budget && !_order.empty()) {
+		auto it = _entries.find(_order.begin()->second);
+		if (it == _entries.end()) {
+			_order.erase(_order.begin());
+			continue;
+		}
+
+		erase(it);
+		++_stats.evicted;
+	}
+}
+
+} // namespace stappler::xenolith::network
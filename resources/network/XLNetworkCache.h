@@ -0,0 +1,113 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef XENOLITH_RESOURCES_NETWORK_XLNETWORKCACHE_H_
+#define XENOLITH_RESOURCES_NETWORK_XLNETWORKCACHE_H_
+
+#include "XLCommon.h" // IWYU pragma: keep
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::network {
+
+/* Disk cache for HTTP responses
+ *
+ * Stores response bodies in separate files within root dir, index is saved on disk with save().
+ * Entries are selected by key, that is built by controller from url and request parameters,
+ * that can affect response. Response headers are stored with entry to be replayed for cached
+ * responses. When total size exceeds budget, least recently used entries are evicted. Freshness
+ * and validators are provided by controller from response headers.
+ */
+class SP_PUBLIC Cache final : public Ref {
+public:
+	static constexpr size_t DefaultBudget = 64 * 1'024 * 1'024;
+
+	using Headers = Vector<Pair<String, String>>;
+
+	struct Entry {
+		String key;
+		String etag;
+		int64_t mtime = 0; // Last-Modified, microseconds
+		uint64_t expires = 0; // end of freshness lifetime, microseconds; 0 - always revalidate
+		uint64_t access = 0; // access sequence number, for LRU eviction
+		size_t size = 0;
+		uint64_t id = 0; // name of data file
+		Headers headers;
+	};
+
+	struct Stats {
+		uint64_t hits = 0; // fresh responses, served without request
+		uint64_t revalidated = 0; // responses, served after 304
+		uint64_t misses = 0;
+		uint64_t stored = 0;
+		uint64_t evicted = 0;
+		size_t size = 0;
+		size_t budget = 0;
+	};
+
+	virtual ~Cache() = default;
+
+	bool init(const FileInfo &root, size_t budget = DefaultBudget);
+
+	// Returns copy of entry, updates its access order
+	bool get(StringView key, Entry &);
+
+	bool isFresh(const Entry &) const;
+
+	String getPath(const Entry &) const;
+
+	bool store(StringView key, StringView etag, int64_t mtime, uint64_t expires, Headers &&,
+			BytesView);
+	bool store(StringView key, StringView etag, int64_t mtime, uint64_t expires, Headers &&,
+			const FileInfo &);
+
+	// update freshness after revalidation
+	void update(StringView key, uint64_t expires);
+
+	void remove(StringView key);
+
+	void save();
+
+	void addHit(bool revalidated);
+	void addMiss();
+
+	Stats getStats() const;
+
+protected:
+	Entry *emplace(StringView key, StringView etag, int64_t mtime, uint64_t expires, Headers &&,
+			size_t);
+	void erase(Map<String, Entry>::iterator);
+	void touch(Entry &);
+	void evict();
+
+	mutable Mutex _mutex;
+	String _root;
+	size_t _budget = DefaultBudget;
+	size_t _size = 0;
+	uint64_t _nextId = 1;
+	uint64_t _nextAccess = 1;
+	Map<String, Entry> _entries;
+	Map<uint64_t, String> _order; // access sequence -> key, oldest first
+	Stats _stats;
+};
+
+} // namespace stappler::xenolith::network
+
+#endif /* XENOLITH_RESOURCES_NETWORK_XLNETWORKCACHE_H_ */
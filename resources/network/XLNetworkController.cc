@@ -35,6 +35,14 @@ struct ControllerHandle {
 	Rc<Request> request;
 	Handle *handle;
 	Context context;
+
+	// identical requests, that will receive copy of response
+	String coalesceKey;
+	Vector<Rc<Request>> followers;
+
+	// response headers for cache entry, recorded before original header callback
+	Cache::Headers headers;
+	Function<void(StringView, StringView)> headerCallback;
 };
 
 struct Controller::Data final : thread::Thread {
@@ -57,6 +65,11 @@ struct Controller::Data final : thread::Thread {
 	Map<CURL *, ControllerHandle> _handles;
 	NetworkFlags _capabilities = NetworkFlags::None;
 
+	Rc<Cache> _cache;
+
+	Map<String, CURL *> _coalescing;
+	std::atomic<uint64_t> _coalesced = 0;
+
 	Data(AppThread *app, Controller *c, StringView name, Bytes &&signKey);
 	virtual ~Data();
 
@@ -81,9 +94,70 @@ struct Controller::Data final : thread::Thread {
 	void wakeup();
 
 	bool prepare(Handle &handle, Context *ctx, const Callback<bool(CURL *)> &onBeforePerform);
-	bool finalize(Handle &handle, Context *ctx, const Callback<bool(CURL *)> &onAfterPerform);
+	bool finalize(ControllerHandle &, const Callback<bool(CURL *)> &onAfterPerform);
+
+	// releases prepared transfer, that will not be performed
+	void release(ControllerHandle &);
+
+	bool isCacheable(const Handle &) const;
+	String getCacheKey(const Handle &) const;
+
+	// request has only headers, that are part of cache key or same for all requests
+	bool hasCacheKeyHeaders(const Handle &, const Context &) const;
+
+	// returns true if fresh response was served from cache, otherwise adds cached validators
+	// to prepared request
+	bool acquireCached(ControllerHandle &);
+	bool loadCached(Handle &, const Cache::Entry &);
+	bool storeCached(ControllerHandle &, bool success);
+
+	bool canCoalesce(const Handle &) const;
+	String getCoalesceKey(const Handle &) const;
+	void completeFollower(const Handle &, Request &, bool success);
 };
 
+// Freshness lifetime from Cache-Control or Expires
+static uint64_t Controller_getCacheExpires(StringView cacheControl, StringView expires,
+		bool &noStore) {
+	int64_t maxAge = -1;
+	while (!cacheControl.empty()) {
+		auto item = cacheControl.readUntil<StringView::Chars<','>>();
+		cacheControl.skipChars<StringView::Chars<',', ' '>>();
+		item.trimChars<StringView::WhiteSpace>();
+
+		if (item == "no-store") {
+			noStore = true;
+		} else if (item == "no-cache") {
+			return 0;
+		} else if (item.starts_with("max-age=")) {
+			maxAge = item.sub(8).readInteger(10).get(0);
+		}
+	}
+
+	if (maxAge >= 0) {
+		return maxAge > 0 ? Time::now().toMicros() + TimeInterval::seconds(maxAge).toMicros() : 0;
+	}
+
+	if (!expires.empty()) {
+		return Time::fromHttp(expires).toMicros();
+	}
+	return 0;
+}
+
+// `Vary: *` - response depends on parameters, other than request headers
+static bool Controller_isVaryAny(StringView vary) {
+	while (!vary.empty()) {
+		auto item = vary.readUntil<StringView::Chars<','>>();
+		vary.skipChars<StringView::Chars<',', ' '>>();
+		item.trimChars<StringView::WhiteSpace>();
+
+		if (item == "*") {
+			return true;
+		}
+	}
+	return false;
+}
+
 Controller::Data::Data(AppThread *app, Controller *c, StringView name, Bytes &&signKey)
 : _application(app), _controller(c), _name(name.str<Interface>()), _signKey(sp::move(signKey)) { }
 
@@ -112,45 +186,90 @@ bool Controller::Data::worker() {
 		return false;
 	}
 
-	do {
-		if (!_pending.pop_direct([&, this](memory::PriorityQueue<Rc<Handle>>::PriorityType type,
-										 Rc<Request> &&it) {
-			auto h = curl_easy_init();
-			auto networkHandle = const_cast<Handle *>(&it->getHandle());
-			auto i = _handles.emplace(h, ControllerHandle{move(it), networkHandle}).first;
-
-			auto sg = i->second.handle->getSharegroup();
-			if (!sg.empty()) {
-				i->second.context.share = getSharegroup(sg);
-			}
+	// all pending requests are started at once, so identical requests, that were queued together,
+	// are coalesced even if the first of them completes before the next worker iteration
+	while (_pending.pop_direct([&, this](memory::PriorityQueue<Rc<Handle>>::PriorityType type,
+									   Rc<Request> &&it) {
+		auto networkHandle = const_cast<Handle *>(&it->getHandle());
+		networkHandle->_cached = false;
+		networkHandle->_coalesced = false;
+		networkHandle->_responseCode = 0;
+		networkHandle->_cacheRevalidate = false;
+		networkHandle->_cacheLookup = _cache && isCacheable(*networkHandle);
+
+		auto h = curl_easy_init();
+		auto i = _handles.emplace(h, ControllerHandle{move(it), networkHandle}).first;
+
+		auto sg = i->second.handle->getSharegroup();
+		if (!sg.empty()) {
+			i->second.context.share = getSharegroup(sg);
+		}
 
-			i->second.context.userdata = this;
-			i->second.context.curl = h;
-			i->second.context.origHandle = networkHandle;
+		i->second.context.userdata = this;
+		i->second.context.curl = h;
+		i->second.context.origHandle = networkHandle;
 
-			i->second.context.origHandle->setDownloadProgress(
-					[this, h = networkHandle](int64_t total, int64_t now) -> int {
-				onDownloadProgress(h, total, now);
-				return 0;
+		i->second.context.origHandle->setDownloadProgress(
+				[this, h = networkHandle, ch = &i->second](int64_t total, int64_t now) -> int {
+			onDownloadProgress(h, total, now);
+			for (auto &it : ch->followers) {
+				onDownloadProgress(const_cast<Handle *>(&it->getHandle()), total, now);
+			}
+			return 0;
+		});
+
+		i->second.context.origHandle->setUploadProgress(
+				[this, h = networkHandle](int64_t total, int64_t now) -> int {
+			onUploadProgress(h, total, now);
+			return 0;
+		});
+
+		if (networkHandle->_cacheLookup) {
+			i->second.headerCallback = networkHandle->getHeaderCallback();
+			networkHandle->setHeaderCallback(
+					[ch = &i->second](StringView key, StringView value) {
+				ch->headers.emplace_back(key.str<Interface>(), value.str<Interface>());
+				if (ch->headerCallback) {
+					ch->headerCallback(key, value);
+				}
 			});
+		}
 
-			i->second.context.origHandle->setUploadProgress(
-					[this, h = networkHandle](int64_t total, int64_t now) -> int {
-				onUploadProgress(h, total, now);
-				return 0;
-			});
+		if (i->second.handle->shouldSignRequest()) {
+			sign(*networkHandle, i->second.context);
+		}
 
-			if (i->second.handle->shouldSignRequest()) {
-				sign(*networkHandle, i->second.context);
-			}
+		prepare(*networkHandle, &i->second.context, nullptr);
 
-			prepare(*networkHandle, &i->second.context, nullptr);
+		// cache is checked with complete request headers, fresh response is served without
+		// transfer; request object is retained by handle until completion
+		if (networkHandle->_cacheLookup && acquireCached(i->second)) {
+			_handles.erase(i);
+			onComplete(networkHandle, networkHandle->isSuccess());
+			return;
+		}
 
-			curl_multi_add_handle(reinterpret_cast<CURLM *>(_handle), h);
-		})) {
-			break;
+		// identical request in flight, response will be copied from it
+		if (canCoalesce(*networkHandle)
+				&& hasCacheKeyHeaders(*networkHandle, i->second.context)) {
+			auto coalesceKey = getCoalesceKey(*networkHandle);
+			auto cIt = _coalescing.find(coalesceKey);
+			if (cIt != _coalescing.end()) {
+				auto hIt = _handles.find(cIt->second);
+				if (hIt != _handles.end()) {
+					release(i->second);
+					hIt->second.followers.emplace_back(move(i->second.request));
+					_handles.erase(i);
+					++_coalesced;
+					return;
+				}
+			}
+			_coalescing.emplace(coalesceKey, h);
+			i->second.coalesceKey = sp::move(coalesceKey);
 		}
-	} while (0);
+
+		curl_multi_add_handle(reinterpret_cast<CURLM *>(_handle), h);
+	})) { }
 
 	int running = 0;
 	auto err = curl_multi_perform(reinterpret_cast<CURLM *>(_handle), &running);
@@ -181,7 +300,15 @@ bool Controller::Data::worker() {
 			auto it = _handles.find(e);
 			if (it != _handles.end()) {
 				it->second.context.code = msg->data.result;
-				auto ret = finalize(*it->second.handle, &it->second.context, nullptr);
+				auto ret = finalize(it->second, nullptr);
+
+				if (!it->second.coalesceKey.empty()) {
+					_coalescing.erase(it->second.coalesceKey);
+				}
+				for (auto &f : it->second.followers) {
+					completeFollower(*it->second.handle, *f, ret);
+				}
+
 				if (!onComplete(it->second.handle, ret)) {
 					_handles.erase(it);
 					return false;
@@ -201,7 +328,7 @@ void Controller::Data::threadDispose() {
 		for (auto &it : _handles) {
 			curl_multi_remove_handle(reinterpret_cast<CURLM *>(_handle), it.first);
 			it.second.context.code = CURLE_FAILED_INIT;
-			finalize(*it.second.handle, &it.second.context, nullptr);
+			finalize(it.second, nullptr);
 			curl_easy_cleanup(it.first);
 		}
 
@@ -211,10 +338,15 @@ void Controller::Data::threadDispose() {
 
 		_handles.clear();
 		_sharegroups.clear();
+		_coalescing.clear();
 
 		_handle = nullptr;
 	}
 
+	if (_cache) {
+		_cache->save();
+	}
+
 	Thread::threadDispose();
 }
 
@@ -299,10 +431,249 @@ bool Controller::Data::prepare(Handle &handle, Context *ctx,
 	return stappler::network::prepare(*handle.getData(), ctx, onBeforePerform);
 }
 
-bool Controller::Data::finalize(Handle &handle, Context *ctx,
+bool Controller::Data::finalize(ControllerHandle &h,
 		const Callback<bool(CURL *)> &onAfterPerform) {
-	auto ret = stappler::network::finalize(*handle.getData(), ctx, onAfterPerform);
-	return handle.finalize(ctx, ret);
+	auto &handle = *h.handle;
+	auto ret = stappler::network::finalize(*handle.getData(), &h.context, onAfterPerform);
+	ret = handle.finalize(&h.context, ret);
+	if (handle._cacheLookup) {
+		handle.setHeaderCallback(sp::move(h.headerCallback));
+		if (_cache) {
+			ret = storeCached(h, ret);
+		}
+	}
+	return ret;
+}
+
+void Controller::Data::release(ControllerHandle &h) {
+	auto &handle = *h.handle;
+	h.context.code = CURLE_FAILED_INIT;
+	stappler::network::finalize(*handle.getData(), &h.context, nullptr);
+	if (handle._cacheLookup) {
+		handle.setHeaderCallback(sp::move(h.headerCallback));
+		handle._cacheLookup = false;
+	}
+	curl_easy_cleanup(h.context.curl);
+}
+
+bool Controller::Data::isCacheable(const Handle &handle) const {
+	// signed requests are authorized by server and can not share responses
+	if (!handle._cacheable || handle._signRequest || handle._method != Method::Get
+			|| !handle._etag.empty() || handle._mtime > 0) {
+		return false;
+	}
+
+	if (std::holds_alternative<String>(handle.getReceiveDataSource())) {
+		return true;
+	}
+
+	auto &req = handle.getReqeust();
+	return req && req->_receiveData && !req->_ignoreResponseData;
+}
+
+String Controller::Data::getCacheKey(const Handle &handle) const {
+	auto headers = handle._varyHeaders;
+	std::sort(headers.begin(), headers.end());
+
+	StringStream key;
+	key << handle.getUrl() << "\n" << handle._sharegroup;
+	for (auto &it : headers) { key << "\n" << it.first << ": " << it.second; }
+	return key.str();
+}
+
+bool Controller::Data::hasCacheKeyHeaders(const Handle &handle, const Context &ctx) const {
+	for (auto l = ctx.headers; l; l = l->next) {
+		StringView name(l->data);
+		name = name.readUntil<StringView::Chars<':', ';'>>();
+		name.trimChars<StringView::WhiteSpace>();
+
+		auto lower = string::tolower<Interface>(name);
+		if (lower.empty() || lower == "x-applicationname" || lower == "x-applicationversion"
+				|| lower == "if-none-match" || lower == "if-modified-since" || lower == "expect"
+				|| lower == "accept-encoding") {
+			continue;
+		}
+
+		auto it = std::find_if(handle._varyHeaders.begin(), handle._varyHeaders.end(),
+				[&](const Pair<String, String> &h) { return h.first == lower; });
+		if (it == handle._varyHeaders.end()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool Controller::Data::acquireCached(ControllerHandle &h) {
+	auto &handle = *h.handle;
+	if (!hasCacheKeyHeaders(handle, h.context)) {
+		// request has own headers, that can affect response
+		handle._cacheLookup = false;
+		handle.setHeaderCallback(sp::move(h.headerCallback));
+		return false;
+	}
+
+	handle._cacheKey = getCacheKey(handle);
+
+	Cache::Entry entry;
+	if (!_cache->get(handle._cacheKey, entry)) {
+		_cache->addMiss();
+		return false;
+	}
+
+	if (_cache->isFresh(entry) && filesystem::exists(FileInfo{_cache->getPath(entry)})) {
+		release(h);
+
+		if (loadCached(handle, entry)) {
+			handle._cached = true;
+			handle._responseCode = 200;
+			handle._success = true;
+			_cache->addHit(false);
+		} else {
+			_cache->remove(handle._cacheKey);
+			_cache->addMiss();
+			handle._success = false;
+		}
+		return true;
+	}
+
+	if (entry.etag.empty() && entry.mtime <= 0) {
+		_cache->addMiss();
+		return false;
+	}
+
+	// conditional request, 304 will be served from disk
+	if (!entry.etag.empty()) {
+		h.context.headers = curl_slist_append(h.context.headers,
+				toString("If-None-Match: ", entry.etag).data());
+	}
+	if (entry.mtime > 0) {
+		auto httpTime = Time::microseconds(entry.mtime).toHttp<Interface>();
+		h.context.headers = curl_slist_append(h.context.headers,
+				toString("If-Modified-Since: ", httpTime).data());
+	}
+	curl_easy_setopt(h.context.curl, CURLOPT_HTTPHEADER, h.context.headers);
+	handle._cacheRevalidate = true;
+	return false;
+}
+
+bool Controller::Data::loadCached(Handle &handle, const Cache::Entry &entry) {
+	// replay stored response headers, data target is sized from Content-Length and then replaced
+	const auto &cb = handle.getHeaderCallback();
+	if (cb) {
+		for (auto &it : entry.headers) { cb(it.first, it.second); }
+	}
+
+	auto path = _cache->getPath(entry);
+	if (auto str = std::get_if<String>(&handle.getReceiveDataSource())) {
+		filesystem::remove(FileInfo{*str});
+		return filesystem::copy(FileInfo{path}, FileInfo{*str});
+	}
+
+	auto &req = handle.getReqeust();
+	if (!req) {
+		return false;
+	}
+
+	req->_data = filesystem::readIntoMemory<Interface>(FileInfo{path});
+	req->_nbytes = req->_data.size();
+	return req->_nbytes == entry.size;
+}
+
+bool Controller::Data::storeCached(ControllerHandle &h, bool success) {
+	if (!success) {
+		return success;
+	}
+
+	auto &handle = *h.handle;
+	StringView key = handle._cacheKey;
+	auto code = handle.NetworkHandle::getResponseCode();
+
+	bool noStore = false;
+	auto expires = Controller_getCacheExpires(handle.getReceivedHeaderString("Cache-Control"),
+			handle.getReceivedHeaderString("Expires"), noStore);
+
+	if (code == 304 && handle._cacheRevalidate) {
+		Cache::Entry entry;
+		if (_cache->get(key, entry) && loadCached(handle, entry)) {
+			_cache->update(key, expires);
+			_cache->addHit(true);
+			handle._cached = true;
+			handle._responseCode = 200;
+			handle._success = true;
+			return true;
+		}
+		_cache->remove(key);
+		return success;
+	}
+
+	if (code != 200) {
+		return success;
+	}
+
+	if (noStore || Controller_isVaryAny(handle.getReceivedHeaderString("Vary"))
+			|| (handle._etag.empty() && handle._mtime == 0 && expires == 0)) {
+		// nothing to revalidate with, or response varies with unknown parameters
+		_cache->remove(key);
+		return success;
+	}
+
+	if (auto str = std::get_if<String>(&handle.getReceiveDataSource())) {
+		_cache->store(key, handle._etag, int64_t(handle._mtime), expires, sp::move(h.headers),
+				FileInfo{*str});
+	} else if (auto &req = handle.getReqeust()) {
+		_cache->store(key, handle._etag, int64_t(handle._mtime), expires, sp::move(h.headers),
+				BytesView(req->_data.data(), std::min(req->_nbytes, req->_data.size())));
+	}
+	return success;
+}
+
+bool Controller::Data::canCoalesce(const Handle &handle) const {
+	if (!handle._coalescing || handle._method != Method::Get) {
+		return false;
+	}
+
+	// header callbacks can not be replayed for followers
+	if (std::holds_alternative<String>(handle.getReceiveDataSource())) {
+		return !handle.getHeaderCallback();
+	}
+
+	auto &req = handle.getReqeust();
+	return req && req->_receiveData && !req->_ignoreResponseData && !req->_targetHeaderCallback;
+}
+
+String Controller::Data::getCoalesceKey(const Handle &handle) const {
+	return toString(std::holds_alternative<String>(handle.getReceiveDataSource()) ? "file" : "data",
+			"\n", handle._etag, "\n", handle._mtime, "\n", handle._signRequest, "\n",
+			getCacheKey(handle));
+}
+
+void Controller::Data::completeFollower(const Handle &source, Request &req, bool success) {
+	auto &handle = req._handle;
+	auto code = source.getStatusCode();
+
+	handle._coalesced = true;
+	handle._cached = source._cached;
+	handle._responseCode = code;
+	handle._success = source._success;
+	handle._etag = source._etag;
+	handle._mtime = source._mtime;
+
+	if (success && code < 300) {
+		if (auto target = std::get_if<String>(&handle.getReceiveDataSource())) {
+			if (auto path = std::get_if<String>(&source.getReceiveDataSource())) {
+				filesystem::remove(FileInfo{*target});
+				if (!filesystem::copy(FileInfo{*path}, FileInfo{*target})) {
+					success = false;
+				}
+			}
+		} else if (auto &sourceReq = source.getReqeust()) {
+			auto size = std::min(sourceReq->_nbytes, sourceReq->_data.size());
+			req._data = Bytes(sourceReq->_data.data(), sourceReq->_data.data() + size);
+			req._nbytes = req._data.size();
+		}
+	}
+
+	onComplete(&handle, success);
 }
 
 Rc<ApplicationExtension> Controller::createController(AppThread *app, StringView name,
@@ -344,4 +715,18 @@ bool Controller::isNetworkOnline() const {
 	return (_data->_capabilities & NetworkFlags::Internet) != NetworkFlags::None;
 }
 
+void Controller::enableCache(size_t budget) {
+	if (!_data->_cache) {
+		_data->_cache = Rc<Cache>::create(
+				FileInfo{toString("network.", _data->_name, ".cache"), FileCategory::AppCache},
+				budget);
+	}
+}
+
+uint64_t Controller::getCoalescedRequests() const { return _data->_coalesced.load(); }
+
+Cache::Stats Controller::getCacheStats() const {
+	return _data->_cache ? _data->_cache->getStats() : Cache::Stats();
+}
+
 } // namespace stappler::xenolith::network
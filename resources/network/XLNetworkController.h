@@ -28,6 +28,7 @@
 #include "SPNetworkHandle.h"
 #include "SPThreadTaskQueue.h"
 #include "SPThread.h"
+#include "XLNetworkCache.h"
 
 namespace STAPPLER_VERSIONIZED stappler::xenolith::network {
 
@@ -57,6 +58,15 @@ public:
 
 	bool isNetworkOnline() const;
 
+	// Enables disk cache in AppCache dir for GET requests, marked with Handle::setCacheable;
+	// should be called before first request
+	void enableCache(size_t budget = Cache::DefaultBudget);
+
+	Cache::Stats getCacheStats() const;
+
+	// Number of requests, that was attached to identical in-flight transfer
+	uint64_t getCoalescedRequests() const;
+
 protected:
 	struct Data;
 
@@ -28,7 +28,7 @@
 
 namespace STAPPLER_VERSIONIZED stappler::xenolith::network {
 
-bool Handle::init(StringView url) { return NetworkHandle::init(Method::Get, url); }
+bool Handle::init(StringView url) { return init(Method::Get, url); }
 
 bool Handle::init(StringView url, const FileInfo &fileName) {
 	if (!init(Method::Get, url)) {
@@ -41,7 +41,15 @@ bool Handle::init(StringView url, const FileInfo &fileName) {
 	return true;
 }
 
-bool Handle::init(Method method, StringView url) { return NetworkHandle::init(method, url); }
+bool Handle::init(Method method, StringView url) {
+	_method = method;
+	return NetworkHandle::init(method, url);
+}
+
+void Handle::addVaryHeader(StringView name, StringView value) {
+	_varyHeaders.emplace_back(string::tolower<Interface>(name), value.str<Interface>());
+	addHeader(name, value);
+}
 
 bool Handle::prepare(Context *ctx) {
 	auto appInfo = _controller->getApplication()->getContext()->getInfo();
@@ -131,6 +139,7 @@ void Request::perform(Controller *c, CompleteCallback &&cb) {
 			_handle.setReceiveCallback(
 					[this](char *buf, size_t size) -> size_t { return handleReceive(buf, size); });
 			_handle.setVerifyTls(false);
+			_receiveData = true;
 		}
 	}
 	c->run(this);
@@ -68,6 +68,37 @@ public:
 	void setSignRequest(bool value) { _signRequest = value; }
 	bool shouldSignRequest() const { return _signRequest; }
 
+	// Response can be stored in and served from controller's disk cache (if enabled); only
+	// unsigned GET requests without own validators (ETag or mtime) are cached. Cache entry is
+	// selected by url, sharegroup and headers, added with addVaryHeader; requests with other
+	// headers bypass cache. Stored response headers are replayed with header callback
+	void setCacheable(bool value) { _cacheable = value; }
+	bool isCacheable() const { return _cacheable; }
+
+	// Response was served from controller's disk cache
+	bool isCached() const { return _cached; }
+
+	// Identical GET requests (same url, validators, sharegroup, headers, added with
+	// addVaryHeader, and response target kind) share single transfer, response is copied into
+	// memory or file target of every request. Enabled by default; requests with other headers,
+	// header callback or own receive callback are always performed separately
+	void setCoalescing(bool value) { _coalescing = value; }
+	bool isCoalescing() const { return _coalescing; }
+
+	// Response was copied from identical request, performed at the same time
+	bool isCoalesced() const { return _coalesced; }
+
+	// Adds request header, that also selects cache entry and coalesced transfer for this request
+	void addVaryHeader(StringView name, StringView value);
+
+	// HTTP status of response; unlike NetworkHandle::getResponseCode, reports status for
+	// responses, served from disk cache or copied from other request
+	long getStatusCode() const {
+		return _responseCode ? _responseCode : NetworkHandle::getResponseCode();
+	}
+
+	Method getRequestMethod() const { return _method; }
+
 	const Rc<Request> &getReqeust() const { return _request; }
 
 protected:
@@ -79,11 +110,21 @@ protected:
 
 	bool _success = false;
 	bool _signRequest = false;
+	bool _cacheable = false;
+	bool _cached = false;
+	bool _cacheLookup = false; // response should be stored in cache
+	bool _cacheRevalidate = false; // validators was provided by cache
+	bool _coalescing = true;
+	bool _coalesced = false;
+	long _responseCode = 0; // override for responses, not received from network
+	Method _method = Method::Get;
 	std::array<char, 256> _errorBuffer = {0};
 
 	uint64_t _mtime = 0;
 	String _etag;
 	String _sharegroup;
+	Vector<Pair<String, String>> _varyHeaders;
+	String _cacheKey; // selected cache entry
 
 	const Controller *_controller = nullptr;
 	Rc<Request> _request;
@@ -135,6 +176,7 @@ protected:
 
 	bool _running = false;
 	bool _ignoreResponseData = false;
+	bool _receiveData = false; // response data is stored in _data
 	bool _setupInput = false;
 	Function<void(StringView, StringView)> _targetHeaderCallback;
 	Pair<int64_t, int64_t> _uploadProgress = pair(0, 0); // total, now
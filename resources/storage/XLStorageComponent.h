@@ -40,6 +40,9 @@ public:
 	virtual void handleChildInit(const Server &, const db::Transaction &);
 	virtual void handleChildRelease(const Server &, const db::Transaction &);
 
+	// Called for every transaction, including ones from Server's read pool threads. Calls are
+	// serialized, but can run in parallel with writer's tasks, so it should only configure
+	// the transaction
 	virtual void handleStorageTransaction(db::Transaction &);
 	virtual void handleHeartbeat(const Server &);
 
@@ -28,6 +28,7 @@
 #include "SPValid.h"
 #include "SPThread.h"
 #include "SPSqlDriver.h"
+#include "SPSqlHandle.h"
 
 namespace STAPPLER_VERSIONIZED stappler::xenolith::storage {
 
@@ -67,12 +68,41 @@ protected:
 struct ServerDataTaskCallback {
 	Function<bool(const Server &, const db::Transaction &)> callback;
 	Rc<Ref> ref;
+	Server::Operation op = Server::Operation::Write;
+	const db::Scheme *scheme = nullptr; // scheme for operation stats, if any
+	uint64_t queued = 0; // time, when task was pushed into queue
+	uint64_t seq = 0; // write sequence number, or last issued write for reads
+
+	// task changes only database state and reports results with ServerData::performOnAppThread,
+	// so it can be executed again, when its group transaction was rolled back
+	bool replayable = false;
 
 	ServerDataTaskCallback() = default;
 	ServerDataTaskCallback(Function<bool(const Server &, const db::Transaction &)> &&cb)
 	: callback(sp::move(cb)) { }
 	ServerDataTaskCallback(Function<bool(const Server &, const db::Transaction &)> &&cb, Ref *ref)
 	: callback(sp::move(cb)), ref(ref) { }
+	ServerDataTaskCallback(Function<bool(const Server &, const db::Transaction &)> &&cb, Ref *ref,
+			Server::Operation op, const db::Scheme *scheme, uint64_t seq)
+	: callback(sp::move(cb))
+	, ref(ref)
+	, op(op)
+	, scheme(scheme)
+	, queued(sp::platform::clock(ClockType::Monotonic))
+	, seq(seq) { }
+};
+
+// Read-only connection, that serves read operations in parallel with writer thread
+struct ServerReader : public thread::Thread {
+	Server::ServerData *data = nullptr;
+	db::sql::Driver::Handle handle;
+	memory::pool_t *pool = nullptr;
+
+	ServerReader(Server::ServerData *, db::sql::Driver::Handle);
+
+	virtual void threadInit() override;
+	virtual bool worker() override;
+	virtual void threadDispose() override;
 };
 
 struct ServerDataStorage : memory::AllocPool {
@@ -92,7 +122,7 @@ struct Server::ServerData : public thread::Thread, public db::ApplicationInterfa
 	AppThread *application = nullptr;
 	ServerDataStorage *storage = nullptr;
 
-	std::condition_variable condition;
+	mutable std::condition_variable condition;
 	Mutex mutexQueue;
 	Mutex mutexFree;
 	db::sql::Driver *driver = nullptr;
@@ -100,6 +130,49 @@ struct Server::ServerData : public thread::Thread, public db::ApplicationInterfa
 	Server *server = nullptr;
 	uint64_t now = 0;
 
+	// group commit: worker drains up to batchLimit ready replayable tasks, waiting up to
+	// batchWindow for more, and runs them in single transaction; when group transaction is
+	// rolled back, its tasks are replayed one by one, each in its own transaction
+	uint32_t batchLimit = 256;
+	TimeInterval batchWindow;
+
+	// app thread calls from tasks in current transaction, posted only when it is complete
+	Vector<Pair<Function<void()>, Rc<Ref>>> *deferredCallbacks = nullptr;
+
+	std::atomic<uint64_t> statTasks = 0;
+	std::atomic<uint64_t> statFailed = 0;
+	std::atomic<uint64_t> statTransactions = 0;
+	std::atomic<uint64_t> statBatched = 0;
+	std::atomic<uint64_t> statRollbacks = 0;
+	std::atomic<uint64_t> statTime = 0;
+	std::atomic<uint64_t> statReads = 0;
+
+	// read pool; reads are routed to writer while writes, issued before them, are not committed
+	uint32_t readerCount = 2;
+	bool sqlite = false;
+	StringView journalMode; // SQLite journal_mode, readers require "wal"
+	mem_std::Vector<Rc<ServerReader>> readers; // writer thread only
+	std::atomic<uint32_t> readersRunning = 0; // published under readMutex
+	std::deque<ServerDataTaskCallback> readQueue;
+	std::condition_variable readCondition;
+	Mutex readMutex;
+
+	// write sequence numbers are issued under writeMutex together with queue push, so queue
+	// order matches sequence order, and writeCommitted never goes back
+	Mutex writeMutex;
+	std::atomic<uint64_t> writeIssued = 0;
+	std::atomic<uint64_t> writeCommitted = 0;
+
+	// protects components list for reader's initTransaction
+	mutable Mutex componentsMutex;
+
+	// component's transaction hooks are never called concurrently from writer and readers
+	mutable Mutex hooksMutex;
+
+	mutable Mutex statMutex;
+	Server::OperationStatsArray operationStats;
+	mem_std::Map<const db::Scheme *, Server::OperationStatsArray> schemeStats;
+
 	mutable db::Vector<db::Function<void(const db::Transaction &)>> *asyncTasks = nullptr;
 
 	db::BackendInterface::Config interfaceConfig;
@@ -113,8 +186,28 @@ struct Server::ServerData : public thread::Thread, public db::ApplicationInterfa
 	virtual ~ServerData();
 
 	bool execute(const ServerDataTaskCallback &);
+	bool execute(SpanView<ServerDataTaskCallback>);
 	void runAsync();
 
+	void performOnAppThread(Function<void()> &&, Ref * = nullptr);
+
+	bool popTask(ServerDataTaskCallback &);
+	bool popRead(ServerDataTaskCallback &);
+
+	void pushWrite(ServerDataTaskCallback &&);
+	void commitWrite(uint64_t seq);
+
+	// Records queue wait time (until `start`) and execution time of the task callback
+	void addTaskStats(const ServerDataTaskCallback &, uint64_t start, uint64_t execTime);
+
+	// Calls task callback, `execTime` receives callback's execution time
+	bool runTask(const ServerDataTaskCallback &, const db::Transaction &, uint64_t &execTime);
+
+	void startReaders();
+	void stopReaders();
+
+	void setJournalMode();
+
 	virtual void threadInit() override;
 	virtual bool worker() override;
 	virtual void threadDispose() override;
@@ -168,6 +261,16 @@ bool Server::init(AppThread *app, const Value &params) {
 	for (auto &it : params.asDict()) {
 		if (it.first == "driver") {
 			driver = StringView(it.second.getString());
+		} else if (it.first == "batchLimit") {
+			_data->batchLimit = uint32_t(std::max(it.second.getInteger(), int64_t(1)));
+		} else if (it.first == "batchWindow") {
+			// in milliseconds
+			_data->batchWindow =
+					TimeInterval::milliseconds(std::max(it.second.getInteger(), int64_t(0)));
+		} else if (it.first == "readers") {
+			_data->readerCount = uint32_t(std::max(it.second.getInteger(), int64_t(0)));
+		} else if (it.first == "journalMode") {
+			_data->journalMode = StringView(it.second.getString()).pdup(pool);
 		} else if (it.first == "serverName") {
 			_data->storage->serverName = StringView(it.second.getString()).pdup(pool);
 		} else {
@@ -180,6 +283,8 @@ bool Server::init(AppThread *app, const Value &params) {
 		driver = StringView("sqlite");
 	}
 
+	_data->sqlite = (driver == "sqlite");
+
 	_data->driver = db::sql::Driver::open(pool, _data, driver);
 	if (!_data->driver) {
 		log::source().error("storage::Server", "Fail to open DB driver: ", driver);
@@ -228,8 +333,7 @@ bool Server::addComponentContainer(const Rc<ComponentContainer> &comp) {
 
 	perform([this, comp](const Server &serv, const db::Transaction &t) -> bool {
 		if (_data->addComponent(comp, t)) {
-			_data->application->performOnAppThread(
-					[this, comp] { comp->handleComponentsLoaded(*this); }, this);
+			_data->performOnAppThread([this, comp] { comp->handleComponentsLoaded(*this); }, this);
 		}
 		return true;
 	});
@@ -274,10 +378,11 @@ bool Server::get(CoderSource key, DataCallback &&cb) const {
 	}
 
 	auto p = new DataCallback(sp::move(cb));
-	return perform([this, p, key = key.view().bytes<Interface>()](const Server &serv,
-						   const db::Transaction &t) {
+	return performRead(Operation::KeyValue, nullptr,
+			[this, p, key = key.view().bytes<Interface>()](const Server &serv,
+					const db::Transaction &t) {
 		auto d = t.getAdapter().get(key);
-		_data->application->performOnAppThread([p, ret = xenolith::Value(d)] {
+		_data->performOnAppThread([p, ret = xenolith::Value(d)] {
 			(*p)(ret);
 			delete p;
 		});
@@ -288,19 +393,20 @@ bool Server::get(CoderSource key, DataCallback &&cb) const {
 bool Server::set(CoderSource key, Value &&data, DataCallback &&cb) const {
 	if (cb) {
 		auto p = new DataCallback(sp::move(cb));
-		return perform([this, p, key = key.view().bytes<Interface>(), data = sp::move(data)](
-							   const Server &serv, const db::Transaction &t) {
+		return performWrite(nullptr,
+				[this, p, key = key.view().bytes<Interface>(), data = sp::move(data)](
+						const Server &serv, const db::Transaction &t) {
 			auto d = t.getAdapter().get(key);
 			t.getAdapter().set(key, data);
-			_data->application->performOnAppThread([p, ret = xenolith::Value(d)] {
+			_data->performOnAppThread([p, ret = xenolith::Value(d)] {
 				(*p)(ret);
 				delete p;
 			});
 			return true;
 		});
 	} else {
-		return perform([key = key.view().bytes<Interface>(), data = move(data)](const Server &serv,
-							   const db::Transaction &t) {
+		return performWrite(nullptr, [key = key.view().bytes<Interface>(), data = move(data)](
+											 const Server &serv, const db::Transaction &t) {
 			t.getAdapter().set(key, data);
 			return true;
 		});
@@ -310,19 +416,19 @@ bool Server::set(CoderSource key, Value &&data, DataCallback &&cb) const {
 bool Server::clear(CoderSource key, DataCallback &&cb) const {
 	if (cb) {
 		auto p = new DataCallback(sp::move(cb));
-		return perform([this, p, key = key.view().bytes<Interface>()](const Server &serv,
-							   const db::Transaction &t) {
+		return performWrite(nullptr, [this, p, key = key.view().bytes<Interface>()](
+											 const Server &serv, const db::Transaction &t) {
 			auto d = t.getAdapter().get(key);
 			t.getAdapter().clear(key);
-			_data->application->performOnAppThread([p, ret = xenolith::Value(d)] {
+			_data->performOnAppThread([p, ret = xenolith::Value(d)] {
 				(*p)(ret);
 				delete p;
 			});
 			return true;
 		});
 	} else {
-		return perform([key = key.view().bytes<Interface>()](const Server &serv,
-							   const db::Transaction &t) {
+		return performWrite(nullptr, [key = key.view().bytes<Interface>()](const Server &serv,
+											 const db::Transaction &t) {
 			t.getAdapter().clear(key);
 			return true;
 		});
@@ -336,10 +442,10 @@ bool Server::get(const Scheme &scheme, DataCallback &&cb, uint64_t oid,
 	}
 
 	auto p = new DataCallback(sp::move(cb));
-	return perform(
+	return performRead(Operation::Get, &scheme,
 			[this, scheme = &scheme, oid, flags, p](const Server &serv, const db::Transaction &t) {
 		auto ret = scheme->get(t, oid, flags);
-		_data->application->performOnAppThread([p, ret = xenolith::Value(ret)] {
+		_data->performOnAppThread([p, ret = xenolith::Value(ret)] {
 			(*p)(ret);
 			delete p;
 		});
@@ -353,10 +459,11 @@ bool Server::get(const Scheme &scheme, DataCallback &&cb, StringView alias,
 	}
 
 	auto p = new DataCallback(sp::move(cb));
-	return perform([this, scheme = &scheme, alias = alias.str<Interface>(), flags,
-						   p](const Server &serv, const db::Transaction &t) {
+	return performRead(Operation::Get, &scheme,
+			[this, scheme = &scheme, alias = alias.str<Interface>(), flags, p](const Server &serv,
+					const db::Transaction &t) {
 		auto ret = scheme->get(t, alias, flags);
-		_data->application->performOnAppThread([p, ret = xenolith::Value(ret)] {
+		_data->performOnAppThread([p, ret = xenolith::Value(ret)] {
 			(*p)(ret);
 			delete p;
 		});
@@ -391,10 +498,11 @@ bool Server::get(const Scheme &scheme, DataCallback &&cb, uint64_t oid, StringVi
 	}
 
 	auto p = new DataCallback(sp::move(cb));
-	return perform([this, scheme = &scheme, oid, field = field.str<Interface>(), flags,
-						   p](const Server &serv, const db::Transaction &t) {
+	return performRead(Operation::Get, &scheme,
+			[this, scheme = &scheme, oid, field = field.str<Interface>(), flags, p](
+					const Server &serv, const db::Transaction &t) {
 		auto ret = scheme->get(t, oid, field, flags);
-		_data->application->performOnAppThread([p, ret = xenolith::Value(ret)] {
+		_data->performOnAppThread([p, ret = xenolith::Value(ret)] {
 			(*p)(ret);
 			delete p;
 		});
@@ -409,11 +517,11 @@ bool Server::get(const Scheme &scheme, DataCallback &&cb, StringView alias, Stri
 	}
 
 	auto p = new DataCallback(sp::move(cb));
-	return perform(
+	return performRead(Operation::Get, &scheme,
 			[this, scheme = &scheme, alias = alias.str<Interface>(), field = field.str<Interface>(),
 					flags, p](const Server &serv, const db::Transaction &t) {
 		auto ret = scheme->get(t, alias, field, flags);
-		_data->application->performOnAppThread([p, ret = xenolith::Value(ret)] {
+		_data->performOnAppThread([p, ret = xenolith::Value(ret)] {
 			(*p)(ret);
 			delete p;
 		});
@@ -573,24 +681,25 @@ bool Server::select(const Scheme &scheme, DataCallback &&cb, QueryCallback &&qcb
 	if (qcb) {
 		auto p = new DataCallback(sp::move(cb));
 		auto q = new QueryCallback(sp::move(qcb));
-		return perform([this, scheme = &scheme, p, q, flags](const Server &serv,
-							   const db::Transaction &t) {
+		return performRead(Operation::Select, &scheme,
+				[this, scheme = &scheme, p, q, flags](const Server &serv,
+						const db::Transaction &t) {
 			db::Query query;
 			(*q)(query);
-			delete q;
 			auto ret = scheme->select(t, query, flags);
-			_data->application->performOnAppThread([p, ret = xenolith::Value(ret)] {
+			_data->performOnAppThread([p, q, ret = xenolith::Value(ret)] {
 				(*p)(ret);
 				delete p;
+				delete q;
 			});
 			return true;
 		});
 	} else {
 		auto p = new DataCallback(sp::move(cb));
-		return perform(
+		return performRead(Operation::Select, &scheme,
 				[this, scheme = &scheme, p, flags](const Server &serv, const db::Transaction &t) {
 			auto ret = scheme->select(t, db::Query(), flags);
-			_data->application->performOnAppThread([p, ret = xenolith::Value(ret)] {
+			_data->performOnAppThread([p, ret = xenolith::Value(ret)] {
 				(*p)(ret);
 				delete p;
 			});
@@ -613,18 +722,20 @@ bool Server::create(const Scheme &scheme, Value &&data, DataCallback &&cb, db::U
 		db::Conflict::Flags conflict) const {
 	if (cb) {
 		auto p = new DataCallback(sp::move(cb));
-		return perform([this, scheme = &scheme, data = move(data), flags, conflict,
-							   p](const Server &serv, const db::Transaction &t) {
+		return performWrite(&scheme,
+				[this, scheme = &scheme, data = move(data), flags, conflict, p](const Server &serv,
+						const db::Transaction &t) {
 			auto ret = scheme->create(t, data, flags | db::UpdateFlags::NoReturn, conflict);
-			_data->application->performOnAppThread([p, ret = xenolith::Value(ret)] {
+			_data->performOnAppThread([p, ret = xenolith::Value(ret)] {
 				(*p)(ret);
 				delete p;
 			});
 			return true;
 		});
 	} else {
-		return perform([scheme = &scheme, data = sp::move(data), flags,
-							   conflict](const Server &serv, const db::Transaction &t) {
+		return performWrite(&scheme,
+				[scheme = &scheme, data = sp::move(data), flags, conflict](const Server &serv,
+						const db::Transaction &t) {
 			scheme->create(t, data, flags | db::UpdateFlags::NoReturn, conflict);
 			return true;
 		});
@@ -635,19 +746,20 @@ bool Server::update(const Scheme &scheme, uint64_t oid, Value &&data, DataCallba
 		db::UpdateFlags flags) const {
 	if (cb) {
 		auto p = new DataCallback(sp::move(cb));
-		return perform([this, scheme = &scheme, oid, data = sp::move(data), flags,
-							   p](const Server &serv, const db::Transaction &t) {
+		return performWrite(&scheme,
+				[this, scheme = &scheme, oid, data = sp::move(data), flags, p](const Server &serv,
+						const db::Transaction &t) {
 			db::Value patch(data);
 			auto ret = scheme->update(t, oid, patch, flags);
-			_data->application->performOnAppThread([p, ret = xenolith::Value(ret)] {
+			_data->performOnAppThread([p, ret = xenolith::Value(ret)] {
 				(*p)(ret);
 				delete p;
 			});
 			return true;
 		});
 	} else {
-		return perform([scheme = &scheme, oid, data = sp::move(data), flags](const Server &serv,
-							   const db::Transaction &t) {
+		return performWrite(&scheme, [scheme = &scheme, oid, data = sp::move(data), flags](
+											 const Server &serv, const db::Transaction &t) {
 			db::Value patch(data);
 			scheme->update(t, oid, patch, flags | db::UpdateFlags::NoReturn);
 			return true;
@@ -659,20 +771,21 @@ bool Server::update(const Scheme &scheme, const Value &obj, Value &&data, DataCa
 		db::UpdateFlags flags) const {
 	if (cb) {
 		auto p = new DataCallback(sp::move(cb));
-		return perform([this, scheme = &scheme, obj, data = sp::move(data), flags,
-							   p](const Server &serv, const db::Transaction &t) {
+		return performWrite(&scheme,
+				[this, scheme = &scheme, obj, data = sp::move(data), flags, p](const Server &serv,
+						const db::Transaction &t) {
 			db::Value value(obj);
 			db::Value patch(data);
 			auto ret = scheme->update(t, value, patch, flags);
-			_data->application->performOnAppThread([p, ret = xenolith::Value(ret)] {
+			_data->performOnAppThread([p, ret = xenolith::Value(ret)] {
 				(*p)(ret);
 				delete p;
 			});
 			return true;
 		});
 	} else {
-		return perform([scheme = &scheme, obj, data = sp::move(data), flags](const Server &serv,
-							   const db::Transaction &t) {
+		return performWrite(&scheme, [scheme = &scheme, obj, data = sp::move(data), flags](
+											 const Server &serv, const db::Transaction &t) {
 			db::Value value(obj);
 			db::Value patch(data);
 			scheme->update(t, value, patch, flags | db::UpdateFlags::NoReturn);
@@ -684,17 +797,18 @@ bool Server::update(const Scheme &scheme, const Value &obj, Value &&data, DataCa
 bool Server::remove(const Scheme &scheme, uint64_t oid, Function<void(bool)> &&cb) const {
 	if (cb) {
 		auto p = new Function<void(bool)>(sp::move(cb));
-		return perform(
+		return performWrite(&scheme,
 				[this, scheme = &scheme, oid, p](const Server &serv, const db::Transaction &t) {
 			auto ret = scheme->remove(t, oid);
-			_data->application->performOnAppThread([p, ret] {
+			_data->performOnAppThread([p, ret] {
 				(*p)(ret);
 				delete p;
 			});
 			return true;
 		});
 	} else {
-		return perform([scheme = &scheme, oid](const Server &serv, const db::Transaction &t) {
+		return performWrite(&scheme,
+				[scheme = &scheme, oid](const Server &serv, const db::Transaction &t) {
 			scheme->remove(t, oid);
 			return true;
 		});
@@ -708,9 +822,10 @@ bool Server::remove(const Scheme &scheme, const Value &obj, Function<void(bool)>
 bool Server::count(const Scheme &scheme, Function<void(size_t)> &&cb) const {
 	if (cb) {
 		auto p = new Function<void(size_t)>(sp::move(cb));
-		return perform([this, scheme = &scheme, p](const Server &serv, const db::Transaction &t) {
+		return performRead(Operation::Count, &scheme,
+				[this, scheme = &scheme, p](const Server &serv, const db::Transaction &t) {
 			auto c = scheme->count(t);
-			_data->application->performOnAppThread([p, c] {
+			_data->performOnAppThread([p, c] {
 				(*p)(c);
 				delete p;
 			});
@@ -725,15 +840,15 @@ bool Server::count(const Scheme &scheme, Function<void(size_t)> &&cb, QueryCallb
 		if (cb) {
 			auto p = new Function<void(size_t)>(sp::move(cb));
 			auto q = new QueryCallback(sp::move(qcb));
-			return perform(
+			return performRead(Operation::Count, &scheme,
 					[this, scheme = &scheme, p, q](const Server &serv, const db::Transaction &t) {
 				db::Query query;
 				(*q)(query);
-				delete q;
 				auto c = scheme->count(t, query);
-				_data->application->performOnAppThread([p, c] {
+				_data->performOnAppThread([p, q, c] {
 					(*p)(c);
 					delete p;
+					delete q;
 				});
 				return true;
 			});
@@ -745,14 +860,16 @@ bool Server::count(const Scheme &scheme, Function<void(size_t)> &&cb, QueryCallb
 }
 
 bool Server::touch(const Scheme &scheme, uint64_t id) const {
-	return perform([scheme = &scheme, id](const Server &serv, const db::Transaction &t) {
+	return performWrite(&scheme,
+			[scheme = &scheme, id](const Server &serv, const db::Transaction &t) {
 		scheme->touch(t, id);
 		return true;
 	});
 }
 
 bool Server::touch(const Scheme &scheme, const Value &obj) const {
-	return perform([scheme = &scheme, obj](const Server &serv, const db::Transaction &t) {
+	return performWrite(&scheme,
+			[scheme = &scheme, obj](const Server &serv, const db::Transaction &t) {
 		db::Value value(obj);
 		scheme->touch(t, value);
 		return true;
@@ -760,6 +877,13 @@ bool Server::touch(const Scheme &scheme, const Value &obj) const {
 }
 
 bool Server::perform(Function<bool(const Server &, const db::Transaction &)> &&cb, Ref *ref) const {
+	// user callbacks can have side effects outside of database, so they are never replayed
+	return performWrite(nullptr, sp::move(cb), ref, false);
+}
+
+bool Server::performWrite(const Scheme *scheme,
+		Function<bool(const Server &, const db::Transaction &)> &&cb, Ref *ref,
+		bool replayable) const {
 	if (!_data) {
 		return false;
 	}
@@ -767,14 +891,67 @@ bool Server::perform(Function<bool(const Server &, const db::Transaction &)> &&c
 	if (thread::Thread::getCurrentThreadId() == _data->getThreadId()) {
 		_data->execute(ServerDataTaskCallback(sp::move(cb), ref));
 	} else {
-		_data->storage->queue.push(0, false, ServerDataTaskCallback(sp::move(cb), ref));
-		_data->condition.notify_one();
+		ServerDataTaskCallback task(sp::move(cb), ref, Operation::Write, scheme, 0);
+		task.replayable = replayable;
+		_data->pushWrite(sp::move(task));
 	}
 	return true;
 }
 
+bool Server::performRead(Operation op, const Scheme *scheme,
+		Function<bool(const Server &, const db::Transaction &)> &&cb, Ref *ref) const {
+	if (!_data) {
+		return false;
+	}
+
+	if (thread::Thread::getCurrentThreadId() == _data->getThreadId()) {
+		_data->execute(ServerDataTaskCallback(sp::move(cb), ref));
+		return true;
+	}
+
+	auto seq = _data->writeIssued.load();
+	// reads have no side effects except app thread calls, so writer can group them with writes
+	ServerDataTaskCallback task(sp::move(cb), ref, op, scheme, seq);
+	task.replayable = true;
+
+	if (_data->readersRunning.load() > 0 && _data->writeCommitted.load() >= seq) {
+		std::unique_lock lock(_data->readMutex);
+		// readers can be stopped since the first check
+		if (_data->readersRunning.load() > 0) {
+			_data->readQueue.emplace_back(sp::move(task));
+			_data->readCondition.notify_one();
+			return true;
+		}
+	}
+
+	// pending writes: writer's queue order guarantees, that they are visible for this read
+	_data->storage->queue.push(0, false, sp::move(task));
+	_data->condition.notify_one();
+	return true;
+}
+
 AppThread *Server::getApplication() const { return _data->application; }
 
+Server::Stats Server::getStats() const {
+	Stats ret;
+	if (_data) {
+		ret.tasks = _data->statTasks.load();
+		ret.failed = _data->statFailed.load();
+		ret.transactions = _data->statTransactions.load();
+		ret.batched = _data->statBatched.load();
+		ret.rollbacks = _data->statRollbacks.load();
+		ret.time = _data->statTime.load();
+		ret.reads = _data->statReads.load();
+
+		std::unique_lock lock(_data->statMutex);
+		ret.operations = _data->operationStats;
+		for (auto &it : _data->schemeStats) {
+			ret.schemes.emplace(it.first->getName().str<Interface>(), it.second);
+		}
+	}
+	return ret;
+}
+
 bool Server::get(const Scheme &scheme, DataCallback &&cb, uint64_t oid,
 		Vector<const db::Field *> &&fields, db::UpdateFlags flags) const {
 	if (!cb) {
@@ -782,10 +959,11 @@ bool Server::get(const Scheme &scheme, DataCallback &&cb, uint64_t oid,
 	}
 
 	auto p = new DataCallback(sp::move(cb));
-	return perform([this, scheme = &scheme, oid, flags, p, fields = sp::move(fields)](
-						   const Server &serv, const db::Transaction &t) {
+	return performRead(Operation::Get, &scheme,
+			[this, scheme = &scheme, oid, flags, p, fields = sp::move(fields)](const Server &serv,
+					const db::Transaction &t) {
 		auto ret = scheme->get(t, oid, fields, flags);
-		_data->application->performOnAppThread([p, ret = xenolith::Value(ret)] {
+		_data->performOnAppThread([p, ret = xenolith::Value(ret)] {
 			(*p)(ret);
 			delete p;
 		});
@@ -800,11 +978,11 @@ bool Server::get(const Scheme &scheme, DataCallback &&cb, StringView alias,
 	}
 
 	auto p = new DataCallback(sp::move(cb));
-	return perform(
+	return performRead(Operation::Get, &scheme,
 			[this, scheme = &scheme, alias = alias.str<Interface>(), flags, p,
 					fields = sp::move(fields)](const Server &serv, const db::Transaction &t) {
 		auto ret = scheme->get(t, alias, fields, flags);
-		_data->application->performOnAppThread([p, ret = xenolith::Value(ret)] {
+		_data->performOnAppThread([p, ret = xenolith::Value(ret)] {
 			(*p)(ret);
 			delete p;
 		});
@@ -834,23 +1012,130 @@ bool Server::ServerData::execute(const ServerDataTaskCallback &task) {
 	}
 
 	bool ret = false;
+	uint64_t execTime = 0;
+	auto start = sp::platform::clock(ClockType::Monotonic);
+
+	Vector<Pair<Function<void()>, Rc<Ref>>> deferred;
+	deferredCallbacks = &deferred;
 
 	memory::perform_clear([&] {
 		driver->performWithStorage(handle, [&, this](const db::Adapter &adapter) {
 			adapter.performWithTransaction([&, this](const db::Transaction &t) {
 				currentTransaction = &t;
-				auto ret = task.callback(*server, t);
+				ret = runTask(task, t, execTime);
 				currentTransaction = nullptr;
 				return ret;
 			});
 		});
 	}, threadPool);
 
+	deferredCallbacks = nullptr;
+
+	// callbacks own task's results, so they are posted even if transaction failed
+	for (auto &it : deferred) { application->performOnAppThread(sp::move(it.first), it.second); }
+
+	addTaskStats(task, start, execTime);
+
+	++statTasks;
+	++statTransactions;
+	if (!ret) {
+		++statFailed;
+	}
+	if (task.op == Server::Operation::Write) {
+		commitWrite(task.seq);
+	}
+	statTime += sp::platform::clock(ClockType::Monotonic) - start;
+
 	runAsync();
 
 	return ret;
 }
 
+bool Server::ServerData::execute(SpanView<ServerDataTaskCallback> tasks) {
+	if (tasks.size() == 1 || currentTransaction) {
+		for (auto &it : tasks) { execute(it); }
+		return true;
+	}
+
+	uint64_t seq = 0;
+	auto start = sp::platform::clock(ClockType::Monotonic);
+	for (auto &it : tasks) {
+		if (it.op == Server::Operation::Write) {
+			seq = std::max(seq, it.seq);
+		}
+	}
+
+	auto async = asyncTasks;
+	auto asyncCount = asyncTasks ? asyncTasks->size() : 0;
+
+	Vector<uint64_t> execTime;
+	execTime.resize(tasks.size(), 0);
+
+	Vector<Pair<Function<void()>, Rc<Ref>>> deferred;
+	deferredCallbacks = &deferred;
+
+	bool committed = false;
+	memory::perform_clear([&] {
+		driver->performWithStorage(handle, [&, this](const db::Adapter &adapter) {
+			committed = adapter.performWithTransaction([&, this](const db::Transaction &t) {
+				currentTransaction = &t;
+				bool ret = true;
+				for (size_t i = 0; i < tasks.size(); ++i) {
+					if (tasks[i].callback && !runTask(tasks[i], t, execTime[i])) {
+						// rollback whole group, tasks will be replayed separately
+						ret = false;
+						break;
+					}
+				}
+				currentTransaction = nullptr;
+				return ret;
+			});
+		});
+	}, threadPool);
+
+	deferredCallbacks = nullptr;
+
+	if (!committed) {
+		// results and async tasks of rolled back group are dropped, replay produces them again
+		if (async) {
+			asyncTasks = async;
+			asyncTasks->resize(asyncCount);
+		} else {
+			asyncTasks = nullptr;
+		}
+
+		++statRollbacks;
+		statTime += sp::platform::clock(ClockType::Monotonic) - start;
+
+		// so, failed task does not abort the others
+		for (auto &it : tasks) { execute(it); }
+		return false;
+	}
+
+	for (auto &it : deferred) { application->performOnAppThread(sp::move(it.first), it.second); }
+
+	// stats for rolled back group are recorded by replay
+	for (size_t i = 0; i < tasks.size(); ++i) { addTaskStats(tasks[i], start, execTime[i]); }
+
+	statTasks += tasks.size();
+	statBatched += tasks.size();
+	++statTransactions;
+	statTime += sp::platform::clock(ClockType::Monotonic) - start;
+	commitWrite(seq);
+
+	runAsync();
+
+	return true;
+}
+
+void Server::ServerData::performOnAppThread(Function<void()> &&cb, Ref *ref) {
+	if (deferredCallbacks && thread::Thread::getCurrentThreadId() == getThreadId()) {
+		deferredCallbacks->emplace_back(sp::move(cb), ref);
+	} else {
+		application->performOnAppThread(sp::move(cb), ref);
+	}
+}
+
 void Server::ServerData::runAsync() {
 	memory::perform_clear([&] {
 		while (asyncTasks && driver->isValid(handle)) {
@@ -897,7 +1182,12 @@ void Server::ServerData::threadInit() {
 		});
 	}, threadPool);
 
+	if (sqlite && !journalMode.empty()) {
+		setJournalMode();
+	}
+
 	runAsync();
+	startReaders();
 
 	if (!storage->serverName.empty()) {
 		thread::ThreadInfo::setThreadInfo(storage->serverName);
@@ -920,10 +1210,7 @@ bool Server::ServerData::worker() {
 	}
 
 	ServerDataTaskCallback task;
-	do {
-		storage->queue.pop_direct([&](memory::PriorityQueue<ServerDataTaskCallback>::PriorityType,
-										  ServerDataTaskCallback &&cb) { task = move(cb); });
-	} while (0);
+	popTask(task);
 
 	if (!task.callback) {
 		std::unique_lock<std::mutex> lock(mutexQueue);
@@ -938,12 +1225,190 @@ bool Server::ServerData::worker() {
 		return false;
 	}
 
-	slog().debug("Server::ServerData", "execute");
-	execute(task);
+	if (batchLimit <= 1 || !task.replayable) {
+		execute(task);
+		return true;
+	}
+
+	// drain ready tasks into single group transaction
+	Vector<ServerDataTaskCallback> tasks;
+	tasks.emplace_back(move(task));
+
+	// first task, that can not be grouped, executed after the group to preserve order
+	ServerDataTaskCallback next;
+
+	auto deadline = t + batchWindow.toMicros();
+	while (tasks.size() < batchLimit) {
+		if (popTask(next)) {
+			if (!next.replayable) {
+				break;
+			}
+			tasks.emplace_back(move(next));
+			next = ServerDataTaskCallback();
+			continue;
+		}
+
+		auto current = sp::platform::clock(ClockType::Monotonic);
+		if (current >= deadline) {
+			break;
+		}
+
+		std::unique_lock<std::mutex> lock(mutexQueue);
+		if (storage->queue.empty(lock)) {
+			condition.wait_for(lock, std::chrono::microseconds(deadline - current));
+		}
+	}
+
+	execute(SpanView<ServerDataTaskCallback>(tasks));
+	if (next.callback) {
+		execute(next);
+	}
 	return true;
 }
 
+bool Server::ServerData::popTask(ServerDataTaskCallback &task) {
+	storage->queue.pop_direct([&](memory::PriorityQueue<ServerDataTaskCallback>::PriorityType,
+									  ServerDataTaskCallback &&cb) { task = move(cb); });
+	return bool(task.callback);
+}
+
+void Server::ServerData::pushWrite(ServerDataTaskCallback &&task) {
+	do {
+		std::unique_lock lock(writeMutex);
+		task.seq = writeIssued.load() + 1;
+		storage->queue.push(0, false, sp::move(task));
+		// published after push, so reads with this seq are queued behind the write
+		writeIssued.store(task.seq);
+	} while (0);
+	condition.notify_one();
+}
+
+void Server::ServerData::commitWrite(uint64_t seq) {
+	// writes from replayed group can be committed out of order
+	auto current = writeCommitted.load();
+	while (current < seq && !writeCommitted.compare_exchange_weak(current, seq)) { }
+}
+
+bool Server::ServerData::popRead(ServerDataTaskCallback &task) {
+	std::unique_lock lock(readMutex);
+	if (readQueue.empty()) {
+		return false;
+	}
+
+	task = move(readQueue.front());
+	readQueue.pop_front();
+	return true;
+}
+
+void Server::ServerData::addTaskStats(const ServerDataTaskCallback &task, uint64_t start,
+		uint64_t execTime) {
+	if (!task.queued) {
+		return;
+	}
+
+	auto wait = start > task.queued ? start - task.queued : 0;
+
+	auto update = [&](Server::OperationStats &stat) {
+		++stat.count;
+		stat.waitTime += wait;
+		stat.maxWaitTime = std::max(stat.maxWaitTime, wait);
+		stat.execTime += execTime;
+		stat.maxExecTime = std::max(stat.maxExecTime, execTime);
+	};
+
+	std::unique_lock lock(statMutex);
+	update(operationStats[toInt(task.op)]);
+	if (task.scheme) {
+		update(schemeStats[task.scheme][toInt(task.op)]);
+	}
+}
+
+bool Server::ServerData::runTask(const ServerDataTaskCallback &task, const db::Transaction &t,
+		uint64_t &execTime) {
+	auto start = sp::platform::clock(ClockType::Monotonic);
+	auto ret = task.callback(*server, t);
+	execTime = sp::platform::clock(ClockType::Monotonic) - start;
+	return ret;
+}
+
+void Server::ServerData::setJournalMode() {
+	static constexpr StringView modes[] = {"delete", "truncate", "persist", "memory", "wal", "off"};
+
+	if (std::find(std::begin(modes), std::end(modes), journalMode) == std::end(modes)) {
+		log::source().error("StorageServer", "Invalid journalMode: ", journalMode);
+		journalMode = StringView();
+		return;
+	}
+
+	memory::perform_clear([&] {
+		driver->performWithStorage(handle, [&](const db::Adapter &adapter) {
+			if (auto iface = dynamic_cast<db::sql::SqlHandle *>(adapter.getBackendInterface())) {
+				iface->performSimpleQuery(toString("PRAGMA journal_mode=", journalMode, ";"));
+			}
+		});
+	}, threadPool);
+}
+
+void Server::ServerData::startReaders() {
+	if (readerCount == 0) {
+		return;
+	}
+
+	// separate connections for in-memory database do not share data
+	auto dbIt = storage->params.find(StringView("dbname"));
+	if (dbIt == storage->params.end() || dbIt->second.empty() || dbIt->second == ":memory:") {
+		return;
+	}
+
+	// without WAL journal SQLite readers are blocked by writer, WAL changes database files,
+	// so it should be requested explicitly with journalMode server param
+	if (sqlite && journalMode != "wal") {
+		return;
+	}
+
+	for (uint32_t i = 0; i < readerCount; ++i) {
+		db::sql::Driver::Handle h;
+		memory::perform([&] { h = driver->connect(storage->params); }, serverPool);
+		if (!h.get()) {
+			log::source().error("StorageServer", "Fail to open read-only connection");
+			break;
+		}
+
+		auto reader = Rc<ServerReader>::alloc(this, h);
+		if (reader->run()) {
+			readers.emplace_back(move(reader));
+		}
+	}
+
+	std::unique_lock lock(readMutex);
+	readersRunning.store(uint32_t(readers.size()));
+}
+
+void Server::ServerData::stopReaders() {
+	do {
+		// no more reads are queued for readers after this
+		std::unique_lock lock(readMutex);
+		readersRunning.store(0);
+	} while (0);
+
+	for (auto &it : readers) { it->stop(); }
+	readCondition.notify_all();
+	for (auto &it : readers) { it->waitStopped(); }
+	readers.clear();
+
+	// execute reads, that was not served by readers
+	ServerDataTaskCallback task;
+	while (popRead(task)) {
+		if (task.callback) {
+			execute(task);
+		}
+		task = ServerDataTaskCallback();
+	}
+}
+
 void Server::ServerData::threadDispose() {
+	stopReaders();
+
 	while (!storage->queue.empty()) {
 		ServerDataTaskCallback task;
 		do {
@@ -997,6 +1462,25 @@ void Server::ServerData::handleHeartbeat() {
 void Server::ServerData::addAsyncTask(
 		const db::Callback<db::Function<void(const db::Transaction &)>(db::pool_t *)> &setupCb)
 		const {
+	if (thread::Thread::getCurrentThreadId() != getThreadId()) {
+		// asyncPool and asyncTasks are owned by writer thread, so task, scheduled from read pool,
+		// is prepared in its own pool and passed through writer's queue
+		auto pool = memory::pool::create();
+		db::Function<void(const db::Transaction &)> *fn = nullptr;
+		memory::perform([&] {
+			fn = new (pool) db::Function<void(const db::Transaction &)>(setupCb(pool));
+		}, pool);
+
+		storage->queue.push(0, false,
+				ServerDataTaskCallback([fn, pool](const Server &, const db::Transaction &t) {
+			(*fn)(t);
+			memory::pool::destroy(pool);
+			return true;
+		}));
+		condition.notify_one();
+		return;
+	}
+
 	memory::perform([&] {
 		if (!asyncTasks) {
 			asyncTasks = new (asyncPool) db::Vector<db::Function<void(const db::Transaction &)>>;
@@ -1014,6 +1498,7 @@ bool Server::ServerData::addComponent(ComponentContainer *comp, const db::Transa
 }
 
 void Server::ServerData::removeComponent(ComponentContainer *comp, const db::Transaction &t) {
+	std::unique_lock lock(componentsMutex);
 	auto cmpIt = storage->components.find(comp);
 	if (cmpIt == storage->components.end()) {
 		return;
@@ -1054,6 +1539,15 @@ void Server::ServerData::pushDebugMessage(db::Value &&val) const {
 }
 
 void Server::ServerData::initTransaction(db::Transaction &t) const {
+	// components list is modified only on writer thread
+	std::unique_lock<Mutex> lock;
+	if (thread::Thread::getCurrentThreadId() != getThreadId()) {
+		lock = std::unique_lock<Mutex>(componentsMutex);
+	}
+
+	// reads are served by several threads, serialize hooks to keep components single-threaded
+	std::unique_lock<Mutex> hooksLock(hooksMutex);
+
 	for (auto &it : storage->components) {
 		for (auto &iit : it.second->components) { iit.second->handleStorageTransaction(t); }
 	}
@@ -1091,7 +1585,10 @@ bool ServerComponentLoader::run(ComponentContainer *comp) {
 	memory::context ctx(_pool);
 
 	_components->container = comp;
-	_data->storage->components.emplace(comp, _components);
+	do {
+		std::unique_lock lock(_data->componentsMutex);
+		_data->storage->components.emplace(comp, _components);
+	} while (0);
 
 	db::Scheme::initSchemes(_components->schemes);
 	_transaction->getAdapter().init(_data->interfaceConfig, _components->schemes);
@@ -1104,4 +1601,69 @@ bool ServerComponentLoader::run(ComponentContainer *comp) {
 	_components = nullptr;
 	return true;
 }
+
+ServerReader::ServerReader(Server::ServerData *d, db::sql::Driver::Handle h)
+: data(d), handle(h) { }
+
+void ServerReader::threadInit() {
+	pool = memory::pool::create();
+
+	memory::perform_clear([&] {
+		data->driver->performWithStorage(handle, [&](const db::Adapter &adapter) {
+			if (auto iface = dynamic_cast<db::sql::SqlHandle *>(adapter.getBackendInterface())) {
+				if (data->sqlite) {
+					iface->performSimpleQuery("PRAGMA query_only=1;");
+				}
+			}
+		});
+	}, pool);
+
+	if (!data->storage->serverName.empty()) {
+		thread::ThreadInfo::setThreadInfo(toString(data->storage->serverName, ":read"));
+	}
+
+	Thread::threadInit();
+}
+
+bool ServerReader::worker() {
+	if (!_continueExecution.test_and_set()) {
+		return false;
+	}
+
+	ServerDataTaskCallback task;
+	if (!data->popRead(task)) {
+		std::unique_lock<std::mutex> lock(data->readMutex);
+		if (data->readQueue.empty()) {
+			data->readCondition.wait_for(lock, std::chrono::seconds(1));
+		}
+		return true;
+	}
+
+	if (!task.callback || !data->driver->isValid(handle)) {
+		return true;
+	}
+
+	uint64_t execTime = 0;
+	auto start = sp::platform::clock(ClockType::Monotonic);
+
+	memory::perform_clear([&] {
+		data->driver->performWithStorage(handle, [&](const db::Adapter &adapter) {
+			adapter.performWithTransaction(
+					[&](const db::Transaction &t) { return data->runTask(task, t, execTime); });
+		});
+	}, pool);
+
+	data->addTaskStats(task, start, execTime);
+
+	++data->statReads;
+	return true;
+}
+
+void ServerReader::threadDispose() {
+	memory::pool::destroy(pool);
+	pool = nullptr;
+
+	Thread::threadDispose();
+}
+
 } // namespace stappler::xenolith::storage
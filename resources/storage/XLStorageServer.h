@@ -43,6 +43,39 @@ public:
 
 	struct ServerData;
 
+	// Operation classes for queue wait and execution time stats
+	enum class Operation : uint32_t {
+		KeyValue, // get for key
+		Get, // get object or its fields
+		Select,
+		Count,
+		Write, // any operation, performed on writer thread
+		Max
+	};
+
+	struct OperationStats {
+		uint64_t count = 0;
+		uint64_t waitTime = 0; // total time in queue, microseconds
+		uint64_t maxWaitTime = 0;
+		uint64_t execTime = 0; // total time of operation itself, without transaction, microseconds
+		uint64_t maxExecTime = 0;
+	};
+
+	using OperationStatsArray = std::array<OperationStats, toInt(Operation::Max)>;
+
+	// Worker thread counters, updated after each transaction
+	struct Stats {
+		uint64_t tasks = 0; // tasks executed
+		uint64_t failed = 0; // tasks, that returned false and was rolled back
+		uint64_t transactions = 0; // transactions committed by worker
+		uint64_t batched = 0; // tasks, executed within group transactions
+		uint64_t rollbacks = 0; // group transactions, that were rolled back and replayed
+		uint64_t time = 0; // time spent in transactions, microseconds
+		uint64_t reads = 0; // operations, performed by read pool
+		OperationStatsArray operations;
+		Map<String, OperationStatsArray> schemes; // operations on schemes, by scheme name
+	};
+
 	using Scheme = db::Scheme;
 
 	static EventHeader onBroadcast;
@@ -136,7 +169,20 @@ public:
 
 	AppThread *getApplication() const;
 
+	Stats getStats() const;
+
 protected:
+	// Read-only operation, performed by read pool in parallel with writer thread. Reads are
+	// routed to writer thread while there are uncommitted writes, issued before them, so
+	// caller always observes its own writes.
+	bool performRead(Operation, const Scheme *,
+			Function<bool(const Server &, const db::Transaction &)> &&, Ref * = nullptr) const;
+
+	// Write, performed on writer thread. Replayable writes are grouped into single transaction
+	// and can be executed again, if the group was rolled back (see ServerDataTaskCallback)
+	bool performWrite(const Scheme *, Function<bool(const Server &, const db::Transaction &)> &&,
+			Ref * = nullptr, bool replayable = true) const;
+
 	bool get(const Scheme &, DataCallback &&, uint64_t oid, Vector<const db::Field *> &&fields,
 			db::UpdateFlags = db::UpdateFlags::None) const;
 	bool get(const Scheme &, DataCallback &&, StringView alias, Vector<const db::Field *> &&fields,
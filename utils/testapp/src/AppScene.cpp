@@ -28,6 +28,7 @@
 #include "XLContext.h"
 
 #include "XLDirector.h"
+#include "XLAppWindow.h"
 
 #include "XL2dSceneContent.h"
 
@@ -77,6 +78,23 @@ bool AppScene::init(NotNull<AppThread> app, NotNull<AppWindow> w,
 
 	setContent(content);
 
+	auto &launchUrl = app->getContext()->getInfo()->launchUrl;
+	if (!launchUrl.empty()) {
+		auto name = getLayoutNameById(launchUrl);
+		if (name != LayoutName::Root) {
+			_benchmarkQueue = getLayoutsForRoot(name);
+			if (_benchmarkQueue.empty()) {
+				_benchmarkQueue.emplace_back(name);
+			}
+			_benchmarkMode = true;
+			runNextBenchmark(content);
+			scheduleUpdate();
+			return true;
+		} else {
+			log::source().warn("AppScene", "Unknown launch URL: ", launchUrl);
+		}
+	}
+
 	Rc<SceneLayout2d> l;
 	auto dataPath = FileInfo("org.stappler.xenolith.test.AppScene.cbor", FileCategory::AppCache);
 	if (auto d = data::readFile<Interface>(dataPath)) {
@@ -122,12 +140,52 @@ void AppScene::runLayout(LayoutName l, Rc<SceneLayout2d> &&node) {
 }
 
 void AppScene::setActiveLayoutId(StringView name, Value &&data) {
+	if (_benchmarkMode) {
+		// do not replace user's last layout with benchmark runs
+		return;
+	}
+
 	Value sceneData({pair("id", Value(name)), pair("data", Value(move(data)))});
 
 	auto path = FileInfo("org.stappler.xenolith.test.AppScene.cbor", FileCategory::AppCache);
 	data::save(sceneData, path, data::EncodeFormat::CborCompressed);
 }
 
+void AppScene::handleBenchmarkFinished(StringView name, bool success, StringView report) {
+	if (!_benchmarkMode) {
+		return;
+	}
+
+	++_benchmarkCount;
+	if (!success) {
+		++_benchmarkFailures;
+	}
+
+	std::cout << (success ? "[  OK  ] " : "[FAILED] ") << name << "\n" << report << "\n";
+
+	if (!runNextBenchmark(static_cast<SceneContent2d *>(_content))) {
+		std::cout << "Benchmarks: " << _benchmarkCount - _benchmarkFailures << " of "
+				  << _benchmarkCount << " passed\n";
+		_director->getWindow()->close(true);
+	}
+}
+
+bool AppScene::runNextBenchmark(SceneContent2d *content) {
+	if (_benchmarkQueue.empty()) {
+		return false;
+	}
+
+	auto name = _benchmarkQueue.front();
+	_benchmarkQueue.erase(_benchmarkQueue.begin());
+
+	auto l = makeLayoutNode(name);
+	l->setDataValue(Value({pair("autorun", Value(true)), pair("exit", Value(true))}));
+
+	content->replaceLayout(l);
+	_contentSizeDirty = true;
+	return true;
+}
+
 DEFINE_PRIMARY_SCENE_CLASS(AppScene)
 
 DEFINE_CONFIG_FUNCTION((ContextConfig &cfg) {
@@ -51,8 +51,20 @@ public:
 
 	void setActiveLayoutId(StringView, Value && = Value());
 
+	// Called by benchmarks, started from launch URL, when workload is complete
+	void handleBenchmarkFinished(StringView name, bool success, StringView report);
+
 protected:
 	using Scene::init;
+
+	// Layouts from launch URL (`--url <layout-id>`) are started one by one with `autorun`,
+	// window is closed when the last one is finished
+	bool runNextBenchmark(basic2d::SceneContent2d *);
+
+	Vector<LayoutName> _benchmarkQueue;
+	bool _benchmarkMode = false;
+	uint32_t _benchmarkCount = 0;
+	uint32_t _benchmarkFailures = 0;
 };
 
 } // namespace stappler::xenolith::app
@@ -34,6 +34,22 @@
 #include "config/AppConfigMenu.cc"
 #include "config/AppConfigPresentModeSwitcher.cc"
 
+#include "bench/AppBenchFrameCacheTest.h"
+#include "bench/AppBenchSceneFrameTest.h"
+#include "bench/AppBenchFramePoolTest.h"
+#include "bench/AppBenchStorageWriteTest.h"
+#include "bench/AppBenchNetworkCacheTest.h"
+#include "bench/AppBenchAssetStreamTest.h"
+#include "bench/AppBenchAssetDownloadTest.h"
+#include "bench/AppBenchSurfaceStyleTest.h"
+#include "bench/AppBenchDrawOrderTest.h"
+#include "bench/AppBenchVertexKernelsTest.h"
+#include "bench/AppBenchDistanceFieldTest.h"
+#include "bench/AppBenchGlyphEvictionTest.h"
+#include "bench/AppBenchStorageQueryTest.h"
+#include "bench/AppBenchMaterialSetTest.h"
+#include "bench/AppBenchDamageTrackingTest.h"
+
 #include "2d/Renderer2dAnimationTest.h"
 #include "2d/Renderer2dParticleTest.h"
 #include "action/AppActionEaseTest.h"
@@ -87,6 +103,7 @@ static Vector<MenuData> s_layouts{
 				LayoutName::UtilsTests,
 				LayoutName::MaterialTests,
 				LayoutName::Renderer2dTests,
+				LayoutName::BenchTests,
 				LayoutName::Config,
 			});
 }},
@@ -177,6 +194,28 @@ static Vector<MenuData> s_layouts{
 				LayoutName::Renderer2dParticleTest,
 			});
 }},
+	MenuData{LayoutName::BenchTests, LayoutName::Root, "org.stappler.xenolith.test.BenchTests",
+		"Benchmarks",
+		[](LayoutName name) {
+	return Rc<LayoutMenu>::create(name,
+			Vector<LayoutName>{
+				LayoutName::BenchFrameCacheTest,
+				LayoutName::BenchSceneFrameTest,
+				LayoutName::BenchFramePoolTest,
+				LayoutName::BenchStorageWriteTest,
+				LayoutName::BenchNetworkCacheTest,
+				LayoutName::BenchAssetStreamTest,
+				LayoutName::BenchAssetDownloadTest,
+				LayoutName::BenchSurfaceStyleTest,
+				LayoutName::BenchDrawOrderTest,
+				LayoutName::BenchVertexKernelsTest,
+				LayoutName::BenchDistanceFieldTest,
+				LayoutName::BenchGlyphEvictionTest,
+				LayoutName::BenchStorageQueryTest,
+				LayoutName::BenchMaterialSetTest,
+				LayoutName::BenchDamageTrackingTest,
+			});
+}},
 
 	MenuData{LayoutName::Config, LayoutName::Root, "org.stappler.xenolith.test.Config", "Config",
 		[](LayoutName name) { return Rc<ConfigMenu>::create(); }},
@@ -296,6 +335,52 @@ static Vector<MenuData> s_layouts{
 	MenuData{LayoutName::Renderer2dParticleTest, LayoutName::Renderer2dTests,
 		"org.stappler.xenolith.test.Renderer2dParticleTest", "Particle test",
 		[](LayoutName name) { return Rc<Renderer2dParticleTest>::create(); }},
+
+	MenuData{LayoutName::BenchFrameCacheTest, LayoutName::BenchTests,
+		"org.stappler.xenolith.test.BenchFrameCacheTest", "FrameCache lookup",
+		[](LayoutName name) { return Rc<BenchFrameCacheTest>::create(); }},
+	MenuData{LayoutName::BenchSceneFrameTest, LayoutName::BenchTests,
+		"org.stappler.xenolith.test.BenchSceneFrameTest", "Scene frame time",
+		[](LayoutName name) { return Rc<BenchSceneFrameTest>::create(); }},
+	MenuData{LayoutName::BenchFramePoolTest, LayoutName::BenchTests,
+		"org.stappler.xenolith.test.BenchFramePoolTest", "Frame memory pools",
+		[](LayoutName name) { return Rc<BenchFramePoolTest>::create(); }},
+	MenuData{LayoutName::BenchStorageWriteTest, LayoutName::BenchTests,
+		"org.stappler.xenolith.test.BenchStorageWriteTest", "Storage writes",
+		[](LayoutName name) { return Rc<BenchStorageWriteTest>::create(); }},
+	MenuData{LayoutName::BenchNetworkCacheTest, LayoutName::BenchTests,
+		"org.stappler.xenolith.test.BenchNetworkCacheTest", "Network cache",
+		[](LayoutName name) { return Rc<BenchNetworkCacheTest>::create(); }},
+	MenuData{LayoutName::BenchAssetStreamTest, LayoutName::BenchTests,
+		"org.stappler.xenolith.test.BenchAssetStreamTest", "Asset streaming",
+		[](LayoutName name) { return Rc<BenchAssetStreamTest>::create(); }},
+	MenuData{LayoutName::BenchAssetDownloadTest, LayoutName::BenchTests,
+		"org.stappler.xenolith.test.BenchAssetDownloadTest", "Asset download",
+		[](LayoutName name) { return Rc<BenchAssetDownloadTest>::create(); }},
+	MenuData{LayoutName::BenchSurfaceStyleTest, LayoutName::BenchTests,
+		"org.stappler.xenolith.test.BenchSurfaceStyleTest", "Surface theme switch",
+		[](LayoutName name) { return Rc<BenchSurfaceStyleTest>::create(); }},
+	MenuData{LayoutName::BenchDrawOrderTest, LayoutName::BenchTests,
+		"org.stappler.xenolith.test.BenchDrawOrderTest", "Draw order",
+		[](LayoutName name) { return Rc<BenchDrawOrderTest>::create(); }},
+	MenuData{LayoutName::BenchVertexKernelsTest, LayoutName::BenchTests,
+		"org.stappler.xenolith.test.BenchVertexKernelsTest", "Vertex kernels",
+		[](LayoutName name) { return Rc<BenchVertexKernelsTest>::create(); }},
+	MenuData{LayoutName::BenchDistanceFieldTest, LayoutName::BenchTests,
+		"org.stappler.xenolith.test.BenchDistanceFieldTest", "Distance field glyphs",
+		[](LayoutName name) { return Rc<BenchDistanceFieldTest>::create(); }},
+	MenuData{LayoutName::BenchGlyphEvictionTest, LayoutName::BenchTests,
+		"org.stappler.xenolith.test.BenchGlyphEvictionTest", "Glyph eviction",
+		[](LayoutName name) { return Rc<BenchGlyphEvictionTest>::create(); }},
+	MenuData{LayoutName::BenchStorageQueryTest, LayoutName::BenchTests,
+		"org.stappler.xenolith.test.BenchStorageQueryTest", "Storage reads",
+		[](LayoutName name) { return Rc<BenchStorageQueryTest>::create(); }},
+	MenuData{LayoutName::BenchMaterialSetTest, LayoutName::BenchTests,
+		"org.stappler.xenolith.test.BenchMaterialSetTest", "Material set update",
+		[](LayoutName name) { return Rc<BenchMaterialSetTest>::create(); }},
+	MenuData{LayoutName::BenchDamageTrackingTest, LayoutName::BenchTests,
+		"org.stappler.xenolith.test.BenchDamageTrackingTest", "Damage tracking",
+		[](LayoutName name) { return Rc<BenchDamageTrackingTest>::create(); }},
 };
 
 LayoutName getRootLayoutForLayout(LayoutName name) {
@@ -334,6 +419,16 @@ LayoutName getLayoutNameById(StringView name) {
 	return LayoutName::Root;
 }
 
+Vector<LayoutName> getLayoutsForRoot(LayoutName root) {
+	Vector<LayoutName> ret;
+	for (auto &it : s_layouts) {
+		if (it.root == root && it.layout != root) {
+			ret.emplace_back(it.layout);
+		}
+	}
+	return ret;
+}
+
 Rc<SceneLayout2d> makeLayoutNode(LayoutName name) {
 	for (auto &it : s_layouts) {
 		if (it.layout == name) {
@@ -42,6 +42,7 @@ enum class LayoutName {
 	UtilsTests,
 	MaterialTests,
 	Renderer2dTests,
+	BenchTests,
 	Config,
 
 	GeneralUpdateTest = 256 * 1,
@@ -88,6 +89,22 @@ enum class LayoutName {
 
 	Renderer2dAnimationTest = 256 * 7,
 	Renderer2dParticleTest,
+
+	BenchFrameCacheTest = 256 * 8,
+	BenchSceneFrameTest,
+	BenchFramePoolTest,
+	BenchStorageWriteTest,
+	BenchNetworkCacheTest,
+	BenchAssetStreamTest,
+	BenchAssetDownloadTest,
+	BenchSurfaceStyleTest,
+	BenchDrawOrderTest,
+	BenchVertexKernelsTest,
+	BenchDistanceFieldTest,
+	BenchGlyphEvictionTest,
+	BenchStorageQueryTest,
+	BenchMaterialSetTest,
+	BenchDamageTrackingTest,
 };
 
 struct MenuData {
@@ -103,6 +120,9 @@ StringView getLayoutNameId(LayoutName);
 StringView getLayoutNameTitle(LayoutName);
 LayoutName getLayoutNameById(StringView);
 
+// Layouts, registered with `root` as parent menu
+Vector<LayoutName> getLayoutsForRoot(LayoutName root);
+
 Rc<basic2d::SceneLayout2d> makeLayoutNode(LayoutName);
 
 } // namespace stappler::xenolith::app
@@ -0,0 +1,190 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "AppBenchAssetDownloadTest.h"
+#include "XLAssetLibrary.h"
+#include "XLDirector.h"
+#include "XLAppThread.h"
+
+namespace stappler::xenolith::app {
+
+static const BenchAssetDownloadTest::Scenario s_downloadScenarios[] = {
+	{"Single connection", 1, 0},
+	{"Single connection, disconnects", 1, 2},
+	{"4 segments", 4, 0},
+	// first response is cut by client itself, when segments are planned
+	{"4 segments, disconnects", 4, 3},
+};
+
+bool BenchAssetDownloadTest::init() {
+	if (!BenchTest::init(LayoutName::BenchAssetDownloadTest, "Asset download throughput")) {
+		return false;
+	}
+
+	_listener = addSystem(Rc<DataListener<storage::Asset>>::create(
+			[this](SubscriptionFlags flags) { handleAssetUpdate(flags); }));
+
+	return true;
+}
+
+void BenchAssetDownloadTest::performBenchmark(DoneCallback &&done) {
+	_done = sp::move(done);
+	_out = StringStream();
+	_success = true;
+
+	auto lib = _director->getApplication()->getExtension<storage::AssetLibrary>();
+	if (!lib) {
+		_out << "AssetLibrary is not available\n";
+		_success = false;
+		finish();
+		return;
+	}
+
+	_server = Rc<BenchHttpServer>::create();
+	if (!_server) {
+		_out << "Local HTTP server is not available\n";
+		finish();
+		return;
+	}
+
+	_segments = lib->getDownloadSegments();
+	_segmentMinSize = lib->getDownloadSegmentMinSize();
+
+	_data.resize(DataSize);
+	for (size_t i = 0; i < DataSize; ++i) { _data[i] = uint8_t((i * 131 + i / 4'096) & 0xFF); }
+
+	_out << "Bandwidth limit: " << ChunkSize / 1'024 << " KiB/ms per connection\n";
+
+	runScenario(0);
+}
+
+void BenchAssetDownloadTest::runScenario(uint32_t idx) {
+	if (idx >= sizeof(s_downloadScenarios) / sizeof(Scenario)) {
+		finish();
+		return;
+	}
+
+	auto &scenario = s_downloadScenarios[idx];
+	auto path = toString("/download-", idx, ".bin");
+
+	BenchHttpServer::Resource res;
+	res.data = _data;
+	res.etag = "\"download\"";
+	res.headers.emplace_back("Accept-Ranges", "bytes");
+	res.chunkSize = ChunkSize;
+	res.chunkDelay = TimeInterval::milliseconds(1);
+	res.disconnects = scenario.disconnects;
+	res.disconnectAfter = DataSize / 8;
+	_server->setResource(path, sp::move(res));
+
+	_scenario = idx;
+	_resumes = 0;
+
+	auto lib = _director->getApplication()->getExtension<storage::AssetLibrary>();
+	lib->setDownloadSegments(scenario.segments, 1'024 * 1'024);
+	lib->acquireAsset(_server->getUrl(path), [this](const Rc<storage::Asset> &asset) {
+		if (!asset) {
+			_out << s_downloadScenarios[_scenario].name << ": fail to acquire asset\n";
+			_success = false;
+			finish();
+			return;
+		}
+
+		_listener->setSubscription(asset);
+		_start = sp::platform::clock(ClockType::Monotonic);
+		if (!asset->download()) {
+			_out << s_downloadScenarios[_scenario].name << ": fail to start download\n";
+			_success = false;
+			finish();
+		}
+	}, TimeInterval::seconds(60), this);
+}
+
+void BenchAssetDownloadTest::handleAssetUpdate(SubscriptionFlags flags) {
+	auto asset = _listener->getSubscription();
+	if (!asset || !_done) {
+		return;
+	}
+
+	if (flags.hasFlag(storage::Asset::DownloadSuccessful)) {
+		handleScenarioComplete(asset);
+	} else if (flags.hasFlag(storage::Asset::DownloadFailed) && !asset->isDownloadInProgress()) {
+		// partial file is kept, next download continues it with range requests
+		if (++_resumes > MaxResumes) {
+			_out << s_downloadScenarios[_scenario].name << ": FAILED after " << MaxResumes
+				 << " resumes\n";
+			_success = false;
+			finish();
+		} else {
+			asset->download();
+		}
+	}
+}
+
+void BenchAssetDownloadTest::handleScenarioComplete(storage::Asset *asset) {
+	auto time = sp::platform::clock(ClockType::Monotonic) - _start;
+	auto &scenario = s_downloadScenarios[_scenario];
+	auto path = toString("/download-", _scenario, ".bin");
+
+	bool valid = false;
+	if (auto lock = asset->lockReadableVersion(this)) {
+		auto data = filesystem::readIntoMemory<Interface>(FileInfo(lock->getPath()));
+		valid = (BytesView(data) == BytesView(_data));
+	}
+
+	_out << scenario.name << ": " << double(time) / 1'000.0 << " ms, "
+		 << double(DataSize) / double(time) << " MB/s, " << _resumes << " resumes, "
+		 << _server->getRequestCount(path) << " requests" << (valid ? "" : ", data FAILED")
+		 << "\n";
+	if (!valid) {
+		_success = false;
+	}
+
+	asset->clear();
+
+	// listener is not modified from its own callback
+	_director->getApplication()->performOnAppThread([this, next = _scenario + 1] {
+		_listener->setSubscription(nullptr);
+		runScenario(next);
+	}, this);
+}
+
+void BenchAssetDownloadTest::finish() {
+	if (auto lib = _director->getApplication()->getExtension<storage::AssetLibrary>()) {
+		lib->setDownloadSegments(_segments, _segmentMinSize);
+	}
+
+	if (_server) {
+		_server->stop();
+		_server = nullptr;
+	}
+
+	_listener->setSubscription(nullptr);
+
+	auto done = sp::move(_done);
+	_done = nullptr;
+	if (done) {
+		done(_success, _out.str());
+	}
+}
+
+} // namespace stappler::xenolith::app
@@ -0,0 +1,79 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef TEST_SRC_TESTS_BENCH_APPBENCHASSETDOWNLOADTEST_H_
+#define TEST_SRC_TESTS_BENCH_APPBENCHASSETDOWNLOADTEST_H_
+
+#include "AppBenchTest.h"
+#include "AppBenchHttpServer.h"
+#include "XLAsset.h"
+
+namespace stappler::xenolith::app {
+
+// Asset download throughput from local HTTP server with limited bandwidth per connection:
+// single connection and parallel segments, with and without injected disconnects, that
+// are recovered by resuming partial files
+class BenchAssetDownloadTest : public BenchTest {
+public:
+	static constexpr size_t DataSize = 16 * 1'024 * 1'024;
+	static constexpr size_t ChunkSize = 64 * 1'024;
+	static constexpr uint32_t MaxResumes = 8;
+
+	struct Scenario {
+		StringView name;
+		uint32_t segments = 1;
+		uint32_t disconnects = 0; // responses, cut off by server
+	};
+
+	virtual ~BenchAssetDownloadTest() { }
+
+	virtual bool init() override;
+
+protected:
+	using BenchTest::init;
+
+	virtual void performBenchmark(DoneCallback &&done) override;
+
+	void runScenario(uint32_t);
+	void handleAssetUpdate(SubscriptionFlags);
+	void handleScenarioComplete(storage::Asset *);
+	void finish();
+
+	DataListener<storage::Asset> *_listener = nullptr;
+	Rc<BenchHttpServer> _server;
+	Bytes _data;
+	uint32_t _scenario = 0;
+	uint32_t _resumes = 0;
+	uint64_t _start = 0;
+
+	// library settings, restored after benchmark
+	uint32_t _segments = 1;
+	size_t _segmentMinSize = 0;
+
+	DoneCallback _done;
+	StringStream _out;
+	bool _success = true;
+};
+
+} // namespace stappler::xenolith::app
+
+#endif /* TEST_SRC_TESTS_BENCH_APPBENCHASSETDOWNLOADTEST_H_ */
@@ -0,0 +1,221 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+
+#include "AppBenchAssetStreamTest.h"
+#include "XLAssetLibrary.h"
+#include "XLDirector.h"
+#include "XLAppThread.h"
+
+namespace stappler::xenolith::app {
+
+// Staging buffer with notifications: data handler is called from network thread, end handler -
+// from application thread
+class BenchAssetStreamBuffer : public storage::AssetStreamBuffer {
+public:
+	virtual ~BenchAssetStreamBuffer() { }
+
+	virtual void handleStreamData(BytesView data) override {
+		AssetStreamBuffer::handleStreamData(data);
+		if (onData) {
+			onData(getSize());
+		}
+	}
+
+	virtual void handleStreamEnd(bool success) override {
+		AssetStreamBuffer::handleStreamEnd(success);
+		if (onEnd) {
+			onEnd();
+		}
+	}
+
+	Function<void(size_t)> onData;
+	Function<void()> onEnd;
+};
+
+bool BenchAssetStreamTest::init() {
+	if (!BenchTest::init(LayoutName::BenchAssetStreamTest, "Asset download streams")) {
+		return false;
+	}
+	return true;
+}
+
+void BenchAssetStreamTest::performBenchmark(DoneCallback &&done) {
+	_done = sp::move(done);
+	_out = StringStream();
+	_success = true;
+	_ended = 0;
+	_attachOffset = 0;
+	_attachPosted = false;
+
+	_server = Rc<BenchHttpServer>::create();
+	if (!_server) {
+		_out << "Local HTTP server is not available\n";
+		finish();
+		return;
+	}
+
+	_data.resize(DataSize);
+	for (size_t i = 0; i < DataSize; ++i) { _data[i] = uint8_t((i * 131) & 0xFF); }
+
+	BenchHttpServer::Resource res;
+	res.data = _data;
+	res.etag = "\"stream\"";
+	res.chunkSize = ChunkSize;
+	res.chunkDelay = TimeInterval::milliseconds(2);
+	_server->setResource("/stream.bin", sp::move(res));
+
+	auto app = _director->getApplication();
+	auto lib = app->getExtension<storage::AssetLibrary>();
+	if (!lib) {
+		_out << "AssetLibrary is not available\n";
+		_success = false;
+		finish();
+		return;
+	}
+
+	lib->acquireAsset(_server->getUrl("/stream.bin"), [this](const Rc<storage::Asset> &asset) {
+		handleAsset(asset);
+	}, TimeInterval::seconds(60), this);
+}
+
+void BenchAssetStreamTest::handleAsset(storage::Asset *asset) {
+	if (!asset) {
+		_out << "Fail to acquire asset\n";
+		_success = false;
+		finish();
+		return;
+	}
+
+	_asset = asset;
+
+	auto app = _director->getApplication();
+	auto first = Rc<BenchAssetStreamBuffer>::create();
+	first->onEnd = [this] { handleStreamEnd(); };
+	first->onData = [this, app](size_t size) {
+		// second stream is attached from app thread in the middle of transfer
+		if (size >= DataSize / 2 && !_attachPosted.exchange(true)) {
+			app->performOnAppThread([this, size] {
+				if (_second || !_asset->isDownloadInProgress()) {
+					return;
+				}
+
+				auto second = Rc<BenchAssetStreamBuffer>::create();
+				second->onEnd = [this] { handleStreamEnd(); };
+				_second = second;
+				_attachOffset = size;
+
+				auto t = sp::platform::clock(ClockType::Monotonic);
+				_asset->addStream(Rc<storage::AssetStream>(second));
+				_out << "Attach with replay: "
+					 << double(sp::platform::clock(ClockType::Monotonic) - t) / 1'000.0
+					 << " ms\n";
+			}, this);
+		}
+	};
+
+	_first = first;
+	_asset->addStream(Rc<storage::AssetStream>(first));
+
+	_start = sp::platform::clock(ClockType::Monotonic);
+	if (!_asset->download()) {
+		_out << "Fail to start download\n";
+		_success = false;
+		finish();
+	}
+}
+
+void BenchAssetStreamTest::handleStreamEnd() {
+	++_ended;
+	if (_ended == 1) {
+		_downloadTime = sp::platform::clock(ClockType::Monotonic) - _start;
+	}
+	if (_ended < (_second ? 2 : 1)) {
+		return;
+	}
+
+	// version is registered after stream end handlers
+	_director->getApplication()->performOnAppThread([this] {
+		auto check = [&](StringView name, storage::AssetStreamBuffer *stream) {
+			bool ok = stream && stream->isComplete() && stream->isValid();
+			if (ok) {
+				stream->read([&](BytesView data) { ok = (data == BytesView(_data)); });
+			}
+			_out << name << ": " << (ok ? "ok" : "FAILED") << "\n";
+			if (!ok) {
+				_success = false;
+			}
+		};
+
+		_out << "Download: " << double(_downloadTime) / 1'000.0 << " ms, " << DataSize
+			 << " bytes\n";
+
+		check("Stream attached before download", _first);
+		if (_second) {
+			_out << "Second stream attached at " << _attachOffset << " bytes\n";
+			check("Stream attached during download", _second);
+		} else {
+			_out << "Download finished before second stream was attached\n";
+		}
+
+		if (auto lock = _asset->lockReadableVersion(this)) {
+			auto t = sp::platform::clock(ClockType::Monotonic);
+			auto data = filesystem::readIntoMemory<Interface>(FileInfo(lock->getPath()));
+			_out << "Read back from file: "
+				 << double(sp::platform::clock(ClockType::Monotonic) - t) / 1'000.0 << " ms\n";
+			if (BytesView(data) != BytesView(_data)) {
+				_out << "Version file: FAILED\n";
+				_success = false;
+			}
+		} else {
+			_out << "Version file: not available\n";
+			_success = false;
+		}
+
+		_first->release();
+		if (_first->getSize() != 0 || _first->read([](BytesView) { })) {
+			_out << "Release: FAILED\n";
+			_success = false;
+		}
+
+		finish();
+	}, this);
+}
+
+void BenchAssetStreamTest::finish() {
+	if (_server) {
+		_server->stop();
+		_server = nullptr;
+	}
+
+	_first = nullptr;
+	_second = nullptr;
+	_asset = nullptr;
+
+	auto done = sp::move(_done);
+	_done = nullptr;
+	if (done) {
+		done(_success, _out.str());
+	}
+}
+
+} // namespace stappler::xenolith::app
@@ -0,0 +1,71 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+
+#ifndef TEST_SRC_TESTS_BENCH_APPBENCHASSETSTREAMTEST_H_
+#define TEST_SRC_TESTS_BENCH_APPBENCHASSETSTREAMTEST_H_
+
+#include "AppBenchTest.h"
+#include "AppBenchHttpServer.h"
+#include "XLAsset.h"
+
+namespace stappler::xenolith::app {
+
+// Asset download from local HTTP server into staging buffers: stream, attached before
+// download, and stream, attached in the middle of transfer, should receive whole file;
+// reports download time and time to read version file back
+class BenchAssetStreamTest : public BenchTest {
+public:
+	static constexpr size_t DataSize = 2 * 1'024 * 1'024;
+	static constexpr size_t ChunkSize = 64 * 1'024;
+
+	virtual ~BenchAssetStreamTest() { }
+
+	virtual bool init() override;
+
+protected:
+	using BenchTest::init;
+
+	virtual void performBenchmark(DoneCallback &&done) override;
+
+	void handleAsset(storage::Asset *);
+	void handleStreamEnd();
+	void finish();
+
+	Rc<BenchHttpServer> _server;
+	Rc<storage::Asset> _asset;
+	Rc<storage::AssetStreamBuffer> _first;
+	Rc<storage::AssetStreamBuffer> _second;
+	Bytes _data;
+	size_t _attachOffset = 0; // bytes, received by first stream, when second was attached
+	std::atomic<bool> _attachPosted = false; // set from network thread
+	uint32_t _ended = 0;
+	uint64_t _start = 0;
+	uint64_t _downloadTime = 0;
+	DoneCallback _done;
+	StringStream _out;
+	bool _success = true;
+};
+
+} // namespace stappler::xenolith::app
+
+#endif /* TEST_SRC_TESTS_BENCH_APPBENCHASSETSTREAMTEST_H_ */
@@ -0,0 +1,384 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "AppBenchDamageTrackingTest.h"
+#include "XL2dLayer.h"
+#include "XLDirector.h"
+#include "XLFrameContext.h"
+
+namespace stappler::xenolith::app {
+
+static bool BenchDamageTrackingTest_isInside(const Vec2 *quad, const Vec2 &p) {
+	// samples, that touch an edge within rounding error, are not counted as inside
+	static constexpr float Tolerance = 0.01f;
+
+	bool hasPositive = false;
+	bool hasNegative = false;
+	for (uint32_t i = 0; i < 4; ++i) {
+		auto &a = quad[i];
+		auto &b = quad[(i + 1) % 4];
+		auto edge = b - a;
+		auto cross = edge.x * (p.y - a.y) - edge.y * (p.x - a.x);
+		auto limit = Tolerance * edge.length();
+		if (cross > limit) {
+			hasPositive = true;
+		} else if (cross < -limit) {
+			hasNegative = true;
+		} else {
+			return false;
+		}
+	}
+	return hasPositive != hasNegative;
+}
+
+static bool BenchDamageTrackingTest_isEqual(const Color4F &a, const Color4F &b) {
+	static constexpr float Tolerance = 1.0f / 512.0f;
+
+	return std::abs(a.r - b.r) < Tolerance && std::abs(a.g - b.g) < Tolerance
+			&& std::abs(a.b - b.b) < Tolerance && std::abs(a.a - b.a) < Tolerance;
+}
+
+bool BenchDamageTrackingTest::init() {
+	if (!BenchTest::init(LayoutName::BenchDamageTrackingTest,
+				"Frame cost and correctness of damage tracking")) {
+		return false;
+	}
+
+	_field = addChild(Rc<Node>::create());
+	_field->setAnchorPoint(Anchor::Middle);
+
+	// static layers in a grid, larger animated layers overlap them
+	_layers.reserve(GridSize * GridSize + AnimatedCount);
+	for (uint32_t i = 0; i < GridSize * GridSize; ++i) {
+		auto layer = _field->addChild(
+				Rc<Layer>::create(Color(Color::Tone(i % 16), Color::Level::b200)), ZOrder(i));
+		layer->setAnchorPoint(Anchor::Middle);
+		_layers.emplace_back(layer);
+	}
+
+	_animated.reserve(AnimatedCount);
+	for (uint32_t i = 0; i < AnimatedCount; ++i) {
+		auto layer = _field->addChild(Rc<Layer>::create(Color(Color::Tone(i), Color::Level::b700)),
+				ZOrder(GridSize * GridSize + i));
+		layer->setAnchorPoint(Anchor::Middle);
+		_layers.emplace_back(layer);
+		_animated.emplace_back(layer);
+	}
+
+	scheduleUpdate();
+
+	return true;
+}
+
+void BenchDamageTrackingTest::handleExit() {
+	stopAllActions();
+	if (_done) {
+		_director->setDamageTrackingEnabled(_initialTracking);
+		_done(false, "Benchmark was interrupted");
+		_done = nullptr;
+	}
+
+	BenchTest::handleExit();
+}
+
+void BenchDamageTrackingTest::handleContentSizeDirty() {
+	BenchTest::handleContentSizeDirty();
+
+	_field->setContentSize(_contentSize);
+	_field->setPosition(_contentSize / 2.0f);
+
+	_cell = Size2(_contentSize.width / GridSize, _contentSize.height / GridSize);
+	for (uint32_t i = 0; i < GridSize * GridSize; ++i) {
+		_layers[i]->setContentSize(_cell * 0.75f);
+		_layers[i]->setPosition(
+				Vec2((i % GridSize + 0.5f) * _cell.width, (i / GridSize + 0.5f) * _cell.height));
+	}
+
+	for (auto &it : _animated) { it->setContentSize(_cell * 1.5f); }
+
+	updateAnimation();
+}
+
+void BenchDamageTrackingTest::update(const UpdateTime &time) {
+	BenchTest::update(time);
+
+	// animation depends on frame number, not time, so the runs are comparable
+	++_animFrame;
+	updateAnimation();
+
+	if (!_done) {
+		return;
+	}
+
+	++_frame;
+	if (_frame < WarmupFrames) {
+		return;
+	}
+
+	if (_frame == WarmupFrames) {
+		_startTime = _lastTime = time.global;
+		return;
+	}
+
+	_lastTime = time.global;
+	_sceneTime += _director->getDirectorFrameTime();
+
+	auto frames = (_run == Run::Verification) ? VerifiedFrames : MeasuredFrames;
+	if (_frame == WarmupFrames + frames) {
+		finalizeRun();
+	}
+}
+
+bool BenchDamageTrackingTest::visitDraw(FrameInfo &info, NodeVisitFlags parentFlags) {
+	if (!BenchTest::visitDraw(info, parentFlags)) {
+		return false;
+	}
+
+	if (!_done || _frame <= WarmupFrames) {
+		return true;
+	}
+
+	// layers report their damage within visit, so it's complete for them here
+	++_drawnFrames;
+	if (info.damage.isFull()) {
+		++_fullFrames;
+	} else if (!info.damage.isEmpty()) {
+		auto fieldRect = TransformRect(Rect(Vec2::ZERO, _field->getContentSize()),
+				_field->getNodeToWorldTransform());
+		auto fieldArea = fieldRect.size.width * fieldRect.size.height;
+		if (fieldArea > 0.0f) {
+			auto &rect = info.damage.rect;
+			_damagedArea += std::min(1.0f, rect.size.width * rect.size.height / fieldArea);
+		}
+	}
+
+	if (_run == Run::Verification) {
+		verifyFrame(info.damage);
+	}
+	return true;
+}
+
+void BenchDamageTrackingTest::performBenchmark(DoneCallback &&done) {
+	_done = sp::move(done);
+	_out = StringStream();
+	_out << "Layers: " << _layers.size() << " (" << AnimatedCount
+		<< " animated), frames: " << MeasuredFrames << "\n";
+
+	_initialTracking = _director->isDamageTrackingEnabled();
+
+	// frames are requested continuously, even with render-on-demand presentation
+	runAction(Rc<RenderContinuously>::create(), "BenchDamageTrackingTest"_tag);
+
+	startRun(Run::TrackingDisabled);
+}
+
+void BenchDamageTrackingTest::updateAnimation() {
+	if (_cell.width <= 0.0f || _cell.height <= 0.0f) {
+		return;
+	}
+
+	auto angle = float(_animFrame % 120) / 120.0f * 2.0f * numbers::pi;
+	for (uint32_t i = 0; i < AnimatedCount; ++i) {
+		auto layer = _animated[i];
+		auto base = Vec2((i * 2.0f + 1.5f) * _cell.width, (i * 2.0f + 1.5f) * _cell.height);
+		switch (i % 4) {
+		case 0:
+			layer->setPosition(base + Vec2(std::sin(angle) * _cell.width * 2.0f, 0.0f));
+			break;
+		case 1:
+			layer->setPosition(base);
+			layer->setRotation(angle);
+			break;
+		case 2:
+			layer->setPosition(base);
+			layer->setOpacity(0.5f + 0.5f * std::sin(angle));
+			break;
+		default:
+			// visibility and z-order changes without transform changes
+			layer->setPosition(base);
+			layer->setVisible((_animFrame / 30) % 2 == 0);
+			if ((_animFrame / 45) % 2 == 0) {
+				layer->setLocalZOrder(ZOrder(-1));
+			} else {
+				layer->setLocalZOrder(ZOrder(GridSize * GridSize + i));
+			}
+			break;
+		}
+	}
+}
+
+void BenchDamageTrackingTest::startRun(Run run) {
+	_run = run;
+	_frame = 0;
+	_startTime = _lastTime = 0;
+	_sceneTime = 0.0;
+	_damagedArea = 0.0;
+	_drawnFrames = 0;
+	_fullFrames = 0;
+
+	_tracked.clear();
+	_mismatchFrames = 0;
+	_mismatchSamples = 0;
+
+	// first frame after the switch is a full redraw, warmup frames cover it
+	_director->setDamageTrackingEnabled(run != Run::TrackingDisabled);
+}
+
+void BenchDamageTrackingTest::finalizeRun() {
+	if (_run == Run::Verification) {
+		_out << "Verification: " << _drawnFrames << " frames, " << _fullFrames
+			<< " full redraws\n";
+		_out << "  Mismatched frames: " << _mismatchFrames << ", samples: " << _mismatchSamples
+			<< "\n";
+		finalizeBenchmark();
+		return;
+	}
+
+	auto frameInterval = double(_lastTime - _startTime) / double(MeasuredFrames) / 1'000.0;
+
+	if (_run == Run::TrackingEnabled) {
+		_out << "Damage tracking enabled:\n";
+	} else {
+		_out << "Damage tracking disabled:\n";
+	}
+	_out << "  Frame interval: " << frameInterval << " ms avg\n";
+	_out << "  Scene time: " << _sceneTime / double(MeasuredFrames) << " ms avg\n";
+	_out << "  GPU time: " << _director->getFenceFrameTime() << " ms (fence), "
+		<< _director->getTimestampFrameTime() << " ms (timestamp)\n";
+	if (_run == Run::TrackingEnabled && _drawnFrames > 0) {
+		_out << "  Damaged area: " << 100.0 * _damagedArea / double(_drawnFrames)
+			<< " % avg, full redraws: " << _fullFrames << "\n";
+	}
+
+	startRun(Run(toInt(_run) + 1));
+}
+
+void BenchDamageTrackingTest::finalizeBenchmark() {
+	stopAllActionsByTag("BenchDamageTrackingTest"_tag);
+	_director->setDamageTrackingEnabled(_initialTracking);
+
+	auto done = sp::move(_done);
+	_done = nullptr;
+	done(_mismatchFrames == 0, _out.str());
+}
+
+void BenchDamageTrackingTest::rasterize(Vector<Color4F> &samples) const {
+	samples.assign(SampleGrid * SampleGrid, Color4F(0.0f, 0.0f, 0.0f, 0.0f));
+
+	auto step = Vec2(_sampleRect.size.width / SampleGrid, _sampleRect.size.height / SampleGrid);
+	if (step.x <= 0.0f || step.y <= 0.0f) {
+		return;
+	}
+
+	auto toSample = [&](float value, float origin, float size) {
+		return int32_t(std::floor((value - origin) / size - 0.5f));
+	};
+
+	// children are sorted by z-order within visit, blend them as the draw pass does
+	for (auto &it : _field->getChildren()) {
+		if (!it->isVisible()) {
+			continue;
+		}
+
+		auto size = it->getContentSize();
+		auto transform = it->getNodeToWorldTransform();
+		Vec2 quad[4] = {
+			transform.transformPoint(Vec2(0.0f, 0.0f)),
+			transform.transformPoint(Vec2(size.width, 0.0f)),
+			transform.transformPoint(Vec2(size.width, size.height)),
+			transform.transformPoint(Vec2(0.0f, size.height)),
+		};
+
+		Vec2 min = quad[0];
+		Vec2 max = quad[0];
+		for (auto &pt : quad) {
+			min.x = std::min(min.x, pt.x);
+			min.y = std::min(min.y, pt.y);
+			max.x = std::max(max.x, pt.x);
+			max.y = std::max(max.y, pt.y);
+		}
+
+		auto x0 = std::max(toSample(min.x, _sampleRect.origin.x, step.x), int32_t(0));
+		auto y0 = std::max(toSample(min.y, _sampleRect.origin.y, step.y), int32_t(0));
+		auto x1 = std::min(toSample(max.x, _sampleRect.origin.x, step.x) + 1,
+				int32_t(SampleGrid - 1));
+		auto y1 = std::min(toSample(max.y, _sampleRect.origin.y, step.y) + 1,
+				int32_t(SampleGrid - 1));
+
+		auto color = it->getDisplayedColor();
+		for (int32_t y = y0; y <= y1; ++y) {
+			for (int32_t x = x0; x <= x1; ++x) {
+				auto p = Vec2(_sampleRect.origin.x + (x + 0.5f) * step.x,
+						_sampleRect.origin.y + (y + 0.5f) * step.y);
+				if (BenchDamageTrackingTest_isInside(quad, p)) {
+					auto &target = samples[y * SampleGrid + x];
+					target.r = target.r * (1.0f - color.a) + color.r * color.a;
+					target.g = target.g * (1.0f - color.a) + color.g * color.a;
+					target.b = target.b * (1.0f - color.a) + color.b * color.a;
+					target.a = target.a * (1.0f - color.a) + color.a;
+				}
+			}
+		}
+	}
+}
+
+void BenchDamageTrackingTest::verifyFrame(const FrameDamage &damage) {
+	_sampleRect = TransformRect(Rect(Vec2::ZERO, _field->getContentSize()),
+			_field->getNodeToWorldTransform());
+
+	// full redraw of the current frame, as it would be drawn without damage tracking
+	rasterize(_full);
+
+	if (_tracked.size() != _full.size() || damage.isFull()) {
+		_tracked = _full;
+		return;
+	}
+
+	// with damage tracking, only samples within damage are updated,
+	// others keep their values from the previous frame
+	auto step = Vec2(_sampleRect.size.width / SampleGrid, _sampleRect.size.height / SampleGrid);
+	auto &rect = damage.rect;
+
+	uint32_t mismatched = 0;
+	for (uint32_t y = 0; y < SampleGrid; ++y) {
+		for (uint32_t x = 0; x < SampleGrid; ++x) {
+			auto idx = y * SampleGrid + x;
+			auto p = Vec2(_sampleRect.origin.x + (x + 0.5f) * step.x,
+					_sampleRect.origin.y + (y + 0.5f) * step.y);
+			if (!damage.isEmpty() && p.x >= rect.getMinX() && p.x <= rect.getMaxX()
+					&& p.y >= rect.getMinY() && p.y <= rect.getMaxY()) {
+				_tracked[idx] = _full[idx];
+			} else if (!BenchDamageTrackingTest_isEqual(_tracked[idx], _full[idx])) {
+				// stale sample, resync it to count every missed change once
+				_tracked[idx] = _full[idx];
+				++mismatched;
+			}
+		}
+	}
+
+	if (mismatched > 0) {
+		++_mismatchFrames;
+		_mismatchSamples += mismatched;
+	}
+}
+
+} // namespace stappler::xenolith::app
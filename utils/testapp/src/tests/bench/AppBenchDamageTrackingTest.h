@@ -0,0 +1,104 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef TEST_SRC_TESTS_BENCH_APPBENCHDAMAGETRACKINGTEST_H_
+#define TEST_SRC_TESTS_BENCH_APPBENCHDAMAGETRACKINGTEST_H_
+
+#include "AppBenchTest.h"
+
+namespace stappler::xenolith::app {
+
+// Frame cost of a mostly-static scene with damage tracking disabled and enabled, then
+// verification run: the scene is rasterized on CPU, and the image, updated only within
+// frame damage, is compared with full redraw of every frame;
+// with `--headless` the frames are rendered by the null device
+class BenchDamageTrackingTest : public BenchTest {
+public:
+	static constexpr uint32_t GridSize = 16;
+	static constexpr uint32_t AnimatedCount = 8;
+	static constexpr uint32_t WarmupFrames = 60;
+	static constexpr uint32_t MeasuredFrames = 600;
+	static constexpr uint32_t VerifiedFrames = 240;
+	static constexpr uint32_t SampleGrid = 128;
+
+	enum class Run {
+		TrackingDisabled,
+		TrackingEnabled,
+		Verification,
+		Max
+	};
+
+	virtual ~BenchDamageTrackingTest() { }
+
+	virtual bool init() override;
+
+	virtual void handleExit() override;
+	virtual void handleContentSizeDirty() override;
+
+	virtual void update(const UpdateTime &) override;
+
+	virtual bool visitDraw(FrameInfo &, NodeVisitFlags parentFlags) override;
+
+protected:
+	using BenchTest::init;
+
+	virtual void performBenchmark(DoneCallback &&done) override;
+
+	void updateAnimation();
+
+	void startRun(Run);
+	void finalizeRun();
+	void finalizeBenchmark();
+
+	// draws layers into samples, as full redraw does
+	void rasterize(Vector<Color4F> &) const;
+	void verifyFrame(const FrameDamage &);
+
+	Node *_field = nullptr;
+	Vector<Layer *> _layers;
+	Vector<Layer *> _animated;
+	Size2 _cell;
+
+	DoneCallback _done;
+	StringStream _out;
+	Run _run = Run::TrackingDisabled;
+	bool _initialTracking = false;
+	uint32_t _animFrame = 0;
+	uint32_t _frame = 0;
+	uint64_t _startTime = 0;
+	uint64_t _lastTime = 0;
+	double _sceneTime = 0.0;
+	double _damagedArea = 0.0;
+	uint32_t _drawnFrames = 0;
+	uint32_t _fullFrames = 0;
+
+	// verification state: image with partial updates and full redraw of the current frame
+	Rect _sampleRect;
+	Vector<Color4F> _tracked;
+	Vector<Color4F> _full;
+	uint32_t _mismatchFrames = 0;
+	uint32_t _mismatchSamples = 0;
+};
+
+} // namespace stappler::xenolith::app
+
+#endif /* TEST_SRC_TESTS_BENCH_APPBENCHDAMAGETRACKINGTEST_H_ */
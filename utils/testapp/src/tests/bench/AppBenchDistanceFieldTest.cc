@@ -0,0 +1,238 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "AppBenchDistanceFieldTest.h"
+#include "XLFontDistanceField.h"
+#include "XLDirector.h"
+
+namespace stappler::xenolith::app {
+
+static constexpr uint32_t BenchDistanceFieldSize = 32;
+static constexpr uint32_t BenchDistanceFieldSamples = 8;
+static constexpr uint32_t BenchDistanceFieldIterations = 1'000;
+static constexpr float BenchDistanceFieldMaxError = 1.0f;
+
+// anti-aliased disk with center, not aligned to pixel grid, coverage from supersampling
+static Bytes BenchDistanceField_makeDisk(uint32_t size, Vec2 center, float radius) {
+	Bytes ret;
+	ret.resize(size * size);
+	for (uint32_t y = 0; y < size; ++y) {
+		for (uint32_t x = 0; x < size; ++x) {
+			uint32_t covered = 0;
+			for (uint32_t sy = 0; sy < BenchDistanceFieldSamples; ++sy) {
+				for (uint32_t sx = 0; sx < BenchDistanceFieldSamples; ++sx) {
+					auto p = Vec2(x + (sx + 0.5f) / BenchDistanceFieldSamples,
+							y + (sy + 0.5f) / BenchDistanceFieldSamples);
+					if (p.distance(center) <= radius) {
+						++covered;
+					}
+				}
+			}
+			ret[y * size + x] = uint8_t(covered * 255
+					/ (BenchDistanceFieldSamples * BenchDistanceFieldSamples));
+		}
+	}
+	return ret;
+}
+
+bool BenchDistanceFieldTest::init() {
+	if (!BenchTest::init(LayoutName::BenchDistanceFieldTest,
+				"Distance field glyphs: field accuracy and atlas updates on zoom")) {
+		return false;
+	}
+
+	_label = addChild(Rc<Label>::create(), ZOrder(1));
+	_label->setFontSize(20);
+	_label->setAnchorPoint(Anchor::Middle);
+	_label->setString("The quick brown fox jumps over the lazy dog 0123456789");
+
+	scheduleUpdate();
+
+	return true;
+}
+
+void BenchDistanceFieldTest::handleExit() {
+	stopAllActions();
+	if (_done) {
+		_done(false, "Benchmark was interrupted");
+		_done = nullptr;
+	}
+
+	BenchTest::handleExit();
+}
+
+void BenchDistanceFieldTest::handleContentSizeDirty() {
+	BenchTest::handleContentSizeDirty();
+
+	_label->setPosition(Vec2(_contentSize.width / 2.0f, _contentSize.height / 3.0f));
+}
+
+void BenchDistanceFieldTest::update(const UpdateTime &time) {
+	BenchTest::update(time);
+
+	if (!_zooming) {
+		return;
+	}
+
+	// zoom in and out with the label transform: 0.5x - 3x
+	auto t = float(_frame % 120) / 120.0f;
+	_label->setScale(1.75f - 1.25f * std::cos(t * 2.0f * numbers::pi));
+
+	++_frame;
+	if (_frame == WarmupFrames) {
+		auto fc = _director->getApplication()->getExtension<font::FontController>();
+		_stats = fc->getStats();
+	} else if (_frame == WarmupFrames + MeasuredFrames) {
+		finalizeBenchmark();
+	}
+}
+
+void BenchDistanceFieldTest::performBenchmark(DoneCallback &&done) {
+	_done = sp::move(done);
+	_report.clear();
+	_frame = 0;
+
+	// field check runs on a worker, then zoom runs on the app thread with frames
+	BenchTest::performBenchmark([this, app = Rc<AppThread>(_director->getApplication())](
+										bool success, String &&report) mutable {
+		app->performOnAppThread([this, success, report = sp::move(report)]() mutable {
+			if (!_done) {
+				return;
+			}
+
+			if (!success) {
+				auto done = sp::move(_done);
+				_done = nullptr;
+				done(false, sp::move(report));
+				return;
+			}
+
+			_report = sp::move(report);
+			_zooming = true;
+			runAction(Rc<RenderContinuously>::create(), "BenchDistanceFieldTest"_tag);
+		}, this);
+	});
+}
+
+bool BenchDistanceFieldTest::runBenchmark(StringStream &out) {
+	const auto radius = uint32_t(font::config::FontDistanceFieldRadius);
+	const auto fieldSize = BenchDistanceFieldSize + radius * 2;
+	const auto center = Vec2(15.3f, 16.7f);
+	const auto diskRadius = 11.6f;
+
+	auto bitmap = BenchDistanceField_makeDisk(BenchDistanceFieldSize, center, diskRadius);
+
+	Bytes field;
+	if (!font::makeDistanceField(field, bitmap.data(), BenchDistanceFieldSize,
+				BenchDistanceFieldSize, int32_t(BenchDistanceFieldSize), radius)
+			|| field.size() != fieldSize * fieldSize) {
+		out << "Fail to build distance field\n";
+		return false;
+	}
+
+	// compare with analytic distance where field is not clamped
+	float maxError = 0.0f;
+	double sumError = 0.0;
+	uint32_t samples = 0;
+	for (uint32_t y = 0; y < fieldSize; ++y) {
+		for (uint32_t x = 0; x < fieldSize; ++x) {
+			auto p = Vec2(x + 0.5f - radius, y + 0.5f - radius);
+			auto expected = p.distance(center) - diskRadius;
+			if (std::abs(expected) > float(radius) - 1.0f) {
+				continue;
+			}
+
+			auto value = (0.5f - float(field[y * fieldSize + x]) / 255.0f) * float(radius * 2);
+			auto error = std::abs(value - expected);
+			maxError = std::max(maxError, error);
+			sumError += error;
+			++samples;
+		}
+	}
+
+	out << "Field: " << fieldSize << "x" << fieldSize << ", radius: " << radius
+		<< ", samples: " << samples << "\n";
+	out << "Distance error: " << sumError / double(samples) << " px avg, " << maxError
+		<< " px max\n";
+
+	if (samples == 0 || maxError > BenchDistanceFieldMaxError) {
+		out << "Distance error exceeds " << BenchDistanceFieldMaxError << " px\n";
+		return false;
+	}
+
+	// bottom-up bitmap with negative pitch should give the same field
+	Bytes flipped;
+	flipped.resize(bitmap.size());
+	for (uint32_t y = 0; y < BenchDistanceFieldSize; ++y) {
+		memcpy(flipped.data() + (BenchDistanceFieldSize - 1 - y) * BenchDistanceFieldSize,
+				bitmap.data() + y * BenchDistanceFieldSize, BenchDistanceFieldSize);
+	}
+
+	Bytes flippedField;
+	font::makeDistanceField(flippedField, flipped.data(), BenchDistanceFieldSize,
+			BenchDistanceFieldSize, -int32_t(BenchDistanceFieldSize), radius);
+	if (flippedField != field) {
+		out << "Field for bottom-up bitmap differs\n";
+		return false;
+	}
+
+	auto time = measureBenchmark(BenchDistanceFieldIterations, [&](size_t) {
+		font::makeDistanceField(field, bitmap.data(), BenchDistanceFieldSize,
+				BenchDistanceFieldSize, int32_t(BenchDistanceFieldSize), radius);
+	});
+
+	out << "Build time: " << time << " mcs per glyph\n";
+	return true;
+}
+
+void BenchDistanceFieldTest::finalizeBenchmark() {
+	stopAllActionsByTag("BenchDistanceFieldTest"_tag);
+	_zooming = false;
+	_label->setScale(1.0f);
+
+	auto fc = _director->getApplication()->getExtension<font::FontController>();
+	auto stats = fc->getStats();
+	auto distanceField = fc->getRenderMode() == font::FontRenderMode::DistanceField;
+
+	auto updates = stats.atlasUpdates - _stats.atlasUpdates;
+	auto glyphs = stats.requestedGlyphs - _stats.requestedGlyphs;
+
+	StringStream out;
+	out << _report;
+	out << "Render mode: " << (distanceField ? "distance field" : "coverage")
+		<< ", zoom frames: " << MeasuredFrames << "\n";
+	out << "Atlas updates: " << updates << ", requested glyphs: " << glyphs
+		<< ", layouts: " << stats.layouts << "\n";
+
+	// coverage glyphs are rasterized for each scale, it's reported only for comparison
+	auto success = true;
+	if (distanceField && updates > 0) {
+		out << "Zoom should not update atlas with distance field glyphs\n";
+		success = false;
+	}
+
+	auto done = sp::move(_done);
+	_done = nullptr;
+	done(success, out.str());
+}
+
+} // namespace stappler::xenolith::app
@@ -0,0 +1,67 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef TEST_SRC_TESTS_BENCH_APPBENCHDISTANCEFIELDTEST_H_
+#define TEST_SRC_TESTS_BENCH_APPBENCHDISTANCEFIELDTEST_H_
+
+#include "AppBenchTest.h"
+#include "XLFontController.h"
+
+namespace stappler::xenolith::app {
+
+// Distance field glyphs: field, built from anti-aliased coverage, should match analytic distance
+// within a pixel; then label is zoomed with its transform, and atlas updates are counted. With
+// distance field render mode zoom should not request any new glyphs
+class BenchDistanceFieldTest : public BenchTest {
+public:
+	static constexpr uint32_t WarmupFrames = 30;
+	static constexpr uint32_t MeasuredFrames = 240;
+
+	virtual ~BenchDistanceFieldTest() { }
+
+	virtual bool init() override;
+
+	virtual void handleExit() override;
+	virtual void handleContentSizeDirty() override;
+
+	virtual void update(const UpdateTime &) override;
+
+protected:
+	using BenchTest::init;
+
+	virtual void performBenchmark(DoneCallback &&done) override;
+	virtual bool runBenchmark(StringStream &out) override;
+
+	void finalizeBenchmark();
+
+	Label *_label = nullptr;
+
+	DoneCallback _done;
+	String _report;
+	uint32_t _frame = 0;
+	bool _zooming = false;
+	font::FontController::Stats _stats;
+};
+
+} // namespace stappler::xenolith::app
+
+#endif /* TEST_SRC_TESTS_BENCH_APPBENCHDISTANCEFIELDTEST_H_ */
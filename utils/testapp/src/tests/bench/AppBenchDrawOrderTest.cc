@@ -0,0 +1,158 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "AppBenchDrawOrderTest.h"
+#include "XL2dCommandList.h"
+
+namespace stappler::xenolith::app {
+
+static constexpr uint32_t BenchDrawOrderCommands = 50'000;
+static constexpr uint32_t BenchDrawOrderMaterials = 48;
+static constexpr uint32_t BenchDrawOrderStates = 16;
+static constexpr uint32_t BenchDrawOrderIterations = 20;
+
+// Order with nested maps, as write plans were built before: level, then z-path for transparent
+// level, then material and state, commands with the same state in submission order
+static void BenchDrawOrder_mapOrder(SpanView<basic2d::DrawOrder::Command> commands,
+		memory::vector<uint32_t> &result) {
+	using StateMap = memory::map<StateId, memory::vector<uint32_t>>;
+	using MaterialMap = memory::map<uint64_t, StateMap>;
+
+	MaterialMap solid;
+	MaterialMap surface;
+	memory::map<SpanView<ZOrder>, MaterialMap, ZOrderLess> transparent;
+
+	for (uint32_t i = 0; i < commands.size(); ++i) {
+		auto &it = commands[i];
+		MaterialMap *target = nullptr;
+		switch (it.level) {
+		case 0: target = &solid; break;
+		case 1: target = &surface; break;
+		default: target = &transparent[it.info->zPath]; break;
+		}
+		(*target)[it.material][it.info->state].emplace_back(i);
+	}
+
+	auto push = [&](const MaterialMap &map) {
+		for (auto &m : map) {
+			for (auto &s : m.second) {
+				result.insert(result.end(), s.second.begin(), s.second.end());
+			}
+		}
+	};
+
+	result.clear();
+	result.reserve(commands.size());
+	push(solid);
+	push(surface);
+	for (auto &it : transparent) { push(it.second); }
+}
+
+bool BenchDrawOrderTest::init() {
+	if (!BenchTest::init(LayoutName::BenchDrawOrderTest, "Draw order for 50k commands")) {
+		return false;
+	}
+	return true;
+}
+
+bool BenchDrawOrderTest::runBenchmark(StringStream &out) {
+	// scene-like command stream: two commands for each node, nodes in tree with fan-out 16
+	Vector<Vector<ZOrder>> paths;
+	Vector<basic2d::CmdInfo> infos;
+	paths.resize(BenchDrawOrderCommands);
+	infos.resize(BenchDrawOrderCommands);
+
+	Vector<basic2d::DrawOrder::Command> commands;
+	commands.reserve(BenchDrawOrderCommands);
+
+	for (uint32_t i = 0; i < BenchDrawOrderCommands; ++i) {
+		auto node = i / 2;
+		for (auto n = node; n > 0; n /= 16) { paths[i].emplace(paths[i].begin(), ZOrder(n % 16)); }
+
+		auto material = (i * 7) % BenchDrawOrderMaterials;
+		infos[i].zPath = paths[i];
+		infos[i].material = core::MaterialId(material + 1);
+		infos[i].state = StateId((i / 32) % BenchDrawOrderStates);
+
+		// 60% solid, 20% surface and 20% transparent commands
+		auto level = uint8_t((i % 5 < 3) ? 0 : (i % 5 == 3 ? 1 : 2));
+		commands.emplace_back(basic2d::DrawOrder::Command{&infos[i],
+			(uint64_t(material % 4) << 32) | uint64_t(infos[i].material), level, level == 2});
+	}
+
+	auto pool = memory::pool::create();
+
+	bool valid = true;
+	uint32_t uniquePaths = 0;
+
+	auto mapTime = measureBenchmark(BenchDrawOrderIterations, [&](size_t) {
+		auto p = memory::pool::create(pool);
+		memory::perform([&] {
+			memory::vector<uint32_t> order;
+			BenchDrawOrder_mapOrder(commands, order);
+		}, p);
+		memory::pool::destroy(p);
+	});
+
+	auto sortTime = measureBenchmark(BenchDrawOrderIterations, [&](size_t) {
+		auto p = memory::pool::create(pool);
+		memory::perform([&] {
+			basic2d::DrawOrder order;
+			order.sort(commands);
+			uniquePaths = uint32_t(order.paths.size());
+		}, p);
+		memory::pool::destroy(p);
+	});
+
+	// both methods should produce the same order
+	memory::perform([&] {
+		memory::vector<uint32_t> expected;
+		BenchDrawOrder_mapOrder(commands, expected);
+
+		basic2d::DrawOrder order;
+		order.sort(commands);
+
+		if (order.keys.size() != expected.size()) {
+			valid = false;
+		} else {
+			for (size_t i = 0; i < expected.size(); ++i) {
+				if (order.keys[i].second != expected[i]) {
+					valid = false;
+					break;
+				}
+			}
+		}
+	}, pool);
+
+	memory::pool::destroy(pool);
+
+	out << "Commands: " << BenchDrawOrderCommands << ", z-paths: " << uniquePaths
+		<< ", materials: " << BenchDrawOrderMaterials << ", states: " << BenchDrawOrderStates
+		<< "\n";
+	out << "Nested maps: " << mapTime / 1'000.0 << " ms\n";
+	out << "DrawOrder: " << sortTime / 1'000.0 << " ms\n";
+	out << "Order: " << (valid ? "matches" : "DIFFERS") << "\n";
+
+	return valid;
+}
+
+} // namespace stappler::xenolith::app
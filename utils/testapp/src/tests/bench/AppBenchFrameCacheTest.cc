@@ -0,0 +1,262 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "AppBenchFrameCacheTest.h"
+#include "XLCoreFrameCache.h"
+#include "XLCoreImageStorage.h"
+#include "XLDirector.h"
+
+namespace stappler::xenolith::app {
+
+// Objects without backend handles: device is never touched, so only FrameCache logic is measured
+
+class BenchFrameCacheImage : public core::ImageObject {
+public:
+	virtual ~BenchFrameCacheImage() = default;
+
+	bool init(core::Device &dev, const core::ImageInfoData &info) {
+		_info = info;
+		return core::ImageObject::init(dev, nullptr, core::ObjectType::Image,
+				core::ObjectHandle::zero(), nullptr);
+	}
+};
+
+class BenchFrameCacheImageView : public core::ImageView {
+public:
+	virtual ~BenchFrameCacheImageView() = default;
+
+	bool init(core::Device &dev, core::ImageObject *image, const core::ImageViewInfo &info) {
+		_info = image->getViewInfo(info);
+		_image = image;
+		return core::ImageView::init(dev, nullptr, core::ObjectType::ImageView,
+				core::ObjectHandle::zero());
+	}
+};
+
+class BenchFrameCacheRenderPass : public core::RenderPass {
+public:
+	virtual ~BenchFrameCacheRenderPass() = default;
+
+	bool init(core::Device &dev) {
+		return core::RenderPass::init(dev, nullptr, core::ObjectType::RenderPass,
+				core::ObjectHandle::zero(), nullptr);
+	}
+};
+
+class BenchFrameCacheFramebuffer : public core::Framebuffer {
+public:
+	virtual ~BenchFrameCacheFramebuffer() = default;
+
+	bool init(core::Device &dev, core::RenderPass *pass, SpanView<Rc<core::ImageView>> views) {
+		auto extent = views.front()->getFramebufferExtent();
+		for (auto &it : views) {
+			_viewIds.emplace_back(it->getIndex());
+			_imageViews.emplace_back(it);
+		}
+		_renderPass = pass;
+		_extent = Extent2(extent.width, extent.height);
+		_layerCount = extent.depth;
+		return core::Framebuffer::init(dev, nullptr, core::ObjectType::Framebuffer,
+				core::ObjectHandle::zero());
+	}
+};
+
+class BenchFrameCacheDevice : public core::Device {
+public:
+	virtual ~BenchFrameCacheDevice() = default;
+
+	bool init() { return core::Device::init(nullptr); }
+
+	virtual Rc<core::Framebuffer> makeFramebuffer(const core::QueuePassData *pass,
+			SpanView<Rc<core::ImageView>> views) override {
+		++framebuffers;
+		return Rc<BenchFrameCacheFramebuffer>::create(*this, pass->impl.get(), views);
+	}
+
+	virtual Rc<ImageStorage> makeImage(StringView, const core::ImageInfoData &info) override {
+		++images;
+		return Rc<ImageStorage>::create(Rc<BenchFrameCacheImage>::create(*this, info));
+	}
+
+	virtual Rc<core::ImageView> makeImageView(const Rc<core::ImageObject> &img,
+			const core::ImageViewInfo &info) override {
+		return Rc<BenchFrameCacheImageView>::create(*this, img.get(), info);
+	}
+
+	uint32_t framebuffers = 0;
+	uint32_t images = 0;
+
+protected:
+	using core::Device::init;
+};
+
+// Frame with 8 passes, every pass uses color and depth attachments
+static constexpr uint32_t BenchFrameCachePasses = 8;
+static constexpr uint32_t BenchFrameCacheFrames = 100'000;
+
+bool BenchFrameCacheTest::init() {
+	if (!BenchTest::init(LayoutName::BenchFrameCacheTest,
+				"FrameCache lookup cost on mock device")) {
+		return false;
+	}
+	return true;
+}
+
+bool BenchFrameCacheTest::runBenchmark(StringStream &out) {
+	auto loop = _director->getGlLoop();
+	auto device = Rc<BenchFrameCacheDevice>::create();
+	auto cache = Rc<core::FrameCache>::create(*loop, *device);
+
+	auto pool = memory::pool::create_tagged("BenchFrameCacheTest");
+
+	bool success = true;
+	mem_pool::perform([&] {
+		struct PassData {
+			core::QueuePassData data;
+			core::ImageInfoData color;
+			core::ImageInfoData depth;
+			uint64_t colorId;
+			uint64_t depthId;
+			Vector<Rc<core::ImageView>> views;
+		};
+
+		Vector<PassData> passes;
+		passes.resize(BenchFrameCachePasses);
+
+		uint64_t attachmentId = 1;
+		for (uint32_t i = 0; i < BenchFrameCachePasses; ++i) {
+			auto &pass = passes[i];
+			pass.data.impl = Rc<BenchFrameCacheRenderPass>::create(*device);
+			cache->addRenderPass(pass.data.impl->getIndex());
+
+			// half of passes render in lower resolution
+			auto extent = (i % 2) ? Extent3(1'024, 768, 1) : Extent3(1'920, 1'080, 1);
+
+			// static hint disables semaphore rearm, so no loop objects are created
+			pass.color.extent = extent;
+			pass.color.format = core::ImageFormat::R8G8B8A8_UNORM;
+			pass.color.usage = core::ImageUsage::ColorAttachment | core::ImageUsage::Sampled;
+			pass.color.hints = core::ImageHints::Static;
+
+			pass.depth.extent = extent;
+			pass.depth.format = core::ImageFormat::D32_SFLOAT;
+			pass.depth.usage = core::ImageUsage::DepthStencilAttachment;
+			pass.depth.hints = core::ImageHints::Static;
+
+			pass.colorId = attachmentId++;
+			pass.depthId = attachmentId++;
+			cache->addAttachment(pass.colorId);
+			cache->addAttachment(pass.depthId);
+		}
+
+		core::ImageViewInfo viewInfo;
+		SpanView<core::ImageViewInfo> views(&viewInfo, 1);
+
+		auto runFrame = [&] {
+			for (auto &pass : passes) {
+				auto color = cache->acquireImage(pass.colorId, pass.color, views);
+				auto depth = cache->acquireImage(pass.depthId, pass.depth, views);
+
+				pass.views.clear();
+				pass.views.emplace_back(color->getView(viewInfo));
+				pass.views.emplace_back(depth->getView(viewInfo));
+
+				auto fb = cache->acquireFramebuffer(&pass.data, pass.views);
+				cache->releaseFramebuffer(move(fb));
+				cache->releaseImage(move(color));
+				cache->releaseImage(move(depth));
+			}
+		};
+
+		// warmup: all objects are created on the first frame
+		runFrame();
+
+		auto createdFramebuffers = device->framebuffers;
+		auto createdImages = device->images;
+
+		auto frameCache = measureBenchmark(BenchFrameCacheFrames, [&](size_t) { runFrame(); });
+
+		if (device->framebuffers != createdFramebuffers || device->images != createdImages) {
+			out << "Objects were recreated after warmup: framebuffers: " << device->framebuffers
+				<< "/" << createdFramebuffers << ", images: " << device->images << "/"
+				<< createdImages << "\n";
+			success = false;
+		}
+
+		// Reference: ordered maps with heap-allocated keys, as FrameCache did before hashing
+		Map<Vector<uint64_t>, Vector<Rc<core::Framebuffer>>> framebuffers;
+		Map<core::ImageInfoData, Vector<Rc<core::ImageStorage>>> images;
+
+		auto runMapFrame = [&] {
+			for (auto &pass : passes) {
+				for (auto info : {&pass.color, &pass.depth}) {
+					auto &vec = images[*info];
+					if (!vec.empty()) {
+						auto img = move(vec.back());
+						vec.pop_back();
+						vec.emplace_back(move(img));
+					} else {
+						vec.emplace_back(device->makeImage("", *info));
+					}
+				}
+
+				auto fbExtent = pass.views.front()->getFramebufferExtent();
+				Vector<uint64_t> key;
+				key.reserve(pass.views.size() + 2);
+				key.emplace_back(pass.data.impl->getIndex());
+				key.emplace_back(uint64_t(fbExtent.height) << 24 | uint64_t(fbExtent.width));
+				for (auto &it : pass.views) { key.emplace_back(it->getIndex()); }
+
+				auto &vec = framebuffers[key];
+				if (!vec.empty()) {
+					auto fb = move(vec.back());
+					vec.pop_back();
+					vec.emplace_back(move(fb));
+				} else {
+					vec.emplace_back(device->makeFramebuffer(&pass.data, pass.views));
+				}
+			}
+		};
+
+		runMapFrame();
+
+		auto orderedMap = measureBenchmark(BenchFrameCacheFrames, [&](size_t) { runMapFrame(); });
+
+		out << std::setprecision(4) << "Frames: " << BenchFrameCacheFrames
+			<< ", passes: " << BenchFrameCachePasses << "\n"
+			<< "FrameCache: " << frameCache << " us/frame\n"
+			<< "Ordered map: " << orderedMap << " us/frame (lookup only)\n";
+
+		for (auto &it : passes) {
+			it.views.clear();
+			it.data.impl = nullptr;
+		}
+	}, pool);
+
+	cache->invalidate();
+	cache->clear();
+	memory::pool::destroy(pool);
+
+	return success;
+}
+
+} // namespace stappler::xenolith::app
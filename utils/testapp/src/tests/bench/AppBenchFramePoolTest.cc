@@ -0,0 +1,112 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+
+#include "AppBenchFramePoolTest.h"
+#include "XLCoreFramePool.h"
+
+namespace stappler::xenolith::app {
+
+static constexpr uint32_t BenchFramePoolFrames = 2'000;
+static constexpr uint32_t BenchFramePoolAllocations = 4'096;
+
+// frames, that hold their pools while next frame is prepared
+static constexpr uint32_t BenchFramePoolInFlight = 2;
+
+// Frame-like allocation pattern: many small objects and some larger arrays
+static void BenchFramePool_fill(memory::pool_t *pool) {
+	for (uint32_t i = 0; i < BenchFramePoolAllocations; ++i) {
+		auto size = (i % 64 == 0) ? 4_KiB : 16 + (i % 16) * 24;
+		auto mem = memory::pool::palloc(pool, size);
+		::memset(mem, 0, 16);
+	}
+}
+
+bool BenchFramePoolTest::init() {
+	if (!BenchTest::init(LayoutName::BenchFramePoolTest, "Frame memory pools reuse")) {
+		return false;
+	}
+	return true;
+}
+
+bool BenchFramePoolTest::runBenchmark(StringStream &out) {
+	auto alloc = Rc<AllocRef>::alloc();
+
+	// pools are kept alive for BenchFramePoolInFlight frames, as frames do in pipeline
+	Vector<Rc<PoolRef>> inFlight;
+	inFlight.resize(BenchFramePoolInFlight);
+
+	auto created = measureBenchmark(BenchFramePoolFrames, [&](size_t i) {
+		auto ref = Rc<PoolRef>::alloc(alloc);
+		BenchFramePool_fill(ref->getPool());
+		inFlight[i % BenchFramePoolInFlight] = move(ref);
+	});
+
+	for (auto &it : inFlight) { it = nullptr; }
+
+	auto ring = Rc<core::FramePoolRing>::create(Rc<AllocRef>::alloc());
+
+	auto reused = measureBenchmark(BenchFramePoolFrames, [&](size_t i) {
+		auto ref = ring->acquireRef();
+		BenchFramePool_fill(ref->getPool());
+		inFlight[i % BenchFramePoolInFlight] = move(ref);
+	});
+
+	for (auto &it : inFlight) { it = nullptr; }
+
+	auto refStats = ring->getStats();
+
+	// scratch pools, as used by vertex processing tasks
+	auto rawCreated = measureBenchmark(BenchFramePoolFrames, [&](size_t) {
+		auto pool = memory::pool::create();
+		BenchFramePool_fill(pool);
+		memory::pool::destroy(pool);
+	});
+
+	auto rawRing = Rc<core::FramePoolRing>::create(Rc<AllocRef>::alloc());
+	auto rawReused = measureBenchmark(BenchFramePoolFrames, [&](size_t) {
+		auto pool = rawRing->acquire();
+		BenchFramePool_fill(pool);
+		rawRing->release(pool);
+	});
+
+	auto rawStats = rawRing->getStats();
+
+	out << "Frames: " << BenchFramePoolFrames << ", allocations per frame: "
+		<< BenchFramePoolAllocations << "\n";
+	out << "PoolRef per frame: " << created << " us, ring: " << reused << " us\n";
+	out << "Scratch pool per frame: " << rawCreated << " us, ring: " << rawReused << " us\n";
+	out << "Ring pools: " << refStats.pools << " (" << refStats.created << " created of "
+		<< refStats.acquired << "), peak frame bytes: " << refStats.peakBytes << "\n";
+	out << "Scratch ring pools: " << rawStats.pools << " (" << rawStats.created
+		<< " created of " << rawStats.acquired << ")\n";
+
+	// ring can grow only up to frames in flight, then pools should be reused
+	if (refStats.created > BenchFramePoolInFlight + 1 || rawStats.created > 1) {
+		out << "Ring created pools in steady state\n";
+		return false;
+	}
+
+	return true;
+}
+
+} // namespace stappler::xenolith::app
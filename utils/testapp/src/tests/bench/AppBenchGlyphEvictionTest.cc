@@ -0,0 +1,159 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "AppBenchGlyphEvictionTest.h"
+#include "XLFontController.h"
+#include "XLDirector.h"
+
+namespace stappler::xenolith::app {
+
+// sizes, that are not used by other labels of the test app
+static uint16_t BenchGlyphEviction_sizes[] = {11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31, 33};
+
+bool BenchGlyphEvictionTest::init() {
+	if (!BenchTest::init(LayoutName::BenchGlyphEvictionTest,
+				"Glyph eviction: tracked glyphs with minimal atlas budget")) {
+		return false;
+	}
+
+	// printable ASCII and basic Cyrillic
+	for (char16_t c = u'!'; c <= u'~'; ++c) { _chars.push_back(c); }
+	for (char16_t c = u'\u0410'; c <= u'\u044F'; ++c) { _chars.push_back(c); }
+
+	_label = addChild(Rc<Label>::create(), ZOrder(1));
+	_label->setAnchorPoint(Anchor::Middle);
+	_label->setVisible(false);
+
+	scheduleUpdate();
+
+	return true;
+}
+
+void BenchGlyphEvictionTest::handleExit() {
+	stopAllActions();
+	if (_done) {
+		finalizeBenchmark(false);
+	}
+
+	BenchTest::handleExit();
+}
+
+void BenchGlyphEvictionTest::handleContentSizeDirty() {
+	BenchTest::handleContentSizeDirty();
+
+	_label->setPosition(Vec2(_contentSize.width / 2.0f, _contentSize.height / 3.0f));
+}
+
+void BenchGlyphEvictionTest::update(const UpdateTime &time) {
+	BenchTest::update(time);
+
+	if (!_done) {
+		return;
+	}
+
+	auto fc = _director->getApplication()->getExtension<font::FontController>();
+	auto stats = fc->getStats();
+	if (stats.trackedGlyphs < _maxTrackedGlyphs || stats.evictedGlyphs > 0) {
+		_evicted = true;
+	}
+	_maxTrackedGlyphs = std::max(_maxTrackedGlyphs, stats.trackedGlyphs);
+	_maxEvictedGlyphs = std::max(_maxEvictedGlyphs, stats.evictedGlyphs);
+
+	++_frame;
+	if (_frame == StepFrames * Steps) {
+		finalizeBenchmark(true);
+	} else if (_frame % StepFrames == 0) {
+		showStep(_frame / StepFrames);
+	}
+}
+
+void BenchGlyphEvictionTest::performBenchmark(DoneCallback &&done) {
+	auto fc = _director->getApplication()->getExtension<font::FontController>();
+	auto stats = fc->getStats();
+
+	_done = sp::move(done);
+	_frame = 0;
+	_atlasBudget = fc->getAtlasBudget();
+	_initialGlyphs = _maxTrackedGlyphs = stats.trackedGlyphs;
+	_maxEvictedGlyphs = 0;
+	_evicted = false;
+	_shownGlyphs.clear();
+
+	fc->setAtlasBudget(AtlasBudget);
+
+	_label->setVisible(true);
+	showStep(0);
+
+	// frames are requested continuously, even with render-on-demand presentation
+	runAction(Rc<RenderContinuously>::create(), "BenchGlyphEvictionTest"_tag);
+}
+
+void BenchGlyphEvictionTest::showStep(uint32_t step) {
+	constexpr size_t NSizes = sizeof(BenchGlyphEviction_sizes) / sizeof(uint16_t);
+
+	// window over the chars moves with every step, so most of steps show new glyphs
+	auto size = BenchGlyphEviction_sizes[step % NSizes];
+	WideString str;
+	for (uint32_t i = 0; i < StepChars; ++i) {
+		auto c = _chars[(step * StepChars + i) % _chars.size()];
+		str.push_back(c);
+		_shownGlyphs.emplace((uint64_t(size) << 32) | uint64_t(c));
+	}
+
+	_label->setFontSize(size);
+	_label->setString(WideStringView(str));
+}
+
+void BenchGlyphEvictionTest::finalizeBenchmark(bool success) {
+	stopAllActionsByTag("BenchGlyphEvictionTest"_tag);
+	_label->setVisible(false);
+
+	auto fc = _director->getApplication()->getExtension<font::FontController>();
+	auto stats = fc->getStats();
+	fc->setAtlasBudget(_atlasBudget);
+
+	auto tracked = stats.trackedGlyphs - std::min(stats.trackedGlyphs, _initialGlyphs);
+
+	StringStream out;
+	out << "Steps: " << Steps << ", glyphs shown: " << _shownGlyphs.size() << "\n";
+	out << "Tracked glyphs: " << stats.trackedGlyphs << " (" << tracked << " new, "
+		<< _maxTrackedGlyphs << " max), evicted: " << stats.evictedGlyphs << " ("
+		<< _maxEvictedGlyphs << " max)\n";
+	out << "Atlas updates: " << stats.atlasUpdates << ", requested glyphs: "
+		<< stats.requestedGlyphs << ", layouts: " << stats.layouts << "\n";
+
+	if (!success) {
+		out << "Benchmark was interrupted\n";
+	} else if (!_evicted) {
+		out << "Eviction was not triggered\n";
+		success = false;
+	} else if (tracked >= _shownGlyphs.size()) {
+		out << "Evicted glyphs are still tracked\n";
+		success = false;
+	}
+
+	auto done = sp::move(_done);
+	_done = nullptr;
+	done(success, out.str());
+}
+
+} // namespace stappler::xenolith::app
@@ -0,0 +1,72 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef TEST_SRC_TESTS_BENCH_APPBENCHGLYPHEVICTIONTEST_H_
+#define TEST_SRC_TESTS_BENCH_APPBENCHGLYPHEVICTIONTEST_H_
+
+#include "AppBenchTest.h"
+
+namespace stappler::xenolith::app {
+
+// Glyph eviction: label shows new glyphs (chars and sizes) every few frames, while font atlas
+// budget is minimal. Glyphs, that were evicted, should not be tracked by font controller, so
+// number of tracked glyphs stays below the number of glyphs shown
+class BenchGlyphEvictionTest : public BenchTest {
+public:
+	static constexpr uint32_t StepFrames = 4;
+	static constexpr uint32_t Steps = 300;
+	static constexpr uint32_t StepChars = 24;
+	static constexpr size_t AtlasBudget = 1;
+
+	virtual ~BenchGlyphEvictionTest() { }
+
+	virtual bool init() override;
+
+	virtual void handleExit() override;
+	virtual void handleContentSizeDirty() override;
+
+	virtual void update(const UpdateTime &) override;
+
+protected:
+	using BenchTest::init;
+
+	virtual void performBenchmark(DoneCallback &&done) override;
+
+	void showStep(uint32_t);
+	void finalizeBenchmark(bool success);
+
+	Label *_label = nullptr;
+	WideString _chars;
+
+	DoneCallback _done;
+	uint32_t _frame = 0;
+	size_t _atlasBudget = 0;
+	size_t _initialGlyphs = 0;
+	size_t _maxTrackedGlyphs = 0;
+	size_t _maxEvictedGlyphs = 0;
+	bool _evicted = false;
+	Set<uint64_t> _shownGlyphs;
+};
+
+} // namespace stappler::xenolith::app
+
+#endif /* TEST_SRC_TESTS_BENCH_APPBENCHGLYPHEVICTIONTEST_H_ */
@@ -0,0 +1,291 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+
+#include "AppBenchHttpServer.h"
+
+#if LINUX || MACOS || ANDROID
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace stappler::xenolith::app {
+
+BenchHttpServer::~BenchHttpServer() { stop(); }
+
+String BenchHttpServer::getUrl(StringView path) const {
+	return toString("http://127.0.0.1:", _port, path);
+}
+
+void BenchHttpServer::setResource(StringView path, Resource &&res) {
+	std::unique_lock lock(_mutex);
+	_resources.insert_or_assign(path.str<Interface>(), sp::move(res));
+}
+
+bool BenchHttpServer::getResource(StringView path, Resource &res) const {
+	std::unique_lock lock(_mutex);
+	auto it = _resources.find(path);
+	if (it != _resources.end()) {
+		res = it->second;
+		return true;
+	}
+	return false;
+}
+
+uint32_t BenchHttpServer::getRequestCount(StringView path) const {
+	std::unique_lock lock(_mutex);
+	auto it = _requests.find(path);
+	return it != _requests.end() ? uint32_t(it->second.size()) : 0;
+}
+
+auto BenchHttpServer::getRequests(StringView path) const -> Vector<RequestHeaders> {
+	std::unique_lock lock(_mutex);
+	auto it = _requests.find(path);
+	return it != _requests.end() ? it->second : Vector<RequestHeaders>();
+}
+
+auto BenchHttpServer::makeResponse(StringView path, RequestHeaders &&headers) -> Response {
+	Resource res;
+	bool found = false;
+	bool disconnect = false;
+
+	do {
+		std::unique_lock lock(_mutex);
+		auto it = _resources.find(path);
+		if (it != _resources.end()) {
+			res = it->second;
+			found = true;
+			if (it->second.disconnects > 0) {
+				--it->second.disconnects;
+				disconnect = true;
+			}
+		}
+		_requests[path.str<Interface>()].emplace_back(headers);
+	} while (0);
+
+	if (!found) {
+		return Response{"HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n"};
+	}
+
+	if (res.delay.toMicros() > 0) {
+		std::this_thread::sleep_for(std::chrono::microseconds(res.delay.toMicros()));
+	}
+
+	auto header = [&](StringView name) -> StringView {
+		auto it = headers.find(name);
+		return it != headers.end() ? StringView(it->second) : StringView();
+	};
+
+	StringView status("200 OK");
+	BytesView body(res.data);
+	String contentRange;
+
+	if (!res.etag.empty() && header("if-none-match") == res.etag) {
+		status = StringView("304 Not Modified");
+		body = BytesView();
+	} else if (auto range = header("range"); !range.empty()
+			&& (header("if-range").empty() || header("if-range") == res.etag)) {
+		// single range: bytes=first-[last]
+		range.skipString("bytes=");
+		auto first = range.readInteger(10).get(-1);
+		range.skipChars<StringView::Chars<'-'>>();
+		auto last = range.empty() ? int64_t(res.data.size()) - 1 : range.readInteger(10).get(-1);
+		last = std::min(last, int64_t(res.data.size()) - 1);
+
+		if (first < 0 || first >= int64_t(res.data.size()) || last < first) {
+			status = StringView("416 Range Not Satisfiable");
+			body = BytesView();
+			contentRange = toString("bytes */", res.data.size());
+		} else {
+			status = StringView("206 Partial Content");
+			body = BytesView(res.data.data() + first, size_t(last - first + 1));
+			contentRange = toString("bytes ", first, "-", last, "/", res.data.size());
+		}
+	}
+
+	StringStream out;
+	out << "HTTP/1.1 " << status << "\r\n"
+		<< "Content-Length: " << body.size() << "\r\n"
+		<< "Connection: close\r\n";
+	if (!res.etag.empty()) {
+		out << "ETag: " << res.etag << "\r\n";
+	}
+	if (!contentRange.empty()) {
+		out << "Content-Range: " << contentRange << "\r\n";
+	}
+	for (auto &it : res.headers) { out << it.first << ": " << it.second << "\r\n"; }
+	out << "\r\n";
+
+	Response ret{String(), res.chunkSize, res.chunkDelay};
+	if (disconnect) {
+		ret.limit = size_t(out.str().size()) + std::min(res.disconnectAfter, body.size());
+	}
+
+	out << StringView((const char *)body.data(), body.size());
+	ret.data = out.str();
+	return ret;
+}
+
+#if LINUX || MACOS || ANDROID
+
+#ifdef MSG_NOSIGNAL
+static constexpr int BenchHttpServerSendFlags = MSG_NOSIGNAL;
+#else
+static constexpr int BenchHttpServerSendFlags = 0;
+#endif
+
+bool BenchHttpServer::init() {
+	_socket = ::socket(AF_INET, SOCK_STREAM, 0);
+	if (_socket < 0) {
+		return false;
+	}
+
+	struct sockaddr_in addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	addr.sin_port = 0; // any free port
+
+	socklen_t len = sizeof(addr);
+	if (::bind(_socket, (struct sockaddr *)&addr, sizeof(addr)) != 0
+			|| ::listen(_socket, 64) != 0
+			|| ::getsockname(_socket, (struct sockaddr *)&addr, &len) != 0) {
+		::close(_socket);
+		_socket = -1;
+		return false;
+	}
+
+	_port = ntohs(addr.sin_port);
+	_running = true;
+	_acceptThread = std::thread([this] { runAccept(); });
+	return true;
+}
+
+void BenchHttpServer::stop() {
+	if (!_running.exchange(false)) {
+		return;
+	}
+
+	if (_acceptThread.joinable()) {
+		_acceptThread.join();
+	}
+
+	::close(_socket);
+	_socket = -1;
+
+	Vector<std::thread> connections;
+	do {
+		std::unique_lock lock(_mutex);
+		connections = sp::move(_connections);
+	} while (0);
+
+	for (auto &it : connections) { it.join(); }
+}
+
+void BenchHttpServer::runAccept() {
+	while (_running) {
+		struct pollfd fd = {_socket, POLLIN, 0};
+		if (::poll(&fd, 1, 100) <= 0) {
+			continue;
+		}
+
+		auto conn = ::accept(_socket, nullptr, nullptr);
+		if (conn >= 0) {
+			std::unique_lock lock(_mutex);
+			_connections.emplace_back([this, conn] { runConnection(conn); });
+		}
+	}
+}
+
+void BenchHttpServer::runConnection(int fd) {
+	String request;
+	char buf[4'096];
+	while (request.find("\r\n\r\n") == String::npos && request.size() < 65'536) {
+		auto n = ::recv(fd, buf, sizeof(buf), 0);
+		if (n <= 0) {
+			::close(fd);
+			return;
+		}
+		request.append(buf, size_t(n));
+	}
+
+	StringView r(request);
+	auto method = r.readUntil<StringView::Chars<' '>>();
+	r.skipChars<StringView::Chars<' '>>();
+	auto path = r.readUntil<StringView::Chars<' '>>();
+	r.skipUntilString("\r\n");
+	r.skipString("\r\n");
+
+	RequestHeaders headers;
+	while (!r.empty() && !r.starts_with("\r\n")) {
+		auto line = r.readUntilString("\r\n");
+		r.skipString("\r\n");
+
+		auto name = line.readUntil<StringView::Chars<':'>>();
+		line.skipChars<StringView::Chars<':', ' '>>();
+		headers.emplace(string::tolower<Interface>(name), line.str<Interface>());
+	}
+
+	Response response;
+	if (method == "GET") {
+		response = makeResponse(path, sp::move(headers));
+	} else {
+		response.data = "HTTP/1.1 405 Method Not Allowed\r\nContent-Length: 0\r\n"
+						"Connection: close\r\n\r\n";
+	}
+
+	auto &out = response.data;
+	auto size = std::min(out.size(), response.limit);
+	auto chunk = response.chunkSize ? response.chunkSize : size;
+
+	size_t offset = 0;
+	while (offset < size) {
+		auto n = ::send(fd, out.data() + offset, std::min(chunk, size - offset),
+				BenchHttpServerSendFlags);
+		if (n <= 0) {
+			break;
+		}
+		offset += size_t(n);
+		if (response.chunkSize && offset < size && _running) {
+			std::this_thread::sleep_for(std::chrono::microseconds(response.chunkDelay.toMicros()));
+		}
+	}
+
+	::close(fd);
+}
+
+#else
+
+bool BenchHttpServer::init() { return false; }
+
+void BenchHttpServer::stop() { }
+
+void BenchHttpServer::runAccept() { }
+
+void BenchHttpServer::runConnection(int fd) { }
+
+#endif
+
+} // namespace stappler::xenolith::app
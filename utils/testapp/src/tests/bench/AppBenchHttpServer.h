@@ -0,0 +1,90 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+
+#ifndef TEST_SRC_TESTS_BENCH_APPBENCHHTTPSERVER_H_
+#define TEST_SRC_TESTS_BENCH_APPBENCHHTTPSERVER_H_
+
+#include "XLCommon.h" // IWYU pragma: keep
+#include <thread>
+
+namespace stappler::xenolith::app {
+
+// Minimal HTTP/1.1 server on loopback interface for network tests and benchmarks: serves
+// static resources with ETag revalidation and single byte ranges, each connection is handled
+// on its own thread and closed after response. Available only on POSIX platforms
+class BenchHttpServer : public Ref {
+public:
+	struct Resource {
+		Bytes data;
+		String etag; // with quotes, as sent in ETag header
+		Vector<Pair<String, String>> headers; // additional response headers
+		TimeInterval delay; // before response, keeps transfer in flight
+		size_t chunkSize = 0; // send body in chunks with chunkDelay between them
+		TimeInterval chunkDelay;
+		uint32_t disconnects = 0; // number of next responses, that are cut off
+		size_t disconnectAfter = 0; // body bytes, sent before connection is closed
+	};
+
+	// received request headers, names in lowercase
+	using RequestHeaders = Map<String, String>;
+
+	virtual ~BenchHttpServer();
+
+	bool init();
+	void stop();
+
+	uint16_t getPort() const { return _port; }
+	String getUrl(StringView path) const;
+
+	void setResource(StringView path, Resource &&);
+	bool getResource(StringView path, Resource &) const;
+
+	uint32_t getRequestCount(StringView path) const;
+	Vector<RequestHeaders> getRequests(StringView path) const;
+
+protected:
+	void runAccept();
+	void runConnection(int fd);
+
+	struct Response {
+		String data;
+		size_t chunkSize = 0;
+		TimeInterval chunkDelay;
+		size_t limit = maxOf<size_t>(); // bytes to send before connection is closed
+	};
+
+	Response makeResponse(StringView path, RequestHeaders &&);
+
+	mutable Mutex _mutex;
+	int _socket = -1;
+	uint16_t _port = 0;
+	std::atomic<bool> _running = false;
+	std::thread _acceptThread;
+	Vector<std::thread> _connections;
+	Map<String, Resource> _resources;
+	Map<String, Vector<RequestHeaders>> _requests;
+};
+
+} // namespace stappler::xenolith::app
+
+#endif /* TEST_SRC_TESTS_BENCH_APPBENCHHTTPSERVER_H_ */
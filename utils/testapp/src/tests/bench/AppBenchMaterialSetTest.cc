@@ -0,0 +1,193 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "AppBenchMaterialSetTest.h"
+#include "XLCoreMaterial.h"
+#include "XLCoreDynamicImage.h"
+#include "XLDirector.h"
+
+namespace stappler::xenolith::app {
+
+// Objects without backend handles: device is never touched, so only MaterialSet logic is measured
+
+class BenchMaterialSetImage : public core::ImageObject {
+public:
+	virtual ~BenchMaterialSetImage() = default;
+
+	bool init(core::Device &dev, const core::ImageInfoData &info) {
+		_info = info;
+		return core::ImageObject::init(dev, nullptr, core::ObjectType::Image,
+				core::ObjectHandle::zero(), nullptr);
+	}
+};
+
+class BenchMaterialSetImageView : public core::ImageView {
+public:
+	virtual ~BenchMaterialSetImageView() = default;
+
+	bool init(core::Device &dev, core::ImageObject *image, const core::ImageViewInfo &info) {
+		_info = image->getViewInfo(info);
+		_image = image;
+		return core::ImageView::init(dev, nullptr, core::ObjectType::ImageView,
+				core::ObjectHandle::zero());
+	}
+};
+
+class BenchMaterialSetDevice : public core::Device {
+public:
+	virtual ~BenchMaterialSetDevice() = default;
+
+	bool init() { return core::Device::init(nullptr); }
+
+protected:
+	using core::Device::init;
+};
+
+// 4096 static materials share 256 images (16 full layouts), 8 materials use dynamic image
+static constexpr uint32_t BenchMaterialSetImages = 256;
+static constexpr uint32_t BenchMaterialSetStatic = 4'096;
+static constexpr uint32_t BenchMaterialSetDynamic = 8;
+static constexpr uint32_t BenchMaterialSetGenerations = 10'000;
+
+bool BenchMaterialSetTest::init() {
+	if (!BenchTest::init(LayoutName::BenchMaterialSetTest,
+				"MaterialSet update for one dynamic image")) {
+		return false;
+	}
+	return true;
+}
+
+bool BenchMaterialSetTest::runBenchmark(StringStream &out) {
+	auto loop = _director->getGlLoop();
+	auto device = Rc<BenchMaterialSetDevice>::create();
+
+	auto pool = memory::pool::create_tagged("BenchMaterialSetTest");
+
+	bool success = true;
+	mem_pool::perform([&] {
+		core::ImageInfoData info;
+		info.extent = Extent3(64, 64, 1);
+		info.format = core::ImageFormat::R8G8B8A8_UNORM;
+		info.usage = core::ImageUsage::Sampled;
+
+		Vector<core::ImageData> images;
+		images.resize(BenchMaterialSetImages);
+		for (auto &it : images) {
+			static_cast<core::ImageInfoData &>(it) = info;
+			it.image = Rc<BenchMaterialSetImage>::create(*device, info);
+		}
+
+		// dynamic image switches between two backend images, like atlas after repack
+		Rc<core::ImageObject> dynamicImages[2] = {
+			Rc<BenchMaterialSetImage>::create(*device, info),
+			Rc<BenchMaterialSetImage>::create(*device, info),
+		};
+
+		auto dynamic = Rc<core::DynamicImage>::create([](core::DynamicImage::Builder &) {
+			return true;
+		});
+		dynamic->setImage(dynamicImages[0]);
+
+		auto makeView = [&](const core::MaterialImage &image) -> Rc<core::ImageView> {
+			return Rc<BenchMaterialSetImageView>::create(*device, image.image->image.get(),
+					image.info);
+		};
+
+		Vector<Rc<core::Material>> materials;
+		materials.reserve(BenchMaterialSetStatic + BenchMaterialSetDynamic);
+		for (uint32_t i = 0; i < BenchMaterialSetStatic; ++i) {
+			materials.emplace_back(Rc<core::Material>::create(core::MaterialId(i), nullptr,
+					&images[i % BenchMaterialSetImages]));
+		}
+
+		Vector<core::MaterialId> dynamicIds;
+		auto instance = dynamic->getInstance();
+		for (uint32_t i = 0; i < BenchMaterialSetDynamic; ++i) {
+			dynamicIds.emplace_back(core::MaterialId(BenchMaterialSetStatic + i));
+			materials.emplace_back(
+					Rc<core::Material>::create(dynamicIds.back(), nullptr, instance));
+		}
+		instance = nullptr;
+
+		auto set = Rc<core::MaterialSet>::create(16);
+		set->updateMaterials(materials, SpanView<core::MaterialId>(),
+				SpanView<core::MaterialId>(), makeView);
+		materials.clear();
+
+		core::MaterialSetStats total;
+
+		auto updateTime = measureBenchmark(BenchMaterialSetGenerations, [&](size_t i) {
+			dynamic->updateInstance(*loop, dynamicImages[(i + 1) % 2]);
+
+			// previous generation is still alive, as it would be while it's used by frames
+			auto next = Rc<core::MaterialSet>::create(set);
+			next->updateMaterials(SpanView<Rc<core::Material>>(), dynamicIds,
+					SpanView<core::MaterialId>(), makeView);
+
+			auto &stats = next->getStats();
+			total.cloneTime += stats.cloneTime;
+			total.updateTime += stats.updateTime;
+			total.updated += stats.updated;
+			total.copiedChunks += stats.copiedChunks;
+			total.copiedLayouts += stats.copiedLayouts;
+			total.dirtyLayouts += stats.dirtyLayouts;
+			total.materials = stats.materials;
+			total.layouts = stats.layouts;
+
+			set = move(next);
+		});
+
+		auto perGeneration = [&](uint64_t value) {
+			return double(value) / double(BenchMaterialSetGenerations);
+		};
+
+		out << std::setprecision(4) << "Generations: " << BenchMaterialSetGenerations
+			<< ", materials: " << total.materials << ", layouts: " << total.layouts << "\n"
+			<< "Generation: " << updateTime << " us (clone: " << perGeneration(total.cloneTime)
+			<< " us, update: " << perGeneration(total.updateTime) << " us)\n"
+			<< "Per generation: updated: " << perGeneration(total.updated)
+			<< ", copied chunks: " << perGeneration(total.copiedChunks)
+			<< ", copied layouts: " << perGeneration(total.copiedLayouts)
+			<< ", dirty layouts: " << perGeneration(total.dirtyLayouts) << "\n";
+
+		// only chunk and layout with dynamic materials should be touched
+		if (total.updated != BenchMaterialSetGenerations * BenchMaterialSetDynamic) {
+			out << "Not all dynamic materials were updated\n";
+			success = false;
+		}
+		if (total.copiedChunks > BenchMaterialSetGenerations
+				|| total.copiedLayouts > BenchMaterialSetGenerations
+				|| total.dirtyLayouts > BenchMaterialSetGenerations) {
+			out << "Unchanged chunks or layouts were copied\n";
+			success = false;
+		}
+
+		set = nullptr;
+		dynamic->finalize();
+	}, pool);
+
+	memory::pool::destroy(pool);
+
+	return success;
+}
+
+} // namespace stappler::xenolith::app
@@ -0,0 +1,332 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+
+#include "AppBenchNetworkCacheTest.h"
+#include "XLNetworkRequest.h"
+#include "XLDirector.h"
+#include "XLAppThread.h"
+
+namespace stappler::xenolith::app {
+
+static constexpr auto BenchNetworkCacheFile = "BenchNetworkCacheTest.bin";
+
+static Bytes BenchNetworkCacheTest_makeData(size_t size, uint8_t seed) {
+	Bytes ret;
+	ret.resize(size);
+	for (size_t i = 0; i < size; ++i) { ret[i] = uint8_t((i * 31 + seed) & 0xFF); }
+	return ret;
+}
+
+bool BenchNetworkCacheTest::init() {
+	if (!BenchTest::init(LayoutName::BenchNetworkCacheTest, "Network disk cache")) {
+		return false;
+	}
+
+	auto vary = [](StringView value) {
+		return [value](network::Handle &handle) { handle.addVaryHeader("X-Variant", value); };
+	};
+
+	_steps = Vector<Step>{
+		Step{"fresh: network", "/fresh", nullptr, false, false, 1},
+		Step{"fresh: cache hit", "/fresh", nullptr, false, true, 1},
+		Step{"vary header: network", "/fresh", vary("a"), false, false, 2},
+		Step{"vary header: cache hit", "/fresh", vary("a"), false, true, 2},
+		Step{"own header: bypass", "/fresh",
+			[](network::Handle &handle) { handle.addHeader("Authorization", "Bearer bench"); },
+			false, false, 3},
+		Step{"signed: bypass", "/fresh",
+			[](network::Handle &handle) { handle.setSignRequest(true); }, false, false, 4},
+		Step{"revalidate: network", "/revalidate", nullptr, false, false, 1},
+		Step{"revalidate: 304", "/revalidate", nullptr, false, true, 2},
+		Step{"vary *: network", "/vary", nullptr, false, false, 1},
+		Step{"vary *: not stored", "/vary", nullptr, false, false, 2},
+		Step{"file: network", "/file", nullptr, true, false, 1},
+		Step{"file: cache hit", "/file", nullptr, true, true, 1},
+		Step{"lru: first", "/big", vary("1"), false, false, 1},
+		Step{"lru: second", "/big", vary("2"), false, false, 2},
+		Step{"lru: second hit", "/big", vary("2"), false, true, 2},
+		Step{"lru: first evicted", "/big", vary("1"), false, false, 3},
+	};
+
+	_coalesceSteps = Vector<CoalesceStep>{
+		CoalesceStep{"coalesce: memory", "/shared", false, true, 1},
+		CoalesceStep{"coalesce: file", "/shared-file", true, true, 1},
+		CoalesceStep{"coalesce: disabled", "/shared", false, false, 1 + CoalesceCount},
+	};
+
+	return true;
+}
+
+void BenchNetworkCacheTest::performBenchmark(DoneCallback &&done) {
+	_done = sp::move(done);
+	_out = StringStream();
+	_success = true;
+
+	_server = Rc<BenchHttpServer>::create();
+	if (!_server) {
+		_out << "Local HTTP server is not available\n";
+		finish();
+		return;
+	}
+
+	auto cached = [](StringView name, Bytes &&data, StringView cacheControl,
+						  StringView etag = StringView(), StringView vary = StringView()) {
+		BenchHttpServer::Resource res;
+		res.data = sp::move(data);
+		res.etag = etag.str<Interface>();
+		res.headers.emplace_back("Cache-Control", cacheControl.str<Interface>());
+		res.headers.emplace_back("X-Bench", name.str<Interface>());
+		if (!vary.empty()) {
+			res.headers.emplace_back("Vary", vary.str<Interface>());
+		}
+		return res;
+	};
+
+	_server->setResource("/fresh",
+			cached("fresh", BenchNetworkCacheTest_makeData(256, 1), "max-age=3600", "\"f1\""));
+	_server->setResource("/revalidate",
+			cached("revalidate", BenchNetworkCacheTest_makeData(256, 2), "no-cache", "\"r1\""));
+	_server->setResource("/vary",
+			cached("vary", BenchNetworkCacheTest_makeData(256, 3), "max-age=3600", "\"v1\"", "*"));
+	_server->setResource("/file",
+			cached("file", BenchNetworkCacheTest_makeData(64 * 1'024, 4), "max-age=3600"));
+	_server->setResource("/big",
+			cached("big", BenchNetworkCacheTest_makeData(600 * 1'024, 5), "max-age=3600"));
+
+	// delayed responses keep the first transfer in flight, while others are queued
+	auto shared = cached("shared", BenchNetworkCacheTest_makeData(4 * 1'024, 6), "no-store");
+	shared.delay = TimeInterval::milliseconds(200);
+	_server->setResource("/shared", sp::move(shared));
+
+	auto sharedFile = cached("shared-file", BenchNetworkCacheTest_makeData(96 * 1'024, 7),
+			"no-store");
+	sharedFile.delay = TimeInterval::milliseconds(200);
+	_server->setResource("/shared-file", sp::move(sharedFile));
+
+	auto app = _director->getApplication();
+	filesystem::remove(FileInfo{"network.BenchNetworkCacheTest.cache", FileCategory::AppCache},
+			true, true);
+
+	_controller = Rc<network::Controller>::alloc(app, "BenchNetworkCacheTest");
+	_controller->enableCache(CacheBudget);
+
+	runStep(0);
+}
+
+void BenchNetworkCacheTest::runStep(uint32_t idx) {
+	if (idx >= _steps.size()) {
+		runCoalesceStep(0);
+		return;
+	}
+
+	auto &step = _steps[idx];
+	auto url = _server->getUrl(step.path);
+	auto file = FileInfo{BenchNetworkCacheFile, FileCategory::AppCache};
+
+	_header.clear();
+
+	auto req = Rc<network::Request>::create([&, this](network::Handle &handle) {
+		if (step.file) {
+			filesystem::remove(file);
+			handle.init(url, file);
+		} else {
+			handle.init(url);
+		}
+		handle.setCacheable(true);
+		handle.setHeaderCallback([this](StringView key, StringView value) {
+			if (string::tolower<Interface>(key) == "x-bench") {
+				_header = value.str<Interface>();
+			}
+		});
+		if (step.setup) {
+			step.setup(handle);
+		}
+		return true;
+	}, this);
+
+	req->perform(_controller.get(), [this, idx, file](const network::Request &req, bool success) {
+		auto &step = _steps[idx];
+		auto &handle = req.getHandle();
+
+		auto expected = StringView(step.path).sub(1);
+		auto requests = _server->getRequestCount(step.path);
+
+		Bytes fileData;
+		BytesView data = req.getData();
+		if (step.file) {
+			fileData = filesystem::readIntoMemory<Interface>(file);
+			data = fileData;
+		}
+
+		BenchHttpServer::Resource res;
+		_server->getResource(step.path, res);
+
+		bool ok = success && handle.getStatusCode() == 200 && handle.isCached() == step.cached
+				&& requests == step.requests && _header == expected && data == BytesView(res.data);
+
+		_out << step.title << ": " << (ok ? "ok" : "FAILED");
+		if (!ok) {
+			_out << " (status " << handle.getStatusCode() << ", cached " << handle.isCached()
+				 << ", requests " << requests << ", header '" << _header << "', size "
+				 << data.size() << ")";
+			_success = false;
+		}
+		_out << "\n";
+
+		runStep(idx + 1);
+	});
+}
+
+void BenchNetworkCacheTest::runCoalesceStep(uint32_t idx) {
+	if (idx >= _coalesceSteps.size()) {
+		_out << "Requests: " << RequestsCount << "\n";
+		runRequests(0, true, sp::platform::clock(ClockType::Monotonic));
+		return;
+	}
+
+	struct StepData : Ref {
+		uint32_t completed = 0;
+		uint32_t failed = 0;
+		uint32_t coalesced = 0;
+		uint64_t coalescedBefore = 0;
+	};
+
+	auto &step = _coalesceSteps[idx];
+	auto url = _server->getUrl(step.path);
+	auto data = Rc<StepData>::alloc();
+	data->coalescedBefore = _controller->getCoalescedRequests();
+
+	BenchHttpServer::Resource res;
+	_server->getResource(step.path, res);
+
+	for (uint32_t i = 0; i < CoalesceCount; ++i) {
+		auto file = FileInfo{toString("BenchNetworkCacheTest.", i, ".bin"), FileCategory::AppCache};
+		auto req = Rc<network::Request>::create([&](network::Handle &handle) {
+			if (step.file) {
+				filesystem::remove(file);
+				handle.init(url, file);
+			} else {
+				handle.init(url);
+			}
+			handle.setCoalescing(step.coalescing);
+			return true;
+		}, this);
+
+		req->perform(_controller.get(),
+				[this, idx, file, data, expected = res.data](const network::Request &req,
+						bool success) {
+			auto &step = _coalesceSteps[idx];
+			auto &handle = req.getHandle();
+
+			// every request should receive complete response into its own target
+			Bytes fileData;
+			BytesView received = req.getData();
+			if (step.file) {
+				fileData = filesystem::readIntoMemory<Interface>(file);
+				received = fileData;
+				filesystem::remove(file);
+			}
+
+			if (!success || handle.getStatusCode() != 200 || received != BytesView(expected)) {
+				++data->failed;
+			}
+			if (handle.isCoalesced()) {
+				++data->coalesced;
+			}
+
+			if (++data->completed < CoalesceCount) {
+				return;
+			}
+
+			auto requests = _server->getRequestCount(step.path);
+			auto coalesced = _controller->getCoalescedRequests() - data->coalescedBefore;
+			auto expectedCoalesced = step.coalescing ? CoalesceCount - 1 : 0;
+
+			bool ok = data->failed == 0 && requests == step.requests
+					&& data->coalesced == expectedCoalesced && coalesced == expectedCoalesced;
+
+			_out << step.title << ": " << (ok ? "ok" : "FAILED");
+			if (!ok) {
+				_out << " (failed " << data->failed << ", requests " << requests
+					 << ", coalesced " << data->coalesced << ", controller " << coalesced << ")";
+				_success = false;
+			}
+			_out << "\n";
+
+			runCoalesceStep(idx + 1);
+		});
+	}
+}
+
+void BenchNetworkCacheTest::runRequests(uint32_t idx, bool cacheable, uint64_t start) {
+	if (idx >= RequestsCount) {
+		auto time = sp::platform::clock(ClockType::Monotonic) - start;
+		_out << (cacheable ? "Cache hit: " : "Network: ")
+			 << double(time) / double(RequestsCount) / 1'000.0 << " ms per request\n";
+
+		if (cacheable) {
+			runRequests(0, false, sp::platform::clock(ClockType::Monotonic));
+		} else {
+			finish();
+		}
+		return;
+	}
+
+	auto url = _server->getUrl("/fresh");
+	auto req = Rc<network::Request>::create([&](network::Handle &handle) {
+		handle.init(url);
+		handle.setCacheable(cacheable);
+		return true;
+	}, this);
+
+	req->perform(_controller.get(),
+			[this, idx, cacheable, start](const network::Request &req, bool success) {
+		if (!success || req.getHandle().isCached() != cacheable) {
+			_success = false;
+		}
+		runRequests(idx + 1, cacheable, start);
+	});
+}
+
+void BenchNetworkCacheTest::finish() {
+	if (_controller) {
+		auto stats = _controller->getCacheStats();
+		_out << "hits: " << stats.hits << ", revalidated: " << stats.revalidated
+			 << ", misses: " << stats.misses << ", stored: " << stats.stored
+			 << ", evicted: " << stats.evicted << ", size: " << stats.size << "\n";
+
+		_controller->invalidate(_director->getApplication());
+		_controller = nullptr;
+	}
+
+	if (_server) {
+		_server->stop();
+		_server = nullptr;
+	}
+
+	auto done = sp::move(_done);
+	_done = nullptr;
+	done(_success, _out.str());
+}
+
+} // namespace stappler::xenolith::app
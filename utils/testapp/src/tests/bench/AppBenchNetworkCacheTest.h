@@ -0,0 +1,86 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+
+#ifndef TEST_SRC_TESTS_BENCH_APPBENCHNETWORKCACHETEST_H_
+#define TEST_SRC_TESTS_BENCH_APPBENCHNETWORKCACHETEST_H_
+
+#include "AppBenchTest.h"
+#include "AppBenchHttpServer.h"
+#include "XLNetworkController.h"
+
+namespace stappler::xenolith::app {
+
+// network::Controller disk cache against local HTTP server: cache keys, header replay,
+// revalidation and LRU eviction, coalescing of identical requests into memory and files,
+// then latency of cached and uncached requests
+class BenchNetworkCacheTest : public BenchTest {
+public:
+	static constexpr uint32_t RequestsCount = 200;
+	static constexpr size_t CacheBudget = 1'024 * 1'024;
+	static constexpr uint32_t CoalesceCount = 8;
+
+	virtual ~BenchNetworkCacheTest() { }
+
+	virtual bool init() override;
+
+protected:
+	using BenchTest::init;
+
+	struct Step {
+		StringView title;
+		StringView path;
+		Function<void(network::Handle &)> setup;
+		bool file = false; // receive into file instead of memory
+		bool cached = false; // expected response from cache
+		uint32_t requests = 0; // expected server requests for path after step
+	};
+
+	// CoalesceCount identical requests, performed at the same time
+	struct CoalesceStep {
+		StringView title;
+		StringView path;
+		bool file = false;
+		bool coalescing = true;
+		uint32_t requests = 0; // expected server requests for path after step
+	};
+
+	virtual void performBenchmark(DoneCallback &&done) override;
+
+	void runStep(uint32_t idx);
+	void runCoalesceStep(uint32_t idx);
+	void runRequests(uint32_t idx, bool cacheable, uint64_t start);
+	void finish();
+
+	Rc<BenchHttpServer> _server;
+	Rc<network::Controller> _controller;
+	Vector<Step> _steps;
+	Vector<CoalesceStep> _coalesceSteps;
+	String _header; // X-Bench header value, received for last request
+	DoneCallback _done;
+	StringStream _out;
+	bool _success = true;
+};
+
+} // namespace stappler::xenolith::app
+
+#endif /* TEST_SRC_TESTS_BENCH_APPBENCHNETWORKCACHETEST_H_ */
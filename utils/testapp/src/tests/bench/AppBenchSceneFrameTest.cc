@@ -0,0 +1,182 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+
+#include "AppBenchSceneFrameTest.h"
+#include "XL2dLayer.h"
+#include "XLAppWindow.h"
+#include "XLDirector.h"
+
+namespace stappler::xenolith::app {
+
+bool BenchSceneFrameTest::init() {
+	if (!BenchTest::init(LayoutName::BenchSceneFrameTest, "Frame time with animated layers")) {
+		return false;
+	}
+
+	_field = addChild(Rc<Node>::create());
+	_field->setAnchorPoint(Anchor::Middle);
+
+	_layers.reserve(LayersCount);
+	for (uint32_t i = 0; i < LayersCount; ++i) {
+		auto layer = _field->addChild(
+				Rc<Layer>::create(Color(Color::Tone(i % 16), Color::Level::b500)), ZOrder(i));
+		layer->setContentSize(Size2(24.0f, 24.0f));
+		layer->setAnchorPoint(Anchor::Middle);
+		_layers.emplace_back(layer);
+	}
+
+	scheduleUpdate();
+
+	return true;
+}
+
+void BenchSceneFrameTest::handleExit() {
+	stopAllActions();
+	if (_done) {
+		setPipelineDepth(_initialDepth);
+		_done(false, "Benchmark was interrupted");
+		_done = nullptr;
+	}
+
+	BenchTest::handleExit();
+}
+
+void BenchSceneFrameTest::handleContentSizeDirty() {
+	BenchTest::handleContentSizeDirty();
+
+	_field->setContentSize(_contentSize);
+	_field->setPosition(_contentSize / 2.0f);
+
+	// grid, that fills the content area
+	auto columns = uint32_t(std::ceil(std::sqrt(float(LayersCount))));
+	auto cell = Size2(_contentSize.width / columns, _contentSize.height / columns);
+	for (uint32_t i = 0; i < LayersCount; ++i) {
+		_layers[i]->setPosition(
+				Vec2((i % columns + 0.5f) * cell.width, (i / columns + 0.5f) * cell.height));
+	}
+}
+
+void BenchSceneFrameTest::update(const UpdateTime &time) {
+	BenchTest::update(time);
+
+	// every layer changes its transform and color on each frame
+	auto t = float(time.app % (2_sec).toMicros()) / float((2_sec).toMicros());
+	for (uint32_t i = 0; i < LayersCount; ++i) {
+		auto phase = t + float(i) / float(LayersCount);
+		_layers[i]->setRotation(phase * 2.0f * numbers::pi);
+		_layers[i]->setOpacity(0.5f + 0.5f * std::sin(phase * 2.0f * numbers::pi));
+	}
+
+	if (!_done) {
+		return;
+	}
+
+	++_frame;
+	if (_frame < WarmupFrames) {
+		return;
+	}
+
+	if (_frame == WarmupFrames) {
+		_startTime = _lastTime = time.global;
+		return;
+	}
+
+	_maxInterval = std::max(_maxInterval, time.global - _lastTime);
+	_lastTime = time.global;
+
+	auto sceneTime = _director->getDirectorFrameTime();
+	_sceneTime += sceneTime;
+	_maxSceneTime = std::max(_maxSceneTime, sceneTime);
+
+	if (_frame == WarmupFrames + MeasuredFrames) {
+		finalizeRun();
+	}
+}
+
+void BenchSceneFrameTest::performBenchmark(DoneCallback &&done) {
+	_done = sp::move(done);
+	_out = StringStream();
+	_out << "Layers: " << LayersCount << ", frames: " << MeasuredFrames << "\n";
+
+	if (auto window = _director->getWindow()) {
+		_initialDepth = window->getPresentationPipelineDepth();
+	}
+
+	// frames are requested continuously, even with render-on-demand presentation
+	runAction(Rc<RenderContinuously>::create(), "BenchSceneFrameTest"_tag);
+
+	startRun(0);
+}
+
+void BenchSceneFrameTest::startRun(uint32_t run) {
+	_run = run;
+	_frame = 0;
+	_startTime = _lastTime = 0;
+	_maxInterval = 0;
+	_sceneTime = 0.0;
+	_maxSceneTime = 0.0f;
+
+	// depth is applied on the presentation thread, warmup frames cover the switch
+	setPipelineDepth(PipelineDepths[run]);
+}
+
+void BenchSceneFrameTest::finalizeRun() {
+	auto frameInterval = double(_lastTime - _startTime) / double(MeasuredFrames) / 1'000.0;
+
+	uint32_t depth = PipelineDepths[_run];
+	if (auto window = _director->getWindow()) {
+		depth = window->getPresentationPipelineDepth();
+	}
+
+	_out << "Pipeline depth: " << PipelineDepths[_run] << " (effective: " << depth << ")\n";
+	_out << "  Frame interval: " << frameInterval << " ms avg, "
+		<< double(_maxInterval) / 1'000.0 << " ms max\n";
+	_out << "  Scene time: " << _sceneTime / double(MeasuredFrames) << " ms avg, "
+		<< _maxSceneTime << " ms max\n";
+	_out << "  Frames per second: " << 1'000.0 / frameInterval << "\n";
+	_out << "  GPU time: " << _director->getFenceFrameTime() << " ms (fence), "
+		<< _director->getTimestampFrameTime() << " ms (timestamp)\n";
+
+	if (_run + 1 < std::size(PipelineDepths)) {
+		startRun(_run + 1);
+	} else {
+		finalizeBenchmark();
+	}
+}
+
+void BenchSceneFrameTest::finalizeBenchmark() {
+	stopAllActionsByTag("BenchSceneFrameTest"_tag);
+	setPipelineDepth(_initialDepth);
+
+	auto done = sp::move(_done);
+	_done = nullptr;
+	done(true, _out.str());
+}
+
+void BenchSceneFrameTest::setPipelineDepth(uint32_t depth) {
+	if (auto window = _director->getWindow()) {
+		window->setPresentationPipelineDepth(depth);
+	}
+}
+
+} // namespace stappler::xenolith::app
@@ -0,0 +1,76 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+
+#ifndef TEST_SRC_TESTS_BENCH_APPBENCHSCENEFRAMETEST_H_
+#define TEST_SRC_TESTS_BENCH_APPBENCHSCENEFRAMETEST_H_
+
+#include "AppBenchTest.h"
+
+namespace stappler::xenolith::app {
+
+// Frame time of a scene with many animated layers, measured with the full frame pipeline
+// for pipeline depth 1 and 2; with `--headless` the frames are rendered by the null device
+class BenchSceneFrameTest : public BenchTest {
+public:
+	static constexpr uint32_t LayersCount = 1'024;
+	static constexpr uint32_t WarmupFrames = 60;
+	static constexpr uint32_t MeasuredFrames = 600;
+	static constexpr uint32_t PipelineDepths[] = {1, 2};
+
+	virtual ~BenchSceneFrameTest() { }
+
+	virtual bool init() override;
+
+	virtual void handleExit() override;
+	virtual void handleContentSizeDirty() override;
+
+	virtual void update(const UpdateTime &) override;
+
+protected:
+	using BenchTest::init;
+
+	virtual void performBenchmark(DoneCallback &&done) override;
+
+	void startRun(uint32_t);
+	void finalizeRun();
+	void finalizeBenchmark();
+	void setPipelineDepth(uint32_t);
+
+	Node *_field = nullptr;
+	Vector<Layer *> _layers;
+
+	DoneCallback _done;
+	StringStream _out;
+	uint32_t _run = 0;
+	uint32_t _initialDepth = 1;
+	uint32_t _frame = 0;
+	uint64_t _startTime = 0;
+	uint64_t _lastTime = 0;
+	uint64_t _maxInterval = 0;
+	double _sceneTime = 0.0;
+	float _maxSceneTime = 0.0f;
+};
+
+} // namespace stappler::xenolith::app
+
+#endif /* TEST_SRC_TESTS_BENCH_APPBENCHSCENEFRAMETEST_H_ */
@@ -0,0 +1,284 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "AppBenchStorageQueryTest.h"
+#include "XLStorageComponent.h"
+#include "XLDirector.h"
+
+namespace stappler::xenolith::app {
+
+class BenchStorageQueryComponent : public storage::Component {
+public:
+	virtual ~BenchStorageQueryComponent() { }
+
+	BenchStorageQueryComponent(storage::ComponentLoader &loader)
+	: Component(loader, "BenchStorageQuery") {
+		using namespace db;
+
+		loader.exportScheme(_items.define({
+			Field::Text("name", MaxLength(64)),
+			Field::Integer("value", Flags::Indexed),
+			Field::Data("data"),
+		}));
+	}
+
+	const db::Scheme &getItems() const { return _items; }
+
+protected:
+	db::Scheme _items = db::Scheme("bench_query_items");
+};
+
+class BenchStorageQueryContainer : public storage::ComponentContainer {
+public:
+	virtual ~BenchStorageQueryContainer() { }
+
+	virtual bool init(Function<void()> &&);
+
+	virtual void handleStorageInit(storage::ComponentLoader &loader) override;
+	virtual void handleStorageDisposed(const db::Transaction &t) override;
+
+	virtual void handleComponentsLoaded(const storage::Server &serv) override;
+
+	const db::Scheme &getItems() const { return _component->getItems(); }
+
+protected:
+	using storage::ComponentContainer::init;
+
+	BenchStorageQueryComponent *_component = nullptr;
+	Function<void()> _onLoaded;
+};
+
+bool BenchStorageQueryContainer::init(Function<void()> &&cb) {
+	_onLoaded = sp::move(cb);
+	return ComponentContainer::init("BenchStorageQuery");
+}
+
+void BenchStorageQueryContainer::handleStorageInit(storage::ComponentLoader &loader) {
+	ComponentContainer::handleStorageInit(loader);
+	_component = new (std::nothrow) BenchStorageQueryComponent(loader);
+}
+
+void BenchStorageQueryContainer::handleStorageDisposed(const db::Transaction &t) {
+	_component = nullptr;
+	ComponentContainer::handleStorageDisposed(t);
+}
+
+void BenchStorageQueryContainer::handleComponentsLoaded(const storage::Server &serv) {
+	ComponentContainer::handleComponentsLoaded(serv);
+	if (_onLoaded) {
+		_onLoaded();
+	}
+}
+
+// Every stage issues CallsCount reads, `done` is set only for the last one; without read pool
+// server executes calls in order, so it marks the end of the stage
+struct BenchStorageQueryStage {
+	StringView name;
+	void (*call)(const storage::Server &, const db::Scheme &, int64_t oid, uint32_t idx,
+			Function<void()> &&done);
+};
+
+static BenchStorageQueryStage s_benchStorageQueryStages[] = {
+	BenchStorageQueryStage{"get by id",
+		[](const storage::Server &serv, const db::Scheme &scheme, int64_t oid, uint32_t,
+				Function<void()> &&done) {
+		serv.get(scheme, [done = sp::move(done)](const Value &) {
+			if (done) {
+				done();
+			}
+		}, uint64_t(oid));
+	}},
+	BenchStorageQueryStage{"get fields by name",
+		[](const storage::Server &serv, const db::Scheme &scheme, int64_t oid, uint32_t,
+				Function<void()> &&done) {
+		serv.get(scheme, [done = sp::move(done)](const Value &) {
+			if (done) {
+				done();
+			}
+		}, uint64_t(oid), {StringView("name"), StringView("value")});
+	}},
+	BenchStorageQueryStage{"get fields by pointer",
+		[](const storage::Server &serv, const db::Scheme &scheme, int64_t oid, uint32_t,
+				Function<void()> &&done) {
+		serv.get(scheme, [done = sp::move(done)](const Value &) {
+			if (done) {
+				done();
+			}
+		}, uint64_t(oid), {scheme.getField("name"), scheme.getField("value")});
+	}},
+	BenchStorageQueryStage{"select by value",
+		[](const storage::Server &serv, const db::Scheme &scheme, int64_t, uint32_t idx,
+				Function<void()> &&done) {
+		serv.select(scheme, [done = sp::move(done)](const Value &) {
+			if (done) {
+				done();
+			}
+		}, [idx](db::Query &q) {
+			q.select("value", db::Value(int64_t(idx % BenchStorageQueryTest::ObjectsCount)));
+		});
+	}},
+	BenchStorageQueryStage{"count by value",
+		[](const storage::Server &serv, const db::Scheme &scheme, int64_t, uint32_t idx,
+				Function<void()> &&done) {
+		serv.count(scheme, [done = sp::move(done)](size_t) {
+			if (done) {
+				done();
+			}
+		}, [idx](db::Query &q) {
+			q.select("value", db::Value(int64_t(idx % BenchStorageQueryTest::ObjectsCount)));
+		});
+	}},
+};
+
+static StringView s_benchStorageQueryOperations[] = {"key-value", "get", "select", "count",
+	"write"};
+
+bool BenchStorageQueryTest::init() {
+	if (!BenchTest::init(LayoutName::BenchStorageQueryTest, "Storage reads, per-call cost")) {
+		return false;
+	}
+	return true;
+}
+
+void BenchStorageQueryTest::performBenchmark(DoneCallback &&done) {
+	_done = sp::move(done);
+	_out = StringStream();
+	_success = true;
+	_oids.clear();
+
+	auto path = FileInfo("BenchStorageQueryTest.sqlite", FileCategory::AppCache);
+	filesystem::remove(path);
+
+	auto app = _director->getApplication();
+	_server = Rc<storage::Server>::create(app,
+			Value({
+				pair("driver", Value("sqlite")),
+				pair("dbname", Value(filesystem::findWritablePath<Interface>(path))),
+				pair("readers", Value(int64_t(0))),
+			}));
+
+	if (!_server) {
+		_out << "Fail to open storage server\n";
+		_success = false;
+		finalizeBenchmark();
+		return;
+	}
+
+	_out << "Objects: " << ObjectsCount << ", calls per stage: " << CallsCount << "\n";
+
+	_container = Rc<BenchStorageQueryContainer>::create([this, guard = Rc<Ref>(this)] {
+		auto &scheme = _container->getItems();
+		for (uint32_t i = 0; i < ObjectsCount; ++i) {
+			_server->create(scheme,
+					Value({
+						pair("name", Value(toString("item.", i))),
+						pair("value", Value(int64_t(i))),
+						pair("data", Value(Bytes(256, uint8_t(i)))),
+					}));
+		}
+
+		// ids are taken with select, it's executed after all writes above
+		_server->select(scheme, [this, guard](const Value &val) {
+			for (auto &it : val.asArray()) { _oids.emplace_back(it.getInteger("__oid")); }
+			if (_oids.size() != ObjectsCount) {
+				_out << "Objects created: " << _oids.size() << "\n";
+				_success = false;
+				finalizeBenchmark();
+				return;
+			}
+			runStage(0);
+		});
+	});
+
+	_server->addComponentContainer(_container);
+}
+
+void BenchStorageQueryTest::runStage(uint32_t idx) {
+	if (idx >= std::size(s_benchStorageQueryStages)) {
+		finalizeBenchmark();
+		return;
+	}
+
+	auto &stage = s_benchStorageQueryStages[idx];
+	auto &scheme = _container->getItems();
+	auto start = sp::platform::clock(ClockType::Monotonic);
+	for (uint32_t i = 0; i < CallsCount; ++i) {
+		Function<void()> done;
+		if (i == CallsCount - 1) {
+			done = [this, guard = Rc<Ref>(this), idx, start] {
+				auto time = sp::platform::clock(ClockType::Monotonic) - start;
+				_out << s_benchStorageQueryStages[idx].name << ": "
+					 << double(time) / double(CallsCount) << " us per call\n";
+				runStage(idx + 1);
+			};
+		}
+		stage.call(*_server, scheme, _oids[i % _oids.size()], i, sp::move(done));
+	}
+}
+
+void BenchStorageQueryTest::finalizeBenchmark() {
+	if (_server) {
+		auto stats = _server->getStats();
+		auto it = stats.schemes.find("bench_query_items");
+		if (it == stats.schemes.end()) {
+			_out << "No stats for scheme\n";
+			_success = false;
+		} else {
+			_out << "Scheme stats (avg / max, us):\n";
+			for (size_t i = 0; i < it->second.size(); ++i) {
+				auto &op = it->second[i];
+				if (op.count == 0) {
+					continue;
+				}
+				_out << "\t" << s_benchStorageQueryOperations[i] << ": " << op.count
+					 << " calls, exec " << double(op.execTime) / double(op.count) << " / "
+					 << op.maxExecTime << ", wait " << double(op.waitTime) / double(op.count)
+					 << " / " << op.maxWaitTime << "\n";
+			}
+
+			// three get stages, select and count, all of them should be recorded
+			auto &ops = it->second;
+			if (ops[toInt(storage::Server::Operation::Get)].count < CallsCount * 3
+					|| ops[toInt(storage::Server::Operation::Select)].count < CallsCount
+					|| ops[toInt(storage::Server::Operation::Count)].count < CallsCount
+					|| ops[toInt(storage::Server::Operation::Write)].count < ObjectsCount) {
+				_out << "Operations are missing from stats\n";
+				_success = false;
+			}
+		}
+
+		if (_container) {
+			_server->removeComponentContainer(_container);
+		}
+		_server->invalidate(_director->getApplication());
+	}
+
+	_server = nullptr;
+	_container = nullptr;
+	filesystem::remove(FileInfo("BenchStorageQueryTest.sqlite", FileCategory::AppCache));
+
+	auto done = sp::move(_done);
+	_done = nullptr;
+	done(_success, _out.str());
+}
+
+} // namespace stappler::xenolith::app
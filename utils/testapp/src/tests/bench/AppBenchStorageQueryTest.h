@@ -0,0 +1,64 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef TEST_SRC_TESTS_BENCH_APPBENCHSTORAGEQUERYTEST_H_
+#define TEST_SRC_TESTS_BENCH_APPBENCHSTORAGEQUERYTEST_H_
+
+#include "AppBenchTest.h"
+#include "XLStorageServer.h"
+
+namespace stappler::xenolith::app {
+
+class BenchStorageQueryContainer;
+
+// Per-call cost of scheme reads in local SQLite storage::Server: get by id, get with field
+// list by name and by field pointers, select and count; execution and queue wait time for
+// every operation are taken from server's per-scheme stats
+class BenchStorageQueryTest : public BenchTest {
+public:
+	static constexpr uint32_t ObjectsCount = 1'000;
+	static constexpr uint32_t CallsCount = 5'000;
+
+	virtual ~BenchStorageQueryTest() { }
+
+	virtual bool init() override;
+
+protected:
+	using BenchTest::init;
+
+	virtual void performBenchmark(DoneCallback &&done) override;
+
+	void runStage(uint32_t idx);
+	void finalizeBenchmark();
+
+	Rc<storage::Server> _server;
+	Rc<BenchStorageQueryContainer> _container;
+	Vector<int64_t> _oids;
+
+	DoneCallback _done;
+	StringStream _out;
+	bool _success = true;
+};
+
+} // namespace stappler::xenolith::app
+
+#endif /* TEST_SRC_TESTS_BENCH_APPBENCHSTORAGEQUERYTEST_H_ */
@@ -0,0 +1,112 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+
+#include "AppBenchStorageWriteTest.h"
+#include "XLStorageServer.h"
+#include "XLDirector.h"
+#include "XLAppThread.h"
+
+namespace stappler::xenolith::app {
+
+// batchLimit server param for each run: one transaction per write, then group commit
+static constexpr uint32_t BenchStorageWriteBatchLimits[] = {1, 256};
+
+bool BenchStorageWriteTest::init() {
+	if (!BenchTest::init(LayoutName::BenchStorageWriteTest, "Storage writes throughput")) {
+		return false;
+	}
+	return true;
+}
+
+void BenchStorageWriteTest::performBenchmark(DoneCallback &&done) {
+	_done = sp::move(done);
+	_out = StringStream();
+	_success = true;
+
+	_out << "Writes: " << WritesCount << "\n";
+
+	runConfig(0);
+}
+
+void BenchStorageWriteTest::runConfig(uint32_t idx) {
+	auto path = FileInfo("BenchStorageWriteTest.sqlite", FileCategory::AppCache);
+	filesystem::remove(path);
+
+	if (idx >= std::size(BenchStorageWriteBatchLimits)) {
+		auto done = sp::move(_done);
+		_done = nullptr;
+		done(_success, _out.str());
+		return;
+	}
+
+	auto app = _director->getApplication();
+	auto limit = BenchStorageWriteBatchLimits[idx];
+	auto server = Rc<storage::Server>::create(app,
+			Value({
+				pair("driver", Value("sqlite")),
+				pair("dbname", Value(filesystem::findWritablePath<Interface>(path))),
+				pair("readers", Value(int64_t(0))),
+				pair("batchLimit", Value(int64_t(limit))),
+			}));
+
+	if (!server) {
+		_out << "Fail to open storage server\n";
+		_success = false;
+		runConfig(uint32_t(std::size(BenchStorageWriteBatchLimits)));
+		return;
+	}
+
+	// first read waits until server thread has opened the database
+	server->get(CoderSource("BenchStorageWriteTest"),
+			[this, guard = Rc<Ref>(this), app, server, idx, limit](const Value &) {
+		auto start = sp::platform::clock(ClockType::Monotonic);
+		for (uint32_t i = 0; i < WritesCount - 1; ++i) {
+			auto key = toString("key.", i);
+			server->set(CoderSource(key), Value({pair("value", Value(int64_t(i)))}));
+		}
+
+		// writes are executed in order, so the last callback marks the end of the burst
+		auto key = toString("key.", WritesCount - 1);
+		server->set(CoderSource(key),
+				Value({pair("value", Value(int64_t(WritesCount - 1)))}),
+				[this, guard, app, server, idx, limit, start](const Value &) {
+			auto time = sp::platform::clock(ClockType::Monotonic) - start;
+			auto stats = server->getStats();
+
+			_out << "batchLimit " << limit << ": " << double(time) / 1'000.0 << " ms, "
+				 << double(time) / double(WritesCount) << " us per write, "
+				 << double(WritesCount) * 1'000'000.0 / double(time) << " writes/s\n";
+			_out << "\ttransactions: " << stats.transactions << ", batched: " << stats.batched
+				 << ", rollbacks: " << stats.rollbacks << ", failed: " << stats.failed << "\n";
+
+			if (stats.failed > 0 || stats.tasks < WritesCount) {
+				_success = false;
+			}
+
+			server->invalidate(app);
+			runConfig(idx + 1);
+		});
+	});
+}
+
+} // namespace stappler::xenolith::app
@@ -0,0 +1,224 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "AppBenchSurfaceStyleTest.h"
+#include "XLDirector.h"
+
+namespace stappler::xenolith::app {
+
+static constexpr material2d::ColorRole s_surfaceRoles[] = {
+	material2d::ColorRole::Primary,
+	material2d::ColorRole::PrimaryContainer,
+	material2d::ColorRole::Secondary,
+	material2d::ColorRole::SecondaryContainer,
+	material2d::ColorRole::Tertiary,
+	material2d::ColorRole::TertiaryContainer,
+	material2d::ColorRole::Surface,
+	material2d::ColorRole::SurfaceVariant,
+};
+
+static constexpr size_t s_surfaceRolesCount = sizeof(s_surfaceRoles) / sizeof(s_surfaceRoles[0]);
+
+bool BenchSurfaceStyleTest::init() {
+	if (!BenchTest::init(LayoutName::BenchSurfaceStyleTest, "Surface theme switch")) {
+		return false;
+	}
+
+	_color = ColorHCT(Color::Red_500);
+
+	_style = addSystem(Rc<material2d::StyleContainer>::create());
+	_style->setPrimaryScheme(material2d::ThemeType::LightTheme, _color, false);
+
+	_field = addChild(Rc<Node>::create());
+	_field->setAnchorPoint(Anchor::Middle);
+
+	_surfaces.reserve(SurfacesCount);
+	for (uint32_t i = 0; i < SurfacesCount; ++i) {
+		auto surface = _field->addChild(Rc<material2d::Surface>::create(material2d::SurfaceStyle(
+				material2d::NodeStyle::Filled, s_surfaceRoles[i % s_surfaceRolesCount])));
+		surface->setContentSize(Size2(20.0f, 20.0f));
+		surface->setAnchorPoint(Anchor::Middle);
+		_surfaces.emplace_back(surface);
+	}
+
+	scheduleUpdate();
+
+	return true;
+}
+
+void BenchSurfaceStyleTest::handleExit() {
+	if (_done) {
+		stopAllActionsByTag("BenchSurfaceStyleTest"_tag);
+		_done(false, "Benchmark was interrupted");
+		_done = nullptr;
+	}
+
+	BenchTest::handleExit();
+}
+
+void BenchSurfaceStyleTest::handleContentSizeDirty() {
+	BenchTest::handleContentSizeDirty();
+
+	_field->setContentSize(_contentSize);
+	_field->setPosition(_contentSize / 2.0f);
+
+	auto columns = uint32_t(std::ceil(std::sqrt(float(SurfacesCount))));
+	auto cell = Size2(_contentSize.width / columns, _contentSize.height / columns);
+	for (uint32_t i = 0; i < SurfacesCount; ++i) {
+		_surfaces[i]->setPosition(
+				Vec2((i % columns + 0.5f) * cell.width, (i / columns + 0.5f) * cell.height));
+	}
+}
+
+void BenchSurfaceStyleTest::update(const UpdateTime &time) {
+	BenchTest::update(time);
+
+	if (!_done) {
+		return;
+	}
+
+	if (_switchTime == 0) {
+		switchTheme(time.global);
+		return;
+	}
+
+	++_frames;
+
+	auto sceneTime = _director->getDirectorFrameTime();
+	_sceneTime += sceneTime;
+	_maxSceneTime = std::max(_maxSceneTime, sceneTime);
+
+	if (time.global - _switchTime > TimeInterval::floatSeconds(TransitionDuration).toMicros()) {
+		if (++_switch == Switches) {
+			finalizeBenchmark();
+		} else {
+			switchTheme(time.global);
+		}
+	}
+}
+
+void BenchSurfaceStyleTest::performBenchmark(DoneCallback &&done) {
+	_out = StringStream();
+	runSolveBenchmark();
+
+	_done = sp::move(done);
+	_switch = 0;
+	_frames = 0;
+	_switchTime = 0;
+	_sceneTime = 0.0;
+	_maxSceneTime = 0.0f;
+
+	material2d::ColorCache::clear();
+	_stats = material2d::ColorCache::getStats();
+
+	// frames are requested continuously, even with render-on-demand presentation
+	runAction(Rc<RenderContinuously>::create(), "BenchSurfaceStyleTest"_tag);
+}
+
+void BenchSurfaceStyleTest::runSolveBenchmark() {
+	// interpolated colors of every surface for every frame of transition
+	auto light = material2d::ColorScheme(material2d::ThemeType::LightTheme, _color, false);
+	auto dark = material2d::ColorScheme(material2d::ThemeType::DarkTheme, _color, false);
+
+	Vector<ColorHCT::Values> values;
+	values.reserve(SurfacesCount * SolveFrames);
+	for (uint32_t f = 0; f < SolveFrames; ++f) {
+		auto p = float(f + 1) / float(SolveFrames);
+		for (uint32_t i = 0; i < SurfacesCount; ++i) {
+			auto role = s_surfaceRoles[i % s_surfaceRolesCount];
+			values.emplace_back(stappler::progress(light.hct(role), dark.hct(role), p).data);
+		}
+	}
+
+	Vector<Color4F> uncached(values.size());
+	Vector<Color4F> cached(values.size());
+	Vector<Color4F> batched(values.size());
+
+	auto uncachedTime = measureBenchmark(values.size(), [&](size_t i) {
+		uncached[i] = ColorHCT::solveColor4F(values[i].hue, values[i].chroma, values[i].tone,
+				values[i].alpha);
+	});
+
+	material2d::ColorCache::clear();
+	auto cachedTime = measureBenchmark(values.size(),
+			[&](size_t i) { cached[i] = material2d::ColorCache::solve(values[i]); });
+
+	// one call per frame, as for all surfaces, dirtied in frame
+	material2d::ColorCache::clear();
+	auto batchTime = measureBenchmark(SolveFrames, [&](size_t f) {
+		material2d::ColorCache::solve(
+				SpanView<ColorHCT::Values>(values.data() + f * SurfacesCount, SurfacesCount),
+				batched.data() + f * SurfacesCount);
+	});
+
+	// quantization step is 0.1 for hue, chroma and tone
+	float maxDiff = 0.0f;
+	for (size_t i = 0; i < values.size(); ++i) {
+		for (auto c : {&cached[i], &batched[i]}) {
+			maxDiff = std::max(maxDiff, std::abs(c->r - uncached[i].r));
+			maxDiff = std::max(maxDiff, std::abs(c->g - uncached[i].g));
+			maxDiff = std::max(maxDiff, std::abs(c->b - uncached[i].b));
+		}
+	}
+
+	_out << "Surfaces: " << SurfacesCount << ", transition frames: " << SolveFrames << "\n";
+	_out << "HCT solve: " << uncachedTime << " mcs per color\n";
+	_out << "ColorCache: " << cachedTime << " mcs per color\n";
+	_out << "ColorCache batch: " << batchTime / double(SurfacesCount) << " mcs per color, "
+		 << batchTime << " mcs per frame\n";
+	_out << "Max channel difference: " << maxDiff << "\n";
+}
+
+void BenchSurfaceStyleTest::switchTheme(uint64_t time) {
+	_dark = !_dark;
+	_switchTime = time;
+
+	auto type = _dark ? material2d::ThemeType::DarkTheme : material2d::ThemeType::LightTheme;
+	_style->setPrimaryScheme(type, _color, false);
+
+	// every surface also changes its role, so style is interpolated on each frame
+	for (uint32_t i = 0; i < SurfacesCount; ++i) {
+		auto role = s_surfaceRoles[(i + (_dark ? 1 : 0)) % s_surfaceRolesCount];
+		_surfaces[i]->setStyle(
+				material2d::SurfaceStyle(material2d::NodeStyle::Filled, role), TransitionDuration);
+	}
+}
+
+void BenchSurfaceStyleTest::finalizeBenchmark() {
+	stopAllActionsByTag("BenchSurfaceStyleTest"_tag);
+
+	auto stats = material2d::ColorCache::getStats();
+	auto hits = stats.hits - _stats.hits;
+	auto misses = stats.misses - _stats.misses;
+
+	_out << "Theme switches: " << Switches << ", frames: " << _frames << "\n";
+	_out << "Scene time: " << _sceneTime / double(std::max(_frames, uint32_t(1)))
+		 << " ms avg, " << _maxSceneTime << " ms max\n";
+	_out << "ColorCache: " << hits << " hits, " << misses << " misses, " << stats.entries
+		 << " entries\n";
+
+	auto done = sp::move(_done);
+	_done = nullptr;
+	done(true, _out.str());
+}
+
+} // namespace stappler::xenolith::app
@@ -0,0 +1,79 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef TEST_SRC_TESTS_BENCH_APPBENCHSURFACESTYLETEST_H_
+#define TEST_SRC_TESTS_BENCH_APPBENCHSURFACESTYLETEST_H_
+
+#include "AppBenchTest.h"
+#include "MaterialSurface.h"
+#include "MaterialStyleContainer.h"
+#include "MaterialColorCache.h"
+
+namespace stappler::xenolith::app {
+
+// Theme switch with many animated material surfaces: HCT resolution of interpolated colors
+// without cache, through ColorCache and with batch resolution, then frame time of surfaces
+// in transition between light and dark schemes
+class BenchSurfaceStyleTest : public BenchTest {
+public:
+	static constexpr uint32_t SurfacesCount = 1'000;
+	static constexpr uint32_t SolveFrames = 30;
+	static constexpr uint32_t Switches = 4;
+	static constexpr float TransitionDuration = 0.5f;
+
+	virtual ~BenchSurfaceStyleTest() { }
+
+	virtual bool init() override;
+
+	virtual void handleExit() override;
+	virtual void handleContentSizeDirty() override;
+
+	virtual void update(const UpdateTime &) override;
+
+protected:
+	using BenchTest::init;
+
+	virtual void performBenchmark(DoneCallback &&done) override;
+
+	void runSolveBenchmark();
+	void switchTheme(uint64_t time);
+	void finalizeBenchmark();
+
+	material2d::StyleContainer *_style = nullptr;
+	Node *_field = nullptr;
+	Vector<material2d::Surface *> _surfaces;
+
+	DoneCallback _done;
+	StringStream _out;
+	ColorHCT _color;
+	bool _dark = false;
+	uint32_t _switch = 0;
+	uint32_t _frames = 0;
+	uint64_t _switchTime = 0;
+	double _sceneTime = 0.0;
+	float _maxSceneTime = 0.0f;
+	material2d::ColorCache::Stats _stats;
+};
+
+} // namespace stappler::xenolith::app
+
+#endif /* TEST_SRC_TESTS_BENCH_APPBENCHSURFACESTYLETEST_H_ */
@@ -0,0 +1,40 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "XLCommon.h" // IWYU pragma: keep
+
+#include "bench/AppBenchFrameCacheTest.cc"
+#include "bench/AppBenchSceneFrameTest.cc"
+#include "bench/AppBenchFramePoolTest.cc"
+#include "bench/AppBenchStorageWriteTest.cc"
+#include "bench/AppBenchHttpServer.cc"
+#include "bench/AppBenchNetworkCacheTest.cc"
+#include "bench/AppBenchAssetStreamTest.cc"
+#include "bench/AppBenchAssetDownloadTest.cc"
+#include "bench/AppBenchSurfaceStyleTest.cc"
+#include "bench/AppBenchDrawOrderTest.cc"
+#include "bench/AppBenchVertexKernelsTest.cc"
+#include "bench/AppBenchDistanceFieldTest.cc"
+#include "bench/AppBenchGlyphEvictionTest.cc"
+#include "bench/AppBenchStorageQueryTest.cc"
+#include "bench/AppBenchMaterialSetTest.cc"
+#include "bench/AppBenchDamageTrackingTest.cc"
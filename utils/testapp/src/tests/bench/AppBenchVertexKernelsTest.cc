@@ -0,0 +1,174 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "AppBenchVertexKernelsTest.h"
+#include "XL2dVertexKernels.h"
+#include <random>
+
+namespace stappler::xenolith::app {
+
+static constexpr uint32_t BenchVertexKernelsVertexes = 64 * 1'024 + 3;
+static constexpr uint32_t BenchVertexKernelsIndexes = 96 * 1'024 + 5;
+static constexpr uint32_t BenchVertexKernelsColors = 64 * 1'024;
+static constexpr uint32_t BenchVertexKernelsIterations = 50;
+
+// values, where variants can diverge: NaN, infinities, signed zero, bounds and rounding ties
+static float BenchVertexKernels_special[] = {
+	std::numeric_limits<float>::quiet_NaN(),
+	-std::numeric_limits<float>::quiet_NaN(),
+	std::numeric_limits<float>::infinity(),
+	-std::numeric_limits<float>::infinity(),
+	0.0f,
+	-0.0f,
+	1.0f,
+	-1.0f,
+	2.0f,
+	0.5f / 255.0f,
+	1.5f / 255.0f,
+	2.5f / 255.0f,
+	254.5f / 255.0f,
+	std::numeric_limits<float>::denorm_min(),
+	std::numeric_limits<float>::max(),
+};
+
+bool BenchVertexKernelsTest::init() {
+	if (!BenchTest::init(LayoutName::BenchVertexKernelsTest,
+				"Vertex write kernels, compared with scalar variant")) {
+		return false;
+	}
+	return true;
+}
+
+bool BenchVertexKernelsTest::runBenchmark(StringStream &out) {
+	constexpr size_t NSpecial = sizeof(BenchVertexKernels_special) / sizeof(float);
+
+	std::mt19937 rnd(12'345);
+	std::uniform_real_distribution<float> dist(-0.5f, 1.5f);
+
+	Vector<basic2d::Vertex> vertexes;
+	vertexes.resize(BenchVertexKernelsVertexes);
+	for (auto &it : vertexes) {
+		auto data = reinterpret_cast<uint32_t *>(&it);
+		for (size_t i = 0; i < sizeof(basic2d::Vertex) / sizeof(uint32_t); ++i) { data[i] = rnd(); }
+	}
+
+	Vector<uint32_t> indexes;
+	indexes.resize(BenchVertexKernelsIndexes);
+	for (auto &it : indexes) { it = rnd(); }
+
+	// all combinations of special values for the first components, random values for the rest
+	Vector<Vec4> colors;
+	colors.resize(BenchVertexKernelsColors);
+	for (size_t i = 0; i < colors.size(); ++i) {
+		if (i < NSpecial * NSpecial) {
+			colors[i] = Vec4(BenchVertexKernels_special[i % NSpecial],
+					BenchVertexKernels_special[i / NSpecial], dist(rnd),
+					BenchVertexKernels_special[(i * 7) % NSpecial]);
+		} else {
+			colors[i] = Vec4(dist(rnd), dist(rnd), dist(rnd), dist(rnd));
+		}
+	}
+
+	auto available = basic2d::VertexKernels::getAvailable();
+	auto &scalar = available[0];
+
+	Vector<basic2d::Vertex> expectedVertexes, vertexesTarget;
+	expectedVertexes.resize(vertexes.size());
+	vertexesTarget.resize(vertexes.size());
+
+	Vector<uint32_t> expectedIndexes, indexesTarget;
+	expectedIndexes.resize(indexes.size());
+	indexesTarget.resize(indexes.size());
+
+	Vector<uint32_t> expectedColors, colorsTarget;
+	expectedColors.resize(colors.size());
+	colorsTarget.resize(colors.size());
+
+	// counts from 0 to 16 cover every tail of vector loops
+	auto checkTails = [&](const basic2d::VertexKernels &k) {
+		for (size_t count = 0; count <= 16; ++count) {
+			std::fill(expectedVertexes.begin(), expectedVertexes.begin() + 17, basic2d::Vertex());
+			std::fill(vertexesTarget.begin(), vertexesTarget.begin() + 17, basic2d::Vertex());
+			scalar.copyVertexes(expectedVertexes.data(), vertexes.data(), count, 0xdead'beef);
+			k.copyVertexes(vertexesTarget.data(), vertexes.data(), count, 0xdead'beef);
+			if (memcmp(expectedVertexes.data(), vertexesTarget.data(),
+						17 * sizeof(basic2d::Vertex))
+					!= 0) {
+				return false;
+			}
+
+			std::fill(expectedIndexes.begin(), expectedIndexes.begin() + 17, 0);
+			std::fill(indexesTarget.begin(), indexesTarget.begin() + 17, 0);
+			scalar.rebaseIndexes(expectedIndexes.data(), indexes.data(), count, 1'000'003);
+			k.rebaseIndexes(indexesTarget.data(), indexes.data(), count, 1'000'003);
+			if (memcmp(expectedIndexes.data(), indexesTarget.data(), 17 * sizeof(uint32_t))
+					!= 0) {
+				return false;
+			}
+		}
+		return true;
+	};
+
+	scalar.copyVertexes(expectedVertexes.data(), vertexes.data(), vertexes.size(), 0x1'0042);
+	scalar.rebaseIndexes(expectedIndexes.data(), indexes.data(), indexes.size(), 1'000'003);
+	for (size_t i = 0; i < colors.size(); ++i) { expectedColors[i] = scalar.packColor(colors[i]); }
+
+	bool valid = true;
+
+	out << "Vertexes: " << vertexes.size() << ", indexes: " << indexes.size()
+		<< ", colors: " << colors.size() << "\n";
+	out << "Selected: " << basic2d::VertexKernels::get().name << "\n";
+
+	for (auto &k : available) {
+		auto copyTime = measureBenchmark(BenchVertexKernelsIterations, [&](size_t) {
+			k.copyVertexes(vertexesTarget.data(), vertexes.data(), vertexes.size(), 0x1'0042);
+		});
+		auto copyValid = memcmp(expectedVertexes.data(), vertexesTarget.data(),
+								 vertexes.size() * sizeof(basic2d::Vertex))
+				== 0;
+
+		auto rebaseTime = measureBenchmark(BenchVertexKernelsIterations, [&](size_t) {
+			k.rebaseIndexes(indexesTarget.data(), indexes.data(), indexes.size(), 1'000'003);
+		});
+		auto rebaseValid = memcmp(expectedIndexes.data(), indexesTarget.data(),
+								   indexes.size() * sizeof(uint32_t))
+				== 0;
+
+		auto packTime = measureBenchmark(BenchVertexKernelsIterations, [&](size_t) {
+			for (size_t i = 0; i < colors.size(); ++i) { colorsTarget[i] = k.packColor(colors[i]); }
+		});
+		auto packValid = expectedColors == colorsTarget;
+
+		auto tailsValid = checkTails(k);
+
+		out << k.name << ": copy " << copyTime << " us (" << (copyValid ? "matches" : "DIFFERS")
+			<< "), rebase " << rebaseTime << " us (" << (rebaseValid ? "matches" : "DIFFERS")
+			<< "), pack color " << packTime << " us (" << (packValid ? "matches" : "DIFFERS")
+			<< "), tails " << (tailsValid ? "match" : "DIFFER") << "\n";
+
+		valid = valid && copyValid && rebaseValid && packValid && tailsValid;
+	}
+
+	return valid;
+}
+
+} // namespace stappler::xenolith::app
@@ -0,0 +1,121 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "AppBenchTest.h"
+#include "XLDirector.h"
+#include "XLAppThread.h"
+#include "AppScene.h"
+
+namespace stappler::xenolith::app {
+
+bool BenchTest::init(LayoutName layout, StringView text) {
+	if (!LayoutTest::init(layout, text)) {
+		return false;
+	}
+
+	_run = addChild(Rc<material2d::Button>::create(material2d::NodeStyle::Filled), ZOrder(1));
+	_run->setText("Run");
+	_run->setAnchorPoint(Anchor::MiddleTop);
+	_run->setFollowContentSize(false);
+	_run->setTapCallback([this] { run(); });
+
+	_result = addChild(Rc<Label>::create(), ZOrder(1));
+	_result->setFontFamily("monospace");
+	_result->setFontSize(14);
+	_result->setAnchorPoint(Anchor::MiddleTop);
+	_result->setAlignment(Label::TextAlign::Left);
+	_result->setString("Press Run to start");
+
+	return true;
+}
+
+void BenchTest::handleContentSizeDirty() {
+	LayoutTest::handleContentSizeDirty();
+
+	_run->setContentSize(Size2(120.0f, 32.0f));
+	_run->setPosition(Vec2(_contentSize.width / 2.0f, _contentSize.height - 96.0f));
+
+	_result->setWidth(std::min(_contentSize.width - 32.0f, 720.0f));
+	_result->setPosition(Vec2(_contentSize.width / 2.0f, _contentSize.height - 144.0f));
+}
+
+void BenchTest::handleEnter(xenolith::Scene *scene) {
+	LayoutTest::handleEnter(scene);
+
+	if (getDataValue().getBool("autorun")) {
+		run();
+	}
+}
+
+void BenchTest::run() {
+	if (_benchRunning) {
+		return;
+	}
+
+	_benchRunning = true;
+	_run->setEnabled(false);
+	_result->setString("Running...");
+
+	performBenchmark([this, app = Rc<AppThread>(_director->getApplication())](bool success,
+							 String &&report) mutable {
+		app->performOnAppThread([this, success, report = sp::move(report)]() mutable {
+			handleBenchmarkResult(success, sp::move(report));
+		}, this);
+	});
+}
+
+void BenchTest::performBenchmark(DoneCallback &&done) {
+	_director->getApplication()->perform(
+			[this, done = sp::move(done)](const thread::Task &) mutable {
+		StringStream out;
+		auto success = runBenchmark(out);
+		done(success, out.str());
+		return true;
+	}, nullptr, this);
+}
+
+bool BenchTest::runBenchmark(StringStream &out) {
+	out << "Benchmark is not defined\n";
+	return false;
+}
+
+void BenchTest::handleBenchmarkResult(bool success, String &&report) {
+	_benchRunning = false;
+	_run->setEnabled(true);
+
+	if (success) {
+		log::source().info(getName(), "Success:\n", report);
+	} else {
+		log::source().error(getName(), "Failed:\n", report);
+	}
+
+	_result->setString(toString(success ? "Success" : "Failed", "\n", report));
+
+	if (getDataValue().getBool("exit")) {
+		// started from launch URL: report to scene, it runs next benchmark or closes window
+		if (auto scene = dynamic_cast<AppScene *>(_scene)) {
+			scene->handleBenchmarkFinished(getName(), success, report);
+		}
+	}
+}
+
+} // namespace stappler::xenolith::app
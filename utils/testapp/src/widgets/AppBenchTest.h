@@ -0,0 +1,76 @@
+/**
+ Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef TEST_SRC_WIDGETS_APPBENCHTEST_H_
+#define TEST_SRC_WIDGETS_APPBENCHTEST_H_
+
+#include "AppLayoutTest.h"
+#include "MaterialButton.h"
+
+namespace stappler::xenolith::app {
+
+// Base layout for benchmarks and self-checking tests: workload is started with Run button
+// (or immediately with `autorun` in data value), report is shown on screen and written into log.
+// With `exit` in data value result is also passed to AppScene to continue launch URL run
+class BenchTest : public LayoutTest {
+public:
+	using DoneCallback = Function<void(bool success, String &&report)>;
+
+	virtual ~BenchTest() { }
+
+	virtual bool init(LayoutName, StringView);
+
+	virtual void handleContentSizeDirty() override;
+	virtual void handleEnter(xenolith::Scene *) override;
+
+	void run();
+
+	bool isBenchRunning() const { return _benchRunning; }
+
+protected:
+	using LayoutTest::init;
+
+	// Starts workload, `done` can be called from any thread.
+	// Default implementation calls runBenchmark on a worker thread
+	virtual void performBenchmark(DoneCallback &&done);
+
+	// Synchronous workload for default performBenchmark, called on a worker thread
+	virtual bool runBenchmark(StringStream &out);
+
+	void handleBenchmarkResult(bool success, String &&report);
+
+	material2d::Button *_run = nullptr;
+	Label *_result = nullptr;
+	bool _benchRunning = false;
+};
+
+// Measures average time of `count` calls, in microseconds
+template <typename Callback>
+inline double measureBenchmark(size_t count, const Callback &cb) {
+	auto t = sp::platform::clock(ClockType::Monotonic);
+	for (size_t i = 0; i < count; ++i) { cb(i); }
+	return double(sp::platform::clock(ClockType::Monotonic) - t) / double(count);
+}
+
+} // namespace stappler::xenolith::app
+
+#endif /* TEST_SRC_WIDGETS_APPBENCHTEST_H_ */
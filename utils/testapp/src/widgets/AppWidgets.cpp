@@ -31,3 +31,4 @@
 #include "AppMaterialColorPicker.cc"
 #include "AppMaterialBackground.cc"
 #include "AppMaterialTest.cc"
+#include "AppBenchTest.cc"